@@ -33,8 +33,30 @@
 #define DBUS_PIPELINE_I_LAUNCH_HANDLER          "handle-launch-pipeline"
 #define DBUS_PIPELINE_I_START_HANDLER           "handle-start-pipeline"
 #define DBUS_PIPELINE_I_STOP_HANDLER            "handle-stop-pipeline"
+#define DBUS_PIPELINE_I_LAUNCH_DEADLINE_HANDLER "handle-launch-pipeline-with-deadline"
+#define DBUS_PIPELINE_I_START_DEADLINE_HANDLER  "handle-start-pipeline-with-deadline"
+#define DBUS_PIPELINE_I_STOP_DEADLINE_HANDLER   "handle-stop-pipeline-with-deadline"
 #define DBUS_PIPELINE_I_DESTROY_HANDLER         "handle-destroy-pipeline"
 #define DBUS_PIPELINE_I_GET_STATE_HANDLER       "handle-get-state"
+#define DBUS_PIPELINE_I_GET_DEADLINE_MISSES_HANDLER "handle-get-deadline-misses"
+#define DBUS_PIPELINE_I_SET_ATTRIBUTES_HANDLER  "handle-set-pipeline-attributes"
+#define DBUS_PIPELINE_I_GET_ATTRIBUTES_HANDLER  "handle-get-pipeline-attributes"
+#define DBUS_PIPELINE_I_GET_POOL_STATS_HANDLER  "handle-get-pool-stats"
+#define DBUS_PIPELINE_I_LAUNCH_ASYNC_HANDLER    "handle-launch-pipeline-async"
+#define DBUS_PIPELINE_I_GET_STATISTICS_HANDLER  "handle-get-statistics"
+#define DBUS_PIPELINE_I_GET_RESTART_INFO_HANDLER "handle-get-restart-info"
+#define DBUS_PIPELINE_I_PROFILE_HANDLER         "handle-profile-pipeline"
+#define DBUS_PIPELINE_I_PROFILE_DEADLINE_HANDLER "handle-profile-pipeline-with-deadline"
+#define DBUS_PIPELINE_I_LAUNCH_BATCH_HANDLER    "handle-launch-pipelines"
+#define DBUS_PIPELINE_I_START_BATCH_HANDLER     "handle-start-pipelines"
+#define DBUS_PIPELINE_I_STOP_BATCH_HANDLER      "handle-stop-pipelines"
+#define DBUS_PIPELINE_I_DESTROY_BATCH_HANDLER   "handle-destroy-pipelines"
+#define DBUS_PIPELINE_I_LAUNCH_WITH_PARAMS_HANDLER "handle-launch-pipeline-with-params"
+#define DBUS_PIPELINE_I_GET_SHARE_STATS_HANDLER "handle-get-share-stats"
+#define DBUS_PIPELINE_I_SET_COMPOSITE_HANDLER   "handle-set-composite"
+#define DBUS_PIPELINE_I_GET_COMPOSITE_HANDLER   "handle-get-composite"
+#define DBUS_PIPELINE_I_DELETE_COMPOSITE_HANDLER "handle-delete-composite"
+#define DBUS_PIPELINE_I_LAUNCH_COMPOSITE_HANDLER "handle-launch-composite"
 
 /* Model Interface */
 #define DBUS_MODEL_INTERFACE            "org.tizen.machinelearning.service.model"
@@ -56,4 +78,11 @@
 #define DBUS_RESOURCE_I_HANDLER_GET                "handle-get"
 #define DBUS_RESOURCE_I_HANDLER_DELETE             "handle-delete"
 
+/* Debug Interface */
+#define DBUS_DEBUG_INTERFACE            "org.tizen.machinelearning.service.debug"
+#define DBUS_DEBUG_PATH                 "/Org/Tizen/MachineLearning/Service/Debug"
+
+#define DBUS_DEBUG_I_GET_LAG_HISTOGRAM_HANDLER     "handle-get-lag-histogram"
+#define DBUS_DEBUG_I_GET_TASK_POOL_STATS_HANDLER   "handle-get-task-pool-stats"
+
 #endif /* __GDBUS_INTERFACE_H__ */
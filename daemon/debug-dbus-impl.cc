@@ -0,0 +1,356 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file    debug-dbus-impl.cc
+ * @date    18 October 2026
+ * @brief   DBus implementation for Debug Interface
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  Sangjung Woo <sangjung.woo@samsung.com>
+ * @bug     No known bugs except for NYI items
+ * @details This implements the debug dbus interface and the stall detector of the main loop.
+ *          The stall detector runs a periodic timer in the main loop and measures how late it is dispatched.
+ *          When the lag exceeds the threshold, it logs the slowest method handler since the previous tick, which is measured by the handler guards.
+ *          The timer is stopped while the daemon is idle, and started again by the next method call.
+ */
+
+#include <errno.h>
+#include <glib.h>
+#include <json-glib/json-glib.h>
+#include <string.h>
+
+#include "common.h"
+#include "dbus-interface.h"
+#include "debug-dbus.h"
+#include "gdbus-util.h"
+#include "log.h"
+#include "mlops-agent-internal.h"
+#include "mlops-agent-node-taskpool.h"
+#include "modules.h"
+
+/**
+ * @brief The threshold (in milliseconds) of the dispatch lag to report the stall of the main loop.
+ */
+#define STALL_THRESHOLD_MS (100)
+
+/**
+ * @brief The interval (in milliseconds) of the timer measuring the dispatch lag.
+ * @details The stall longer than twice of the interval is always measured over the threshold.
+ */
+#define LAG_PROBE_INTERVAL_MS (STALL_THRESHOLD_MS)
+
+/**
+ * @brief The idle time (in microseconds) to stop the timer measuring the dispatch lag.
+ */
+#define LAG_PROBE_IDLE_TIME (10 * G_TIME_SPAN_SECOND)
+
+/**
+ * @brief The upper bounds (in milliseconds) of the histogram buckets. The last bucket has no upper bound.
+ */
+static const gint64 lag_bounds_ms[] = { 1, 5, 10, 50, 100, 500, 1000, 5000 };
+
+#define LAG_NUM_BUCKETS (G_N_ELEMENTS (lag_bounds_ms) + 1)
+
+/**
+ * @brief Internal structure for the stall detector. This is accessed only in the main context.
+ */
+typedef struct
+{
+  guint64 buckets[LAG_NUM_BUCKETS];
+  guint64 count;
+  guint64 stalls;
+  gint64 max_lag;
+  guint source;         /**< The timer measuring the dispatch lag, 0 if it is stopped */
+  gint64 expected;      /**< The monotonic time when the timer should be dispatched */
+  const gchar *method;  /**< The slowest method handler since the previous tick */
+  gint64 method_time;   /**< The time (in microseconds) the slowest method handler blocked the main loop */
+} stall_detector_s;
+
+static stall_detector_s g_stall_detector = { 0 };
+static MachinelearningServiceDebug *g_gdbus_debug_instance = NULL;
+
+/**
+ * @brief Record the dispatch lag of the timer, and report the stall of the main loop.
+ */
+static void
+_stall_detector_record (gint64 elapsed)
+{
+  stall_detector_s *detector = &g_stall_detector;
+  gboolean stalled;
+  gint64 lag;
+  guint i;
+
+  lag = elapsed / G_TIME_SPAN_MILLISECOND;
+  if (lag < 0)
+    lag = 0;
+
+  for (i = 0; i < G_N_ELEMENTS (lag_bounds_ms); i++) {
+    if (lag <= lag_bounds_ms[i])
+      break;
+  }
+
+  detector->buckets[i]++;
+  detector->count++;
+  if (lag > detector->max_lag)
+    detector->max_lag = lag;
+
+  stalled = (lag >= STALL_THRESHOLD_MS);
+  if (stalled) {
+    detector->stalls++;
+
+    if (detector->method) {
+      ml_logw ("The main loop was stalled for %" G_GINT64_FORMAT " ms, the method call '%s' blocked it for %" G_GINT64_FORMAT " ms.",
+          lag, detector->method, detector->method_time / G_TIME_SPAN_MILLISECOND);
+    } else {
+      ml_logw ("The main loop was stalled for %" G_GINT64_FORMAT " ms without the method call.", lag);
+    }
+  }
+
+  /* The watchdog is not notified if the main loop is stalled for its timeout. */
+  ml_agent_set_dispatch_lag (elapsed, stalled);
+
+  detector->method = NULL;
+  detector->method_time = 0;
+}
+
+/**
+ * @brief Timer callback to measure the dispatch lag of the main loop.
+ */
+static gboolean
+_stall_detector_probe (gpointer user_data)
+{
+  stall_detector_s *detector = &g_stall_detector;
+  gint64 now = g_get_monotonic_time ();
+  gint64 idle_time;
+
+  _stall_detector_record (now - detector->expected);
+
+  /* The timer is dispatched after the interval from now. */
+  detector->expected = now + LAG_PROBE_INTERVAL_MS * G_TIME_SPAN_MILLISECOND;
+
+  idle_time = ml_agent_get_idle_time ();
+  if (idle_time >= LAG_PROBE_IDLE_TIME) {
+    ml_agent_set_dispatch_lag (0, FALSE);
+    detector->source = 0;
+    return G_SOURCE_REMOVE;
+  }
+
+  return G_SOURCE_CONTINUE;
+}
+
+/**
+ * @brief Start the timer measuring the dispatch lag, if it is stopped.
+ */
+static void
+_stall_detector_start (void)
+{
+  stall_detector_s *detector = &g_stall_detector;
+
+  if (detector->source > 0)
+    return;
+
+  detector->expected = g_get_monotonic_time () + LAG_PROBE_INTERVAL_MS * G_TIME_SPAN_MILLISECOND;
+  detector->source = g_timeout_add (LAG_PROBE_INTERVAL_MS, _stall_detector_probe, NULL);
+}
+
+/**
+ * @brief Keep the slowest method handler since the previous tick when the handler returns, to report it with the stall.
+ */
+static void
+_stall_detector_record_method (const gchar *method, gint64 elapsed)
+{
+  stall_detector_s *detector = &g_stall_detector;
+
+  if (!detector->method || elapsed > detector->method_time) {
+    detector->method = method ? method : "unknown";
+    detector->method_time = elapsed;
+  }
+
+  _stall_detector_start ();
+}
+
+/**
+ * @brief Get the histogram of the dispatch lag in JSON string.
+ */
+static gchar *
+_stall_detector_get_histogram (void)
+{
+  stall_detector_s *detector = &g_stall_detector;
+  JsonBuilder *builder;
+  JsonNode *root;
+  gchar *histogram;
+  guint i;
+
+  builder = json_builder_new ();
+  json_builder_begin_object (builder);
+
+  json_builder_set_member_name (builder, "threshold_ms");
+  json_builder_add_int_value (builder, STALL_THRESHOLD_MS);
+  json_builder_set_member_name (builder, "count");
+  json_builder_add_int_value (builder, (gint64) detector->count);
+  json_builder_set_member_name (builder, "stalls");
+  json_builder_add_int_value (builder, (gint64) detector->stalls);
+  json_builder_set_member_name (builder, "max_ms");
+  json_builder_add_int_value (builder, detector->max_lag);
+
+  /* The bucket with 'le_ms' -1 counts the lag over the last bound. */
+  json_builder_set_member_name (builder, "buckets");
+  json_builder_begin_array (builder);
+  for (i = 0; i < LAG_NUM_BUCKETS; i++) {
+    json_builder_begin_object (builder);
+    json_builder_set_member_name (builder, "le_ms");
+    json_builder_add_int_value (builder,
+        (i < G_N_ELEMENTS (lag_bounds_ms)) ? lag_bounds_ms[i] : -1);
+    json_builder_set_member_name (builder, "count");
+    json_builder_add_int_value (builder, (gint64) detector->buckets[i]);
+    json_builder_end_object (builder);
+  }
+  json_builder_end_array (builder);
+
+  json_builder_end_object (builder);
+
+  root = json_builder_get_root (builder);
+  histogram = json_to_string (root, FALSE);
+
+  json_node_unref (root);
+  g_object_unref (builder);
+  return histogram;
+}
+
+/**
+ * @brief The callback function of get_lag_histogram method
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_debug_get_lag_histogram (MachinelearningServiceDebug *obj, GDBusMethodInvocation *invoc)
+{
+  g_autofree gchar *histogram = _stall_detector_get_histogram ();
+  gint ret = histogram ? 0 : -EIO;
+
+  machinelearning_service_debug_complete_get_lag_histogram (
+      obj, invoc, ret, histogram ? histogram : "");
+
+  return TRUE;
+}
+
+/**
+ * @brief The callback function of get_task_pool_stats method
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_debug_get_task_pool_stats (MachinelearningServiceDebug *obj, GDBusMethodInvocation *invoc)
+{
+  g_autofree gchar *stats = NULL;
+  gint ret;
+
+  ret = mlops_node_task_pool_get_stats (&stats);
+  machinelearning_service_debug_complete_get_task_pool_stats (
+      obj, invoc, ret, stats ? stats : "");
+
+  return TRUE;
+}
+
+/**
+ * @brief Event handler list of debug interface
+ */
+static struct gdbus_signal_info debug_handler_infos[] = {
+  {
+      .signal_name = DBUS_DEBUG_I_GET_LAG_HISTOGRAM_HANDLER,
+      .cb = G_CALLBACK (gdbus_cb_debug_get_lag_histogram),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_DEBUG_I_GET_TASK_POOL_STATS_HANDLER,
+      .cb = G_CALLBACK (gdbus_cb_debug_get_task_pool_stats),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+};
+
+/**
+ * @brief The callback function for probing debug interface module.
+ */
+static int
+probe_debug_module (void *data)
+{
+  int ret = 0;
+
+  ml_logd ("probe_debug_module");
+
+  g_gdbus_debug_instance = machinelearning_service_debug_skeleton_new ();
+  if (NULL == g_gdbus_debug_instance) {
+    ml_loge ("cannot get a dbus instance for the %s interface\n", DBUS_DEBUG_INTERFACE);
+    return -ENOSYS;
+  }
+
+  ret = gdbus_connect_signal (g_gdbus_debug_instance,
+      ARRAY_SIZE (debug_handler_infos), debug_handler_infos);
+  if (ret < 0) {
+    ml_loge ("cannot register callbacks as the dbus method invocation handlers\n ret: %d", ret);
+    ret = -ENOSYS;
+    goto out;
+  }
+
+  ret = gdbus_export_interface (g_gdbus_debug_instance, DBUS_DEBUG_PATH);
+  if (ret < 0) {
+    ml_loge ("cannot export the dbus interface '%s' at the object path '%s'\n",
+        DBUS_DEBUG_INTERFACE, DBUS_DEBUG_PATH);
+    ret = -ENOSYS;
+    goto out_disconnect;
+  }
+
+  return 0;
+
+out_disconnect:
+  gdbus_disconnect_signal (g_gdbus_debug_instance,
+      ARRAY_SIZE (debug_handler_infos), debug_handler_infos);
+
+out:
+  g_clear_object (&g_gdbus_debug_instance);
+
+  return ret;
+}
+
+/**
+ * @brief The callback function for initializing debug interface module.
+ */
+static void
+init_debug_module (void *data)
+{
+  memset (&g_stall_detector, 0, sizeof (g_stall_detector));
+  gdbus_set_dispatch_cb (_stall_detector_record_method);
+  _stall_detector_start ();
+}
+
+/**
+ * @brief The callback function for exiting debug interface module.
+ */
+static void
+exit_debug_module (void *data)
+{
+  gdbus_set_dispatch_cb (NULL);
+
+  if (g_stall_detector.source > 0) {
+    g_source_remove (g_stall_detector.source);
+    g_stall_detector.source = 0;
+  }
+  ml_agent_set_dispatch_lag (0, FALSE);
+
+  gdbus_disconnect_signal (g_gdbus_debug_instance,
+      ARRAY_SIZE (debug_handler_infos), debug_handler_infos);
+  g_clear_object (&g_gdbus_debug_instance);
+}
+
+static const struct module_ops debug_ops = {
+  .name = "debug-interface",
+  .probe = probe_debug_module,
+  .init = init_debug_module,
+  .exit = exit_debug_module,
+};
+
+MODULE_OPS_REGISTER (&debug_ops)
@@ -16,8 +16,120 @@
 
 #include "gdbus-util.h"
 #include "log.h"
+#include "mlops-agent-internal.h"
 
 static GDBusConnection *g_dbus_sys_conn = NULL;
+static guint g_dbus_name_id = 0;
+static guint g_dbus_filter_id = 0;
+static GHashTable *g_dbus_exported_table = NULL;
+static gdbus_dispatch_cb g_dbus_dispatch_cb = NULL;
+
+/**
+ * @brief Internal structure for the method handler, to track the dispatch in the main context.
+ */
+typedef struct
+{
+  const gchar *method;  /**< The interned name of the handler signal */
+  gint64 start;         /**< The monotonic time when the handler is called */
+} gdbus_dispatch_s;
+
+/**
+ * @brief Filter function for the incoming messages, to update the activity of mlops-agent.
+ * @remarks This is called in the worker thread of GDBus, before the method call is dispatched to the main context.
+ */
+static GDBusMessage *
+_gdbus_message_filter (GDBusConnection * connection, GDBusMessage * message,
+    gboolean incoming, gpointer user_data)
+{
+  if (incoming && g_dbus_message_get_message_type (message) == G_DBUS_MESSAGE_TYPE_METHOD_CALL)
+    ml_agent_update_activity ();
+
+  return message;
+}
+
+/**
+ * @brief Marshal guard called in the main context before the method handler, to set the current method.
+ */
+static void
+_gdbus_dispatch_begin (gpointer data, GClosure * closure)
+{
+  gdbus_dispatch_s *dispatch = (gdbus_dispatch_s *) data;
+
+  dispatch->start = g_get_monotonic_time ();
+  ml_agent_set_current_method (dispatch->method);
+}
+
+/**
+ * @brief Marshal guard called in the main context after the method handler returns, to clear the current method.
+ */
+static void
+_gdbus_dispatch_end (gpointer data, GClosure * closure)
+{
+  gdbus_dispatch_s *dispatch = (gdbus_dispatch_s *) data;
+  gdbus_dispatch_cb cb = g_dbus_dispatch_cb;
+
+  ml_agent_set_current_method (NULL);
+
+  if (cb)
+    cb (dispatch->method, g_get_monotonic_time () - dispatch->start);
+}
+
+/**
+ * @brief Free the dispatch information when the handler is disconnected.
+ */
+static void
+_gdbus_dispatch_free (gpointer data, GClosure * closure)
+{
+  g_free (data);
+}
+
+/**
+ * @brief Call the method handler of the DBus interface with the method invocation.
+ * @details The vtable of the skeleton does not emit 'g-authorize-method', so authorize the method here as GDBus does.
+ */
+static void
+_gdbus_call_method (GDBusInterfaceSkeleton * skeleton, GDBusMethodInvocation * invoc)
+{
+  GDBusInterfaceVTable *vtable;
+  gboolean authorized = TRUE;
+
+  if (g_signal_has_handler_pending (skeleton,
+          g_signal_lookup ("g-authorize-method", G_TYPE_DBUS_INTERFACE_SKELETON), 0, TRUE)) {
+    g_signal_emit_by_name (skeleton, "g-authorize-method", invoc, &authorized);
+  }
+
+  if (!authorized) {
+    /* The handler of 'g-authorize-method' takes the reference and completes the invocation. */
+    ml_logw ("The method '%s' is not authorized.", g_dbus_method_invocation_get_method_name (invoc));
+    g_object_unref (invoc);
+    return;
+  }
+
+  vtable = g_dbus_interface_skeleton_get_vtable (skeleton);
+
+  /* The method handler takes the ownership of invocation. */
+  vtable->method_call (g_dbus_method_invocation_get_connection (invoc),
+      g_dbus_method_invocation_get_sender (invoc),
+      g_dbus_method_invocation_get_object_path (invoc),
+      g_dbus_method_invocation_get_interface_name (invoc),
+      g_dbus_method_invocation_get_method_name (invoc),
+      g_dbus_method_invocation_get_parameters (invoc), invoc, skeleton);
+}
+
+/**
+ * @brief Callback function called when the exported interface is finalized.
+ */
+static void
+_gdbus_exported_instance_finalized (gpointer data, GObject * where_the_object_was)
+{
+  gchar *obj_path = (gchar *) data;
+
+  if (g_dbus_exported_table &&
+      g_hash_table_lookup (g_dbus_exported_table, obj_path) == (gpointer) where_the_object_was)
+    g_hash_table_remove (g_dbus_exported_table, obj_path);
+
+  g_free (obj_path);
+}
 
 /**
  * @brief Export the DBus interface at the Object path on the bus connection.
@@ -35,9 +147,79 @@ gdbus_export_interface (gpointer instance, const char *obj_path)
     return -EBUSY;
   }
 
+  /* Keep the exported interface to dispatch the method invocation (see gdbus_dispatch_invocation()). */
+  if (!g_dbus_exported_table)
+    g_dbus_exported_table = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  g_hash_table_insert (g_dbus_exported_table, g_strdup (obj_path), instance);
+  g_object_weak_ref (G_OBJECT (instance), _gdbus_exported_instance_finalized,
+      g_strdup (obj_path));
+
+  return 0;
+}
+
+/**
+ * @brief Register the object with the interface information at the Object path on the bus connection.
+ */
+int
+gdbus_register_object (const char *obj_path, GDBusInterfaceInfo * info,
+    const GDBusInterfaceVTable * vtable, gpointer user_data, guint * id)
+{
+  GError *err = NULL;
+  guint reg_id;
+
+  if (!obj_path || !info || !vtable || !id)
+    return -EINVAL;
+
+  if (g_dbus_sys_conn == NULL) {
+    ml_loge ("Cannot get the dbus connection to the system message bus");
+    return -ENOSYS;
+  }
+
+  reg_id = g_dbus_connection_register_object (g_dbus_sys_conn, obj_path, info,
+      vtable, user_data, NULL, &err);
+  if (reg_id == 0) {
+    ml_loge ("Cannot register the object at '%s': %s", obj_path,
+        err ? err->message : "Unknown error");
+    g_clear_error (&err);
+    return -EBUSY;
+  }
+
+  *id = reg_id;
   return 0;
 }
 
+/**
+ * @brief Unregister the object registered by gdbus_register_object().
+ */
+void
+gdbus_unregister_object (guint id)
+{
+  if (g_dbus_sys_conn && id > 0)
+    g_dbus_connection_unregister_object (g_dbus_sys_conn, id);
+}
+
+/**
+ * @brief Dispatch the method invocation to the handler of the DBus interface exported at the object path.
+ */
+gboolean
+gdbus_dispatch_invocation (GDBusMethodInvocation * invoc)
+{
+  GDBusInterfaceSkeleton *skeleton = NULL;
+
+  if (g_dbus_exported_table) {
+    skeleton = (GDBusInterfaceSkeleton *) g_hash_table_lookup (g_dbus_exported_table,
+        g_dbus_method_invocation_get_object_path (invoc));
+  }
+
+  if (!skeleton)
+    return FALSE;
+
+  _gdbus_call_method (skeleton, invoc);
+
+  return TRUE;
+}
+
 /**
  * @brief Callback function for acquireing the bus name.
  * @remarks If the daemon is launched by systemd service,
@@ -47,6 +229,7 @@ static void
 name_acquired_cb (GDBusConnection * connection,
     const gchar * name, gpointer user_data)
 {
+  ml_agent_trace_startup ("bus name acquired");
   sd_notify (0, "READY=1");
 }
 
@@ -63,9 +246,106 @@ gdbus_get_name (const char *name)
   if (id == 0)
     return -ENOSYS;
 
+  g_dbus_name_id = id;
+  return 0;
+}
+
+/**
+ * @brief Release the name owned on the DBus message bus.
+ */
+void
+gdbus_put_name (void)
+{
+  if (g_dbus_name_id > 0) {
+    g_bus_unown_name (g_dbus_name_id);
+    g_dbus_name_id = 0;
+  }
+}
+
+/**
+ * @brief Release the name owned on the DBus message bus, and wait until the message bus handles it.
+ */
+int
+gdbus_put_name_sync (void)
+{
+  GError *err = NULL;
+  GVariant *reply;
+
+  gdbus_put_name ();
+
+  if (g_dbus_sys_conn == NULL)
+    return -ENOSYS;
+
+  /**
+   * The message bus handles the messages in order. When the reply of this call arrives,
+   * the method calls routed to this process before releasing the name are already received.
+   */
+  reply = g_dbus_connection_call_sync (g_dbus_sys_conn, "org.freedesktop.DBus",
+      "/org/freedesktop/DBus", "org.freedesktop.DBus", "GetId", NULL, NULL,
+      G_DBUS_CALL_FLAGS_NONE, -1, NULL, &err);
+  if (reply == NULL) {
+    ml_loge ("Failed to wait for releasing the name: %s", err ? err->message : "Unknown error");
+    g_clear_error (&err);
+    return -EIO;
+  }
+
+  g_variant_unref (reply);
   return 0;
 }
 
+/**
+ * @brief Internal structure for the method invocation pending until the dependencies are ready.
+ */
+typedef struct
+{
+  GDBusInterfaceSkeleton *skeleton;
+  GDBusMethodInvocation *invoc;
+} gdbus_pending_invocation_s;
+
+/**
+ * @brief Dispatch the pending method invocation to the handler of the DBus interface.
+ */
+static gboolean
+_gdbus_dispatch_invocation (gpointer data)
+{
+  gdbus_pending_invocation_s *pending = (gdbus_pending_invocation_s *) data;
+  GDBusMethodInvocation *invoc = pending->invoc;
+
+  _gdbus_call_method (pending->skeleton, invoc);
+
+  g_object_unref (pending->skeleton);
+  g_free (pending);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Defer the method invocation until the dependencies are ready.
+ */
+gboolean
+gdbus_defer_invocation (gpointer instance, GDBusMethodInvocation * invoc,
+    const int deps)
+{
+  gdbus_pending_invocation_s *pending;
+
+  if (ml_agent_is_ready (deps))
+    return FALSE;
+
+  pending = g_new0 (gdbus_pending_invocation_s, 1);
+  pending->skeleton = G_DBUS_INTERFACE_SKELETON (g_object_ref (instance));
+  pending->invoc = invoc;
+
+  if (!ml_agent_run_when_ready (deps, _gdbus_dispatch_invocation, pending)) {
+    /* The dependencies became ready in the meantime. */
+    g_object_unref (pending->skeleton);
+    g_free (pending);
+    return FALSE;
+  }
+
+  ml_logd ("The method '%s' is pending until the dependencies are ready.",
+      g_dbus_method_invocation_get_method_name (invoc));
+  return TRUE;
+}
+
 /**
  * @brief Connects the callback functions for each signal of the particular DBus interface.
  */
@@ -75,11 +355,20 @@ gdbus_connect_signal (gpointer instance, int num_signals,
 {
   int i;
   unsigned long handler_id;
+  GClosure *closure;
+  gdbus_dispatch_s *dispatch;
 
   for (i = 0; i < num_signals; i++) {
-    handler_id = g_signal_connect (instance,
-        signal_infos[i].signal_name,
-        signal_infos[i].cb, signal_infos[i].cb_data);
+    dispatch = g_new0 (gdbus_dispatch_s, 1);
+    dispatch->method = g_intern_string (signal_infos[i].signal_name);
+
+    closure = g_cclosure_new (signal_infos[i].cb, signal_infos[i].cb_data, NULL);
+    g_closure_add_marshal_guards (closure, dispatch, _gdbus_dispatch_begin,
+        dispatch, _gdbus_dispatch_end);
+    g_closure_add_finalize_notifier (closure, dispatch, _gdbus_dispatch_free);
+
+    handler_id = g_signal_connect_closure (instance,
+        signal_infos[i].signal_name, closure, FALSE);
     if (handler_id <= 0)
       goto out_err;
     signal_infos[i].handler_id = handler_id;
@@ -114,6 +403,15 @@ gdbus_disconnect_signal (gpointer instance, int num_signals,
   }
 }
 
+/**
+ * @brief Set the callback to be called when the method handler connected with gdbus_connect_signal() returns.
+ */
+void
+gdbus_set_dispatch_cb (gdbus_dispatch_cb cb)
+{
+  g_dbus_dispatch_cb = cb;
+}
+
 /**
  * @brief Connect to the DBus message bus, which type is SYSTEM.
  */
@@ -131,6 +429,8 @@ gdbus_get_system_connection (gboolean is_session)
     return -ENOSYS;
   }
 
+  g_dbus_filter_id = g_dbus_connection_add_filter (g_dbus_sys_conn,
+      _gdbus_message_filter, NULL, NULL);
   return 0;
 }
 
@@ -140,6 +440,12 @@ gdbus_get_system_connection (gboolean is_session)
 void
 gdbus_put_system_connection (void)
 {
+  gdbus_put_name ();
+
+  if (g_dbus_sys_conn && g_dbus_filter_id > 0)
+    g_dbus_connection_remove_filter (g_dbus_sys_conn, g_dbus_filter_id);
+  g_dbus_filter_id = 0;
+
   g_clear_object (&g_dbus_sys_conn);
 }
 
@@ -149,10 +455,6 @@ gdbus_put_system_connection (void)
 void
 gdbus_initialize (void)
 {
-  GError *err = NULL;
-
-  if (!gst_init_check (NULL, NULL, &err))
-    ml_loge ("Failed to initialize GStreamer: %s", (err ? err->message : "Unknown error"));
-
-  g_clear_error (&err);
+  /* GStreamer is initialized in the background thread, not to block the main loop. */
+  ml_agent_start_dependency (ML_AGENT_DEP_GST);
 }
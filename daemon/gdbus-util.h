@@ -38,6 +38,13 @@ struct gdbus_signal_info
   gulong handler_id;    /**< Connected handler ID */
 };
 
+/**
+ * @brief Callback called in the main context when the method handler returns.
+ * @param method The name of the handler signal of the method.
+ * @param elapsed The time (in microseconds) the handler blocked the main context.
+ */
+typedef void (*gdbus_dispatch_cb) (const gchar *method, gint64 elapsed);
+
 /**
  * @brief Export the DBus interface at the Object path on the bus connection.
  * @param instance The instance of the DBus interface to export.
@@ -46,6 +53,33 @@ struct gdbus_signal_info
  */
 int gdbus_export_interface (gpointer instance, const char *obj_path);
 
+/**
+ * @brief Register the object with the interface information at the Object path on the bus connection.
+ * @details This is used to register the stub of the DBus interface which is not exported yet.
+ * @param obj_path The path to register the object at.
+ * @param info The introspection information of the interface.
+ * @param vtable The function table to handle the method call.
+ * @param user_data The data to pass to the functions in @a vtable.
+ * @param id The registration id, to unregister the object using gdbus_unregister_object().
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+int gdbus_register_object (const char *obj_path, GDBusInterfaceInfo *info,
+    const GDBusInterfaceVTable *vtable, gpointer user_data, guint *id);
+
+/**
+ * @brief Unregister the object registered by gdbus_register_object().
+ * @param id The registration id.
+ */
+void gdbus_unregister_object (guint id);
+
+/**
+ * @brief Dispatch the method invocation to the handler of the DBus interface exported at the object path of the invocation.
+ * @details The method is authorized with 'g-authorize-method' of the interface before calling the handler.
+ * @param invoc The method invocation handle. The handler takes the ownership if the invocation is dispatched.
+ * @return TRUE if the invocation is dispatched. FALSE if there is no exported interface at the object path.
+ */
+gboolean gdbus_dispatch_invocation (GDBusMethodInvocation *invoc);
+
 /**
  * @brief Acquire the given name on the SYSTEM session of the DBus message bus.
  * @remarks If the name is acquired, 'READY=1' signal will be sent to the systemd.
@@ -54,8 +88,34 @@ int gdbus_export_interface (gpointer instance, const char *obj_path);
  */
 int gdbus_get_name (const char *name);
 
+/**
+ * @brief Release the name owned on the DBus message bus.
+ * @remarks The new request to the name will activate the daemon again (D-Bus activation).
+ */
+void gdbus_put_name (void);
+
+/**
+ * @brief Release the name owned on the DBus message bus, and wait until the message bus handles it.
+ * @details The method calls sent to the name before it is released are queued in the main context when this returns.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+int gdbus_put_name_sync (void);
+
+/**
+ * @brief Defer the method invocation until the dependencies are ready.
+ * @details If the dependencies are not ready, the invocation is dispatched again to the handler of the DBus interface in the main context when the dependencies are ready.
+ *          The deferred invocations are dispatched in arrival order, and authorized again with 'g-authorize-method' of the interface.
+ * @param instance The instance of the DBus interface.
+ * @param invoc The method invocation handle.
+ * @param deps The dependencies of the method (see ml_agent_dep_e).
+ * @return TRUE if the invocation is deferred, the handler should return without completing the invocation.
+ */
+gboolean gdbus_defer_invocation (gpointer instance, GDBusMethodInvocation *invoc,
+    const int deps);
+
 /**
  * @brief Connects the callback functions for each signal of the particular DBus interface.
+ * @details The current method is set while the callback function runs in the main context (see ml_agent_get_current_method()).
  * @param instance The instance of the DBus interface.
  * @param num_signals The number of signals to connect.
  * @param signal_infos The array of DBus signal handler.
@@ -73,8 +133,15 @@ int gdbus_connect_signal (gpointer instance, int num_signals,
 void gdbus_disconnect_signal (gpointer instance, int num_signals,
     struct gdbus_signal_info *signal_infos);
 
+/**
+ * @brief Set the callback to be called when the method handler connected with gdbus_connect_signal() returns.
+ * @param cb The callback function, NULL to remove the callback.
+ */
+void gdbus_set_dispatch_cb (gdbus_dispatch_cb cb);
+
 /**
  * @brief Connect to the DBus message bus
+ * @remarks Each method call on the connection updates the activity of mlops-agent (see ml_agent_update_activity()).
  * @param is_session True is DBus Bus type is session.
  * @return @c 0 on success. Otherwise a negative error value.
  */
@@ -87,6 +154,7 @@ void gdbus_put_system_connection (void);
 
 /**
  * @brief Common function to initialize the DBus module.
+ * @remarks GStreamer is initialized in the background thread. Use gdbus_defer_invocation() for the method which requires GStreamer.
  */
 void gdbus_initialize (void);
 
@@ -18,6 +18,9 @@ extern "C" {
 
 /**
  * @brief An interface exported for setting the description of a pipeline.
+ * @details The description may have the placeholders replaced when launching the pipeline, see ml_agent_pipeline_launch_with_params().
+ *          The text '${' which is not a valid placeholder is kept as it is, and '$${' is the escape of the literal '${'. The running pipelines keep the previous description,
+ *          unless the reload policy is set with the attribute 'reload', see ml_agent_pipeline_set_attributes().
  * @param[in] name A name indicating the pipeline whose description would be set.
  * @param[in] pipeline_desc A stringified description of the pipeline.
  * @return 0 on success, a negative error value if failed.
@@ -42,12 +45,44 @@ int ml_agent_pipeline_delete (const char *name);
 
 /**
  * @brief An interface exported for launching the pipeline's description corresponding to the given @a name.
+ * @details If mlops-agent is exiting on idle, the request is rejected with -EAGAIN. Retry to launch it in the daemon activated again.
  * @param[in] name A given name of the pipeline to launch.
  * @param[out] id A pointer of integer identifier for the launched pipeline.
  * @return 0 on success, a negative error value if failed.
  */
 int ml_agent_pipeline_launch (const char *name, int64_t *id);
 
+/**
+ * @brief An interface exported for launching the pipeline's description corresponding to the given @a name with the parameters.
+ * @details The description may have the placeholders, '${key}' is replaced with the value of the parameter,
+ *          '${key:-default}' is replaced with the default value if the parameter is not given,
+ *          and '${model:name}' is replaced with the path of the activated model of the given name.
+ *          The model reference is also allowed without the braces in the value of the model property, e.g., 'tensor_filter model=model:name', and
+ *          the version of the activated model is recorded on the launched pipeline.
+ *          '${source:name}' receives the data from the shared source, the stored pipeline of the given name ending with the source pad,
+ *          e.g., 'v4l2src ! videoconvert'. The source is launched once and its buffers are passed to the pipelines referring it without copying the data.
+ *          The pipeline receives the data while it is playing, and the source is stopped when the last pipeline referring it is destroyed.
+ *          The value of the parameter should not have the space, quotes, backslash and '!'.
+ * @param[in] name A given name of the pipeline to launch.
+ * @param[in] keys The names of the parameters.
+ * @param[in] values The values of the parameters.
+ * @param[in] count The number of the parameters.
+ * @param[out] id A pointer of integer identifier for the launched pipeline.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_pipeline_launch_with_params (const char *name, const char **keys, const char **values, const unsigned int count, int64_t *id);
+
+/**
+ * @brief An interface exported for launching the pipeline's description corresponding to the given @a name asynchronously.
+ * @details The identifier is given immediately, and the pipeline is launched in the background.
+ *          The state of the pipeline is GST_STATE_VOID_PENDING until it is prerolled.
+ *          The signal NodeReady or NodeFailed of the pipeline interface is emitted when launching the pipeline is done.
+ * @param[in] name A given name of the pipeline to launch.
+ * @param[out] id A pointer of integer identifier for the launched pipeline.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_pipeline_launch_async (const char *name, int64_t *id);
+
 /**
  * @brief An interface exported for changing the pipeline's state of the given @a id to start.
  * @param[in] id An identifier of the launched pipeline whose state would be changed to start.
@@ -69,14 +104,202 @@ int ml_agent_pipeline_stop (const int64_t id);
  */
 int ml_agent_pipeline_destroy (const int64_t id);
 
+/**
+ * @brief An interface exported for launching the pipelines of the given @a names in parallel.
+ * @details The pipelines are built at the same time, the call returns when all pipelines are launched.
+ * @param[in] names The names of the pipelines to launch.
+ * @param[in] count The number of the pipelines.
+ * @param[out] ids The identifiers of the launched pipelines, -1 if the launch is failed. This should have @a count elements.
+ * @param[out] results The result of each pipeline. This should have @a count elements.
+ * @return 0 if all pipelines are launched, otherwise the error of the first failed pipeline.
+ */
+int ml_agent_pipeline_launch_batch (const char **names, const unsigned int count, int64_t *ids, int *results);
+
+/**
+ * @brief An interface exported for changing the state of the pipelines of the given @a ids to start in parallel.
+ * @param[in] ids The identifiers of the launched pipelines.
+ * @param[in] count The number of the pipelines.
+ * @param[out] results The result of each pipeline. This should have @a count elements.
+ * @return 0 if all pipelines are started, otherwise the error of the first failed pipeline.
+ */
+int ml_agent_pipeline_start_batch (const int64_t *ids, const unsigned int count, int *results);
+
+/**
+ * @brief An interface exported for changing the state of the pipelines of the given @a ids to stop in parallel.
+ * @param[in] ids The identifiers of the launched pipelines.
+ * @param[in] count The number of the pipelines.
+ * @param[out] results The result of each pipeline. This should have @a count elements.
+ * @return 0 if all pipelines are stopped, otherwise the error of the first failed pipeline.
+ */
+int ml_agent_pipeline_stop_batch (const int64_t *ids, const unsigned int count, int *results);
+
+/**
+ * @brief An interface exported for destroying the launched pipelines of the given @a ids in parallel.
+ * @param[in] ids The identifiers of the launched pipelines.
+ * @param[in] count The number of the pipelines.
+ * @param[out] results The result of each pipeline. This should have @a count elements.
+ * @return 0 if all pipelines are destroyed, otherwise the error of the first failed pipeline.
+ */
+int ml_agent_pipeline_destroy_batch (const int64_t *ids, const unsigned int count, int *results);
+
 /**
  * @brief An interface exported for getting the pipeline's state of the given @a id.
+ * @details This returns the last state posted by the pipeline without waiting for the state change.
+ *          The signal StateChanged of the pipeline interface is emitted when the state is changed.
  * @param[in] id An identifier of the launched pipeline that would be destroyed.
  * @param[out] state A pointer for the pipeline's state.
  * @return 0 on success, a negative error value if failed.
  */
 int ml_agent_pipeline_get_state (const int64_t id, int *state);
 
+/**
+ * @brief An interface exported for setting the attributes of a pipeline.
+ * @details The attributes (JSON object) are merged into the existing attributes of the pipeline, and a member with null value is removed.
+ *          The attributes below are used by mlops-agent.
+ *          - Pool
+ *            - 'pool_size': The number of the prerolled pipelines to keep, to launch the pipeline immediately.
+ *          - Scheduling, applied to the streaming threads. The real-time policy and the negative nice value need the privilege.
+ *            - 'cpu_set': The list of the CPUs, e.g., "0-1,4".
+ *            - 'nice': The nice value, -20 ~ 19.
+ *            - 'sched_policy': "fifo", "rr" or "other".
+ *            - 'sched_priority': The real-time priority.
+ *          - Admission
+ *            - 'priority': The order of the launch request queued over the budget.
+ *            - 'cost_cpu': The estimated CPU usage (percent of a core), updated after the pipeline runs.
+ *            - 'cost_memory_kb': The estimated memory, updated after the pipeline runs.
+ *          - Reload
+ *            - 'reload': If "seamless", the running pipelines are switched to the description set later and keep the id.
+ *          - Restart
+ *            - 'restart_max_retries': The number of consecutive restarts of the pipeline which posted an error.
+ *            - 'restart_backoff_ms': The first delay of the restart, doubled for each retry (default 10).
+ *            - 'restart_backoff_max_ms': The maximum delay of the restart (default 5000).
+ *            - 'restart_strategy': "repreroll" (default) to preroll the pipeline again, or "rebuild" to replace it.
+ *          - Stall detection
+ *            - 'stall_threshold_ms': The signal 'PipelineStalled' is emitted when no buffer enters the sinks of the playing pipeline for the threshold.
+ *            - 'stall_restart': If "true", the stalled pipeline is restarted with the restart policy.
+ *          - Configuration, applied without dropping the prerolled pipelines.
+ *            - 'share_model': If "true", the filters loading the same model with the same options share one instance. Applied to the pipelines built later.
+ *            - 'stats': If "false", the buffers and the latency of the elements are not counted, and the stall is not detected.
+ * @param[in] name A service name for describing a pipeline.
+ * @param[in] attributes The attributes in JSON string, e.g., {"pool_size":2}.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_pipeline_set_attributes (const char *name, const char *attributes);
+
+/**
+ * @brief An interface exported for getting the attributes of a pipeline.
+ * @remarks If the function succeeds, @a attributes should be released using free().
+ * @param[in] name A service name for describing a pipeline.
+ * @param[out] attributes A pointer for the attributes in JSON string.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_pipeline_get_attributes (const char *name, char **attributes);
+
+/**
+ * @brief An interface exported for getting the statistics of the prerolled pipeline pools.
+ * @details The statistics is a JSON object which has the size, the number of ready pipelines, hits, misses and hit rate of each service.
+ * @remarks If the function succeeds, @a stats should be released using free().
+ * @param[out] stats A pointer for the statistics in JSON string.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_pipeline_get_pool_stats (char **stats);
+
+/**
+ * @brief An interface exported for getting the statistics of the models shared by the launched pipelines.
+ * @details The filters loading the same model with the same framework and options share one loaded instance.
+ *          The statistics is a JSON object which has the shared models with the number of users, the time and memory to load each model,
+ *          the number of filters which shared the loaded model ('shares'), the load time saved so far ('saved_load_time_us'),
+ *          and the memory currently saved ('saved_memory_kb'). The time and memory of the model are estimated from the pipeline loading it.
+ * @remarks If the function succeeds, @a stats should be released using free().
+ * @param[out] stats A pointer for the statistics in JSON string.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_pipeline_get_share_stats (char **stats);
+
+/**
+ * @brief An interface exported for setting the definition of a composite service, which chains the stored pipelines in one node.
+ * @details The definition is a JSON object with the names of the pipelines and the links between them, e.g.,
+ *          '{"pipelines":["camera","detect"],"links":[{"from":"camera","to":"detect"}]}'.
+ *          The pipelines are complete, and launched in one node. The source element of the downstream is replaced with appsrc,
+ *          which receives the caps and the buffers of the sink element of the upstream by reference, without copying the data.
+ *          So the pipeline linked from the other has one source element, and the pipeline linked to the others has one sink element.
+ *          Each pipeline has one upstream at most. Returns -EINVAL if the link refers the unknown pipeline or makes a cycle.
+ * @param[in] name A name indicating the composite service whose definition would be set.
+ * @param[in] definition A stringified definition of the composite service.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_composite_set (const char *name, const char *definition);
+
+/**
+ * @brief An interface exported for getting the definition of the composite service corresponding to the given @a name.
+ * @remarks If the function succeeds, @a definition should be released using free().
+ * @param[in] name A name indicating the composite service whose definition would be returned.
+ * @param[out] definition A pointer for the definition of the composite service.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_composite_get (const char *name, char **definition);
+
+/**
+ * @brief An interface exported for deletion of the definition of the composite service corresponding to the given @a name.
+ * @param[in] name A name indicating the composite service whose definition would be deleted.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_composite_delete (const char *name);
+
+/**
+ * @brief An interface exported for launching the composite service corresponding to the given @a name.
+ * @details The pipelines are launched as one node. Use the interfaces of the pipeline with @a id to start, stop, destroy the node,
+ *          and to get the state and the statistics of the composite service.
+ * @param[in] name A name indicating the composite service to launch.
+ * @param[out] id A pointer of integer identifier for the launched composite service.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_composite_launch (const char *name, int64_t *id);
+
+/**
+ * @brief An interface exported for getting the runtime statistics of the pipeline of the given @a id.
+ * @details The statistics is a JSON object which has the time spent in each state, the throughput (buffers and bytes per second in the playing state), the number of dropped buffers (QoS),
+ *          and the statistics of each element including the processing latency and the level of the queue.
+ *          'probe' is false if the pipeline attribute 'stats' disables counting the buffers of the elements.
+ *          'swap' has the number of times the pipeline is switched to the activated model, the interrupted time of the last switch in microseconds ('gap_us'),
+ *          and the way of the switch ('reload' if the filter reloads the model in place, 'shadow' if the new pipeline replaces the running one).
+ * @remarks If the function succeeds, @a stats should be released using free().
+ * @param[in] id An identifier of the launched pipeline.
+ * @param[out] stats A pointer for the statistics in JSON string.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_pipeline_get_statistics (const int64_t id, char **stats);
+
+/**
+ * @brief An interface exported for getting the restart information of the pipeline of the given @a id.
+ * @details The pipeline which posted an error is restarted with the exponential backoff, if 'restart_max_retries' is set in the pipeline attributes of the service.
+ *          The information is a JSON object which has the restart policy ('policy'), the number of times the pipeline is recovered ('count'),
+ *          the number of consecutive restarts ('attempts'), whether the restart is scheduled ('pending'), the time to recover by the last restart in microseconds ('recovery_us'),
+ *          the stall detection ('stall' with 'threshold_ms', 'restart', 'stalled' and 'count'),
+ *          and the last error ('last_error' with 'source', 'message' and 'timestamp_ms', null if the pipeline has not posted an error).
+ * @remarks If the function succeeds, @a info should be released using free().
+ * @param[in] id An identifier of the launched pipeline.
+ * @param[out] info A pointer for the restart information in JSON string.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_pipeline_get_restart_info (const int64_t id, char **info);
+
+/**
+ * @brief An interface exported for running the pipeline of the service in the benchmark mode.
+ * @details The pipeline is launched apart from the other pipelines and runs until the sinks receive @a num_buffers buffers.
+ *          The options are a JSON object, 'replace_sinks' (default true) replaces the sinks with fakesink (sync=false), and 'timeout_ms' (default 10000, max 20000) limits the running time.
+ *          The report is a JSON object which has the throughput, the percentiles of the end-to-end latency, the CPU time of the streaming threads of the pipeline,
+ *          the peak of the resident memory of mlops-agent while the pipeline runs (delta from the start), and the runtime statistics of the pipeline.
+ *          The benchmark is not started if the timeout of the call is expired while the request waits for the other benchmark.
+ * @remarks If the function succeeds, @a report should be released using free().
+ * @param[in] name A service name for describing a pipeline.
+ * @param[in] num_buffers The number of buffers to run the pipeline.
+ * @param[in] options The options of the benchmark in JSON string. NULL to use the default options.
+ * @param[out] report A pointer for the report in JSON string.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_pipeline_profile (const char *name, const unsigned int num_buffers, const char *options, char **report);
+
 /**
  * @brief An interface exported for registering a model.
  * @param[in] name A name indicating the model that would be registered.
@@ -102,6 +325,8 @@ int ml_agent_model_update_description (
 
 /**
  * @brief An interface exported for activating the model with @a name and @a version.
+ * @details The running pipelines referring the model are switched to the activated version without relaunching.
+ *          The time the stream is interrupted is reported in the statistics of the pipeline.
  * @param[in] name A name indicating a registered model.
  * @param[in] version A version of the given model, @a name.
  * @return 0 on success, a negative error value if failed.
@@ -174,6 +399,50 @@ int ml_agent_resource_delete (const char *name);
  */
 int ml_agent_resource_get (const char *name, char **res_info);
 
+/**
+ * @brief An interface exported for setting the default timeout of the calls to mlops-agent in this process.
+ * @details The timeout is also delivered to mlops-agent as a deadline of the request, then mlops-agent drops the request if the caller has already given up.
+ * @param[in] timeout_ms The timeout in milliseconds. -1 means the default timeout of D-Bus (about 25 seconds).
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_set_timeout (const int timeout_ms);
+
+/**
+ * @brief An interface exported for setting the timeout of the calls to mlops-agent in the calling thread.
+ * @details This overrides the default timeout of this process. Set the timeout before each call to give a per-call deadline.
+ * @param[in] timeout_ms The timeout in milliseconds. -1 means the default timeout of this process.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_set_call_timeout (const int timeout_ms);
+
+/**
+ * @brief An interface exported for getting the number of requests which are dropped or failed in mlops-agent because of the deadline.
+ * @param[out] count A pointer for the number of deadline misses.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_get_deadline_misses (uint64_t *count);
+
+/**
+ * @brief An interface exported for getting the histogram of the main loop dispatch lag in mlops-agent.
+ * @details The lag is how late a periodic timer of the main loop is dispatched, so it includes any work blocking the main loop. The timer is stopped while mlops-agent is idle.
+ *          The histogram is a JSON string, which has the number of the measurements, the number of the stalls, the maximum lag and the buckets of the lag in milliseconds.
+ * @param[out] histogram A pointer for the JSON string of the histogram. The caller should release it using free().
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_get_lag_histogram (char **histogram);
+
+/**
+ * @brief An interface exported for getting the statistics of the shared streaming thread pool in mlops-agent.
+ * @details The streaming tasks of all launched pipelines run on one thread pool, the number of its workers is bounded (4 workers for each core by default).
+ *          The streaming task keeps its worker until it is stopped, so the task over the bound waits for the worker and its pipeline does not stream meanwhile.
+ *          The statistics is a JSON string, which has the bound, the number of the running tasks and its peak, the number of the waiting tasks,
+ *          the number of the tasks and the threads of the pool which have run them, the number of the tasks which have waited for the worker,
+ *          and the number of the waiting tasks which are stopped before running.
+ * @param[out] stats A pointer for the JSON string of the statistics. The caller should release it using free().
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_get_task_pool_stats (char **stats);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
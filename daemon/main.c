@@ -15,6 +15,7 @@
 #include <glib.h>
 #include <gio/gio.h>
 #include <errno.h>
+#include <systemd/sd-daemon.h>
 
 #include "common.h"
 #include "modules.h"
@@ -22,11 +23,25 @@
 #include "log.h"
 #include "dbus-interface.h"
 #include "mlops-agent-internal.h"
+#include "mlops-agent-node.h"
+#include "mlops-agent-node-admission.h"
+#include "mlops-agent-node-taskpool.h"
 
 static GMainLoop *g_mainloop = NULL;
 static gboolean verbose = FALSE;
 static gboolean is_session = FALSE;
 static gchar *db_path = NULL;
+static gint idle_timeout = 0;
+static gint max_nodes = 0;
+static gint cpu_budget = 0;
+static gint memory_budget = 0;
+static gint app_max_nodes = 0;
+static gint admission_timeout = 0;
+static gint reclaim_timeout = 0;
+static gint stream_threads = 0;
+static guint idle_source_id = 0;
+static guint watchdog_source_id = 0;
+static gint64 watchdog_timeout = 0;
 
 /**
  * @brief Handle the SIGTERM signal and quit the main loop
@@ -38,6 +53,112 @@ handle_sigterm (int signo)
   g_main_loop_quit (g_mainloop);
 }
 
+static void schedule_idle_check (gint64 interval);
+
+/**
+ * @brief Quit the main loop after the requests delivered before releasing the bus name are dispatched.
+ */
+static gboolean
+quit_on_idle (gpointer user_data)
+{
+  /**
+   * The bus name is released and the new request activates another instance,
+   * so do not own the name again. The launch requests delivered in the meantime are rejected with -EAGAIN.
+   */
+  g_main_loop_quit (g_mainloop);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Check the idle time of mlops-agent and exit if there is no activity for the idle timeout.
+ */
+static gboolean
+check_idle (gpointer user_data)
+{
+  gint64 timeout = (gint64) idle_timeout * G_TIME_SPAN_SECOND;
+  gint64 idle_time;
+
+  idle_source_id = 0;
+  idle_time = ml_agent_idle_try_exit (timeout);
+
+  if (idle_time < timeout) {
+    /* Check again when the idle timeout will be expired from the last activity. */
+    schedule_idle_check ((idle_time < 0) ? timeout : (timeout - idle_time));
+    return G_SOURCE_REMOVE;
+  }
+
+  ml_logi ("mlops-agent is idle for %d seconds, exit.", idle_timeout);
+  sd_notify (0, "STOPPING=1");
+
+  /**
+   * Release the bus name first so that the new request activates the daemon again,
+   * and then quit after dispatching the requests already delivered to this process.
+   * The exit is certain once the name is released, the pipeline is not launched any more.
+   */
+  gdbus_put_name_sync ();
+  g_idle_add_full (G_PRIORITY_LOW, quit_on_idle, NULL, NULL);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Schedule to check the idle state of mlops-agent after the interval (in microseconds).
+ */
+static void
+schedule_idle_check (gint64 interval)
+{
+  guint seconds;
+
+  if (idle_timeout <= 0)
+    return;
+
+  /* Use the timer in seconds, the wakeup may be coalesced with the other timers. */
+  seconds = (guint) ((interval + G_TIME_SPAN_SECOND - 1) / G_TIME_SPAN_SECOND);
+  if (seconds == 0)
+    seconds = 1;
+
+  if (idle_source_id > 0)
+    g_source_remove (idle_source_id);
+  idle_source_id = g_timeout_add_seconds (seconds, check_idle, NULL);
+}
+
+/**
+ * @brief Send the keep-alive ping to the systemd watchdog.
+ * @remarks This is dispatched in the main loop, the daemon is restarted by systemd if the main loop is stalled.
+ *          The ping is also skipped if the dispatch lag measured by the stall detector exceeds the threshold for the watchdog timeout.
+ */
+static gboolean
+send_watchdog (gpointer user_data)
+{
+  gint64 stalled_time = ml_agent_get_stalled_time ();
+
+  if (stalled_time >= watchdog_timeout) {
+    ml_loge ("The main loop has been stalled for %" G_GINT64_FORMAT " ms, skip the watchdog ping.",
+        stalled_time / G_TIME_SPAN_MILLISECOND);
+    return G_SOURCE_CONTINUE;
+  }
+
+  sd_notify (0, "WATCHDOG=1");
+  return G_SOURCE_CONTINUE;
+}
+
+/**
+ * @brief Start the keep-alive ping if the systemd watchdog is enabled.
+ */
+static void
+start_watchdog (void)
+{
+  uint64_t usec = 0;
+
+  if (sd_watchdog_enabled (0, &usec) <= 0 || usec == 0)
+    return;
+
+  watchdog_timeout = (gint64) usec;
+
+  /* Send the ping at half of the watchdog timeout. */
+  watchdog_source_id = g_timeout_add ((guint) MAX (usec / 2000, 1), send_watchdog, NULL);
+  ml_logi ("The systemd watchdog is enabled, timeout %" G_GUINT64_FORMAT " us.", (guint64) usec);
+}
+
 /**
  * @brief Handle the post init tasks before starting the main loop.
  * @return @c 0 on success. Otherwise a negative error value.
@@ -56,9 +177,29 @@ postinit (void)
     return ret;
   }
 
+  ml_agent_trace_startup ("bus name requested");
+
+  start_watchdog ();
+
+  /* Exit if there is no pipeline and no method call for the idle timeout. */
+  if (idle_timeout > 0)
+    schedule_idle_check ((gint64) idle_timeout * G_TIME_SPAN_SECOND);
+
   return 0;
 }
 
+/**
+ * @brief Handle the failure of the initialization in the background and quit the main loop.
+ */
+static void
+handle_init_error (const int error, gpointer user_data)
+{
+  int *status = (int *) user_data;
+
+  *status = error;
+  g_main_loop_quit (g_mainloop);
+}
+
 /**
  * @brief Parse commandline option.
  * @return @c 0 on success. Otherwise a negative error value.
@@ -74,6 +215,14 @@ parse_args (gint *argc, gchar ***argv)
     { "verbose", 'v', 0, G_OPTION_ARG_NONE, &verbose, "Be verbose", NULL },
     { "session", 's', 0, G_OPTION_ARG_NONE, &is_session, "Bus type is session", NULL },
     { "path", 'p', 0, G_OPTION_ARG_STRING, &db_path, "Path to database", NULL },
+    { "idle-timeout", 't', 0, G_OPTION_ARG_INT, &idle_timeout, "Exit after the seconds of inactivity (0 to disable)", "SECONDS" },
+    { "max-nodes", 0, 0, G_OPTION_ARG_INT, &max_nodes, "Maximum number of launched pipelines (0 for no limit)", "COUNT" },
+    { "cpu-budget", 0, 0, G_OPTION_ARG_INT, &cpu_budget, "Estimated CPU usage of launched pipelines in percent of a core (0 for no limit)", "PERCENT" },
+    { "memory-budget", 0, 0, G_OPTION_ARG_INT, &memory_budget, "Estimated memory usage of launched pipelines (0 for no limit)", "MB" },
+    { "app-max-nodes", 0, 0, G_OPTION_ARG_INT, &app_max_nodes, "Maximum number of launched pipelines of each application (0 for no limit)", "COUNT" },
+    { "admission-timeout", 0, 0, G_OPTION_ARG_INT, &admission_timeout, "Milliseconds to queue the launch request over the budget (0 to reject immediately)", "MS" },
+    { "reclaim-timeout", 0, 0, G_OPTION_ARG_INT, &reclaim_timeout, "Release the stopped pipeline after the seconds, and build it again when started (0 to disable)", "SECONDS" },
+    { "stream-threads", 0, 0, G_OPTION_ARG_INT, &stream_threads, "Maximum number of threads running the streaming tasks, the tasks over it wait (0 for 4 threads per core)", "COUNT" },
     { NULL }
   };
 
@@ -98,6 +247,23 @@ parse_args (gint *argc, gchar ***argv)
   return 0;
 }
 
+/**
+ * @brief Set the budget of the launched pipelines from commandline option.
+ */
+static void
+configure_admission (void)
+{
+  mlops_node_admission_config_s config;
+
+  config.max_nodes = (guint) MAX (max_nodes, 0);
+  config.cpu_budget = (guint) MAX (cpu_budget, 0);
+  config.memory_budget_kb = (guint64) MAX (memory_budget, 0) * 1024;
+  config.app_max_nodes = (guint) MAX (app_max_nodes, 0);
+  config.queue_timeout_ms = (guint) MAX (admission_timeout, 0);
+
+  mlops_node_admission_configure (&config);
+}
+
 /**
  * @brief main function of the Machine Learning agent daemon.
  */
@@ -106,6 +272,8 @@ main (int argc, char **argv)
 {
   int ret = 0;
 
+  ml_agent_trace_startup ("started");
+
   ret = parse_args (&argc, &argv);
   if (ret < 0)
     goto error;
@@ -114,32 +282,65 @@ main (int argc, char **argv)
   if (!db_path)
     db_path = g_strdup (DB_PATH);
 
-  ret = ml_agent_initialize (db_path);
+  configure_admission ();
+  mlops_node_set_reclaim_timeout ((guint) MAX (reclaim_timeout, 0));
+  if (stream_threads > 0)
+    mlops_node_task_pool_set_bound ((guint) stream_threads);
+
+  g_mainloop = g_main_loop_new (NULL, FALSE);
+
+  /**
+   * The database is initialized in the background thread, and GStreamer is initialized
+   * when the pipeline interface is activated by the first method call.
+   * The interfaces are registered and the bus name is claimed immediately,
+   * and the requests arrived early are pending until the dependency is ready.
+   */
+  ret = ml_agent_initialize_async (db_path, handle_init_error, &ret);
   if (ret < 0)
     goto error;
 
-  g_mainloop = g_main_loop_new (NULL, FALSE);
   ret = gdbus_get_system_connection (is_session);
   if (ret < 0)
     goto error;
 
+  ml_agent_trace_startup ("bus connected");
+
   init_modules (NULL);
+  ml_agent_trace_startup ("interfaces registered");
 
   ret = postinit ();
   if (ret < 0)
     goto error;
 
   g_main_loop_run (g_mainloop);
+
+  if (idle_source_id > 0) {
+    g_source_remove (idle_source_id);
+    idle_source_id = 0;
+  }
+
+  if (watchdog_source_id > 0) {
+    g_source_remove (watchdog_source_id);
+    watchdog_source_id = 0;
+  }
+  watchdog_timeout = 0;
+
   exit_modules (NULL);
 
+error:
   gdbus_put_system_connection ();
-  g_main_loop_unref (g_mainloop);
-  g_mainloop = NULL;
+  if (g_mainloop) {
+    g_main_loop_unref (g_mainloop);
+    g_mainloop = NULL;
+  }
 
-error:
+  mlops_node_set_reclaim_timeout (0U);
   ml_agent_finalize ();
 
   is_session = verbose = FALSE;
+  idle_timeout = 0;
+  max_nodes = cpu_budget = memory_budget = app_max_nodes = admission_timeout = 0;
+  reclaim_timeout = stream_threads = 0;
   g_clear_pointer (&db_path, g_free);
   return ret;
 }
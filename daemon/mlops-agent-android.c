@@ -11,24 +11,63 @@
 #include <errno.h>
 #include <glib.h>
 #include <stdint.h>
+#include <unistd.h>
 
 #include "log.h"
 #include "mlops-agent-interface.h"
 #include "mlops-agent-internal.h"
 #include "mlops-agent-node.h"
+#include "mlops-agent-node-composite.h"
+#include "mlops-agent-node-profile.h"
+#include "mlops-agent-node-share.h"
+#include "mlops-agent-node-taskpool.h"
+#include "mlops-agent-node-template.h"
 #include "service-db-util.h"
 
+/**
+ * @brief Internal function to get the name of the application launching the pipelines.
+ * @details The library is loaded in the application, all pipelines launched in this process are counted for the per-app quota.
+ */
+static const gchar *
+_ml_agent_get_app (void)
+{
+  static gsize app = 0;
+
+  if (g_once_init_enter (&app)) {
+    const gchar *prgname = g_get_prgname ();
+    gchar *name;
+
+    if (STR_IS_VALID (prgname))
+      name = g_strdup (prgname);
+    else
+      name = g_strdup_printf ("pid:%d", (gint) getpid ());
+
+    g_once_init_leave (&app, (gsize) name);
+  }
+
+  return (const gchar *) app;
+}
+
 /**
  * @brief An interface exported for setting the description of a pipeline.
  */
 int
 ml_agent_pipeline_set_description (const char *name, const char *pipeline_desc)
 {
+  int ret;
+
   if (!STR_IS_VALID (name) || !STR_IS_VALID (pipeline_desc)) {
     g_return_val_if_reached (-EINVAL);
   }
 
-  return svcdb_pipeline_set (name, pipeline_desc);
+  ret = svcdb_pipeline_set (name, pipeline_desc);
+  if (ret == 0) {
+    mlops_node_template_set (name, pipeline_desc);
+    mlops_node_pool_flush (name);
+    mlops_node_description_update (name);
+  }
+
+  return ret;
 }
 
 /**
@@ -50,11 +89,19 @@ ml_agent_pipeline_get_description (const char *name, char **pipeline_desc)
 int
 ml_agent_pipeline_delete (const char *name)
 {
+  int ret;
+
   if (!STR_IS_VALID (name)) {
     g_return_val_if_reached (-EINVAL);
   }
 
-  return svcdb_pipeline_delete (name);
+  ret = svcdb_pipeline_delete (name);
+  if (ret == 0) {
+    mlops_node_template_set (name, NULL);
+    mlops_node_pool_flush (name);
+  }
+
+  return ret;
 }
 
 /**
@@ -67,7 +114,48 @@ ml_agent_pipeline_launch (const char *name, int64_t * id)
     g_return_val_if_reached (-EINVAL);
   }
 
-  return mlops_node_create (name, MLOPS_NODE_TYPE_PIPELINE, id);
+  return mlops_node_create_with_params (name, MLOPS_NODE_TYPE_PIPELINE, _ml_agent_get_app (), NULL, id);
+}
+
+/**
+ * @brief An interface exported for launching the pipeline's description corresponding to the given @a name with the parameters.
+ */
+int
+ml_agent_pipeline_launch_with_params (const char *name, const char **keys,
+    const char **values, const unsigned int count, int64_t * id)
+{
+  GHashTable *params;
+  unsigned int i;
+  int ret;
+
+  if (!STR_IS_VALID (name) || !id || (count > 0 && (!keys || !values))) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  params = g_hash_table_new (g_str_hash, g_str_equal);
+  for (i = 0; i < count; i++) {
+    if (!STR_IS_VALID (keys[i]) || !values[i]) {
+      g_hash_table_destroy (params);
+      g_return_val_if_reached (-EINVAL);
+    }
+
+    g_hash_table_insert (params, (gpointer) keys[i], (gpointer) values[i]);
+  }
+
+  ret = mlops_node_create_with_params (name, MLOPS_NODE_TYPE_PIPELINE, _ml_agent_get_app (), params, id);
+  g_hash_table_destroy (params);
+
+  return ret;
+}
+
+/**
+ * @brief An interface exported for launching the pipeline's description corresponding to the given @a name asynchronously.
+ * @details There is no main loop to notify the result, the pipeline is launched synchronously.
+ */
+int
+ml_agent_pipeline_launch_async (const char *name, int64_t * id)
+{
+  return ml_agent_pipeline_launch (name, id);
 }
 
 /**
@@ -97,6 +185,43 @@ ml_agent_pipeline_destroy (const int64_t id)
   return mlops_node_destroy (id);
 }
 
+/**
+ * @brief An interface exported for launching the pipelines of the given @a names in parallel.
+ */
+int
+ml_agent_pipeline_launch_batch (const char **names, const unsigned int count,
+    int64_t * ids, int *results)
+{
+  return mlops_node_create_batch ((const gchar * const *) names, count, _ml_agent_get_app (), ids, results);
+}
+
+/**
+ * @brief An interface exported for changing the state of the pipelines of the given @a ids to start in parallel.
+ */
+int
+ml_agent_pipeline_start_batch (const int64_t * ids, const unsigned int count, int *results)
+{
+  return mlops_node_batch (MLOPS_NODE_BATCH_START, ids, count, results);
+}
+
+/**
+ * @brief An interface exported for changing the state of the pipelines of the given @a ids to stop in parallel.
+ */
+int
+ml_agent_pipeline_stop_batch (const int64_t * ids, const unsigned int count, int *results)
+{
+  return mlops_node_batch (MLOPS_NODE_BATCH_STOP, ids, count, results);
+}
+
+/**
+ * @brief An interface exported for destroying the launched pipelines of the given @a ids in parallel.
+ */
+int
+ml_agent_pipeline_destroy_batch (const int64_t * ids, const unsigned int count, int *results)
+{
+  return mlops_node_batch (MLOPS_NODE_BATCH_DESTROY, ids, count, results);
+}
+
 /**
  * @brief An interface exported for getting the pipeline's state of the given @a id.
  */
@@ -106,6 +231,162 @@ ml_agent_pipeline_get_state (const int64_t id, int *state)
   return mlops_node_get_state (id, (GstState *) state);
 }
 
+/**
+ * @brief An interface exported for setting the attributes of a pipeline.
+ */
+int
+ml_agent_pipeline_set_attributes (const char *name, const char *attributes)
+{
+  int ret;
+
+  if (!STR_IS_VALID (name) || !STR_IS_VALID (attributes)) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  ret = svcdb_pipeline_set_attributes (name, attributes);
+  if (ret == 0)
+    mlops_node_pool_update (name);
+
+  return ret;
+}
+
+/**
+ * @brief An interface exported for getting the attributes of a pipeline.
+ */
+int
+ml_agent_pipeline_get_attributes (const char *name, char **attributes)
+{
+  if (!STR_IS_VALID (name) || !attributes) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return svcdb_pipeline_get_attributes (name, attributes);
+}
+
+/**
+ * @brief An interface exported for getting the statistics of the prerolled pipeline pools.
+ */
+int
+ml_agent_pipeline_get_pool_stats (char **stats)
+{
+  if (!stats) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return mlops_node_pool_get_stats (stats);
+}
+
+/**
+ * @brief An interface exported for getting the statistics of the models shared by the launched pipelines.
+ */
+int
+ml_agent_pipeline_get_share_stats (char **stats)
+{
+  if (!stats) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return mlops_node_share_get_stats (stats);
+}
+
+/**
+ * @brief An interface exported for setting the definition of a composite service.
+ */
+int
+ml_agent_composite_set (const char *name, const char *definition)
+{
+  int ret;
+
+  if (!STR_IS_VALID (name) || !STR_IS_VALID (definition)) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  ret = mlops_node_composite_validate (definition);
+  if (ret == 0)
+    ret = svcdb_composite_set (name, definition);
+
+  return ret;
+}
+
+/**
+ * @brief An interface exported for getting the composite service's definition corresponding to the given @a name.
+ */
+int
+ml_agent_composite_get (const char *name, char **definition)
+{
+  if (!STR_IS_VALID (name) || !definition) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return svcdb_composite_get (name, definition);
+}
+
+/**
+ * @brief An interface exported for deletion of the composite service's definition corresponding to the given @a name.
+ */
+int
+ml_agent_composite_delete (const char *name)
+{
+  if (!STR_IS_VALID (name)) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return svcdb_composite_delete (name);
+}
+
+/**
+ * @brief An interface exported for launching the composite service corresponding to the given @a name.
+ */
+int
+ml_agent_composite_launch (const char *name, int64_t * id)
+{
+  if (!STR_IS_VALID (name) || !id) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return mlops_node_create_with_params (name, MLOPS_NODE_TYPE_COMPOSITE, _ml_agent_get_app (), NULL, id);
+}
+
+/**
+ * @brief An interface exported for getting the runtime statistics of the pipeline of the given @a id.
+ */
+int
+ml_agent_pipeline_get_statistics (const int64_t id, char **stats)
+{
+  if (!stats) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return mlops_node_get_statistics (id, stats);
+}
+
+/**
+ * @brief An interface exported for getting the restart information of the pipeline of the given @a id.
+ */
+int
+ml_agent_pipeline_get_restart_info (const int64_t id, char **info)
+{
+  if (!info) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return mlops_node_get_restart_info (id, info);
+}
+
+/**
+ * @brief An interface exported for running the pipeline of the service in the benchmark mode.
+ */
+int
+ml_agent_pipeline_profile (const char *name, const unsigned int num_buffers,
+    const char *options, char **report)
+{
+  if (!STR_IS_VALID (name) || num_buffers == 0 || !report) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return mlops_node_profile (name, num_buffers, options, report);
+}
+
 /**
  * @brief An interface exported for registering a model.
  */
@@ -114,11 +395,17 @@ ml_agent_model_register (const char *name, const char *path,
     const int activate, const char *description, const char *app_info,
     uint32_t * version)
 {
+  int ret;
+
   if (!STR_IS_VALID (name) || !STR_IS_VALID (path) || !version) {
     g_return_val_if_reached (-EINVAL);
   }
 
-  return svcdb_model_add (name, path, activate, description, app_info, version);
+  ret = svcdb_model_add (name, path, activate, description, app_info, version);
+  if (ret == 0 && activate)
+    mlops_node_model_update (name);
+
+  return ret;
 }
 
 /**
@@ -141,11 +428,17 @@ ml_agent_model_update_description (const char *name,
 int
 ml_agent_model_activate (const char *name, const uint32_t version)
 {
+  int ret;
+
   if (!STR_IS_VALID (name) || version == 0U) {
     g_return_val_if_reached (-EINVAL);
   }
 
-  return svcdb_model_activate (name, version);
+  ret = svcdb_model_activate (name, version);
+  if (ret == 0)
+    mlops_node_model_update (name);
+
+  return ret;
 }
 
 /**
@@ -195,11 +488,17 @@ int
 ml_agent_model_delete (const char *name, const uint32_t version,
     const int force)
 {
+  int ret;
+
   if (!STR_IS_VALID (name)) {
     g_return_val_if_reached (-EINVAL);
   }
 
-  return svcdb_model_delete (name, version, force);
+  ret = svcdb_model_delete (name, version, force);
+  if (ret == 0)
+    mlops_node_template_model_changed (name);
+
+  return ret;
 }
 
 /**
@@ -241,3 +540,72 @@ ml_agent_resource_get (const char *name, char **res_info)
 
   return svcdb_resource_get (name, res_info);
 }
+
+/**
+ * @brief An interface exported for setting the default timeout of the calls to mlops-agent in this process.
+ * @note The requests are handled in the calling process, the timeout is not used.
+ */
+int
+ml_agent_set_timeout (const int timeout_ms)
+{
+  if (timeout_ms < -1 || timeout_ms == 0) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return 0;
+}
+
+/**
+ * @brief An interface exported for setting the timeout of the calls to mlops-agent in the calling thread.
+ * @note The requests are handled in the calling process, the timeout is not used.
+ */
+int
+ml_agent_set_call_timeout (const int timeout_ms)
+{
+  if (timeout_ms < -1 || timeout_ms == 0) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the number of requests which are dropped or failed in mlops-agent because of the deadline.
+ */
+int
+ml_agent_get_deadline_misses (uint64_t * count)
+{
+  if (!count) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  *count = 0;
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the histogram of the main loop dispatch lag in mlops-agent.
+ * @note The requests are handled in the calling process, there is no main loop of mlops-agent.
+ */
+int
+ml_agent_get_lag_histogram (char **histogram)
+{
+  if (!histogram) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return -ENOTSUP;
+}
+
+/**
+ * @brief An interface exported for getting the statistics of the shared streaming thread pool in mlops-agent.
+ */
+int
+ml_agent_get_task_pool_stats (char **stats)
+{
+  if (!stats) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return mlops_node_task_pool_get_stats (stats);
+}
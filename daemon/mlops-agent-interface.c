@@ -17,6 +17,7 @@
 #include "mlops-agent-interface.h"
 #include "mlops-agent-internal.h"
 #include "dbus-interface.h"
+#include "debug-dbus.h"
 #include "model-dbus.h"
 #include "pipeline-dbus.h"
 #include "resource-dbus.h"
@@ -131,6 +132,69 @@ _resolve_rpk_path_in_json (const char *json_str)
 
 typedef gpointer ml_agent_proxy_h;
 
+/**
+ * @brief The default timeout (in milliseconds) of the dbus calls for this process. -1 means the default timeout of GDBus.
+ */
+static gint g_ml_agent_timeout = -1;
+
+/**
+ * @brief The timeout (in milliseconds) of the dbus calls for the calling thread. It overrides the default timeout of this process.
+ */
+static GPrivate g_ml_agent_call_timeout = G_PRIVATE_INIT (NULL);
+
+/**
+ * @brief Internal helper to get the timeout (in milliseconds) for the dbus call.
+ */
+static gint
+_get_call_timeout (void)
+{
+  gpointer timeout = g_private_get (&g_ml_agent_call_timeout);
+
+  if (timeout)
+    return GPOINTER_TO_INT (timeout);
+
+  return g_atomic_int_get (&g_ml_agent_timeout);
+}
+
+/**
+ * @brief Internal helper to get the deadline (monotonic time in microseconds) for the dbus call. 0 means there is no deadline.
+ */
+static gint64
+_get_call_deadline (void)
+{
+  gint timeout = _get_call_timeout ();
+
+  if (timeout <= 0)
+    return 0;
+
+  return g_get_monotonic_time () + (gint64) timeout * G_TIME_SPAN_MILLISECOND;
+}
+
+/**
+ * @brief Internal helper to convert the error of failed dbus call.
+ */
+static gint
+_get_call_error (GError **err)
+{
+  gint ret = -EIO;
+
+  if (*err) {
+    if (g_error_matches (*err, G_IO_ERROR, G_IO_ERROR_TIMED_OUT))
+      ret = -ETIMEDOUT;
+
+    ml_loge ("Failed to call the method of mlops-agent: %s", (*err)->message);
+    g_clear_error (err);
+  }
+
+  return ret;
+}
+
+/**
+ * @brief The flags to create the dbus proxy. The interfaces of mlops-agent do not have any property, and the client does not handle the signals.
+ */
+#define ML_AGENT_PROXY_FLAGS \
+    (G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES | G_DBUS_PROXY_FLAGS_DO_NOT_CONNECT_SIGNALS)
+
 /**
  * @brief An internal helper to get the dbus proxy
  */
@@ -150,7 +214,7 @@ _get_proxy_new_for_bus_sync (ml_agent_service_type_e type)
 
       for (i = 0; i < num_bus_types; ++i) {
         mlsp = machinelearning_service_pipeline_proxy_new_for_bus_sync
-            (bus_types[i], G_DBUS_PROXY_FLAGS_NONE, DBUS_ML_BUS_NAME,
+            (bus_types[i], ML_AGENT_PROXY_FLAGS, DBUS_ML_BUS_NAME,
             DBUS_PIPELINE_PATH, NULL, NULL);
         if (mlsp) {
           break;
@@ -165,7 +229,7 @@ _get_proxy_new_for_bus_sync (ml_agent_service_type_e type)
 
       for (i = 0; i < num_bus_types; ++i) {
         mlsm = machinelearning_service_model_proxy_new_for_bus_sync
-            (bus_types[i], G_DBUS_PROXY_FLAGS_NONE, DBUS_ML_BUS_NAME,
+            (bus_types[i], ML_AGENT_PROXY_FLAGS, DBUS_ML_BUS_NAME,
             DBUS_MODEL_PATH, NULL, NULL);
         if (mlsm)
           break;
@@ -179,7 +243,7 @@ _get_proxy_new_for_bus_sync (ml_agent_service_type_e type)
 
       for (i = 0; i < num_bus_types; ++i) {
         mlsr = machinelearning_service_resource_proxy_new_for_bus_sync
-            (bus_types[i], G_DBUS_PROXY_FLAGS_NONE, DBUS_ML_BUS_NAME,
+            (bus_types[i], ML_AGENT_PROXY_FLAGS, DBUS_ML_BUS_NAME,
             DBUS_RESOURCE_PATH, NULL, NULL);
         if (mlsr)
           break;
@@ -187,10 +251,27 @@ _get_proxy_new_for_bus_sync (ml_agent_service_type_e type)
       proxy = (ml_agent_proxy_h) mlsr;
       break;
     }
+    case ML_AGENT_SERVICE_DEBUG:
+    {
+      MachinelearningServiceDebug *mlsd;
+
+      for (i = 0; i < num_bus_types; ++i) {
+        mlsd = machinelearning_service_debug_proxy_new_for_bus_sync
+            (bus_types[i], ML_AGENT_PROXY_FLAGS, DBUS_ML_BUS_NAME,
+            DBUS_DEBUG_PATH, NULL, NULL);
+        if (mlsd)
+          break;
+      }
+      proxy = (ml_agent_proxy_h) mlsd;
+      break;
+    }
     default:
       break;
   }
 
+  if (proxy)
+    g_dbus_proxy_set_default_timeout (G_DBUS_PROXY (proxy), _get_call_timeout ());
+
   return proxy;
 }
 
@@ -203,6 +284,7 @@ ml_agent_pipeline_set_description (const char *name, const char *pipeline_desc)
   MachinelearningServicePipeline *mlsp;
   gboolean result;
   gint ret;
+  GError *err = NULL;
 
   if (!STR_IS_VALID (name) || !STR_IS_VALID (pipeline_desc)) {
     g_return_val_if_reached (-EINVAL);
@@ -214,9 +296,12 @@ ml_agent_pipeline_set_description (const char *name, const char *pipeline_desc)
   }
 
   result = machinelearning_service_pipeline_call_set_pipeline_sync (mlsp,
-      name, pipeline_desc, &ret, NULL, NULL);
+      name, pipeline_desc, &ret, NULL, &err);
   g_object_unref (mlsp);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -230,6 +315,7 @@ ml_agent_pipeline_get_description (const char *name, char **pipeline_desc)
   MachinelearningServicePipeline *mlsp;
   gboolean result;
   gint ret;
+  GError *err = NULL;
 
   if (!STR_IS_VALID (name) || !pipeline_desc) {
     g_return_val_if_reached (-EINVAL);
@@ -241,9 +327,12 @@ ml_agent_pipeline_get_description (const char *name, char **pipeline_desc)
   }
 
   result = machinelearning_service_pipeline_call_get_pipeline_sync (mlsp,
-      name, &ret, pipeline_desc, NULL, NULL);
+      name, &ret, pipeline_desc, NULL, &err);
   g_object_unref (mlsp);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -257,6 +346,7 @@ ml_agent_pipeline_delete (const char *name)
   MachinelearningServicePipeline *mlsp;
   gboolean result;
   gint ret;
+  GError *err = NULL;
 
   if (!STR_IS_VALID (name)) {
     g_return_val_if_reached (-EINVAL);
@@ -268,9 +358,12 @@ ml_agent_pipeline_delete (const char *name)
   }
 
   result = machinelearning_service_pipeline_call_delete_pipeline_sync (mlsp,
-      name, &ret, NULL, NULL);
+      name, &ret, NULL, &err);
   g_object_unref (mlsp);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -284,20 +377,105 @@ ml_agent_pipeline_launch (const char *name, int64_t * id)
   MachinelearningServicePipeline *mlsp;
   gboolean result;
   gint ret;
+  GError *err = NULL;
+  gint64 deadline;
+
+  if (!STR_IS_VALID (name) || !id) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  deadline = _get_call_deadline ();
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_launch_pipeline_with_deadline_sync (mlsp,
+      name, deadline, &ret, id, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for launching the pipeline's description corresponding to the given @a name with the parameters.
+ */
+int
+ml_agent_pipeline_launch_with_params (const char *name, const char **keys,
+    const char **values, const unsigned int count, int64_t * id)
+{
+  MachinelearningServicePipeline *mlsp;
+  GVariantBuilder builder;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+  gint64 deadline;
+  unsigned int i;
+
+  if (!STR_IS_VALID (name) || !id || (count > 0 && (!keys || !values))) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  for (i = 0; i < count; i++) {
+    if (!STR_IS_VALID (keys[i]) || !values[i]) {
+      g_return_val_if_reached (-EINVAL);
+    }
+  }
+
+  deadline = _get_call_deadline ();
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{ss}"));
+  for (i = 0; i < count; i++)
+    g_variant_builder_add (&builder, "{ss}", keys[i], values[i]);
+
+  result = machinelearning_service_pipeline_call_launch_pipeline_with_params_sync (mlsp,
+      name, g_variant_builder_end (&builder), deadline, &ret, id, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for launching the pipeline's description corresponding to the given @a name asynchronously.
+ */
+int
+ml_agent_pipeline_launch_async (const char *name, int64_t * id)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+  gint64 deadline;
 
   if (!STR_IS_VALID (name) || !id) {
     g_return_val_if_reached (-EINVAL);
   }
 
+  deadline = _get_call_deadline ();
   mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
   if (!mlsp) {
     g_return_val_if_reached (-EIO);
   }
 
-  result = machinelearning_service_pipeline_call_launch_pipeline_sync (mlsp,
-      name, &ret, id, NULL, NULL);
+  result = machinelearning_service_pipeline_call_launch_pipeline_async_sync (mlsp,
+      name, deadline, &ret, id, NULL, &err);
   g_object_unref (mlsp);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -311,16 +489,22 @@ ml_agent_pipeline_start (const int64_t id)
   MachinelearningServicePipeline *mlsp;
   gboolean result;
   gint ret;
+  GError *err = NULL;
+  gint64 deadline;
 
+  deadline = _get_call_deadline ();
   mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
   if (!mlsp) {
     g_return_val_if_reached (-EIO);
   }
 
-  result = machinelearning_service_pipeline_call_start_pipeline_sync (mlsp,
-      id, &ret, NULL, NULL);
+  result = machinelearning_service_pipeline_call_start_pipeline_with_deadline_sync (mlsp,
+      id, deadline, &ret, NULL, &err);
   g_object_unref (mlsp);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -334,16 +518,22 @@ ml_agent_pipeline_stop (const int64_t id)
   MachinelearningServicePipeline *mlsp;
   gboolean result;
   gint ret;
+  GError *err = NULL;
+  gint64 deadline;
 
+  deadline = _get_call_deadline ();
   mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
   if (!mlsp) {
     g_return_val_if_reached (-EIO);
   }
 
-  result = machinelearning_service_pipeline_call_stop_pipeline_sync (mlsp,
-      id, &ret, NULL, NULL);
+  result = machinelearning_service_pipeline_call_stop_pipeline_with_deadline_sync (mlsp,
+      id, deadline, &ret, NULL, &err);
   g_object_unref (mlsp);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -357,6 +547,7 @@ ml_agent_pipeline_destroy (const int64_t id)
   MachinelearningServicePipeline *mlsp;
   gboolean result;
   gint ret;
+  GError *err = NULL;
 
   mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
   if (!mlsp) {
@@ -364,13 +555,195 @@ ml_agent_pipeline_destroy (const int64_t id)
   }
 
   result = machinelearning_service_pipeline_call_destroy_pipeline_sync (mlsp,
-      id, &ret, NULL, NULL);
+      id, &ret, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief Internal helper to copy the result of each pipeline in the batch.
+ * @details The pipeline without the result (e.g., the request is dropped) has the result of the call.
+ */
+static void
+_get_batch_results (GVariant * results_v, const gint ret, int *results,
+    const unsigned int count)
+{
+  const gint32 *values = NULL;
+  gsize n = 0;
+  unsigned int i;
+
+  if (results_v)
+    values = (const gint32 *) g_variant_get_fixed_array (results_v, &n, sizeof (gint32));
+
+  for (i = 0; i < count; i++)
+    results[i] = (i < n) ? values[i] : ret;
+}
+
+/**
+ * @brief An interface exported for launching the pipelines of the given @a names in parallel.
+ */
+int
+ml_agent_pipeline_launch_batch (const char **names, const unsigned int count,
+    int64_t * ids, int *results)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+  gint64 deadline;
+  GVariant *ids_v = NULL;
+  GVariant *results_v = NULL;
+  g_autofree const gchar **strv = NULL;
+  const gint64 *values = NULL;
+  gsize n = 0;
+  unsigned int i;
+
+  if (!names || count == 0 || !ids || !results) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  for (i = 0; i < count; i++) {
+    if (!STR_IS_VALID (names[i])) {
+      g_return_val_if_reached (-EINVAL);
+    }
+  }
+
+  /* The names are passed as the NULL-terminated array. */
+  strv = g_new0 (const gchar *, count + 1);
+  for (i = 0; i < count; i++)
+    strv[i] = names[i];
+
+  deadline = _get_call_deadline ();
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_launch_pipelines_sync (mlsp,
+      strv, deadline, &ret, &ids_v, &results_v, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  if (ids_v)
+    values = (const gint64 *) g_variant_get_fixed_array (ids_v, &n, sizeof (gint64));
+
+  for (i = 0; i < count; i++)
+    ids[i] = (i < n) ? values[i] : -1;
+
+  _get_batch_results (results_v, ret, results, count);
+
+  if (ids_v)
+    g_variant_unref (ids_v);
+  if (results_v)
+    g_variant_unref (results_v);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief Internal enumeration for the operation on the pipelines in the batch.
+ */
+typedef enum
+{
+  PIPELINE_BATCH_START = 0,
+  PIPELINE_BATCH_STOP,
+  PIPELINE_BATCH_DESTROY
+} pipeline_batch_op_e;
+
+/**
+ * @brief Internal helper to start, stop or destroy the pipelines of the given @a ids in parallel.
+ */
+static int
+_pipeline_batch (const pipeline_batch_op_e op, const int64_t * ids,
+    const unsigned int count, int *results)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result = FALSE;
+  gint ret = -EINVAL;
+  GError *err = NULL;
+  gint64 deadline;
+  GVariant *ids_v;
+  GVariant *results_v = NULL;
+
+  if (!ids || count == 0 || !results) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  deadline = _get_call_deadline ();
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  ids_v = g_variant_new_fixed_array (G_VARIANT_TYPE_INT64, ids, count, sizeof (gint64));
+
+  switch (op) {
+    case PIPELINE_BATCH_START:
+      result = machinelearning_service_pipeline_call_start_pipelines_sync (mlsp,
+          ids_v, deadline, &ret, &results_v, NULL, &err);
+      break;
+    case PIPELINE_BATCH_STOP:
+      result = machinelearning_service_pipeline_call_stop_pipelines_sync (mlsp,
+          ids_v, deadline, &ret, &results_v, NULL, &err);
+      break;
+    case PIPELINE_BATCH_DESTROY:
+      result = machinelearning_service_pipeline_call_destroy_pipelines_sync (mlsp,
+          ids_v, &ret, &results_v, NULL, &err);
+      break;
+    default:
+      /* The floating reference is not consumed. */
+      g_variant_unref (g_variant_ref_sink (ids_v));
+      g_object_unref (mlsp);
+      g_return_val_if_reached (-EINVAL);
+  }
   g_object_unref (mlsp);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
+  _get_batch_results (results_v, ret, results, count);
+  if (results_v)
+    g_variant_unref (results_v);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
 
+/**
+ * @brief An interface exported for changing the state of the pipelines of the given @a ids to start in parallel.
+ */
+int
+ml_agent_pipeline_start_batch (const int64_t * ids, const unsigned int count, int *results)
+{
+  return _pipeline_batch (PIPELINE_BATCH_START, ids, count, results);
+}
+
+/**
+ * @brief An interface exported for changing the state of the pipelines of the given @a ids to stop in parallel.
+ */
+int
+ml_agent_pipeline_stop_batch (const int64_t * ids, const unsigned int count, int *results)
+{
+  return _pipeline_batch (PIPELINE_BATCH_STOP, ids, count, results);
+}
+
+/**
+ * @brief An interface exported for destroying the launched pipelines of the given @a ids in parallel.
+ */
+int
+ml_agent_pipeline_destroy_batch (const int64_t * ids, const unsigned int count, int *results)
+{
+  return _pipeline_batch (PIPELINE_BATCH_DESTROY, ids, count, results);
+}
+
 /**
  * @brief An interface exported for getting the pipeline's state of the given @a id.
  */
@@ -380,6 +753,7 @@ ml_agent_pipeline_get_state (const int64_t id, int *state)
   MachinelearningServicePipeline *mlsp;
   gboolean result;
   gint ret;
+  GError *err = NULL;
 
   if (!state) {
     g_return_val_if_reached (-EINVAL);
@@ -391,9 +765,12 @@ ml_agent_pipeline_get_state (const int64_t id, int *state)
   }
 
   result = machinelearning_service_pipeline_call_get_state_sync (mlsp,
-      id, &ret, state, NULL, NULL);
+      id, &ret, state, NULL, &err);
   g_object_unref (mlsp);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -409,6 +786,7 @@ ml_agent_model_register (const char *name, const char *path,
   MachinelearningServiceModel *mlsm;
   gboolean result;
   gint ret;
+  GError *err = NULL;
 
   if (!STR_IS_VALID (name) || !STR_IS_VALID (path) || !version) {
     g_return_val_if_reached (-EINVAL);
@@ -421,9 +799,12 @@ ml_agent_model_register (const char *name, const char *path,
 
   result = machinelearning_service_model_call_register_sync (mlsm, name, path,
       activate, description ? description : "", app_info ? app_info : "",
-      version, &ret, NULL, NULL);
+      version, &ret, NULL, &err);
   g_object_unref (mlsm);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -438,6 +819,7 @@ ml_agent_model_update_description (const char *name,
   MachinelearningServiceModel *mlsm;
   gboolean result;
   gint ret;
+  GError *err = NULL;
 
   if (!STR_IS_VALID (name) || !STR_IS_VALID (description) || version == 0U) {
     g_return_val_if_reached (-EINVAL);
@@ -449,9 +831,12 @@ ml_agent_model_update_description (const char *name,
   }
 
   result = machinelearning_service_model_call_update_description_sync (mlsm,
-      name, version, description, &ret, NULL, NULL);
+      name, version, description, &ret, NULL, &err);
   g_object_unref (mlsm);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -465,6 +850,7 @@ ml_agent_model_activate (const char *name, const uint32_t version)
   MachinelearningServiceModel *mlsm;
   gboolean result;
   gint ret;
+  GError *err = NULL;
 
   if (!STR_IS_VALID (name) || version == 0U) {
     g_return_val_if_reached (-EINVAL);
@@ -476,9 +862,12 @@ ml_agent_model_activate (const char *name, const uint32_t version)
   }
 
   result = machinelearning_service_model_call_activate_sync (mlsm,
-      name, version, &ret, NULL, NULL);
+      name, version, &ret, NULL, &err);
   g_object_unref (mlsm);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -492,6 +881,7 @@ ml_agent_model_get (const char *name, const uint32_t version, char **model_info)
   MachinelearningServiceModel *mlsm;
   gboolean result;
   gint ret;
+  GError *err = NULL;
   gchar *ret_json;
 
   if (!STR_IS_VALID (name) || !model_info || version == 0U) {
@@ -504,9 +894,12 @@ ml_agent_model_get (const char *name, const uint32_t version, char **model_info)
   }
 
   result = machinelearning_service_model_call_get_sync (mlsm,
-      name, version, &ret_json, &ret, NULL, NULL);
+      name, version, &ret_json, &ret, NULL, &err);
   g_object_unref (mlsm);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
 
   *model_info = _resolve_rpk_path_in_json (ret_json);
@@ -524,6 +917,7 @@ ml_agent_model_get_activated (const char *name, char **model_info)
   MachinelearningServiceModel *mlsm;
   gboolean result;
   gint ret;
+  GError *err = NULL;
   gchar *ret_json;
 
   if (!STR_IS_VALID (name) || !model_info) {
@@ -536,9 +930,12 @@ ml_agent_model_get_activated (const char *name, char **model_info)
   }
 
   result = machinelearning_service_model_call_get_activated_sync (mlsm,
-      name, &ret_json, &ret, NULL, NULL);
+      name, &ret_json, &ret, NULL, &err);
   g_object_unref (mlsm);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
 
   *model_info = _resolve_rpk_path_in_json (ret_json);
@@ -556,6 +953,7 @@ ml_agent_model_get_all (const char *name, char **model_info)
   MachinelearningServiceModel *mlsm;
   gboolean result;
   gint ret;
+  GError *err = NULL;
   gchar *ret_json;
 
   if (!STR_IS_VALID (name) || !model_info) {
@@ -568,9 +966,12 @@ ml_agent_model_get_all (const char *name, char **model_info)
   }
 
   result = machinelearning_service_model_call_get_all_sync (mlsm,
-      name, &ret_json, &ret, NULL, NULL);
+      name, &ret_json, &ret, NULL, &err);
   g_object_unref (mlsm);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
 
   *model_info = _resolve_rpk_path_in_json (ret_json);
@@ -590,6 +991,7 @@ ml_agent_model_delete (const char *name, const uint32_t version,
   MachinelearningServiceModel *mlsm;
   gboolean result;
   gint ret;
+  GError *err = NULL;
 
   if (!STR_IS_VALID (name)) {
     g_return_val_if_reached (-EINVAL);
@@ -601,9 +1003,12 @@ ml_agent_model_delete (const char *name, const uint32_t version,
   }
 
   result = machinelearning_service_model_call_delete_sync (mlsm,
-      name, version, force, &ret, NULL, NULL);
+      name, version, force, &ret, NULL, &err);
   g_object_unref (mlsm);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -618,6 +1023,7 @@ ml_agent_resource_add (const char *name, const char *path,
   MachinelearningServiceResource *mlsr;
   gboolean result;
   gint ret;
+  GError *err = NULL;
 
   if (!STR_IS_VALID (name) || !STR_IS_VALID (path)) {
     g_return_val_if_reached (-EINVAL);
@@ -630,9 +1036,12 @@ ml_agent_resource_add (const char *name, const char *path,
 
   result = machinelearning_service_resource_call_add_sync (mlsr, name, path,
       description ? description : "", app_info ? app_info : "",
-      &ret, NULL, NULL);
+      &ret, NULL, &err);
   g_object_unref (mlsr);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -646,6 +1055,7 @@ ml_agent_resource_delete (const char *name)
   MachinelearningServiceResource *mlsr;
   gboolean result;
   gint ret;
+  GError *err = NULL;
 
   if (!STR_IS_VALID (name)) {
     g_return_val_if_reached (-EINVAL);
@@ -657,9 +1067,12 @@ ml_agent_resource_delete (const char *name)
   }
 
   result = machinelearning_service_resource_call_delete_sync (mlsr,
-      name, &ret, NULL, NULL);
+      name, &ret, NULL, &err);
   g_object_unref (mlsr);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
@@ -673,6 +1086,7 @@ ml_agent_resource_get (const char *name, char **res_info)
   MachinelearningServiceResource *mlsr;
   gboolean result;
   gint ret;
+  GError *err = NULL;
   gchar *ret_json;
 
   if (!STR_IS_VALID (name) || !res_info) {
@@ -685,9 +1099,12 @@ ml_agent_resource_get (const char *name, char **res_info)
   }
 
   result = machinelearning_service_resource_call_get_sync (mlsr,
-      name, &ret_json, &ret, NULL, NULL);
+      name, &ret_json, &ret, NULL, &err);
   g_object_unref (mlsr);
 
+  if (!result)
+    ret = _get_call_error (&err);
+
   g_return_val_if_fail (ret == 0 && result, ret);
 
   *res_info = _resolve_rpk_path_in_json (ret_json);
@@ -695,3 +1112,475 @@ ml_agent_resource_get (const char *name, char **res_info)
 
   return 0;
 }
+
+/**
+ * @brief An interface exported for setting the default timeout of the calls to mlops-agent in this process.
+ */
+int
+ml_agent_set_timeout (const int timeout_ms)
+{
+  if (timeout_ms < -1 || timeout_ms == 0) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  g_atomic_int_set (&g_ml_agent_timeout, timeout_ms);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for setting the timeout of the calls to mlops-agent in the calling thread.
+ */
+int
+ml_agent_set_call_timeout (const int timeout_ms)
+{
+  if (timeout_ms < -1 || timeout_ms == 0) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  /* Reset thread-local value if timeout is -1, then the default timeout of this process is used. */
+  g_private_set (&g_ml_agent_call_timeout,
+      (timeout_ms > 0) ? GINT_TO_POINTER (timeout_ms) : NULL);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the number of requests which are dropped or failed in mlops-agent because of the deadline.
+ */
+int
+ml_agent_get_deadline_misses (uint64_t * count)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+  guint64 misses = 0;
+
+  if (!count) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_get_deadline_misses_sync (mlsp,
+      &ret, &misses, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+
+  *count = misses;
+  return 0;
+}
+
+/**
+ * @brief An interface exported for setting the attributes of a pipeline.
+ */
+int
+ml_agent_pipeline_set_attributes (const char *name, const char *attributes)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+
+  if (!STR_IS_VALID (name) || !STR_IS_VALID (attributes)) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_set_pipeline_attributes_sync (mlsp,
+      name, attributes, &ret, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the attributes of a pipeline.
+ */
+int
+ml_agent_pipeline_get_attributes (const char *name, char **attributes)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+
+  if (!STR_IS_VALID (name) || !attributes) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_get_pipeline_attributes_sync (mlsp,
+      name, &ret, attributes, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the statistics of the prerolled pipeline pools.
+ */
+int
+ml_agent_pipeline_get_pool_stats (char **stats)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+
+  if (!stats) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_get_pool_stats_sync (mlsp,
+      &ret, stats, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the statistics of the models shared by the launched pipelines.
+ */
+int
+ml_agent_pipeline_get_share_stats (char **stats)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+
+  if (!stats) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_get_share_stats_sync (mlsp,
+      &ret, stats, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for setting the definition of a composite service.
+ */
+int
+ml_agent_composite_set (const char *name, const char *definition)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+
+  if (!STR_IS_VALID (name) || !STR_IS_VALID (definition)) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_set_composite_sync (mlsp,
+      name, definition, &ret, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the composite service's definition corresponding to the given @a name.
+ */
+int
+ml_agent_composite_get (const char *name, char **definition)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+
+  if (!STR_IS_VALID (name) || !definition) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_get_composite_sync (mlsp,
+      name, &ret, definition, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for deletion of the composite service's definition corresponding to the given @a name.
+ */
+int
+ml_agent_composite_delete (const char *name)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+
+  if (!STR_IS_VALID (name)) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_delete_composite_sync (mlsp,
+      name, &ret, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for launching the composite service corresponding to the given @a name.
+ */
+int
+ml_agent_composite_launch (const char *name, int64_t * id)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+  gint64 deadline;
+
+  if (!STR_IS_VALID (name) || !id) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  deadline = _get_call_deadline ();
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_launch_composite_sync (mlsp,
+      name, deadline, &ret, id, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the runtime statistics of the pipeline of the given @a id.
+ */
+int
+ml_agent_pipeline_get_statistics (const int64_t id, char **stats)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+
+  if (!stats) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_get_statistics_sync (mlsp,
+      id, &ret, stats, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the restart information of the pipeline of the given @a id.
+ */
+int
+ml_agent_pipeline_get_restart_info (const int64_t id, char **info)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+
+  if (!info) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_get_restart_info_sync (mlsp,
+      id, &ret, info, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for running the pipeline of the service in the benchmark mode.
+ */
+int
+ml_agent_pipeline_profile (const char *name, const unsigned int num_buffers,
+    const char *options, char **report)
+{
+  MachinelearningServicePipeline *mlsp;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+  gint64 deadline;
+
+  if (!STR_IS_VALID (name) || num_buffers == 0 || !report) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  deadline = _get_call_deadline ();
+  mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+  if (!mlsp) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_pipeline_call_profile_pipeline_with_deadline_sync (mlsp,
+      name, num_buffers, options ? options : "", deadline, &ret, report, NULL, &err);
+  g_object_unref (mlsp);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the histogram of the main loop dispatch lag in mlops-agent.
+ */
+int
+ml_agent_get_lag_histogram (char **histogram)
+{
+  MachinelearningServiceDebug *mlsd;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+
+  if (!histogram) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsd = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_DEBUG);
+  if (!mlsd) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_debug_call_get_lag_histogram_sync (mlsd,
+      &ret, histogram, NULL, &err);
+  g_object_unref (mlsd);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the statistics of the shared streaming thread pool in mlops-agent.
+ */
+int
+ml_agent_get_task_pool_stats (char **stats)
+{
+  MachinelearningServiceDebug *mlsd;
+  gboolean result;
+  gint ret;
+  GError *err = NULL;
+
+  if (!stats) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsd = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_DEBUG);
+  if (!mlsd) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_debug_call_get_task_pool_stats_sync (mlsd,
+      &ret, stats, NULL, &err);
+  g_object_unref (mlsd);
+
+  if (!result)
+    ret = _get_call_error (&err);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
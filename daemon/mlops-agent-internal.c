@@ -8,43 +8,499 @@
  * @bug     No known bugs except for NYI items
  */
 
+#include <gst/gst.h>
+
 #include "log.h"
 #include "mlops-agent-internal.h"
 #include "mlops-agent-node.h"
 #include "service-db-util.h"
 
 /**
- * @brief Internal function to initialize mlops-agent interface.
+ * @brief Internal structure for the request pending until the dependencies are ready.
  */
-int
-ml_agent_initialize (const char *db_path)
+typedef struct
+{
+  int deps;
+  GSourceFunc func;
+  gpointer data;
+} ml_agent_pending_s;
+
+/**
+ * @brief Internal structure for the dependencies of mlops-agent.
+ */
+typedef struct
+{
+  int ready;
+  int started;
+  GList *pending;
+  GThread *threads[2];
+  ml_agent_error_cb error_cb;
+  gpointer error_data;
+  gint64 start_time;
+} ml_agent_deps_s;
+
+static ml_agent_deps_s g_ml_agent_deps = { 0 };
+G_LOCK_DEFINE_STATIC (ml_agent_deps);
+
+static gint64 g_ml_agent_last_activity = 0;
+static const gchar *g_ml_agent_current_method = NULL;
+static gint64 g_ml_agent_stalled_since = 0;
+static gint g_ml_agent_idle_inhibitors = 0;
+static gboolean g_ml_agent_exiting = FALSE;
+G_LOCK_DEFINE_STATIC (ml_agent_activity);
+
+/**
+ * @brief Internal structure to notify the result of the dependency initialization.
+ */
+typedef struct
+{
+  ml_agent_dep_e dep;
+  int status;
+} ml_agent_dep_result_s;
+
+/**
+ * @brief Internal function to trace the timeline of mlops-agent startup.
+ */
+void
+ml_agent_trace_startup (const char *event)
+{
+  gint64 now = g_get_monotonic_time ();
+  gint64 start;
+
+  G_LOCK (ml_agent_deps);
+  if (g_ml_agent_deps.start_time == 0)
+    g_ml_agent_deps.start_time = now;
+  start = g_ml_agent_deps.start_time;
+  G_UNLOCK (ml_agent_deps);
+
+  ml_logi ("[startup] +%" G_GINT64_FORMAT ".%03d ms: %s",
+      (now - start) / 1000, (int) ((now - start) % 1000), event);
+}
+
+/**
+ * @brief Internal function to dispatch the pending requests in the main context.
+ */
+static gboolean
+_ml_agent_dependency_done (gpointer data)
 {
+  ml_agent_dep_result_s *result = (ml_agent_dep_result_s *) data;
+  ml_agent_error_cb error_cb = NULL;
+  gpointer error_data = NULL;
+  GList *ready_list = NULL;
+  GList *l, *next;
+
+  G_LOCK (ml_agent_deps);
+  if (result->status < 0) {
+    error_cb = g_ml_agent_deps.error_cb;
+    error_data = g_ml_agent_deps.error_data;
+  } else {
+    g_ml_agent_deps.ready |= result->dep;
+
+    for (l = g_ml_agent_deps.pending; l != NULL; l = next) {
+      ml_agent_pending_s *pending = (ml_agent_pending_s *) l->data;
+
+      next = l->next;
+      if ((pending->deps & g_ml_agent_deps.ready) == pending->deps) {
+        g_ml_agent_deps.pending = g_list_remove_link (g_ml_agent_deps.pending, l);
+        ready_list = g_list_concat (ready_list, l);
+      }
+    }
+  }
+  G_UNLOCK (ml_agent_deps);
+
+  if (result->status < 0) {
+    ml_loge ("Failed to initialize the dependency (0x%x) of mlops-agent (%d).",
+        result->dep, result->status);
+    if (error_cb)
+      error_cb (result->status, error_data);
+    return G_SOURCE_REMOVE;
+  }
+
+  ml_agent_trace_startup (result->dep == ML_AGENT_DEP_DB ? "database ready" : "gstreamer ready");
+
+  /* Dispatch the pending requests in arrival order. */
+  for (l = ready_list; l != NULL; l = l->next) {
+    ml_agent_pending_s *pending = (ml_agent_pending_s *) l->data;
+
+    pending->func (pending->data);
+  }
+
+  g_list_free_full (ready_list, g_free);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Internal function to notify the result of the dependency initialization to the main context.
+ */
+static void
+_ml_agent_dependency_notify (const ml_agent_dep_e dep, const int status)
+{
+  ml_agent_dep_result_s *result = g_new0 (ml_agent_dep_result_s, 1);
+
+  result->dep = dep;
+  result->status = status;
+
+  g_main_context_invoke_full (NULL, G_PRIORITY_HIGH,
+      _ml_agent_dependency_done, result, g_free);
+}
+
+/**
+ * @brief Thread to open the database.
+ */
+static gpointer
+_ml_agent_db_thread (gpointer data)
+{
+  gchar *db_path = (gchar *) data;
   int ret;
 
+  ret = svcdb_initialize (db_path);
+  g_free (db_path);
+
+  _ml_agent_dependency_notify (ML_AGENT_DEP_DB, ret);
+  return NULL;
+}
+
+/**
+ * @brief Thread to initialize GStreamer.
+ */
+static gpointer
+_ml_agent_gst_thread (gpointer data)
+{
+  GError *err = NULL;
+  int ret = 0;
+
+  if (!gst_init_check (NULL, NULL, &err)) {
+    ml_loge ("Failed to initialize GStreamer: %s", (err ? err->message : "Unknown error"));
+    ret = -EIO;
+  }
+
+  g_clear_error (&err);
+
+  _ml_agent_dependency_notify (ML_AGENT_DEP_GST, ret);
+  return NULL;
+}
+
+/**
+ * @brief Internal function to start the thread for the dependency.
+ */
+static void
+_ml_agent_start_dependency (const ml_agent_dep_e dep, gpointer data)
+{
+  GThread *thread = NULL;
+  int index = (dep == ML_AGENT_DEP_DB) ? 0 : 1;
+
+  G_LOCK (ml_agent_deps);
+  if (!(g_ml_agent_deps.started & dep)) {
+    g_ml_agent_deps.started |= dep;
+
+    if (dep == ML_AGENT_DEP_DB)
+      thread = g_thread_new ("ml-agent-db", _ml_agent_db_thread, data);
+    else
+      thread = g_thread_new ("ml-agent-gst", _ml_agent_gst_thread, data);
+
+    g_ml_agent_deps.threads[index] = thread;
+  } else {
+    g_free (data);
+  }
+  G_UNLOCK (ml_agent_deps);
+}
+
+/**
+ * @brief Internal function to check the database path.
+ */
+static int
+_ml_agent_check_db_path (const char *db_path)
+{
   if (!STR_IS_VALID (db_path) ||
       !g_file_test (db_path, G_FILE_TEST_EXISTS | G_FILE_TEST_IS_DIR)) {
     ml_loge ("Failed to initialize mlops-agent, database path (%s) is invalid.", db_path);
     return -EINVAL;
   }
 
+  return 0;
+}
+
+/**
+ * @brief Internal function to initialize mlops-agent interface.
+ */
+int
+ml_agent_initialize (const char *db_path)
+{
+  int ret;
+
+  ret = _ml_agent_check_db_path (db_path);
+  if (ret < 0)
+    return ret;
+
   ret = svcdb_initialize (db_path);
   if (ret < 0)
     goto error;
 
   ret = mlops_node_initialize ();
 
+  /* All dependencies are initialized in the caller's context. */
+  G_LOCK (ml_agent_deps);
+  g_ml_agent_deps.ready = g_ml_agent_deps.started = ML_AGENT_DEP_ALL;
+  G_UNLOCK (ml_agent_deps);
+
 error:
   if (ret < 0)
     ml_agent_finalize ();
   return ret;
 }
 
+/**
+ * @brief Internal function to initialize mlops-agent interface in the background threads.
+ */
+int
+ml_agent_initialize_async (const char *db_path, ml_agent_error_cb cb, gpointer user_data)
+{
+  int ret;
+
+  ret = _ml_agent_check_db_path (db_path);
+  if (ret < 0)
+    return ret;
+
+  ret = mlops_node_initialize ();
+  if (ret < 0)
+    return ret;
+
+  G_LOCK (ml_agent_deps);
+  g_ml_agent_deps.error_cb = cb;
+  g_ml_agent_deps.error_data = user_data;
+  G_UNLOCK (ml_agent_deps);
+
+  /* GStreamer is initialized when the pipeline interface is activated (see ml_agent_start_dependency()). */
+  _ml_agent_start_dependency (ML_AGENT_DEP_DB, g_strdup (db_path));
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to start the initialization of the dependency in the background thread.
+ */
+void
+ml_agent_start_dependency (const ml_agent_dep_e dep)
+{
+  g_return_if_fail (dep == ML_AGENT_DEP_GST);
+
+  _ml_agent_start_dependency (dep, NULL);
+}
+
+/**
+ * @brief Internal function to check the dependencies are ready.
+ */
+gboolean
+ml_agent_is_ready (const int deps)
+{
+  gboolean ready;
+
+  G_LOCK (ml_agent_deps);
+  ready = ((g_ml_agent_deps.ready & deps) == deps);
+  G_UNLOCK (ml_agent_deps);
+
+  return ready;
+}
+
+/**
+ * @brief Internal function to call the function in the main context when the dependencies are ready.
+ */
+gboolean
+ml_agent_run_when_ready (const int deps, GSourceFunc func, gpointer data)
+{
+  ml_agent_pending_s *pending;
+  gboolean is_pending = FALSE;
+
+  g_return_val_if_fail (func != NULL, FALSE);
+
+  G_LOCK (ml_agent_deps);
+  if ((g_ml_agent_deps.ready & deps) != deps) {
+    pending = g_new0 (ml_agent_pending_s, 1);
+    pending->deps = deps;
+    pending->func = func;
+    pending->data = data;
+
+    g_ml_agent_deps.pending = g_list_append (g_ml_agent_deps.pending, pending);
+    is_pending = TRUE;
+  }
+  G_UNLOCK (ml_agent_deps);
+
+  return is_pending;
+}
+
+/**
+ * @brief Internal function to update the time of the last activity (e.g., method call) of mlops-agent.
+ */
+void
+ml_agent_update_activity (void)
+{
+  G_LOCK (ml_agent_activity);
+  g_ml_agent_last_activity = g_get_monotonic_time ();
+  G_UNLOCK (ml_agent_activity);
+}
+
+/**
+ * @brief Internal function to set the method handled in the main context now.
+ */
+void
+ml_agent_set_current_method (const char *name)
+{
+  /* This is accessed only in the main context. */
+  g_ml_agent_current_method = name;
+}
+
+/**
+ * @brief Internal function to get the method handled in the main context now.
+ */
+const char *
+ml_agent_get_current_method (void)
+{
+  return g_ml_agent_current_method;
+}
+
+/**
+ * @brief Internal function to set the dispatch lag of the main loop measured by the stall detector.
+ */
+void
+ml_agent_set_dispatch_lag (const gint64 lag, const gboolean stalled)
+{
+  /* This is accessed only in the main context. The stall started when the late timer should have been dispatched. */
+  if (!stalled)
+    g_ml_agent_stalled_since = 0;
+  else if (g_ml_agent_stalled_since == 0)
+    g_ml_agent_stalled_since = g_get_monotonic_time () - lag;
+}
+
+/**
+ * @brief Internal function to get the time the main loop has been stalled continuously.
+ */
+gint64
+ml_agent_get_stalled_time (void)
+{
+  if (g_ml_agent_stalled_since == 0)
+    return 0;
+
+  return g_get_monotonic_time () - g_ml_agent_stalled_since;
+}
+
+/**
+ * @brief Internal function to inhibit the idle state of mlops-agent (e.g., while the pipeline exists).
+ */
+void
+ml_agent_idle_inhibit (void)
+{
+  G_LOCK (ml_agent_activity);
+  g_ml_agent_idle_inhibitors++;
+  G_UNLOCK (ml_agent_activity);
+}
+
+/**
+ * @brief Internal function to release the inhibitor of the idle state.
+ */
+void
+ml_agent_idle_uninhibit (void)
+{
+  G_LOCK (ml_agent_activity);
+  if (g_ml_agent_idle_inhibitors > 0)
+    g_ml_agent_idle_inhibitors--;
+
+  /* The idle time starts when the last inhibitor is released. */
+  g_ml_agent_last_activity = g_get_monotonic_time ();
+  G_UNLOCK (ml_agent_activity);
+}
+
+/**
+ * @brief Internal function to get the idle time of mlops-agent.
+ */
+gint64
+ml_agent_get_idle_time (void)
+{
+  gint64 now = g_get_monotonic_time ();
+  gint64 idle_time = -1;
+
+  G_LOCK (ml_agent_activity);
+  if (g_ml_agent_last_activity == 0)
+    g_ml_agent_last_activity = now;
+
+  if (g_ml_agent_idle_inhibitors == 0)
+    idle_time = now - g_ml_agent_last_activity;
+  G_UNLOCK (ml_agent_activity);
+
+  return idle_time;
+}
+
+/**
+ * @brief Internal function to get the idle time of mlops-agent, and start exiting if it is idle for the timeout.
+ */
+gint64
+ml_agent_idle_try_exit (const gint64 timeout)
+{
+  gint64 now = g_get_monotonic_time ();
+  gint64 idle_time = -1;
+
+  G_LOCK (ml_agent_activity);
+  if (g_ml_agent_last_activity == 0)
+    g_ml_agent_last_activity = now;
+
+  if (g_ml_agent_idle_inhibitors == 0)
+    idle_time = now - g_ml_agent_last_activity;
+
+  /* Decide with the inhibitors in the same lock, the pipeline is not launched after this. */
+  if (idle_time >= timeout)
+    g_ml_agent_exiting = TRUE;
+  G_UNLOCK (ml_agent_activity);
+
+  return idle_time;
+}
+
+/**
+ * @brief Internal function to check mlops-agent is exiting on idle.
+ */
+gboolean
+ml_agent_is_exiting (void)
+{
+  gboolean exiting;
+
+  G_LOCK (ml_agent_activity);
+  exiting = g_ml_agent_exiting;
+  G_UNLOCK (ml_agent_activity);
+
+  return exiting;
+}
+
 /**
  * @brief Internal function to finalize mlops-agent interface.
  */
 void
 ml_agent_finalize (void)
 {
+  GThread *threads[2];
+  guint i;
+
+  G_LOCK (ml_agent_deps);
+  threads[0] = g_ml_agent_deps.threads[0];
+  threads[1] = g_ml_agent_deps.threads[1];
+  g_ml_agent_deps.threads[0] = g_ml_agent_deps.threads[1] = NULL;
+  G_UNLOCK (ml_agent_deps);
+
+  /* Wait for the initialization in progress. */
+  for (i = 0; i < G_N_ELEMENTS (threads); i++) {
+    if (threads[i])
+      g_thread_join (threads[i]);
+  }
+
   mlops_node_finalize ();
   svcdb_finalize ();
+
+  G_LOCK (ml_agent_deps);
+  g_list_free_full (g_ml_agent_deps.pending, g_free);
+  g_ml_agent_deps.pending = NULL;
+  g_ml_agent_deps.ready = g_ml_agent_deps.started = 0;
+  g_ml_agent_deps.error_cb = NULL;
+  g_ml_agent_deps.error_data = NULL;
+  G_UNLOCK (ml_agent_deps);
+
+  G_LOCK (ml_agent_activity);
+  g_ml_agent_exiting = FALSE;
+  G_UNLOCK (ml_agent_activity);
 }
@@ -10,12 +10,14 @@
 
 #ifndef __MLOPS_AGENT_INTERNAL_H__
 #define __MLOPS_AGENT_INTERNAL_H__
+
+#include <stdint.h>
+#include <glib.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
-#include <stdint.h>
-
 #define STR_IS_VALID(s) ((s) && (s)[0] != '\0')
 
 /**
@@ -26,14 +28,122 @@ typedef enum
   ML_AGENT_SERVICE_PIPELINE = 0,
   ML_AGENT_SERVICE_MODEL,
   ML_AGENT_SERVICE_RESOURCE,
+  ML_AGENT_SERVICE_DEBUG,
   ML_AGENT_SERVICE_END
 } ml_agent_service_type_e;
 
+/**
+ * @brief Internal enumeration for the dependency of the requests to mlops-agent.
+ */
+typedef enum
+{
+  ML_AGENT_DEP_NONE = 0,
+  ML_AGENT_DEP_DB = (1 << 0),
+  ML_AGENT_DEP_GST = (1 << 1),
+  ML_AGENT_DEP_ALL = (ML_AGENT_DEP_DB | ML_AGENT_DEP_GST)
+} ml_agent_dep_e;
+
+/**
+ * @brief Callback to notify the failure of the dependency.
+ */
+typedef void (*ml_agent_error_cb) (const int error, gpointer user_data);
+
 /**
  * @brief Internal function to initialize mlops-agent interface.
  */
 int ml_agent_initialize (const char *db_path);
 
+/**
+ * @brief Internal function to initialize mlops-agent interface in the background threads.
+ * @details The database is initialized in the background thread, and the pending requests are dispatched in the main context when the dependency is ready. GStreamer is initialized on demand using ml_agent_start_dependency().
+ * @param[in] db_path The path to database.
+ * @param[in] cb The callback to be called in the main context if failed to initialize the dependency.
+ * @param[in] user_data Private data for the callback.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_initialize_async (const char *db_path, ml_agent_error_cb cb, gpointer user_data);
+
+/**
+ * @brief Internal function to start the initialization of the dependency in the background thread.
+ * @details This does nothing if the initialization of the dependency is already started.
+ */
+void ml_agent_start_dependency (const ml_agent_dep_e dep);
+
+/**
+ * @brief Internal function to check the dependencies are ready.
+ */
+gboolean ml_agent_is_ready (const int deps);
+
+/**
+ * @brief Internal function to call the function in the main context when the dependencies are ready.
+ * @return TRUE if the function is pending. FALSE if the dependencies are already ready and the function is not called.
+ */
+gboolean ml_agent_run_when_ready (const int deps, GSourceFunc func, gpointer data);
+
+/**
+ * @brief Internal function to trace the timeline of mlops-agent startup.
+ */
+void ml_agent_trace_startup (const char *event);
+
+/**
+ * @brief Internal function to update the time of the last activity (e.g., method call) of mlops-agent.
+ */
+void ml_agent_update_activity (void);
+
+/**
+ * @brief Internal function to set the method handled in the main context now. This should be called in the main context.
+ * @param name The name of the method, NULL when the handler returns. The string should not be freed while it is set.
+ */
+void ml_agent_set_current_method (const char *name);
+
+/**
+ * @brief Internal function to get the method handled in the main context now. This should be called in the main context.
+ * @return The name of the method, the caller should not free it. NULL if no method is handled.
+ */
+const char *ml_agent_get_current_method (void);
+
+/**
+ * @brief Internal function to set the dispatch lag of the main loop measured by the stall detector. This should be called in the main context.
+ * @param lag The time (in microseconds) the periodic timer of the main loop is dispatched late.
+ * @param stalled TRUE if the lag exceeds the threshold of the stall.
+ */
+void ml_agent_set_dispatch_lag (const gint64 lag, const gboolean stalled);
+
+/**
+ * @brief Internal function to get the time the main loop has been stalled continuously. This should be called in the main context.
+ * @return The time (in microseconds) since the stall started. 0 if the main loop is not stalled.
+ */
+gint64 ml_agent_get_stalled_time (void);
+
+/**
+ * @brief Internal function to inhibit the idle state of mlops-agent (e.g., while the pipeline exists).
+ */
+void ml_agent_idle_inhibit (void);
+
+/**
+ * @brief Internal function to release the inhibitor of the idle state.
+ */
+void ml_agent_idle_uninhibit (void);
+
+/**
+ * @brief Internal function to get the idle time of mlops-agent.
+ * @return The time (in microseconds) since the last activity. -1 if the idle state is inhibited.
+ */
+gint64 ml_agent_get_idle_time (void);
+
+/**
+ * @brief Internal function to get the idle time of mlops-agent, and start exiting if it is idle for the timeout.
+ * @details Once exiting, the request to launch the pipeline is rejected with -EAGAIN, since the bus name is released and the process exits.
+ * @param timeout The idle timeout in microseconds.
+ * @return The time (in microseconds) since the last activity. -1 if the idle state is inhibited.
+ */
+gint64 ml_agent_idle_try_exit (const gint64 timeout);
+
+/**
+ * @brief Internal function to check mlops-agent is exiting on idle.
+ */
+gboolean ml_agent_is_exiting (void);
+
 /**
  * @brief Internal function to finalize mlops-agent interface.
  */
@@ -0,0 +1,565 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-admission.c
+ * @date      18 October 2026
+ * @brief     Admission control of the pipelines in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The cost of the pipeline is reserved when it is launched, and released when it is destroyed.
+ *            The cost of the service is learned from the CPU time of its streaming threads and the memory
+ *            allocated while building the pipeline, and kept in the attributes of the pipeline.
+ *            The queued requests are admitted or expired in the worker, so this does not depend on the main loop.
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "mlops-agent-node-admission.h"
+#include "service-db-util.h"
+
+/**
+ * @brief The names of the pipeline attributes for the admission control.
+ */
+#define MLOPS_ADMISSION_COST_CPU_ATTR "cost_cpu"
+#define MLOPS_ADMISSION_COST_MEMORY_ATTR "cost_memory_kb"
+#define MLOPS_ADMISSION_PRIORITY_ATTR "priority"
+
+/**
+ * @brief The weight of the last run to update the estimated cost.
+ */
+#define MLOPS_ADMISSION_LEARNING_RATE (0.3)
+
+/**
+ * @brief Structure for the queued request.
+ */
+typedef struct
+{
+  gchar *app;
+  mlops_node_cost_s cost;
+  gint priority;
+  gint64 deadline;      /**< The monotonic time when the request is rejected */
+  gint result;
+  mlops_node_admission_cb cb;
+  void *user_data;
+  GDestroyNotify notify;
+} mlops_admission_entry_s;
+
+/**
+ * @brief Structure for the admission control.
+ */
+typedef struct
+{
+  mlops_node_admission_config_s config;
+  guint nodes;                  /**< The number of the admitted pipelines */
+  guint cpu;                    /**< The sum of the estimated CPU usage of the admitted pipelines */
+  guint64 memory_kb;            /**< The sum of the estimated memory usage of the admitted pipelines */
+  GHashTable *apps;             /**< The number of the admitted pipelines of each app */
+  GQueue queue;                 /**< The queued requests, sorted by the priority */
+  GQueue ready;                 /**< The admitted or expired requests to notify in the worker */
+  GCond cond;                   /**< Wakes the worker when the queue is changed */
+  GThreadPool *worker;          /**< The worker to notify and expire the queued requests */
+  gboolean running;             /**< The worker is running while the requests are queued */
+  gboolean closing;
+} mlops_admission_s;
+
+static mlops_admission_s g_mlops_admission;
+G_LOCK_DEFINE_STATIC (mlops_admission);
+
+static GPrivate g_mlops_thread_enter = G_PRIVATE_INIT (g_free);
+
+/**
+ * @brief Internal function to get the number of the admitted pipelines of the app. Should be called with the lock.
+ */
+static guint
+_mlops_admission_get_app_nodes_locked (const gchar * app)
+{
+  mlops_admission_s *adm = &g_mlops_admission;
+
+  if (!app || !adm->apps)
+    return 0U;
+
+  return GPOINTER_TO_UINT (g_hash_table_lookup (adm->apps, app));
+}
+
+/**
+ * @brief Internal function to check the request is within the budget. Should be called with the lock.
+ * @details The pipeline is admitted if no other pipeline is running, even if its cost exceeds the budget.
+ */
+static gboolean
+_mlops_admission_fits_locked (const gchar * app, const mlops_node_cost_s * cost)
+{
+  mlops_admission_s *adm = &g_mlops_admission;
+  mlops_node_admission_config_s *config = &adm->config;
+
+  if (config->max_nodes > 0 && adm->nodes >= config->max_nodes)
+    return FALSE;
+
+  if (app && config->app_max_nodes > 0 &&
+      _mlops_admission_get_app_nodes_locked (app) >= config->app_max_nodes)
+    return FALSE;
+
+  if (adm->nodes == 0)
+    return TRUE;
+
+  if (config->cpu_budget > 0 && adm->cpu + cost->cpu > config->cpu_budget)
+    return FALSE;
+
+  if (config->memory_budget_kb > 0 && adm->memory_kb + cost->memory_kb > config->memory_budget_kb)
+    return FALSE;
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to reserve the cost of the admitted request. Should be called with the lock.
+ */
+static void
+_mlops_admission_reserve_locked (const gchar * app, const mlops_node_cost_s * cost)
+{
+  mlops_admission_s *adm = &g_mlops_admission;
+
+  adm->nodes++;
+  adm->cpu += cost->cpu;
+  adm->memory_kb += cost->memory_kb;
+
+  if (app) {
+    if (!adm->apps)
+      adm->apps = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+    g_hash_table_insert (adm->apps, g_strdup (app),
+        GUINT_TO_POINTER (_mlops_admission_get_app_nodes_locked (app) + 1));
+  }
+}
+
+/**
+ * @brief Internal function to release the queued request.
+ */
+static void
+_mlops_admission_entry_free (gpointer data)
+{
+  mlops_admission_entry_s *entry = (mlops_admission_entry_s *) data;
+
+  g_free (entry->app);
+  g_free (entry);
+}
+
+/**
+ * @brief Internal function to wake the worker to notify or expire the queued requests. Should be called with the lock.
+ */
+static void
+_mlops_admission_wake_locked (void)
+{
+  mlops_admission_s *adm = &g_mlops_admission;
+
+  if (adm->running) {
+    g_cond_signal (&adm->cond);
+    return;
+  }
+
+  if (!adm->worker || adm->closing)
+    return;
+
+  /* The worker returns to the pool when no request is queued. */
+  adm->running = TRUE;
+  if (!g_thread_pool_push (adm->worker, GINT_TO_POINTER (1), NULL)) {
+    ml_loge ("Failed to run the worker of the admission control.");
+    adm->running = FALSE;
+  }
+}
+
+/**
+ * @brief Internal function to admit the queued requests within the budget. Should be called with the lock.
+ * @details The requests are admitted in the order of the priority, the lower priority request does not overtake.
+ */
+static void
+_mlops_admission_dispatch_locked (void)
+{
+  mlops_admission_s *adm = &g_mlops_admission;
+  mlops_admission_entry_s *entry;
+
+  while ((entry = (mlops_admission_entry_s *) g_queue_peek_head (&adm->queue)) != NULL) {
+    if (!_mlops_admission_fits_locked (entry->app, &entry->cost))
+      break;
+
+    g_queue_pop_head (&adm->queue);
+    _mlops_admission_reserve_locked (entry->app, &entry->cost);
+
+    entry->result = 0;
+    g_queue_push_tail (&adm->ready, entry);
+  }
+
+  if (adm->ready.length > 0)
+    _mlops_admission_wake_locked ();
+}
+
+/**
+ * @brief Internal function to reject the requests which have waited in the queue for the timeout. Should be called with the lock.
+ * @return The deadline of the next expiry in monotonic time, or -1 if no request is queued.
+ */
+static gint64
+_mlops_admission_expire_locked (void)
+{
+  mlops_admission_s *adm = &g_mlops_admission;
+  gint64 now = g_get_monotonic_time ();
+  gint64 next = -1;
+  gboolean expired = FALSE;
+  GList *l, *n;
+
+  for (l = adm->queue.head; l != NULL; l = n) {
+    mlops_admission_entry_s *entry = (mlops_admission_entry_s *) l->data;
+
+    n = l->next;
+    if (entry->deadline <= now) {
+      ml_logw ("The launch request is rejected, it has waited for the budget for %u ms.",
+          adm->config.queue_timeout_ms);
+
+      g_queue_delete_link (&adm->queue, l);
+      entry->result = -EBUSY;
+      g_queue_push_tail (&adm->ready, entry);
+      expired = TRUE;
+    } else if (next < 0 || entry->deadline < next) {
+      next = entry->deadline;
+    }
+  }
+
+  /* The lower priority requests may be admitted now. */
+  if (expired)
+    _mlops_admission_dispatch_locked ();
+
+  return next;
+}
+
+/**
+ * @brief Worker to notify the admitted or expired requests, and wait for the next expiry while the requests are queued.
+ */
+static void
+_mlops_admission_worker (gpointer data, gpointer user_data)
+{
+  mlops_admission_s *adm = &g_mlops_admission;
+  mlops_admission_entry_s *entry;
+  gint64 next;
+
+  G_LOCK (mlops_admission);
+  while (!adm->closing) {
+    next = _mlops_admission_expire_locked ();
+
+    if ((entry = (mlops_admission_entry_s *) g_queue_pop_head (&adm->ready)) != NULL) {
+      G_UNLOCK (mlops_admission);
+      entry->cb (entry->result, entry->user_data);
+      _mlops_admission_entry_free (entry);
+      G_LOCK (mlops_admission);
+      continue;
+    }
+
+    if (next < 0)
+      break;
+
+    g_cond_wait_until (&adm->cond, &G_LOCK_NAME (mlops_admission), next);
+  }
+  adm->running = FALSE;
+  g_cond_broadcast (&adm->cond);
+  G_UNLOCK (mlops_admission);
+}
+
+/**
+ * @brief Internal function to compare the priority of the queued requests.
+ * @details The request is inserted after the requests with the same or higher priority.
+ */
+static gint
+_mlops_admission_compare (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+  const mlops_admission_entry_s *queued = (const mlops_admission_entry_s *) a;
+  const mlops_admission_entry_s *entry = (const mlops_admission_entry_s *) b;
+
+  return (queued->priority >= entry->priority) ? -1 : 1;
+}
+
+/**
+ * @brief Set the budget of the launched pipelines.
+ */
+void
+mlops_node_admission_configure (const mlops_node_admission_config_s * config)
+{
+  g_return_if_fail (config != NULL);
+
+  G_LOCK (mlops_admission);
+  g_mlops_admission.config = *config;
+  _mlops_admission_dispatch_locked ();
+  G_UNLOCK (mlops_admission);
+}
+
+/**
+ * @brief Get the estimated cost and the priority of the service from the database.
+ */
+void
+mlops_node_admission_get_cost (const gchar * name, mlops_node_cost_s * cost, gint * priority)
+{
+  g_autofree gchar *cpu = NULL;
+  g_autofree gchar *memory = NULL;
+  g_autofree gchar *prio = NULL;
+  gint64 value;
+
+  g_return_if_fail (name != NULL);
+  g_return_if_fail (cost != NULL);
+
+  cost->cpu = 0U;
+  cost->memory_kb = 0U;
+
+  if (svcdb_pipeline_get_attribute (name, MLOPS_ADMISSION_COST_CPU_ATTR, &cpu) == 0 && cpu) {
+    value = g_ascii_strtoll (cpu, NULL, 10);
+    cost->cpu = (value > 0) ? (guint) MIN (value, G_MAXINT) : 0U;
+  }
+
+  if (svcdb_pipeline_get_attribute (name, MLOPS_ADMISSION_COST_MEMORY_ATTR, &memory) == 0 && memory) {
+    value = g_ascii_strtoll (memory, NULL, 10);
+    cost->memory_kb = (value > 0) ? (guint64) value : 0U;
+  }
+
+  if (priority) {
+    *priority = 0;
+    if (svcdb_pipeline_get_attribute (name, MLOPS_ADMISSION_PRIORITY_ATTR, &prio) == 0 && prio) {
+      value = g_ascii_strtoll (prio, NULL, 10);
+      *priority = (gint) CLAMP (value, G_MININT, G_MAXINT);
+    }
+  }
+}
+
+/**
+ * @brief Request to admit the pipeline with the cost.
+ */
+int
+mlops_node_admission_acquire (const gchar * app, const mlops_node_cost_s * cost,
+    const gint priority, mlops_node_admission_cb cb, void *user_data, GDestroyNotify notify)
+{
+  mlops_admission_s *adm = &g_mlops_admission;
+  mlops_admission_entry_s *entry, *head;
+  gint ret = -EBUSY;
+
+  g_return_val_if_fail (cost != NULL, -EINVAL);
+
+  G_LOCK (mlops_admission);
+  /* The request does not overtake the queued requests with the same or higher priority. */
+  head = (mlops_admission_entry_s *) g_queue_peek_head (&adm->queue);
+  if ((!head || priority > head->priority) && _mlops_admission_fits_locked (app, cost)) {
+    _mlops_admission_reserve_locked (app, cost);
+    ret = 0;
+  } else if (cb && adm->config.queue_timeout_ms > 0) {
+    if (!adm->worker) {
+      adm->worker = g_thread_pool_new (_mlops_admission_worker, NULL, 1, FALSE, NULL);
+      if (!adm->worker) {
+        G_UNLOCK (mlops_admission);
+        ml_loge ("Failed to create the worker of the admission control.");
+        return -EIO;
+      }
+    }
+
+    entry = g_new0 (mlops_admission_entry_s, 1);
+    entry->app = g_strdup (app);
+    entry->cost = *cost;
+    entry->priority = priority;
+    entry->cb = cb;
+    entry->user_data = user_data;
+    entry->notify = notify;
+    entry->deadline = g_get_monotonic_time () +
+        (gint64) adm->config.queue_timeout_ms * G_TIME_SPAN_MILLISECOND;
+
+    g_queue_insert_sorted (&adm->queue, entry, _mlops_admission_compare, NULL);
+    _mlops_admission_wake_locked ();
+    ret = -EINPROGRESS;
+  }
+  G_UNLOCK (mlops_admission);
+
+  if (ret == -EBUSY)
+    ml_logw ("The launch request is rejected, the launched pipelines exceed the budget.");
+
+  return ret;
+}
+
+/**
+ * @brief Release the cost of the admitted pipeline, and admit the queued requests.
+ */
+void
+mlops_node_admission_release (const gchar * app, const mlops_node_cost_s * cost)
+{
+  mlops_admission_s *adm = &g_mlops_admission;
+  guint count;
+
+  g_return_if_fail (cost != NULL);
+
+  G_LOCK (mlops_admission);
+  adm->nodes = (adm->nodes > 0) ? (adm->nodes - 1) : 0U;
+  adm->cpu = (adm->cpu > cost->cpu) ? (adm->cpu - cost->cpu) : 0U;
+  adm->memory_kb = (adm->memory_kb > cost->memory_kb) ? (adm->memory_kb - cost->memory_kb) : 0U;
+
+  count = _mlops_admission_get_app_nodes_locked (app);
+  if (count > 1)
+    g_hash_table_insert (adm->apps, g_strdup (app), GUINT_TO_POINTER (count - 1));
+  else if (count == 1)
+    g_hash_table_remove (adm->apps, app);
+
+  _mlops_admission_dispatch_locked ();
+  G_UNLOCK (mlops_admission);
+}
+
+/**
+ * @brief Update the estimated cost of the service with the measured cost of the last run.
+ */
+void
+mlops_node_admission_learn (const gchar * name, const mlops_node_cost_s * measured)
+{
+  g_autofree gchar *attributes = NULL;
+  mlops_node_cost_s cost;
+  gdouble rate = MLOPS_ADMISSION_LEARNING_RATE;
+
+  g_return_if_fail (name != NULL);
+  g_return_if_fail (measured != NULL);
+
+  mlops_node_admission_get_cost (name, &cost, NULL);
+
+  /* The moving average of the cost, the first run is used as it is. */
+  if (cost.cpu > 0U || cost.memory_kb > 0U) {
+    cost.cpu = (guint) (cost.cpu * (1.0 - rate) + measured->cpu * rate + 0.5);
+    cost.memory_kb = (guint64) (cost.memory_kb * (1.0 - rate) + measured->memory_kb * rate + 0.5);
+  } else {
+    cost = *measured;
+  }
+
+  attributes = g_strdup_printf ("{\"%s\":%u,\"%s\":%" G_GUINT64_FORMAT "}",
+      MLOPS_ADMISSION_COST_CPU_ATTR, cost.cpu, MLOPS_ADMISSION_COST_MEMORY_ATTR, cost.memory_kb);
+
+  if (svcdb_pipeline_set_attributes (name, attributes) != 0)
+    ml_logw ("Failed to update the estimated cost of the service '%s'.", name);
+}
+
+/**
+ * @brief Internal function to get the CPU time (in nanoseconds) of the calling thread.
+ */
+static gint64
+_mlops_admission_get_thread_time (void)
+{
+  struct timespec ts;
+
+  if (clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+    return -1;
+
+  return (gint64) ts.tv_sec * G_GINT64_CONSTANT (1000000000) + ts.tv_nsec;
+}
+
+/**
+ * @brief Record the CPU time of the streaming thread entering the task.
+ */
+void
+mlops_node_admission_thread_enter (void)
+{
+  gint64 *enter = (gint64 *) g_private_get (&g_mlops_thread_enter);
+
+  if (!enter) {
+    enter = g_new (gint64, 1);
+    g_private_set (&g_mlops_thread_enter, enter);
+  }
+
+  *enter = _mlops_admission_get_thread_time ();
+}
+
+/**
+ * @brief Get the CPU time (in nanoseconds) spent by the streaming thread since it entered the task.
+ */
+gint64
+mlops_node_admission_thread_leave (void)
+{
+  gint64 *enter = (gint64 *) g_private_get (&g_mlops_thread_enter);
+  gint64 now;
+
+  if (!enter || *enter < 0)
+    return 0;
+
+  now = _mlops_admission_get_thread_time ();
+  now = (now > *enter) ? (now - *enter) : 0;
+  *enter = -1;
+
+  return now;
+}
+
+/**
+ * @brief Get the resident memory (in kilobytes) of the process.
+ */
+gint64
+mlops_node_admission_get_rss (void)
+{
+  g_autofree gchar *contents = NULL;
+  gchar **fields;
+  gint64 pages = 0;
+  glong page_size;
+
+  if (!g_file_get_contents ("/proc/self/statm", &contents, NULL, NULL))
+    return 0;
+
+  /* The second field is the number of the resident pages. */
+  fields = g_strsplit (contents, " ", 3);
+  if (fields[0] && fields[1])
+    pages = g_ascii_strtoll (fields[1], NULL, 10);
+  g_strfreev (fields);
+
+  page_size = sysconf (_SC_PAGESIZE);
+  if (page_size <= 0)
+    page_size = 4096;
+
+  return pages * (page_size / 1024);
+}
+
+/**
+ * @brief Drop the queued requests and reset the budget.
+ */
+void
+mlops_node_admission_finalize (void)
+{
+  mlops_admission_s *adm = &g_mlops_admission;
+  GThreadPool *worker;
+  GList *queued, *l;
+
+  G_LOCK (mlops_admission);
+  queued = g_list_concat (adm->ready.head, adm->queue.head);
+  g_queue_init (&adm->ready);
+  g_queue_init (&adm->queue);
+
+  /* Stop the worker, it may be notifying the request. */
+  worker = adm->worker;
+  adm->worker = NULL;
+  adm->closing = TRUE;
+  g_cond_broadcast (&adm->cond);
+  G_UNLOCK (mlops_admission);
+
+  if (worker)
+    g_thread_pool_free (worker, FALSE, TRUE);
+
+  G_LOCK (mlops_admission);
+  adm->closing = FALSE;
+
+  if (adm->apps) {
+    g_hash_table_destroy (adm->apps);
+    adm->apps = NULL;
+  }
+
+  adm->nodes = adm->cpu = 0U;
+  adm->memory_kb = 0U;
+  G_UNLOCK (mlops_admission);
+
+  /* The callback is not called, release the data of the queued requests. */
+  for (l = queued; l != NULL; l = l->next) {
+    mlops_admission_entry_s *entry = (mlops_admission_entry_s *) l->data;
+
+    if (entry->notify)
+      entry->notify (entry->user_data);
+  }
+
+  g_list_free_full (queued, _mlops_admission_entry_free);
+}
@@ -0,0 +1,102 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-admission.h
+ * @date      18 October 2026
+ * @brief     Admission control of the pipelines in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The launch request is admitted if the launched pipelines are within the budget,
+ *            otherwise it is queued with the priority of the service or rejected.
+ */
+
+#ifndef _MLOPS_AGENT_NODE_ADMISSION_H_
+#define _MLOPS_AGENT_NODE_ADMISSION_H_
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Structure for the budget of the launched pipelines. 0 means there is no limit.
+ */
+typedef struct
+{
+  guint max_nodes;              /**< The maximum number of the launched pipelines */
+  guint cpu_budget;             /**< The CPU budget in percent of a core, e.g., 400 for 4 cores */
+  guint64 memory_budget_kb;     /**< The memory budget in kilobytes */
+  guint app_max_nodes;          /**< The maximum number of the launched pipelines of each app */
+  guint queue_timeout_ms;       /**< The time to wait in the queue, 0 to reject the request over the budget immediately */
+} mlops_node_admission_config_s;
+
+/**
+ * @brief Structure for the estimated cost of the pipeline.
+ */
+typedef struct
+{
+  guint cpu;                    /**< The CPU usage in percent of a core while playing */
+  guint64 memory_kb;            /**< The memory usage in kilobytes */
+} mlops_node_cost_s;
+
+/**
+ * @brief Callback to notify the result of the queued request. This is called in the worker of the admission control, not in the main context.
+ * @details The request is admitted if @a result is 0, otherwise it is rejected with -EBUSY.
+ */
+typedef void (*mlops_node_admission_cb) (const int result, void *user_data);
+
+/**
+ * @brief Set the budget of the launched pipelines.
+ */
+void mlops_node_admission_configure (const mlops_node_admission_config_s *config);
+
+/**
+ * @brief Get the estimated cost and the priority of the service from the database.
+ */
+void mlops_node_admission_get_cost (const gchar *name, mlops_node_cost_s *cost, gint *priority);
+
+/**
+ * @brief Request to admit the pipeline with the cost.
+ * @details If @a cb is NULL, the request over the budget is rejected immediately.
+ *          @a cb is called once for the queued request. If the queue is dropped when finalizing,
+ *          @a notify is called instead to release @a user_data.
+ * @return 0 if admitted, -EINPROGRESS if queued, -EBUSY if rejected.
+ */
+int mlops_node_admission_acquire (const gchar *app, const mlops_node_cost_s *cost, const gint priority, mlops_node_admission_cb cb, void *user_data, GDestroyNotify notify);
+
+/**
+ * @brief Release the cost of the admitted pipeline, and admit the queued requests.
+ */
+void mlops_node_admission_release (const gchar *app, const mlops_node_cost_s *cost);
+
+/**
+ * @brief Update the estimated cost of the service with the measured cost of the last run.
+ */
+void mlops_node_admission_learn (const gchar *name, const mlops_node_cost_s *measured);
+
+/**
+ * @brief Record the CPU time of the streaming thread entering the task.
+ */
+void mlops_node_admission_thread_enter (void);
+
+/**
+ * @brief Get the CPU time (in nanoseconds) spent by the streaming thread since it entered the task.
+ */
+gint64 mlops_node_admission_thread_leave (void);
+
+/**
+ * @brief Get the resident memory (in kilobytes) of the process.
+ */
+gint64 mlops_node_admission_get_rss (void);
+
+/**
+ * @brief Drop the queued requests and reset the budget.
+ */
+void mlops_node_admission_finalize (void);
+
+G_END_DECLS
+#endif /* _MLOPS_AGENT_NODE_ADMISSION_H_ */
@@ -0,0 +1,1080 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-composite.c
+ * @date      18 October 2026
+ * @brief     Composite service chaining the stored pipelines in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The complete descriptions of the pipelines are combined into one description, and the linked pipeline is put in the bin
+ *            whose name has the index of the pipeline and its upstream. When the pipeline is built, the source element of the downstream
+ *            is replaced with appsrc, and the probe on the pad of the sink element of the upstream pushes the buffers and caps to the appsrc.
+ *            The appsrc takes the reference of the buffer (GstBuffer is refcounted), so the data is not copied.
+ *            Thus the linked pipeline has one source element if it has upstream, and one sink element if it has downstreams,
+ *            and the names of the elements do not collide with the other pipelines.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <gst/gst.h>
+#include <json-glib/json-glib.h>
+
+#include "log.h"
+#include "mlops-agent-internal.h"
+#include "mlops-agent-node-composite.h"
+#include "mlops-agent-node-template.h"
+#include "service-db-util.h"
+
+/**
+ * @brief The prefix of the names of the elements added by the composite service.
+ * @details The bin of the linked pipeline is named with the index of the pipeline, followed by '_' and the index of its upstream.
+ */
+#define MLOPS_COMPOSITE_PREFIX "mlops_composite_"
+
+/**
+ * @brief The prefix of the name of appsrc replacing the source element of the downstream, followed by the index of the pipeline.
+ */
+#define MLOPS_COMPOSITE_SRC_PREFIX MLOPS_COMPOSITE_PREFIX "src_"
+
+/**
+ * @brief Structure for the pipeline in the composite service.
+ */
+typedef struct
+{
+  gchar *name;          /**< The name of the stored pipeline */
+  gint upstream;        /**< The index of the upstream, -1 if the pipeline is not linked from the other */
+  GArray *downstream;   /**< The indices (gint) of the downstreams */
+  gchar *desc;          /**< The expanded description of the pipeline */
+} mlops_composite_member_s;
+
+/**
+ * @brief Structure for the definition of the composite service kept when it is launched.
+ */
+typedef struct
+{
+  gchar *definition;    /**< The definition of the composite service read from the database */
+  gchar **pipelines;    /**< The names of the pipelines in the composite service */
+} mlops_composite_kept_s;
+
+static GHashTable *g_mlops_composite_table = NULL;
+G_LOCK_DEFINE_STATIC (mlops_composite);
+
+/**
+ * @brief Internal function to release the kept definition of the composite service.
+ */
+static void
+_mlops_composite_kept_free (gpointer data)
+{
+  mlops_composite_kept_s *kept = (mlops_composite_kept_s *) data;
+
+  g_free (kept->definition);
+  g_strfreev (kept->pipelines);
+  g_free (kept);
+}
+
+/**
+ * @brief Internal function to release the pipeline in the composite service.
+ */
+static void
+_mlops_composite_member_free (gpointer data)
+{
+  mlops_composite_member_s *member = (mlops_composite_member_s *) data;
+
+  g_free (member->name);
+  g_array_free (member->downstream, TRUE);
+  g_free (member->desc);
+  g_free (member);
+}
+
+/**
+ * @brief Internal function to find the pipeline with given name.
+ * @return The index of the pipeline, -1 if not found.
+ */
+static gint
+_mlops_composite_find (GPtrArray * members, const gchar * name)
+{
+  guint i;
+
+  for (i = 0; i < members->len; i++) {
+    mlops_composite_member_s *member =
+        (mlops_composite_member_s *) g_ptr_array_index (members, i);
+
+    if (g_str_equal (member->name, name))
+      return (gint) i;
+  }
+
+  return -1;
+}
+
+/**
+ * @brief Internal function to get the string of the JSON node.
+ * @return The string, NULL if the node does not hold the string.
+ */
+static const gchar *
+_mlops_composite_get_string (JsonNode * node)
+{
+  if (!node || !JSON_NODE_HOLDS_VALUE (node)
+      || json_node_get_value_type (node) != G_TYPE_STRING)
+    return NULL;
+
+  return json_node_get_string (node);
+}
+
+/**
+ * @brief Internal function to add the pipelines in the definition.
+ */
+static int
+_mlops_composite_parse_pipelines (JsonObject * object, GPtrArray * members)
+{
+  JsonNode *node;
+  JsonArray *array;
+  guint i, length;
+
+  node = json_object_get_member (object, "pipelines");
+  array = (node && JSON_NODE_HOLDS_ARRAY (node)) ? json_node_get_array (node) : NULL;
+  length = array ? json_array_get_length (array) : 0U;
+  if (length == 0U) {
+    ml_loge ("The composite service should have the array of the pipelines.");
+    return -EINVAL;
+  }
+
+  for (i = 0; i < length; i++) {
+    mlops_composite_member_s *member;
+    const gchar *name = _mlops_composite_get_string (json_array_get_element (array, i));
+
+    if (!STR_IS_VALID (name)) {
+      ml_loge ("The name of the pipeline in the composite service is invalid.");
+      return -EINVAL;
+    }
+
+    if (_mlops_composite_find (members, name) >= 0) {
+      ml_loge ("The pipeline '%s' is duplicated in the composite service.", name);
+      return -EINVAL;
+    }
+
+    member = g_new0 (mlops_composite_member_s, 1);
+    member->name = g_strdup (name);
+    member->upstream = -1;
+    member->downstream = g_array_new (FALSE, FALSE, sizeof (gint));
+    g_ptr_array_add (members, member);
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to add the links in the definition.
+ */
+static int
+_mlops_composite_parse_links (JsonObject * object, GPtrArray * members)
+{
+  JsonNode *node;
+  JsonArray *array;
+  guint i, length;
+
+  node = json_object_get_member (object, "links");
+  if (!node || JSON_NODE_HOLDS_NULL (node))
+    return 0;
+
+  if (!JSON_NODE_HOLDS_ARRAY (node)) {
+    ml_loge ("The links of the composite service should be an array.");
+    return -EINVAL;
+  }
+
+  array = json_node_get_array (node);
+  length = json_array_get_length (array);
+
+  for (i = 0; i < length; i++) {
+    JsonNode *link = json_array_get_element (array, i);
+    JsonObject *link_object;
+    mlops_composite_member_s *to;
+    const gchar *from_name, *to_name;
+    gint from_idx, to_idx;
+
+    if (!link || !JSON_NODE_HOLDS_OBJECT (link)) {
+      ml_loge ("The link of the composite service should be an object.");
+      return -EINVAL;
+    }
+
+    link_object = json_node_get_object (link);
+    from_name = _mlops_composite_get_string (json_object_get_member (link_object, "from"));
+    to_name = _mlops_composite_get_string (json_object_get_member (link_object, "to"));
+
+    from_idx = from_name ? _mlops_composite_find (members, from_name) : -1;
+    to_idx = to_name ? _mlops_composite_find (members, to_name) : -1;
+    if (from_idx < 0 || to_idx < 0 || from_idx == to_idx) {
+      ml_loge ("Invalid link from '%s' to '%s' in the composite service.",
+          from_name ? from_name : "(null)", to_name ? to_name : "(null)");
+      return -EINVAL;
+    }
+
+    to = (mlops_composite_member_s *) g_ptr_array_index (members, to_idx);
+    if (to->upstream >= 0) {
+      ml_loge ("The pipeline '%s' is linked from more than one pipeline.", to_name);
+      return -EINVAL;
+    }
+
+    to->upstream = from_idx;
+    g_array_append_val (((mlops_composite_member_s *)
+            g_ptr_array_index (members, from_idx))->downstream, to_idx);
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to check the pipelines are reachable from the pipelines without upstream.
+ * @details Each pipeline has one upstream at most, the pipeline in the cycle is not reachable.
+ */
+static int
+_mlops_composite_check_cycle (GPtrArray * members)
+{
+  GArray *stack;
+  guint i, j, visited = 0U;
+
+  stack = g_array_new (FALSE, FALSE, sizeof (gint));
+  for (i = 0; i < members->len; i++) {
+    mlops_composite_member_s *member =
+        (mlops_composite_member_s *) g_ptr_array_index (members, i);
+
+    if (member->upstream < 0) {
+      gint idx = (gint) i;
+
+      g_array_append_val (stack, idx);
+    }
+  }
+
+  while (stack->len > 0U) {
+    mlops_composite_member_s *member;
+    gint idx = g_array_index (stack, gint, stack->len - 1);
+
+    g_array_remove_index (stack, stack->len - 1);
+    visited++;
+
+    member = (mlops_composite_member_s *) g_ptr_array_index (members, idx);
+    for (j = 0; j < member->downstream->len; j++)
+      g_array_append_val (stack, g_array_index (member->downstream, gint, j));
+  }
+
+  g_array_free (stack, TRUE);
+
+  if (visited != members->len) {
+    ml_loge ("The links of the composite service make a cycle.");
+    return -EINVAL;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to parse the definition of the composite service.
+ */
+static int
+_mlops_composite_parse (const gchar * definition, GPtrArray ** members)
+{
+  JsonNode *root;
+  GPtrArray *parsed;
+  int result;
+
+  root = json_from_string (definition, NULL);
+  if (!root || !JSON_NODE_HOLDS_OBJECT (root)) {
+    ml_loge ("The definition of the composite service should be a JSON object, '%s'.", definition);
+    if (root)
+      json_node_unref (root);
+    return -EINVAL;
+  }
+
+  parsed = g_ptr_array_new_with_free_func (_mlops_composite_member_free);
+
+  result = _mlops_composite_parse_pipelines (json_node_get_object (root), parsed);
+  if (result == 0)
+    result = _mlops_composite_parse_links (json_node_get_object (root), parsed);
+  if (result == 0)
+    result = _mlops_composite_check_cycle (parsed);
+
+  json_node_unref (root);
+
+  if (result != 0) {
+    g_ptr_array_unref (parsed);
+    return result;
+  }
+
+  *members = parsed;
+  return 0;
+}
+
+/**
+ * @brief Internal function to check the element has no pad template of given direction.
+ * @details The source element has no sink pad, and the sink element has no source pad.
+ *          The bin without the pad template, e.g., the bin in the description, is not counted and its children are checked.
+ */
+static gboolean
+_mlops_composite_is_end (GstElement * element, const GstPadDirection direction)
+{
+  GstElementFactory *factory;
+  const GList *templates;
+
+  factory = gst_element_get_factory (element);
+  if (!factory)
+    return FALSE;
+
+  templates = gst_element_factory_get_static_pad_templates (factory);
+  if (!templates && GST_IS_BIN (element))
+    return FALSE;
+
+  for (; templates != NULL; templates = templates->next) {
+    if (((GstStaticPadTemplate *) templates->data)->direction == direction)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to check the name of the element, and count the source and sink elements of the pipeline.
+ * @param names The names of the elements (string to the name of the pipeline) in the composite service.
+ */
+static int
+_mlops_composite_check_element (mlops_composite_member_s * member,
+    GstElement * element, GHashTable * names, guint * sources, guint * sinks)
+{
+  const gchar *name = GST_ELEMENT_NAME (element);
+  const gchar *owner;
+
+  owner = (const gchar *) g_hash_table_lookup (names, name);
+  if (owner || g_str_has_prefix (name, MLOPS_COMPOSITE_PREFIX)) {
+    ml_loge ("The element '%s' of the pipeline '%s' collides with the pipeline '%s' in the composite service.",
+        name, member->name, owner ? owner : "(composite)");
+    return -EINVAL;
+  }
+  g_hash_table_insert (names, g_strdup (name), member->name);
+
+  if (_mlops_composite_is_end (element, GST_PAD_SINK))
+    (*sources)++;
+  else if (_mlops_composite_is_end (element, GST_PAD_SRC))
+    (*sinks)++;
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to check the element name is added by the pipeline.
+ */
+static gboolean
+_mlops_composite_is_owner (gpointer key, gpointer value, gpointer user_data)
+{
+  return (value == user_data);
+}
+
+/**
+ * @brief Internal function to check the expanded description of the pipeline can be linked with the other pipelines.
+ */
+static int
+_mlops_composite_check_member (mlops_composite_member_s * member, GHashTable * names)
+{
+  GstElement *pipeline;
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  GError *err = NULL;
+  gboolean done = FALSE;
+  guint sources = 0U, sinks = 0U;
+  int result = 0;
+
+  /* The elements are created but not started, the devices and the models are not opened. */
+  pipeline = gst_parse_launch (member->desc, &err);
+  if (!pipeline || err) {
+    ml_loge ("Failed to parse the pipeline '%s' of the composite service (error msg: %s).",
+        member->name, (err) ? err->message : "unknown reason");
+    g_clear_error (&err);
+
+    if (pipeline)
+      gst_object_unref (pipeline);
+    return -EINVAL;
+  }
+
+  if (!GST_IS_BIN (pipeline)) {
+    result = _mlops_composite_check_element (member, pipeline, names, &sources, &sinks);
+  } else {
+    it = gst_bin_iterate_recurse (GST_BIN (pipeline));
+    while (!done && result == 0) {
+      switch (gst_iterator_next (it, &item)) {
+        case GST_ITERATOR_OK:
+          result = _mlops_composite_check_element (member,
+              GST_ELEMENT (g_value_get_object (&item)), names, &sources, &sinks);
+          g_value_reset (&item);
+          break;
+        case GST_ITERATOR_RESYNC:
+          g_hash_table_foreach_remove (names, _mlops_composite_is_owner, member->name);
+          sources = sinks = 0U;
+          gst_iterator_resync (it);
+          break;
+        default:
+          done = TRUE;
+          break;
+      }
+    }
+
+    g_value_unset (&item);
+    gst_iterator_free (it);
+  }
+
+  gst_object_unref (pipeline);
+  if (result != 0)
+    return result;
+
+  /* The source element of the downstream is replaced, and the buffers are taken from the sink element of the upstream. */
+  if (member->upstream >= 0 && sources != 1U) {
+    ml_loge ("The pipeline '%s' is linked from the other pipeline, but it has %u source elements.",
+        member->name, sources);
+    return -EINVAL;
+  }
+
+  if (member->downstream->len > 0U && sinks != 1U) {
+    ml_loge ("The pipeline '%s' is linked to the other pipeline, but it has %u sink elements.",
+        member->name, sinks);
+    return -EINVAL;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to check the expanded pipelines can be linked.
+ * @details The pipeline which is not expanded yet is skipped.
+ */
+static int
+_mlops_composite_check_members (GPtrArray * members)
+{
+  GHashTable *names;
+  guint i;
+  int result = 0;
+
+  names = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  for (i = 0; i < members->len && result == 0; i++) {
+    mlops_composite_member_s *member =
+        (mlops_composite_member_s *) g_ptr_array_index (members, i);
+
+    if (member->desc)
+      result = _mlops_composite_check_member (member, names);
+  }
+
+  g_hash_table_destroy (names);
+  return result;
+}
+
+/**
+ * @brief Internal function to append the description of the pipeline.
+ * @details The linked pipeline is put in the bin, to find its source and sink elements when the pipeline is built.
+ */
+static void
+_mlops_composite_append (GString * str, GPtrArray * members, const guint idx)
+{
+  mlops_composite_member_s *member =
+      (mlops_composite_member_s *) g_ptr_array_index (members, idx);
+
+  if (str->len > 0)
+    g_string_append_c (str, ' ');
+
+  if (member->upstream < 0 && member->downstream->len == 0U) {
+    g_string_append (str, member->desc);
+    return;
+  }
+
+  g_string_append_printf (str, "bin.( name=" MLOPS_COMPOSITE_PREFIX "%u", idx);
+  if (member->upstream >= 0)
+    g_string_append_printf (str, "_%d", member->upstream);
+  g_string_append_printf (str, " %s )", member->desc);
+}
+
+/**
+ * @brief Internal function to move the activated models of the pipeline.
+ */
+static void
+_mlops_composite_merge_models (GHashTable ** models, GHashTable * member_models)
+{
+  GHashTableIter iter;
+  gpointer key, value;
+
+  if (!member_models)
+    return;
+
+  if (!*models) {
+    *models = g_hash_table_ref (member_models);
+    return;
+  }
+
+  g_hash_table_iter_init (&iter, member_models);
+  while (g_hash_table_iter_next (&iter, &key, &value)) {
+    mlops_node_model_s *info;
+
+    if (g_hash_table_contains (*models, key))
+      continue;
+
+    info = g_new0 (mlops_node_model_s, 1);
+    info->path = g_strdup (((mlops_node_model_s *) value)->path);
+    info->version = ((mlops_node_model_s *) value)->version;
+    g_hash_table_insert (*models, g_strdup ((const gchar *) key), info);
+  }
+}
+
+/**
+ * @brief Check the definition of the composite service.
+ */
+int
+mlops_node_composite_validate (const gchar * definition)
+{
+  GPtrArray *members = NULL;
+  guint i;
+  int result;
+
+  g_return_val_if_fail (STR_IS_VALID (definition), -EINVAL);
+
+  result = _mlops_composite_parse (definition, &members);
+  if (result != 0)
+    return result;
+
+  /* The pipelines stored already are checked with the default parameters, the others are checked when the service is launched. */
+  for (i = 0; i < members->len; i++) {
+    mlops_composite_member_s *member =
+        (mlops_composite_member_s *) g_ptr_array_index (members, i);
+    g_autofree gchar *stored = NULL;
+    GHashTable *member_models = NULL;
+
+    if (svcdb_pipeline_get (member->name, &stored) != 0 ||
+        mlops_node_template_expand (member->name, stored, NULL, &member->desc, &member_models) != 0)
+      continue;
+
+    if (member_models)
+      g_hash_table_unref (member_models);
+  }
+
+  result = _mlops_composite_check_members (members);
+  g_ptr_array_unref (members);
+
+  return result;
+}
+
+/**
+ * @brief Internal function to keep the definition of the composite service, the running service is switched with it when its pipeline is changed.
+ */
+static void
+_mlops_composite_keep (const gchar * name, const gchar * definition, GPtrArray * members)
+{
+  mlops_composite_kept_s *kept;
+  guint i;
+
+  kept = g_new0 (mlops_composite_kept_s, 1);
+  kept->definition = g_strdup (definition);
+  kept->pipelines = g_new0 (gchar *, members->len + 1);
+  for (i = 0; i < members->len; i++)
+    kept->pipelines[i] = g_strdup (((mlops_composite_member_s *) g_ptr_array_index (members, i))->name);
+
+  G_LOCK (mlops_composite);
+  if (!g_mlops_composite_table) {
+    g_mlops_composite_table = g_hash_table_new_full (g_str_hash, g_str_equal,
+        g_free, _mlops_composite_kept_free);
+  }
+  g_hash_table_replace (g_mlops_composite_table, g_strdup (name), kept);
+  G_UNLOCK (mlops_composite);
+}
+
+/**
+ * @brief Internal function to get the kept definition of the composite service.
+ * @return The definition, NULL if the composite service is not launched.
+ */
+static gchar *
+_mlops_composite_get_kept (const gchar * name, gchar *** pipelines)
+{
+  mlops_composite_kept_s *kept = NULL;
+  gchar *definition = NULL;
+
+  G_LOCK (mlops_composite);
+  if (g_mlops_composite_table)
+    kept = (mlops_composite_kept_s *) g_hash_table_lookup (g_mlops_composite_table, name);
+  if (kept) {
+    definition = g_strdup (kept->definition);
+    if (pipelines)
+      *pipelines = g_strdupv (kept->pipelines);
+  }
+  G_UNLOCK (mlops_composite);
+
+  return definition;
+}
+
+/**
+ * @brief Internal function to expand the descriptions of the pipelines and link them.
+ * @details If @a kept is TRUE, the kept descriptions of the pipelines are expanded and this does not access the database.
+ */
+static int
+_mlops_composite_expand_members (const gchar * name, GPtrArray * members,
+    GHashTable * params, const gboolean kept, gchar ** desc, GHashTable ** models)
+{
+  GHashTable *merged = NULL;
+  GString *str;
+  guint i;
+  int result = 0;
+
+  for (i = 0; i < members->len; i++) {
+    mlops_composite_member_s *member =
+        (mlops_composite_member_s *) g_ptr_array_index (members, i);
+    g_autofree gchar *stored = NULL;
+    GHashTable *member_models = NULL;
+
+    if (kept) {
+      result = mlops_node_template_expand_kept (member->name, params,
+          &member->desc, &member_models);
+    } else {
+      result = svcdb_pipeline_get (member->name, &stored);
+      if (result == 0) {
+        result = mlops_node_template_expand (member->name, stored, params,
+            &member->desc, &member_models);
+      }
+    }
+
+    if (result != 0) {
+      ml_loge ("Failed to get the pipeline '%s' of the composite service '%s'.",
+          member->name, name);
+      break;
+    }
+
+    _mlops_composite_merge_models (&merged, member_models);
+    if (member_models)
+      g_hash_table_unref (member_models);
+  }
+
+  /* Reject the pipeline which cannot be linked before building it. */
+  if (result == 0)
+    result = _mlops_composite_check_members (members);
+
+  if (result != 0) {
+    if (merged)
+      g_hash_table_unref (merged);
+    return result;
+  }
+
+  /* The pipelines are linked when the pipeline is built, see mlops_node_composite_attach(). */
+  str = g_string_new (NULL);
+  for (i = 0; i < members->len; i++)
+    _mlops_composite_append (str, members, i);
+
+  *desc = g_string_free (str, FALSE);
+  if (models)
+    *models = merged;
+  else if (merged)
+    g_hash_table_unref (merged);
+
+  return 0;
+}
+
+/**
+ * @brief Get the description to launch the composite service, the descriptions of the pipelines are expanded and linked.
+ */
+int
+mlops_node_composite_expand (const gchar * name, GHashTable * params,
+    gchar ** desc, GHashTable ** models)
+{
+  g_autofree gchar *definition = NULL;
+  GPtrArray *members = NULL;
+  int result;
+
+  g_return_val_if_fail (STR_IS_VALID (name), -EINVAL);
+  g_return_val_if_fail (desc != NULL, -EINVAL);
+
+  result = svcdb_composite_get (name, &definition);
+  if (result == 0)
+    result = _mlops_composite_parse (definition, &members);
+
+  if (result != 0) {
+    ml_loge ("Failed to get the composite service '%s'.", name);
+    return result;
+  }
+
+  result = _mlops_composite_expand_members (name, members, params, FALSE, desc, models);
+  if (result == 0)
+    _mlops_composite_keep (name, definition, members);
+
+  g_ptr_array_unref (members);
+  return result;
+}
+
+/**
+ * @brief Check the composite service includes the pipeline.
+ */
+gboolean
+mlops_node_composite_has_pipeline (const gchar * name, const gchar * pipeline)
+{
+  mlops_composite_kept_s *kept = NULL;
+  gboolean found = FALSE;
+
+  g_return_val_if_fail (name != NULL, FALSE);
+  g_return_val_if_fail (pipeline != NULL, FALSE);
+
+  G_LOCK (mlops_composite);
+  if (g_mlops_composite_table)
+    kept = (mlops_composite_kept_s *) g_hash_table_lookup (g_mlops_composite_table, name);
+  if (kept)
+    found = g_strv_contains ((const gchar * const *) kept->pipelines, pipeline);
+  G_UNLOCK (mlops_composite);
+
+  return found;
+}
+
+/**
+ * @brief Read the activated models and the shared sources referred by the pipelines of the kept composite service.
+ */
+int
+mlops_node_composite_resolve (const gchar * name)
+{
+  gchar **pipelines = NULL;
+  gchar *definition;
+  guint i;
+  int result = 0;
+
+  g_return_val_if_fail (STR_IS_VALID (name), -EINVAL);
+
+  definition = _mlops_composite_get_kept (name, &pipelines);
+  if (!definition)
+    return -ENOENT;
+
+  for (i = 0; result == 0 && pipelines[i] != NULL; i++)
+    result = mlops_node_template_resolve (pipelines[i]);
+
+  g_strfreev (pipelines);
+  g_free (definition);
+  return result;
+}
+
+/**
+ * @brief Get the description of the composite service from the kept definition and the kept descriptions of the pipelines.
+ */
+int
+mlops_node_composite_expand_kept (const gchar * name, GHashTable * params,
+    gchar ** desc, GHashTable ** models)
+{
+  g_autofree gchar *definition = NULL;
+  GPtrArray *members = NULL;
+  int result;
+
+  g_return_val_if_fail (STR_IS_VALID (name), -EINVAL);
+  g_return_val_if_fail (desc != NULL, -EINVAL);
+
+  definition = _mlops_composite_get_kept (name, NULL);
+  if (!definition)
+    return -ENOENT;
+
+  result = _mlops_composite_parse (definition, &members);
+  if (result != 0)
+    return result;
+
+  result = _mlops_composite_expand_members (name, members, params, TRUE, desc, models);
+  g_ptr_array_unref (members);
+
+  return result;
+}
+
+/**
+ * @brief Internal function to pass the buffers and caps of the upstream to the appsrc of the downstream.
+ * @details The buffer is dropped if the queue of appsrc is full, the slow downstream does not block the upstream and the other downstreams.
+ */
+static GstPadProbeReturn
+_mlops_composite_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  GstElement *appsrc = GST_ELEMENT (user_data);
+  GstFlowReturn ret;
+  guint64 level = 0U, max = 0U;
+
+  if (info->type & GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM) {
+    GstEvent *event = GST_PAD_PROBE_INFO_EVENT (info);
+    GstCaps *caps = NULL;
+
+    if (GST_EVENT_TYPE (event) == GST_EVENT_CAPS) {
+      gst_event_parse_caps (event, &caps);
+      g_object_set (appsrc, "caps", caps, NULL);
+    } else if (GST_EVENT_TYPE (event) == GST_EVENT_EOS) {
+      g_signal_emit_by_name (appsrc, "end-of-stream", &ret);
+    }
+
+    return GST_PAD_PROBE_OK;
+  }
+
+  g_object_get (appsrc, "current-level-bytes", &level, "max-bytes", &max, NULL);
+  if (max > 0U && level >= max)
+    return GST_PAD_PROBE_OK;
+
+  /* The appsrc holds the reference of the buffer, the sink of the upstream still gets it. */
+  if (info->type & GST_PAD_PROBE_TYPE_BUFFER_LIST)
+    g_signal_emit_by_name (appsrc, "push-buffer-list", GST_PAD_PROBE_INFO_BUFFER_LIST (info), &ret);
+  else
+    g_signal_emit_by_name (appsrc, "push-buffer", GST_PAD_PROBE_INFO_BUFFER (info), &ret);
+
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Internal function to get the source or sink element in the bin of the linked pipeline.
+ * @param direction The direction of the pad which the element does not have.
+ * @return The element with its reference, NULL if the bin does not have one element of given direction.
+ */
+static GstElement *
+_mlops_composite_get_end (GstElement * bin, const GstPadDirection direction)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  GstElement *found = NULL;
+  gboolean done = FALSE;
+  guint count = 0U;
+
+  it = gst_bin_iterate_recurse (GST_BIN (bin));
+  while (!done) {
+    switch (gst_iterator_next (it, &item)) {
+      case GST_ITERATOR_OK:
+      {
+        GstElement *element = GST_ELEMENT (g_value_get_object (&item));
+
+        if (_mlops_composite_is_end (element, direction)) {
+          if (!found)
+            found = gst_object_ref (element);
+          count++;
+        }
+
+        g_value_reset (&item);
+        break;
+      }
+      case GST_ITERATOR_RESYNC:
+        g_clear_object (&found);
+        count = 0U;
+        gst_iterator_resync (it);
+        break;
+      default:
+        done = TRUE;
+        break;
+    }
+  }
+
+  g_value_unset (&item);
+  gst_iterator_free (it);
+
+  if (count != 1U)
+    g_clear_object (&found);
+
+  return found;
+}
+
+/**
+ * @brief Internal function to get the pad of the element, the element should have one pad of given direction.
+ * @return The pad with its reference, NULL if the element has no pad or several pads.
+ */
+static GstPad *
+_mlops_composite_get_pad (GstElement * element, const GstPadDirection direction)
+{
+  GstPad *pad = NULL;
+
+  GST_OBJECT_LOCK (element);
+  if (direction == GST_PAD_SRC && element->numsrcpads == 1)
+    pad = gst_object_ref (element->srcpads->data);
+  else if (direction == GST_PAD_SINK && element->numsinkpads == 1)
+    pad = gst_object_ref (element->sinkpads->data);
+  GST_OBJECT_UNLOCK (element);
+
+  return pad;
+}
+
+/**
+ * @brief Internal function to replace the source element of the downstream with appsrc, and push the buffers of the upstream to it.
+ */
+static int
+_mlops_composite_link (GstElement * upstream, GstElement * downstream, const gint idx)
+{
+  GstElement *source, *sink, *appsrc = NULL;
+  GstObject *parent = NULL;
+  GstPad *srcpad = NULL, *peer = NULL, *sinkpad = NULL, *pad = NULL;
+  gchar *name;
+  int result = -EINVAL;
+
+  sink = _mlops_composite_get_end (upstream, GST_PAD_SRC);
+  source = _mlops_composite_get_end (downstream, GST_PAD_SINK);
+  if (!sink || !source) {
+    ml_loge ("Failed to find the elements to link the pipelines of the composite service.");
+    goto done;
+  }
+
+  sinkpad = _mlops_composite_get_pad (sink, GST_PAD_SINK);
+  srcpad = _mlops_composite_get_pad (source, GST_PAD_SRC);
+  peer = srcpad ? gst_pad_get_peer (srcpad) : NULL;
+  parent = gst_object_get_parent (GST_OBJECT (source));
+  if (!sinkpad || !peer || !parent) {
+    ml_loge ("The element '%s' or '%s' of the composite service should have one linked pad.",
+        GST_ELEMENT_NAME (sink), GST_ELEMENT_NAME (source));
+    goto done;
+  }
+
+  name = g_strdup_printf (MLOPS_COMPOSITE_SRC_PREFIX "%d", idx);
+  appsrc = gst_element_factory_make ("appsrc", name);
+  g_free (name);
+  if (!appsrc) {
+    ml_loge ("Failed to create appsrc to link the pipelines of the composite service.");
+    result = -ESTRPIPE;
+    goto done;
+  }
+  gst_object_ref_sink (appsrc);
+
+  /* The timestamps of the upstream are kept with the same clock, and the live appsrc does not wait for the buffer to preroll. */
+  g_object_set (appsrc, "format", GST_FORMAT_TIME, "is-live", TRUE, NULL);
+
+  gst_pad_unlink (srcpad, peer);
+  gst_bin_remove (GST_BIN (parent), source);
+  gst_bin_add (GST_BIN (parent), appsrc);
+
+  pad = gst_element_get_static_pad (appsrc, "src");
+  if (gst_pad_link (pad, peer) != GST_PAD_LINK_OK) {
+    ml_loge ("Failed to link appsrc to the pipeline of the composite service.");
+    goto done;
+  }
+
+  gst_pad_add_probe (sinkpad, GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST |
+      GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM, _mlops_composite_probe,
+      gst_object_ref (appsrc), gst_object_unref);
+  result = 0;
+
+done:
+  if (pad)
+    gst_object_unref (pad);
+  if (appsrc)
+    gst_object_unref (appsrc);
+  if (parent)
+    gst_object_unref (parent);
+  if (peer)
+    gst_object_unref (peer);
+  if (srcpad)
+    gst_object_unref (srcpad);
+  if (sinkpad)
+    gst_object_unref (sinkpad);
+  if (source)
+    gst_object_unref (source);
+  if (sink)
+    gst_object_unref (sink);
+
+  return result;
+}
+
+/**
+ * @brief Internal function to get the indices of the pipeline and its upstream from the name of the bin.
+ */
+static gboolean
+_mlops_composite_parse_bin_name (const gchar * name, gint * idx, gint * upstream)
+{
+  const gchar *str;
+  gchar *end = NULL;
+
+  if (!g_str_has_prefix (name, MLOPS_COMPOSITE_PREFIX))
+    return FALSE;
+
+  str = name + strlen (MLOPS_COMPOSITE_PREFIX);
+  if (!g_ascii_isdigit (*str))
+    return FALSE;
+
+  *idx = (gint) g_ascii_strtoll (str, &end, 10);
+  *upstream = -1;
+
+  if (*end == '_' && g_ascii_isdigit (end[1]))
+    *upstream = (gint) g_ascii_strtoll (end + 1, &end, 10);
+
+  return (*end == '\0');
+}
+
+/**
+ * @brief Link the pipelines in the pipeline of the composite service.
+ */
+int
+mlops_node_composite_attach (GstElement * pipeline)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  GHashTable *bins;
+  GList *linked = NULL, *l;
+  gboolean done = FALSE;
+  int result = 0;
+
+  g_return_val_if_fail (pipeline != NULL, -EINVAL);
+
+  if (!GST_IS_BIN (pipeline))
+    return 0;
+
+  /* The index of the pipeline to its bin. */
+  bins = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, gst_object_unref);
+
+  it = gst_bin_iterate_elements (GST_BIN (pipeline));
+  while (!done) {
+    switch (gst_iterator_next (it, &item)) {
+      case GST_ITERATOR_OK:
+      {
+        GstElement *element = GST_ELEMENT (g_value_get_object (&item));
+        gint idx, upstream;
+
+        if (GST_IS_BIN (element) &&
+            _mlops_composite_parse_bin_name (GST_ELEMENT_NAME (element), &idx, &upstream)) {
+          g_hash_table_insert (bins, GINT_TO_POINTER (idx), gst_object_ref (element));
+          if (upstream >= 0)
+            linked = g_list_prepend (linked, element);
+        }
+
+        g_value_reset (&item);
+        break;
+      }
+      case GST_ITERATOR_RESYNC:
+        g_hash_table_remove_all (bins);
+        g_list_free (linked);
+        linked = NULL;
+        gst_iterator_resync (it);
+        break;
+      default:
+        done = TRUE;
+        break;
+    }
+  }
+
+  g_value_unset (&item);
+  gst_iterator_free (it);
+
+  for (l = linked; l != NULL && result == 0; l = l->next) {
+    GstElement *downstream = GST_ELEMENT (l->data);
+    GstElement *upstream;
+    gint idx, up;
+
+    _mlops_composite_parse_bin_name (GST_ELEMENT_NAME (downstream), &idx, &up);
+    upstream = (GstElement *) g_hash_table_lookup (bins, GINT_TO_POINTER (up));
+    if (!upstream) {
+      ml_loge ("The upstream of the pipeline '%s' is not found in the composite service.",
+          GST_ELEMENT_NAME (downstream));
+      result = -EINVAL;
+      break;
+    }
+
+    result = _mlops_composite_link (upstream, downstream, idx);
+  }
+
+  /* The elements in the list are held by the table. */
+  g_list_free (linked);
+  g_hash_table_destroy (bins);
+  return result;
+}
+
+/**
+ * @brief Release the kept definitions of the composite services.
+ */
+void
+mlops_node_composite_finalize (void)
+{
+  G_LOCK (mlops_composite);
+  if (g_mlops_composite_table) {
+    g_hash_table_destroy (g_mlops_composite_table);
+    g_mlops_composite_table = NULL;
+  }
+  G_UNLOCK (mlops_composite);
+}
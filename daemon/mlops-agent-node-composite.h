@@ -0,0 +1,84 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-composite.h
+ * @date      18 October 2026
+ * @brief     Composite service chaining the stored pipelines in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The composite service is defined with the names of the stored pipelines and the links between them in JSON, e.g.,
+ *            '{"pipelines":["camera","detect","record"],"links":[{"from":"camera","to":"detect"},{"from":"camera","to":"record"}]}'.
+ *            The complete pipelines are launched in one pipeline and managed as one node. The source element of the downstream is replaced
+ *            with appsrc, which receives the caps and the buffers arriving at the sink element of the upstream.
+ *            GstBuffer is refcounted, appsrc takes the reference of the buffer and the data is not copied.
+ */
+
+#ifndef _MLOPS_AGENT_NODE_COMPOSITE_H_
+#define _MLOPS_AGENT_NODE_COMPOSITE_H_
+
+#include <glib.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Check the definition of the composite service.
+ * @details Each pipeline has one upstream at most, and the links should not make a cycle.
+ *          The stored pipelines are expanded with the default parameters and checked they can be linked:
+ *          the pipeline with upstream has one source element, the pipeline with downstreams has one sink element,
+ *          and the names of the elements do not collide. These are checked again when the service is launched.
+ * @return 0 on success, -EINVAL if the definition is invalid.
+ */
+int mlops_node_composite_validate (const gchar *definition);
+
+/**
+ * @brief Get the description to launch the composite service, the descriptions of the pipelines are expanded and linked.
+ * @details This accesses the database to get the definition and the descriptions of the pipelines.
+ * @param[in] params The parameters (string to string) to replace the placeholders of the pipelines, NULL to use the default values.
+ * @param[out] desc The description to launch the composite service.
+ * @param[out] models The activated models (mlops_node_model_s) referred by the pipelines, NULL if there is no model.
+ * @return 0 on success, -EINVAL if the definition is invalid or the pipeline cannot be linked, or the error to get the description.
+ */
+int mlops_node_composite_expand (const gchar *name, GHashTable *params, gchar **desc, GHashTable **models);
+
+/**
+ * @brief Check the composite service includes the pipeline.
+ * @details This does not access the database, the definition is kept when the composite service is launched.
+ * @return TRUE if the kept definition includes @a pipeline, FALSE otherwise.
+ */
+gboolean mlops_node_composite_has_pipeline (const gchar *name, const gchar *pipeline);
+
+/**
+ * @brief Read the activated models and the shared sources referred by the pipelines of the kept composite service.
+ * @details This accesses the database for the models and sources which are not read yet, see mlops_node_template_resolve().
+ * @return 0 on success, -ENOENT if the composite service is not launched, or the error to get the model or the source.
+ */
+int mlops_node_composite_resolve (const gchar *name);
+
+/**
+ * @brief Get the description of the composite service from the kept definition and the kept descriptions of the pipelines.
+ * @details This does not access the database, the models and sources should be read with mlops_node_composite_resolve() in advance.
+ * @return 0 on success, -ENOENT if the definition or the description is not kept, or -EINVAL if the pipeline cannot be linked.
+ */
+int mlops_node_composite_expand_kept (const gchar *name, GHashTable *params, gchar **desc, GHashTable **models);
+
+/**
+ * @brief Link the pipelines in the pipeline of the composite service.
+ * @details The source element of the downstream is replaced with appsrc, and the buffers arriving at the sink element of the upstream are pushed to it.
+ *          The buffer is dropped if the queue of appsrc is full. This does nothing if @a pipeline is not the composite service.
+ * @return 0 on success, -EINVAL if the pipelines cannot be linked, or -ESTRPIPE if failed to create appsrc.
+ */
+int mlops_node_composite_attach (GstElement *pipeline);
+
+/**
+ * @brief Release the kept definitions of the composite services.
+ */
+void mlops_node_composite_finalize (void);
+
+G_END_DECLS
+#endif /* _MLOPS_AGENT_NODE_COMPOSITE_H_ */
@@ -0,0 +1,99 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-config.c
+ * @date      18 October 2026
+ * @brief     Configuration of the pipeline in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The configuration is attached to the pipeline when it is built. The pipeline taken from the pool
+ *            gets the latest one again, but the model sharing is applied only to the pipelines built after the change.
+ */
+
+#include "mlops-agent-node-config.h"
+#include "service-db-util.h"
+
+/**
+ * @brief The name of the pipeline attribute to share the model instances of the filters with the other pipelines.
+ * @details If the value is "true", the filters loading the same model share one instance.
+ */
+#define MLOPS_CONFIG_SHARE_MODEL_ATTR "share_model"
+
+/**
+ * @brief The name of the pipeline attribute to collect the statistics of the elements with the pad probes.
+ * @details If the value is "false", the pad probes are not added and only the state and QoS of the pipeline are collected.
+ */
+#define MLOPS_CONFIG_STATS_ATTR "stats"
+
+/**
+ * @brief The key of the configuration attached to the pipeline.
+ */
+#define MLOPS_CONFIG_KEY "mlops-node-config"
+
+/**
+ * @brief The default configuration of the pipeline.
+ */
+static const mlops_node_config_s g_mlops_config_default = {
+  .share_model = FALSE,
+  .stats = TRUE,
+};
+
+/**
+ * @brief Get the configuration of the service from the database.
+ */
+void
+mlops_node_config_load (const gchar * name, mlops_node_config_s * config)
+{
+  g_autofree gchar *share_model = NULL;
+  g_autofree gchar *stats = NULL;
+
+  g_return_if_fail (config != NULL);
+
+  *config = g_mlops_config_default;
+  if (!name)
+    return;
+
+  svcdb_pipeline_get_attribute (name, MLOPS_CONFIG_SHARE_MODEL_ATTR, &share_model);
+  svcdb_pipeline_get_attribute (name, MLOPS_CONFIG_STATS_ATTR, &stats);
+
+  if (share_model)
+    config->share_model = (g_ascii_strcasecmp (share_model, "true") == 0);
+
+  if (stats)
+    config->stats = (g_ascii_strcasecmp (stats, "false") != 0);
+}
+
+/**
+ * @brief Attach the copy of the configuration to the pipeline.
+ */
+void
+mlops_node_config_attach (GstElement * pipeline, const mlops_node_config_s * config)
+{
+  mlops_node_config_s *copy;
+
+  g_return_if_fail (pipeline != NULL);
+  g_return_if_fail (config != NULL);
+
+  copy = g_new (mlops_node_config_s, 1);
+  *copy = *config;
+  g_object_set_data_full (G_OBJECT (pipeline), MLOPS_CONFIG_KEY, copy, g_free);
+}
+
+/**
+ * @brief Get the configuration attached to the pipeline.
+ */
+const mlops_node_config_s *
+mlops_node_config_get (GstElement * pipeline)
+{
+  const mlops_node_config_s *config = NULL;
+
+  if (pipeline)
+    config = (const mlops_node_config_s *) g_object_get_data (G_OBJECT (pipeline), MLOPS_CONFIG_KEY);
+
+  return config ? config : &g_mlops_config_default;
+}
@@ -0,0 +1,53 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-config.h
+ * @date      18 October 2026
+ * @brief     Configuration of the pipeline in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   This keeps the pipeline attributes which are not the scheduling attributes,
+ *            so the pool of the prerolled pipelines is not dropped when these are changed.
+ */
+
+#ifndef _MLOPS_AGENT_NODE_CONFIG_H_
+#define _MLOPS_AGENT_NODE_CONFIG_H_
+
+#include <glib.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Structure for the configuration of the pipeline.
+ */
+typedef struct
+{
+  gboolean share_model; /**< The filters share the model instances with the other pipelines, 'share_model' */
+  gboolean stats;       /**< The pad probes collecting the statistics are added, 'stats' */
+} mlops_node_config_s;
+
+/**
+ * @brief Get the configuration of the service from the database.
+ * @details The default value is set if the service does not have the attribute.
+ */
+void mlops_node_config_load (const gchar *name, mlops_node_config_s *config);
+
+/**
+ * @brief Attach the copy of the configuration to the pipeline.
+ */
+void mlops_node_config_attach (GstElement *pipeline, const mlops_node_config_s *config);
+
+/**
+ * @brief Get the configuration attached to the pipeline.
+ * @return The default configuration if nothing is attached.
+ */
+const mlops_node_config_s *mlops_node_config_get (GstElement *pipeline);
+
+G_END_DECLS
+#endif /* _MLOPS_AGENT_NODE_CONFIG_H_ */
@@ -0,0 +1,781 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-profile.c
+ * @date      18 October 2026
+ * @brief     Benchmark mode of the pipeline in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   This runs the stored pipeline for the given number of buffers and reports the performance.
+ *            The end-to-end latency is measured by matching the timestamp of the buffer from the sources to the sinks.
+ *            CPU time is measured for the streaming threads of the pipeline, and the resident memory of the process
+ *            is sampled while the pipeline runs to get its peak.
+ */
+
+#include <errno.h>
+#include <gst/gst.h>
+#include <json-glib/json-glib.h>
+#include <string.h>
+
+#include "log.h"
+#include "mlops-agent-node-admission.h"
+#include "mlops-agent-node-profile.h"
+#include "mlops-agent-node-sched.h"
+#include "mlops-agent-node-source.h"
+#include "mlops-agent-node-stats.h"
+#include "mlops-agent-node-taskpool.h"
+#include "mlops-agent-node-template.h"
+#include "service-db-util.h"
+
+/**
+ * @brief The default and maximum time (in milliseconds) to run the pipeline in the benchmark mode.
+ */
+#define MLOPS_PROFILE_DEFAULT_TIMEOUT_MS (10000)
+#define MLOPS_PROFILE_MAX_TIMEOUT_MS (20000)
+
+/**
+ * @brief The maximum number of the buffers from the sources waiting to be matched in the sinks.
+ */
+#define MLOPS_PROFILE_MAX_PENDING (4096)
+
+/**
+ * @brief The interval (in milliseconds) to sample the resident memory while the pipeline runs.
+ */
+#define MLOPS_PROFILE_SAMPLE_INTERVAL_MS (20)
+
+/**
+ * @brief Structure for the benchmark of the pipeline.
+ */
+typedef struct
+{
+  GMutex lock;
+  GCond cond;
+  guint num_buffers;    /**< The number of buffers to be received in the sinks */
+  guint buffers;        /**< The number of buffers received in the sinks */
+  gint64 first_time;
+  gint64 last_time;
+  GHashTable *pending;  /**< The time when the buffer is pushed from the source, with the timestamp as the key */
+  GArray *latencies;    /**< The end-to-end latency (in microseconds) of the buffers */
+  gboolean done;
+  gint result;
+  const mlops_node_sched_s *sched;      /**< The scheduling attributes of the service */
+  gint64 cpu_time;      /**< The CPU time (in nanoseconds) of the streaming threads which left the task */
+} mlops_profile_s;
+
+/**
+ * @brief Structure for the task to run the benchmark in the worker.
+ */
+typedef struct
+{
+  gchar *name;
+  guint num_buffers;
+  gchar *options;
+  gint64 deadline;      /**< The monotonic time when the caller gives up, 0 if there is no deadline */
+  mlops_node_profile_cb cb;
+  void *user_data;
+  gint result;
+  gchar *report;
+} mlops_profile_task_s;
+
+static GThreadPool *g_mlops_profile_workers = NULL;
+static gint g_mlops_profile_closing = 0;
+G_LOCK_DEFINE_STATIC (mlops_profile);
+
+/**
+ * @brief Internal function to finish the benchmark. Should be called with the lock.
+ */
+static void
+_mlops_profile_finish_locked (mlops_profile_s * profile, gint result)
+{
+  if (!profile->done) {
+    profile->done = TRUE;
+    profile->result = result;
+    g_cond_broadcast (&profile->cond);
+  }
+}
+
+/**
+ * @brief Pad probe to record the time when the buffer is pushed from the source.
+ */
+static GstPadProbeReturn
+_mlops_profile_src_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  mlops_profile_s *profile = (mlops_profile_s *) user_data;
+  GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+  GstClockTime pts = GST_BUFFER_PTS (buffer);
+
+  if (!GST_CLOCK_TIME_IS_VALID (pts))
+    return GST_PAD_PROBE_OK;
+
+  g_mutex_lock (&profile->lock);
+  if (g_hash_table_size (profile->pending) < MLOPS_PROFILE_MAX_PENDING) {
+    gint64 *key = g_new (gint64, 1);
+    gint64 *now = g_new (gint64, 1);
+
+    *key = (gint64) pts;
+    *now = g_get_monotonic_time ();
+    g_hash_table_insert (profile->pending, key, now);
+  }
+  g_mutex_unlock (&profile->lock);
+
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Pad probe to count the buffers received in the sink and measure the end-to-end latency.
+ */
+static GstPadProbeReturn
+_mlops_profile_sink_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  mlops_profile_s *profile = (mlops_profile_s *) user_data;
+  GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+  GstClockTime pts = GST_BUFFER_PTS (buffer);
+  gint64 now = g_get_monotonic_time ();
+  gint64 key = (gint64) pts;
+  gint64 *pushed;
+
+  g_mutex_lock (&profile->lock);
+  if (profile->done)
+    goto done;
+
+  if (profile->buffers == 0)
+    profile->first_time = now;
+  profile->last_time = now;
+  profile->buffers++;
+
+  if (GST_CLOCK_TIME_IS_VALID (pts)) {
+    pushed = (gint64 *) g_hash_table_lookup (profile->pending, &key);
+    if (pushed) {
+      gint64 latency = now - *pushed;
+
+      g_array_append_val (profile->latencies, latency);
+      g_hash_table_remove (profile->pending, &key);
+    }
+  }
+
+  if (profile->buffers >= profile->num_buffers)
+    _mlops_profile_finish_locked (profile, 0);
+
+done:
+  g_mutex_unlock (&profile->lock);
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Internal function to add the CPU time of the streaming thread leaving the task.
+ * @details The streaming threads are shared with the other pipelines, the time is measured between entering and leaving the task.
+ */
+static void
+_mlops_profile_handle_thread_status (mlops_profile_s * profile, GstMessage * msg)
+{
+  GstStreamStatusType type;
+  GstElement *owner = NULL;
+  gint64 cpu_time;
+
+  gst_message_parse_stream_status (msg, &type, &owner);
+
+  switch (type) {
+    case GST_STREAM_STATUS_TYPE_ENTER:
+      mlops_node_admission_thread_enter ();
+      break;
+    case GST_STREAM_STATUS_TYPE_LEAVE:
+      cpu_time = mlops_node_admission_thread_leave ();
+
+      g_mutex_lock (&profile->lock);
+      profile->cpu_time += cpu_time;
+      g_mutex_unlock (&profile->lock);
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Internal function to handle the bus messages of the pipeline in the benchmark mode.
+ */
+static GstBusSyncReply
+_mlops_profile_bus_sync_handler (GstBus * bus, GstMessage * msg, gpointer user_data)
+{
+  mlops_profile_s *profile = (mlops_profile_s *) user_data;
+  GError *err = NULL;
+
+  switch (GST_MESSAGE_TYPE (msg)) {
+    case GST_MESSAGE_ERROR:
+      gst_message_parse_error (msg, &err, NULL);
+      ml_loge ("The pipeline in the benchmark mode posted an error: %s",
+          err ? err->message : "unknown reason");
+      g_clear_error (&err);
+
+      g_mutex_lock (&profile->lock);
+      _mlops_profile_finish_locked (profile, -ESTRPIPE);
+      g_mutex_unlock (&profile->lock);
+      break;
+    case GST_MESSAGE_EOS:
+      /* The sources are finished before the sinks receive the given number of buffers. */
+      g_mutex_lock (&profile->lock);
+      _mlops_profile_finish_locked (profile, 0);
+      g_mutex_unlock (&profile->lock);
+      break;
+    case GST_MESSAGE_STREAM_STATUS:
+      mlops_node_task_pool_handle_message (msg);
+      mlops_node_sched_handle_message (profile->sched, msg);
+      _mlops_profile_handle_thread_status (profile, msg);
+      break;
+    default:
+      break;
+  }
+
+  return GST_BUS_DROP;
+}
+
+/**
+ * @brief Internal function to get the sink elements in the pipeline.
+ */
+static GList *
+_mlops_profile_get_sinks (GstElement * pipeline)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  GList *sinks = NULL;
+  gboolean done = FALSE;
+
+  if (!GST_IS_BIN (pipeline))
+    return NULL;
+
+  it = gst_bin_iterate_sinks (GST_BIN (pipeline));
+  while (!done) {
+    switch (gst_iterator_next (it, &item)) {
+      case GST_ITERATOR_OK:
+        sinks = g_list_prepend (sinks, g_value_dup_object (&item));
+        g_value_reset (&item);
+        break;
+      case GST_ITERATOR_RESYNC:
+        g_list_free_full (sinks, gst_object_unref);
+        sinks = NULL;
+        gst_iterator_resync (it);
+        break;
+      default:
+        done = TRUE;
+        break;
+    }
+  }
+
+  g_value_unset (&item);
+  gst_iterator_free (it);
+  return sinks;
+}
+
+/**
+ * @brief Internal function to replace the sink with fakesink (sync=false).
+ */
+static int
+_mlops_profile_replace_sink (GstElement * sink)
+{
+  GstElementFactory *factory = gst_element_get_factory (sink);
+  GstObject *parent = NULL;
+  GstElement *fake = NULL;
+  GstPad *pad = NULL, *peer = NULL, *fake_pad = NULL;
+  gint ret = -ESTRPIPE;
+
+  if (factory && g_str_equal (GST_OBJECT_NAME (factory), "fakesink")) {
+    g_object_set (sink, "sync", FALSE, NULL);
+    return 0;
+  }
+
+  pad = gst_element_get_static_pad (sink, "sink");
+  peer = pad ? gst_pad_get_peer (pad) : NULL;
+  parent = gst_object_get_parent (GST_OBJECT (sink));
+  if (!peer || !parent || !GST_IS_BIN (parent)) {
+    ml_logw ("Cannot replace the sink '%s', keep it in the benchmark mode.", GST_ELEMENT_NAME (sink));
+    ret = 0;
+    goto done;
+  }
+
+  fake = gst_element_factory_make ("fakesink", NULL);
+  if (!fake) {
+    ml_loge ("Failed to create fakesink to replace the sink '%s'.", GST_ELEMENT_NAME (sink));
+    goto done;
+  }
+
+  g_object_set (fake, "sync", FALSE, NULL);
+
+  gst_pad_unlink (peer, pad);
+  gst_bin_remove (GST_BIN (parent), sink);
+  gst_bin_add (GST_BIN (parent), fake);
+
+  fake_pad = gst_element_get_static_pad (fake, "sink");
+  if (gst_pad_link (peer, fake_pad) != GST_PAD_LINK_OK) {
+    ml_loge ("Failed to link fakesink replacing the sink '%s'.", GST_ELEMENT_NAME (sink));
+    goto done;
+  }
+
+  ret = 0;
+
+done:
+  if (fake_pad)
+    gst_object_unref (fake_pad);
+  if (parent)
+    gst_object_unref (parent);
+  if (peer)
+    gst_object_unref (peer);
+  if (pad)
+    gst_object_unref (pad);
+  return ret;
+}
+
+/**
+ * @brief Internal function to add the pad probes to the source and sink elements.
+ */
+static void
+_mlops_profile_add_probes (GstElement * pipeline, mlops_profile_s * profile)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  gboolean done = FALSE;
+  GList *elements = NULL, *l;
+
+  if (GST_IS_BIN (pipeline)) {
+    it = gst_bin_iterate_recurse (GST_BIN (pipeline));
+    while (!done) {
+      switch (gst_iterator_next (it, &item)) {
+        case GST_ITERATOR_OK:
+          elements = g_list_prepend (elements, g_value_dup_object (&item));
+          g_value_reset (&item);
+          break;
+        case GST_ITERATOR_RESYNC:
+          g_list_free_full (elements, gst_object_unref);
+          elements = NULL;
+          gst_iterator_resync (it);
+          break;
+        default:
+          done = TRUE;
+          break;
+      }
+    }
+
+    g_value_unset (&item);
+    gst_iterator_free (it);
+  } else {
+    elements = g_list_prepend (elements, gst_object_ref (pipeline));
+  }
+
+  for (l = elements; l != NULL; l = l->next) {
+    GstElement *element = GST_ELEMENT (l->data);
+    GstPad *pad = NULL;
+
+    if (GST_IS_BIN (element))
+      continue;
+
+    if (GST_OBJECT_FLAG_IS_SET (element, GST_ELEMENT_FLAG_SOURCE)) {
+      pad = gst_element_get_static_pad (element, "src");
+      if (pad)
+        gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER, _mlops_profile_src_probe, profile, NULL);
+    } else if (GST_OBJECT_FLAG_IS_SET (element, GST_ELEMENT_FLAG_SINK)) {
+      pad = gst_element_get_static_pad (element, "sink");
+      if (pad)
+        gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER, _mlops_profile_sink_probe, profile, NULL);
+    }
+
+    if (pad)
+      gst_object_unref (pad);
+  }
+
+  g_list_free_full (elements, gst_object_unref);
+}
+
+/**
+ * @brief Internal function to parse the options of the benchmark.
+ */
+static int
+_mlops_profile_parse_options (const gchar * options, gboolean * replace_sinks, gint64 * timeout_ms)
+{
+  JsonNode *root;
+  JsonObject *object;
+
+  *replace_sinks = TRUE;
+  *timeout_ms = MLOPS_PROFILE_DEFAULT_TIMEOUT_MS;
+
+  if (!options || options[0] == '\0')
+    return 0;
+
+  root = json_from_string (options, NULL);
+  if (!root || !JSON_NODE_HOLDS_OBJECT (root)) {
+    ml_loge ("The options of the benchmark should be a JSON object, '%s'.", options);
+    if (root)
+      json_node_unref (root);
+    return -EINVAL;
+  }
+
+  object = json_node_get_object (root);
+  if (json_object_has_member (object, "replace_sinks"))
+    *replace_sinks = json_object_get_boolean_member (object, "replace_sinks");
+  if (json_object_has_member (object, "timeout_ms"))
+    *timeout_ms = json_object_get_int_member (object, "timeout_ms");
+
+  json_node_unref (root);
+
+  if (*timeout_ms <= 0 || *timeout_ms > MLOPS_PROFILE_MAX_TIMEOUT_MS) {
+    ml_loge ("Invalid timeout of the benchmark, %" G_GINT64_FORMAT " ms.", *timeout_ms);
+    return -EINVAL;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to compare the latency to sort.
+ */
+static gint
+_mlops_profile_compare_latency (gconstpointer a, gconstpointer b)
+{
+  gint64 la = *((const gint64 *) a);
+  gint64 lb = *((const gint64 *) b);
+
+  return (la > lb) - (la < lb);
+}
+
+/**
+ * @brief Internal function to build the report of the benchmark in JSON string.
+ */
+static gchar *
+_mlops_profile_build_report (const gchar * name, mlops_profile_s * profile,
+    mlops_node_stats_s * stats, gint64 duration, gint64 cpu_time, gint64 rss_delta)
+{
+  JsonBuilder *builder;
+  JsonNode *root;
+  gchar *report;
+  gint64 span = profile->last_time - profile->first_time;
+  guint count = profile->latencies->len;
+
+  g_array_sort (profile->latencies, _mlops_profile_compare_latency);
+
+  builder = json_builder_new ();
+  json_builder_begin_object (builder);
+
+  json_builder_set_member_name (builder, "service_name");
+  json_builder_add_string_value (builder, name);
+  json_builder_set_member_name (builder, "num_buffers");
+  json_builder_add_int_value (builder, profile->num_buffers);
+  json_builder_set_member_name (builder, "buffers");
+  json_builder_add_int_value (builder, profile->buffers);
+  json_builder_set_member_name (builder, "completed");
+  json_builder_add_boolean_value (builder, profile->buffers >= profile->num_buffers);
+  json_builder_set_member_name (builder, "duration_ms");
+  json_builder_add_int_value (builder, duration / G_TIME_SPAN_MILLISECOND);
+
+  /* The throughput is measured from the first buffer in the sinks, excluding the preroll. */
+  json_builder_set_member_name (builder, "buffers_per_sec");
+  json_builder_add_double_value (builder, (span > 0 && profile->buffers > 1) ?
+      ((gdouble) (profile->buffers - 1) * G_USEC_PER_SEC / (gdouble) span) : 0.0);
+
+  json_builder_set_member_name (builder, "latency_us");
+  json_builder_begin_object (builder);
+  json_builder_set_member_name (builder, "count");
+  json_builder_add_int_value (builder, count);
+  if (count > 0) {
+    json_builder_set_member_name (builder, "min");
+    json_builder_add_int_value (builder, g_array_index (profile->latencies, gint64, 0));
+    json_builder_set_member_name (builder, "p50");
+    json_builder_add_int_value (builder,
+        g_array_index (profile->latencies, gint64, (count - 1) * 50 / 100));
+    json_builder_set_member_name (builder, "p90");
+    json_builder_add_int_value (builder,
+        g_array_index (profile->latencies, gint64, (count - 1) * 90 / 100));
+    json_builder_set_member_name (builder, "p99");
+    json_builder_add_int_value (builder,
+        g_array_index (profile->latencies, gint64, (count - 1) * 99 / 100));
+    json_builder_set_member_name (builder, "max");
+    json_builder_add_int_value (builder, g_array_index (profile->latencies, gint64, count - 1));
+  }
+  json_builder_end_object (builder);
+
+  json_builder_set_member_name (builder, "cpu_time_ms");
+  json_builder_add_int_value (builder, cpu_time / G_TIME_SPAN_MILLISECOND);
+  json_builder_set_member_name (builder, "peak_rss_delta_kb");
+  json_builder_add_int_value (builder, rss_delta);
+
+  if (stats) {
+    json_builder_set_member_name (builder, "pipeline");
+    json_builder_begin_object (builder);
+    mlops_node_stats_build (stats, builder);
+    json_builder_end_object (builder);
+  }
+
+  json_builder_end_object (builder);
+
+  root = json_builder_get_root (builder);
+  report = json_to_string (root, FALSE);
+
+  json_node_unref (root);
+  g_object_unref (builder);
+  return report;
+}
+
+/**
+ * @brief Run the pipeline of the service in the benchmark mode, and get the report in JSON string.
+ */
+int
+mlops_node_profile (const gchar * name, const guint num_buffers, const gchar * options,
+    gchar ** report)
+{
+  mlops_profile_s profile;
+  mlops_node_stats_s *stats = NULL;
+  mlops_node_sched_s *sched = NULL;
+  GstElement *pipeline = NULL;
+  GstBus *bus;
+  GList *sinks, *l;
+  GError *err = NULL;
+  g_autofree gchar *stored = NULL;
+  gchar *desc = NULL;
+  gboolean replace_sinks;
+  gint64 timeout_ms, start, end_time;
+  gint64 rss_before, rss_peak;
+  gint result;
+
+  g_return_val_if_fail (name != NULL, -EINVAL);
+  g_return_val_if_fail (num_buffers > 0, -EINVAL);
+  g_return_val_if_fail (report != NULL, -EINVAL);
+
+  result = _mlops_profile_parse_options (options, &replace_sinks, &timeout_ms);
+  if (result != 0)
+    return result;
+
+  /* The benchmark runs with the default values of the parameters. */
+  result = svcdb_pipeline_get (name, &stored);
+  if (result == 0)
+    result = mlops_node_template_expand (name, stored, NULL, &desc, NULL);
+
+  if (result != 0) {
+    ml_loge ("Failed to get the pipeline of '%s' for the benchmark.", name);
+    return result;
+  }
+
+  memset (&profile, 0, sizeof (profile));
+  g_mutex_init (&profile.lock);
+  g_cond_init (&profile.cond);
+  profile.num_buffers = num_buffers;
+
+  /* The benchmark runs with the scheduling attributes of the service. */
+  sched = mlops_node_sched_new (name);
+  profile.sched = sched;
+  profile.pending = g_hash_table_new_full (g_int64_hash, g_int64_equal, g_free, g_free);
+  profile.latencies = g_array_new (FALSE, FALSE, sizeof (gint64));
+
+  /* The lifetime peak of the process (VmHWM) hides the memory of the pipeline, sample the resident memory instead. */
+  rss_before = rss_peak = mlops_node_admission_get_rss ();
+
+  pipeline = gst_parse_launch (desc, &err);
+  if (!pipeline || err) {
+    ml_loge ("Failed to launch pipeline '%s' for the benchmark (error msg: %s).",
+        desc, (err) ? err->message : "unknown reason");
+    g_clear_error (&err);
+    result = -ESTRPIPE;
+    goto done;
+  }
+
+  if (replace_sinks) {
+    sinks = _mlops_profile_get_sinks (pipeline);
+    for (l = sinks; l != NULL && result == 0; l = l->next)
+      result = _mlops_profile_replace_sink (GST_ELEMENT (l->data));
+    g_list_free_full (sinks, gst_object_unref);
+
+    if (result != 0)
+      goto done;
+  }
+
+  /* The benchmark receives the data from the shared source if the service refers it. */
+  result = mlops_node_source_attach (pipeline);
+  if (result != 0)
+    goto done;
+
+  _mlops_profile_add_probes (pipeline, &profile);
+  stats = mlops_node_stats_new (pipeline, TRUE);
+
+  bus = gst_element_get_bus (pipeline);
+  gst_bus_set_sync_handler (bus, _mlops_profile_bus_sync_handler, &profile, NULL);
+  gst_object_unref (bus);
+
+  start = g_get_monotonic_time ();
+  end_time = start + timeout_ms * G_TIME_SPAN_MILLISECOND;
+
+  if (gst_element_set_state (pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+    ml_loge ("Failed to start the pipeline of '%s' for the benchmark.", name);
+    result = -ESTRPIPE;
+    goto done;
+  }
+  if (stats)
+    mlops_node_stats_set_state (stats, GST_STATE_PLAYING);
+
+  /* The models are loaded while the pipeline is prerolled. */
+  rss_peak = MAX (rss_peak, mlops_node_admission_get_rss ());
+
+  g_mutex_lock (&profile.lock);
+  while (!profile.done) {
+    gint64 wake = MIN (end_time,
+        g_get_monotonic_time () + MLOPS_PROFILE_SAMPLE_INTERVAL_MS * G_TIME_SPAN_MILLISECOND);
+
+    if (!g_cond_wait_until (&profile.cond, &profile.lock, wake) && wake >= end_time) {
+      ml_logw ("The benchmark of '%s' is timed out, %u of %u buffers are received.",
+          name, profile.buffers, num_buffers);
+      _mlops_profile_finish_locked (&profile, 0);
+    }
+
+    /* Do not block the streaming threads while reading the memory. */
+    g_mutex_unlock (&profile.lock);
+    rss_peak = MAX (rss_peak, mlops_node_admission_get_rss ());
+    g_mutex_lock (&profile.lock);
+  }
+  result = profile.result;
+  g_mutex_unlock (&profile.lock);
+
+  /* The streaming threads leave the task when the pipeline is stopped. */
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  if (stats)
+    mlops_node_stats_set_state (stats, GST_STATE_NULL);
+
+  if (result == 0) {
+    g_mutex_lock (&profile.lock);
+    *report = _mlops_profile_build_report (name, &profile, stats,
+        g_get_monotonic_time () - start, profile.cpu_time / 1000, rss_peak - rss_before);
+    g_mutex_unlock (&profile.lock);
+  }
+
+done:
+  if (pipeline) {
+    gst_element_set_state (pipeline, GST_STATE_NULL);
+    bus = gst_element_get_bus (pipeline);
+    gst_bus_set_sync_handler (bus, NULL, NULL, NULL);
+    gst_object_unref (bus);
+    gst_object_unref (pipeline);
+  }
+
+  mlops_node_stats_unref (stats);
+  g_hash_table_destroy (profile.pending);
+  g_array_free (profile.latencies, TRUE);
+  g_cond_clear (&profile.cond);
+  g_mutex_clear (&profile.lock);
+  mlops_node_sched_free (sched);
+  g_free (desc);
+  return result;
+}
+
+/**
+ * @brief Internal function to release the task of the benchmark.
+ */
+static void
+_mlops_profile_task_free (gpointer data)
+{
+  mlops_profile_task_s *task = (mlops_profile_task_s *) data;
+
+  g_free (task->name);
+  g_free (task->options);
+  g_free (task->report);
+  g_free (task);
+}
+
+/**
+ * @brief Internal function to notify the result of the benchmark in the main context.
+ */
+static gboolean
+_mlops_profile_notify (gpointer data)
+{
+  mlops_profile_task_s *task = (mlops_profile_task_s *) data;
+
+  task->cb (task->result, task->report, task->user_data);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Worker to run the benchmark.
+ */
+static void
+_mlops_profile_worker (gpointer data, gpointer user_data)
+{
+  mlops_profile_task_s *task = (mlops_profile_task_s *) data;
+
+  /* Skip the queued tasks when finalizing. */
+  if (g_atomic_int_get (&g_mlops_profile_closing)) {
+    _mlops_profile_task_free (task);
+    return;
+  }
+
+  /* The benchmark takes long, do not start it if the caller has already given up while queued. */
+  if (task->deadline > 0 && g_get_monotonic_time () >= task->deadline) {
+    ml_logw ("The caller has already given up, drop the benchmark of '%s'.", task->name);
+    task->result = -ETIMEDOUT;
+  } else {
+    task->result = mlops_node_profile (task->name, task->num_buffers, task->options, &task->report);
+  }
+
+  g_idle_add_full (G_PRIORITY_DEFAULT, _mlops_profile_notify, task, _mlops_profile_task_free);
+}
+
+/**
+ * @brief Run the pipeline of the service in the benchmark mode in the worker.
+ */
+int
+mlops_node_profile_async (const gchar * name, const guint num_buffers, const gchar * options,
+    const gint64 deadline, mlops_node_profile_cb cb, void *user_data)
+{
+  mlops_profile_task_s *task;
+  gboolean replace_sinks;
+  gint64 timeout_ms;
+  gint result;
+
+  g_return_val_if_fail (name != NULL, -EINVAL);
+  g_return_val_if_fail (num_buffers > 0, -EINVAL);
+  g_return_val_if_fail (cb != NULL, -EINVAL);
+
+  /* Check the options before queueing the request. */
+  result = _mlops_profile_parse_options (options, &replace_sinks, &timeout_ms);
+  if (result != 0)
+    return result;
+
+  G_LOCK (mlops_profile);
+  if (!g_mlops_profile_workers) {
+    g_mlops_profile_workers = g_thread_pool_new (_mlops_profile_worker, NULL, 1, FALSE, NULL);
+    if (!g_mlops_profile_workers) {
+      G_UNLOCK (mlops_profile);
+      ml_loge ("Failed to create the thread pool to run the benchmark.");
+      return -EIO;
+    }
+  }
+
+  task = g_new0 (mlops_profile_task_s, 1);
+  task->name = g_strdup (name);
+  task->num_buffers = num_buffers;
+  task->options = g_strdup (options);
+  task->deadline = deadline;
+  task->cb = cb;
+  task->user_data = user_data;
+
+  g_thread_pool_push (g_mlops_profile_workers, task, NULL);
+  G_UNLOCK (mlops_profile);
+
+  return 0;
+}
+
+/**
+ * @brief Wait for the running benchmark and skip the queued requests.
+ */
+void
+mlops_node_profile_finalize (void)
+{
+  GThreadPool *workers;
+
+  G_LOCK (mlops_profile);
+  workers = g_mlops_profile_workers;
+  g_mlops_profile_workers = NULL;
+  G_UNLOCK (mlops_profile);
+
+  if (workers) {
+    g_atomic_int_set (&g_mlops_profile_closing, 1);
+    g_thread_pool_free (workers, FALSE, TRUE);
+    g_atomic_int_set (&g_mlops_profile_closing, 0);
+  }
+}
@@ -0,0 +1,51 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-profile.h
+ * @date      18 October 2026
+ * @brief     Benchmark mode of the pipeline in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   This runs the stored pipeline for the given number of buffers and reports the performance.
+ */
+
+#ifndef _MLOPS_AGENT_NODE_PROFILE_H_
+#define _MLOPS_AGENT_NODE_PROFILE_H_
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Callback to notify the result of the benchmark. This is called in the main context.
+ */
+typedef void (*mlops_node_profile_cb) (const int result, const gchar *report, void *user_data);
+
+/**
+ * @brief Run the pipeline of the service in the benchmark mode, and get the report in JSON string.
+ * @details The pipeline is not added to the node table, and runs until the sinks receive @a num_buffers buffers.
+ *          The options are a JSON object, 'replace_sinks' (default true) replaces the sinks with fakesink (sync=false),
+ *          and 'timeout_ms' (default 10000, max 20000) is the maximum time to run the pipeline.
+ *          This blocks the caller until the benchmark is done.
+ */
+int mlops_node_profile (const gchar *name, const guint num_buffers, const gchar *options, gchar **report);
+
+/**
+ * @brief Run the pipeline of the service in the benchmark mode in the worker.
+ * @details The benchmarks are done one by one, so the result is not affected by the other benchmark.
+ *          If @a deadline (monotonic time in microseconds) is expired before the benchmark starts, the result is -ETIMEDOUT.
+ */
+int mlops_node_profile_async (const gchar *name, const guint num_buffers, const gchar *options, const gint64 deadline, mlops_node_profile_cb cb, void *user_data);
+
+/**
+ * @brief Wait for the running benchmark and skip the queued requests.
+ */
+void mlops_node_profile_finalize (void);
+
+G_END_DECLS
+#endif /* _MLOPS_AGENT_NODE_PROFILE_H_ */
@@ -0,0 +1,416 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-sched.c
+ * @date      18 October 2026
+ * @brief     Scheduling attributes of the pipeline in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The attributes are applied when the streaming thread enters the task, and restored when it leaves,
+ *            because the threads of the shared task pool are reused by the other pipelines.
+ *            The nice value higher than the process is applied only if the thread can lower it again.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "mlops-agent-node-sched.h"
+#include "service-db-util.h"
+
+/**
+ * @brief The names of the pipeline attributes for the scheduling.
+ * @details 'cpu_set' is the list of the CPUs (e.g., "0-1,4"), 'nice' is the nice value (-20 ~ 19),
+ *          'sched_policy' is one of "fifo", "rr" and "other", and 'sched_priority' is the real-time priority.
+ */
+#define MLOPS_SCHED_CPU_SET_ATTR "cpu_set"
+#define MLOPS_SCHED_NICE_ATTR "nice"
+#define MLOPS_SCHED_POLICY_ATTR "sched_policy"
+#define MLOPS_SCHED_PRIORITY_ATTR "sched_priority"
+
+/**
+ * @brief The key of the scheduling attributes attached to the pipeline.
+ */
+#define MLOPS_SCHED_KEY "mlops-node-sched"
+
+/**
+ * @brief The capability to lower the nice value (see linux/capability.h).
+ */
+#define MLOPS_SCHED_CAP_SYS_NICE (23)
+
+/**
+ * @brief Structure for the scheduling attributes of the service.
+ */
+struct _mlops_node_sched_s
+{
+  gboolean has_cpu_set;
+  cpu_set_t cpu_set;
+  gboolean has_nice;
+  gint nice;
+  gint policy;          /**< SCHED_OTHER if the real-time policy is not set */
+  gint priority;
+};
+
+/**
+ * @brief The scheduling attributes of the process, restored when the streaming thread leaves the task.
+ */
+typedef struct
+{
+  gboolean has_cpu_set;
+  cpu_set_t cpu_set;
+  gint nice;
+  gboolean can_restore_nice;    /**< The thread can lower the nice value to the value of the process again */
+} mlops_sched_default_s;
+
+static mlops_sched_default_s g_mlops_sched_default;
+static gint g_mlops_sched_denied = 0;
+
+/**
+ * @brief Internal function to check the process has the capability to lower the nice value.
+ */
+static gboolean
+_mlops_sched_has_cap_sys_nice (void)
+{
+  FILE *fp;
+  gchar line[256];
+  guint64 caps = 0;
+  gboolean found = FALSE;
+
+  fp = fopen ("/proc/self/status", "r");
+  if (!fp)
+    return FALSE;
+
+  while (!found && fgets (line, sizeof (line), fp)) {
+    if (g_str_has_prefix (line, "CapEff:")) {
+      caps = g_ascii_strtoull (line + strlen ("CapEff:"), NULL, 16);
+      found = TRUE;
+    }
+  }
+  fclose (fp);
+
+  return (caps & (G_GUINT64_CONSTANT (1) << MLOPS_SCHED_CAP_SYS_NICE)) != 0;
+}
+
+/**
+ * @brief Internal function to get the scheduling attributes of the main thread once in the process.
+ */
+static gpointer
+_mlops_sched_init_default (gpointer data)
+{
+  mlops_sched_default_s *def = &g_mlops_sched_default;
+  struct rlimit limit;
+
+  memset (def, 0, sizeof (mlops_sched_default_s));
+
+  /* The id of the main thread is same as the process id. */
+  def->has_cpu_set = (sched_getaffinity (getpid (), sizeof (cpu_set_t), &def->cpu_set) == 0);
+
+  errno = 0;
+  def->nice = getpriority (PRIO_PROCESS, getpid ());
+  if (errno != 0)
+    def->nice = 0;
+
+  /* The thread can lower the nice value down to (20 - RLIMIT_NICE) without the capability. */
+  def->can_restore_nice = _mlops_sched_has_cap_sys_nice ();
+  if (!def->can_restore_nice && getrlimit (RLIMIT_NICE, &limit) == 0) {
+    def->can_restore_nice = (limit.rlim_cur == RLIM_INFINITY ||
+        (rlim_t) (20 - def->nice) <= limit.rlim_cur);
+  }
+
+  return def;
+}
+
+/**
+ * @brief Internal function to get the scheduling attributes of the process.
+ */
+static const mlops_sched_default_s *
+_mlops_sched_get_default (void)
+{
+  static GOnce once = G_ONCE_INIT;
+
+  return (const mlops_sched_default_s *) g_once (&once, _mlops_sched_init_default, NULL);
+}
+
+/**
+ * @brief Internal function to parse the list of the CPUs, e.g., "0-1,4".
+ */
+static gboolean
+_mlops_sched_parse_cpu_set (const gchar * value, cpu_set_t * set)
+{
+  gchar **ranges;
+  gboolean valid = TRUE;
+  guint i;
+
+  CPU_ZERO (set);
+
+  ranges = g_strsplit (value, ",", -1);
+  for (i = 0; valid && ranges[i] != NULL; i++) {
+    gchar *range = g_strstrip (ranges[i]);
+    gchar *end = NULL;
+    guint64 first, last;
+
+    first = last = g_ascii_strtoull (range, &end, 10);
+    if (end == range) {
+      valid = FALSE;
+      break;
+    }
+
+    if (*end == '-') {
+      range = end + 1;
+      last = g_ascii_strtoull (range, &end, 10);
+      if (end == range)
+        valid = FALSE;
+    }
+
+    if (!valid || *end != '\0' || first > last || last >= CPU_SETSIZE) {
+      valid = FALSE;
+      break;
+    }
+
+    for (; first <= last; first++)
+      CPU_SET ((int) first, set);
+  }
+  g_strfreev (ranges);
+
+  return valid && CPU_COUNT (set) > 0;
+}
+
+/**
+ * @brief Internal function to parse the integer attribute.
+ */
+static gboolean
+_mlops_sched_parse_int (const gchar * value, gint64 min, gint64 max, gint * result)
+{
+  gchar *end = NULL;
+  gint64 parsed;
+
+  parsed = g_ascii_strtoll (value, &end, 10);
+  if (end == value || *end != '\0' || parsed < min || parsed > max)
+    return FALSE;
+
+  *result = (gint) parsed;
+  return TRUE;
+}
+
+/**
+ * @brief Get the scheduling attributes of the service from the database.
+ */
+mlops_node_sched_s *
+mlops_node_sched_new (const gchar * name)
+{
+  g_autofree gchar *cpu_set = NULL;
+  g_autofree gchar *nice_value = NULL;
+  g_autofree gchar *policy = NULL;
+  g_autofree gchar *priority = NULL;
+  mlops_node_sched_s *sched;
+
+  g_return_val_if_fail (name != NULL, NULL);
+
+  svcdb_pipeline_get_attribute (name, MLOPS_SCHED_CPU_SET_ATTR, &cpu_set);
+  svcdb_pipeline_get_attribute (name, MLOPS_SCHED_NICE_ATTR, &nice_value);
+  svcdb_pipeline_get_attribute (name, MLOPS_SCHED_POLICY_ATTR, &policy);
+  svcdb_pipeline_get_attribute (name, MLOPS_SCHED_PRIORITY_ATTR, &priority);
+
+  if (!cpu_set && !nice_value && !policy)
+    return NULL;
+
+  /* Capture the attributes of the process before changing the streaming threads. */
+  _mlops_sched_get_default ();
+
+  sched = g_new0 (mlops_node_sched_s, 1);
+  sched->policy = SCHED_OTHER;
+
+  /* The invalid attribute is ignored, the pipeline runs with the attributes of the process. */
+  if (cpu_set) {
+    sched->has_cpu_set = _mlops_sched_parse_cpu_set (cpu_set, &sched->cpu_set);
+    if (!sched->has_cpu_set)
+      ml_logw ("Invalid CPU set '%s' of the service '%s'.", cpu_set, name);
+  }
+
+  if (nice_value) {
+    sched->has_nice = _mlops_sched_parse_int (nice_value, -20, 19, &sched->nice);
+    if (!sched->has_nice)
+      ml_logw ("Invalid nice value '%s' of the service '%s'.", nice_value, name);
+  }
+
+  if (policy) {
+    if (g_ascii_strcasecmp (policy, "fifo") == 0) {
+      sched->policy = SCHED_FIFO;
+    } else if (g_ascii_strcasecmp (policy, "rr") == 0) {
+      sched->policy = SCHED_RR;
+    } else if (g_ascii_strcasecmp (policy, "other") != 0) {
+      ml_logw ("Invalid scheduling policy '%s' of the service '%s'.", policy, name);
+    }
+  }
+
+  if (sched->policy != SCHED_OTHER) {
+    gint min = sched_get_priority_min (sched->policy);
+    gint max = sched_get_priority_max (sched->policy);
+
+    sched->priority = min;
+    if (priority && !_mlops_sched_parse_int (priority, min, max, &sched->priority))
+      ml_logw ("Invalid scheduling priority '%s' of the service '%s', use %d.", priority, name, min);
+  }
+
+  if (!sched->has_cpu_set && !sched->has_nice && sched->policy == SCHED_OTHER) {
+    g_free (sched);
+    return NULL;
+  }
+
+  return sched;
+}
+
+/**
+ * @brief Copy the scheduling attributes.
+ */
+mlops_node_sched_s *
+mlops_node_sched_copy (const mlops_node_sched_s * sched)
+{
+  mlops_node_sched_s *copy;
+
+  if (!sched)
+    return NULL;
+
+  copy = g_new (mlops_node_sched_s, 1);
+  *copy = *sched;
+  return copy;
+}
+
+/**
+ * @brief Release the scheduling attributes.
+ */
+void
+mlops_node_sched_free (mlops_node_sched_s * sched)
+{
+  g_free (sched);
+}
+
+/**
+ * @brief Check the scheduling attributes are same.
+ */
+gboolean
+mlops_node_sched_equal (const mlops_node_sched_s * a, const mlops_node_sched_s * b)
+{
+  if (!a || !b)
+    return (a == b);
+
+  if (a->has_cpu_set != b->has_cpu_set ||
+      (a->has_cpu_set && !CPU_EQUAL (&a->cpu_set, &b->cpu_set)))
+    return FALSE;
+
+  if (a->has_nice != b->has_nice || (a->has_nice && a->nice != b->nice))
+    return FALSE;
+
+  return (a->policy == b->policy && a->priority == b->priority);
+}
+
+/**
+ * @brief Attach the copy of the scheduling attributes to the pipeline.
+ */
+void
+mlops_node_sched_attach (GstElement * pipeline, const mlops_node_sched_s * sched)
+{
+  g_return_if_fail (pipeline != NULL);
+
+  if (sched) {
+    g_object_set_data_full (G_OBJECT (pipeline), MLOPS_SCHED_KEY,
+        mlops_node_sched_copy (sched), (GDestroyNotify) mlops_node_sched_free);
+  }
+}
+
+/**
+ * @brief Get the scheduling attributes attached to the pipeline.
+ */
+const mlops_node_sched_s *
+mlops_node_sched_get (GstElement * pipeline)
+{
+  g_return_val_if_fail (pipeline != NULL, NULL);
+
+  return (const mlops_node_sched_s *) g_object_get_data (G_OBJECT (pipeline), MLOPS_SCHED_KEY);
+}
+
+/**
+ * @brief Internal function to log the failure to change the scheduling of the streaming thread.
+ * @details The real-time policy and the negative nice value need the privilege, and the higher nice value is not applied if it cannot be restored.
+ *          This is logged once in the process.
+ */
+static void
+_mlops_sched_warn (const gchar * what, gint error)
+{
+  if (error == EPERM || error == EACCES) {
+    if (!g_atomic_int_compare_and_exchange (&g_mlops_sched_denied, 0, 1))
+      return;
+  }
+
+  ml_logw ("Failed to set the %s of the streaming thread, error %d.", what, error);
+}
+
+/**
+ * @brief Apply the scheduling attributes to the streaming thread entering the task, and restore it when leaving.
+ * @details On Linux, the id 0 means the calling thread, not the whole process.
+ */
+void
+mlops_node_sched_handle_message (const mlops_node_sched_s * sched, GstMessage * msg)
+{
+  const mlops_sched_default_s *def;
+  GstStreamStatusType type;
+  GstElement *owner = NULL;
+  struct sched_param param;
+
+  if (!sched || GST_MESSAGE_TYPE (msg) != GST_MESSAGE_STREAM_STATUS)
+    return;
+
+  gst_message_parse_stream_status (msg, &type, &owner);
+  memset (&param, 0, sizeof (param));
+
+  switch (type) {
+    case GST_STREAM_STATUS_TYPE_ENTER:
+      if (sched->has_cpu_set &&
+          sched_setaffinity (0, sizeof (cpu_set_t), &sched->cpu_set) != 0)
+        _mlops_sched_warn ("CPU set", errno);
+
+      if (sched->policy != SCHED_OTHER) {
+        param.sched_priority = sched->priority;
+        if (sched_setscheduler (0, sched->policy, &param) != 0)
+          _mlops_sched_warn ("scheduling policy", errno);
+      }
+
+      if (sched->has_nice) {
+        def = _mlops_sched_get_default ();
+
+        /* The thread returns to the shared task pool, do not leave the higher nice value to the other pipelines. */
+        if (sched->nice > def->nice && !def->can_restore_nice)
+          _mlops_sched_warn ("nice value", EPERM);
+        else if (setpriority (PRIO_PROCESS, 0, sched->nice) != 0)
+          _mlops_sched_warn ("nice value", errno);
+      }
+      break;
+    case GST_STREAM_STATUS_TYPE_LEAVE:
+      def = _mlops_sched_get_default ();
+
+      if (sched->has_cpu_set && def->has_cpu_set)
+        sched_setaffinity (0, sizeof (cpu_set_t), &def->cpu_set);
+
+      if (sched->policy != SCHED_OTHER)
+        sched_setscheduler (0, SCHED_OTHER, &param);
+
+      if (sched->has_nice && setpriority (PRIO_PROCESS, 0, def->nice) != 0)
+        ml_logd ("Failed to restore the nice value of the streaming thread, error %d.", errno);
+      break;
+    default:
+      break;
+  }
+}
@@ -0,0 +1,68 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-sched.h
+ * @date      18 October 2026
+ * @brief     Scheduling attributes of the pipeline in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   This applies the CPU set, the nice value and the real-time scheduling policy of the service
+ *            to the streaming threads of the pipeline.
+ */
+
+#ifndef _MLOPS_AGENT_NODE_SCHED_H_
+#define _MLOPS_AGENT_NODE_SCHED_H_
+
+#include <glib.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+typedef struct _mlops_node_sched_s mlops_node_sched_s;
+
+/**
+ * @brief Get the scheduling attributes of the service from the database.
+ * @return NULL if the service does not have the scheduling attributes.
+ */
+mlops_node_sched_s *mlops_node_sched_new (const gchar *name);
+
+/**
+ * @brief Copy the scheduling attributes.
+ */
+mlops_node_sched_s *mlops_node_sched_copy (const mlops_node_sched_s *sched);
+
+/**
+ * @brief Release the scheduling attributes.
+ */
+void mlops_node_sched_free (mlops_node_sched_s *sched);
+
+/**
+ * @brief Check the scheduling attributes are same.
+ */
+gboolean mlops_node_sched_equal (const mlops_node_sched_s *a, const mlops_node_sched_s *b);
+
+/**
+ * @brief Attach the copy of the scheduling attributes to the pipeline.
+ */
+void mlops_node_sched_attach (GstElement *pipeline, const mlops_node_sched_s *sched);
+
+/**
+ * @brief Get the scheduling attributes attached to the pipeline.
+ */
+const mlops_node_sched_s *mlops_node_sched_get (GstElement *pipeline);
+
+/**
+ * @brief Apply the scheduling attributes to the streaming thread entering the task, and restore it when leaving.
+ * @details This should be called in the sync handler of the bus, which runs in the streaming thread.
+ *          The nice value higher than the process is applied only if the process can lower it again (CAP_SYS_NICE or RLIMIT_NICE),
+ *          because the thread of the shared task pool is reused by the other pipelines.
+ */
+void mlops_node_sched_handle_message (const mlops_node_sched_s *sched, GstMessage *msg);
+
+G_END_DECLS
+#endif /* _MLOPS_AGENT_NODE_SCHED_H_ */
@@ -0,0 +1,358 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-share.c
+ * @date      18 October 2026
+ * @brief     Shared model instances of the filters in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   tensor_filter keeps one instance of the model for the filters with the same shared key.
+ *            The key is made from the framework, the model and the options to open the model,
+ *            and the filters with the key are counted here to report the saved time and memory.
+ */
+
+#include <errno.h>
+#include <json-glib/json-glib.h>
+
+#include "log.h"
+#include "mlops-agent-node-share.h"
+
+/**
+ * @brief The name of the property of tensor_filter to share the model instance.
+ */
+#define MLOPS_SHARE_KEY_PROP "shared-tensor-filter-key"
+
+/**
+ * @brief The key of the shared model attached to the filter.
+ */
+#define MLOPS_SHARE_FILTER_KEY "mlops-node-share"
+
+/**
+ * @brief The key of the shared models loaded by the pipeline, the cost is not recorded yet.
+ */
+#define MLOPS_SHARE_LOADED_KEY "mlops-node-share-loaded"
+
+/**
+ * @brief The properties of tensor_filter to open the model. The filters with the same values share the model.
+ */
+static const gchar *const g_mlops_share_props[] = {
+  "framework", "model", "accelerator", "custom",
+  "input", "inputtype", "output", "outputtype", NULL
+};
+
+/**
+ * @brief Structure for the model shared by the filters.
+ */
+typedef struct
+{
+  guint refcount;       /**< The number of the filters using the model */
+  gchar *framework;
+  gchar *model;
+  gboolean measured;    /**< The cost to load the model is recorded */
+  gint64 load_time;     /**< The time (in microseconds) to load the model */
+  guint64 memory_kb;    /**< The memory (in kilobytes) allocated to load the model */
+  guint pending;        /**< The number of the filters sharing the model before the cost is recorded */
+} mlops_share_s;
+
+static GHashTable *g_mlops_share_table = NULL;
+static guint64 g_mlops_share_count = 0U;
+static gint64 g_mlops_share_saved_time = 0;
+G_LOCK_DEFINE_STATIC (mlops_share);
+
+/**
+ * @brief Internal function to release the shared model.
+ */
+static void
+_mlops_share_free (gpointer data)
+{
+  mlops_share_s *share = (mlops_share_s *) data;
+
+  g_free (share->framework);
+  g_free (share->model);
+  g_free (share);
+}
+
+/**
+ * @brief Internal function to release the reference of the shared model when the filter is released.
+ */
+static void
+_mlops_share_release (gpointer data)
+{
+  gchar *key = (gchar *) data;
+  mlops_share_s *share;
+
+  G_LOCK (mlops_share);
+  share = g_mlops_share_table ?
+      (mlops_share_s *) g_hash_table_lookup (g_mlops_share_table, key) : NULL;
+  if (share && --share->refcount == 0U) {
+    g_hash_table_remove (g_mlops_share_table, key);
+
+    if (g_hash_table_size (g_mlops_share_table) == 0U) {
+      g_hash_table_destroy (g_mlops_share_table);
+      g_mlops_share_table = NULL;
+    }
+  }
+  G_UNLOCK (mlops_share);
+
+  g_free (key);
+}
+
+/**
+ * @brief Internal function to make the shared key from the properties to open the model.
+ * @return Newly allocated key, NULL if the filter does not load the model or has the shared key already.
+ */
+static gchar *
+_mlops_share_make_key (GstElement * filter, gchar ** framework, gchar ** model)
+{
+  GObjectClass *klass = G_OBJECT_GET_CLASS (filter);
+  GString *str;
+  gchar *value = NULL;
+  gchar *key;
+  guint i;
+
+  g_object_get (filter, MLOPS_SHARE_KEY_PROP, &value, NULL);
+  if (value && value[0] != '\0') {
+    g_free (value);
+    return NULL;
+  }
+  g_free (value);
+
+  g_object_get (filter, "framework", framework, "model", model, NULL);
+  if (!*model || (*model)[0] == '\0') {
+    g_free (*framework);
+    g_free (*model);
+    *framework = *model = NULL;
+    return NULL;
+  }
+
+  str = g_string_new (NULL);
+  for (i = 0; g_mlops_share_props[i]; i++) {
+    GParamSpec *pspec = g_object_class_find_property (klass, g_mlops_share_props[i]);
+
+    if (!pspec || pspec->value_type != G_TYPE_STRING)
+      continue;
+
+    g_object_get (filter, g_mlops_share_props[i], &value, NULL);
+    g_string_append_printf (str, "%s=%s\n", g_mlops_share_props[i], value ? value : "");
+    g_free (value);
+  }
+
+  /* The model path may be long, use the digest as the key. */
+  value = g_compute_checksum_for_string (G_CHECKSUM_SHA1, str->str, (gssize) str->len);
+  key = g_strdup_printf ("mlops-%s", value);
+
+  g_free (value);
+  g_string_free (str, TRUE);
+  return key;
+}
+
+/**
+ * @brief Internal function to set the shared key to the filter and count the reference of the shared model.
+ */
+static void
+_mlops_share_attach_filter (GstElement * pipeline, GstElement * filter)
+{
+  mlops_share_s *share;
+  GPtrArray *loaded;
+  gchar *framework = NULL;
+  gchar *model = NULL;
+  gchar *key;
+
+  if (!g_object_class_find_property (G_OBJECT_GET_CLASS (filter), MLOPS_SHARE_KEY_PROP))
+    return;
+
+  key = _mlops_share_make_key (filter, &framework, &model);
+  if (!key)
+    return;
+
+  g_object_set (filter, MLOPS_SHARE_KEY_PROP, key, NULL);
+
+  G_LOCK (mlops_share);
+  if (!g_mlops_share_table) {
+    g_mlops_share_table = g_hash_table_new_full (g_str_hash, g_str_equal,
+        g_free, _mlops_share_free);
+  }
+
+  share = (mlops_share_s *) g_hash_table_lookup (g_mlops_share_table, key);
+  if (share) {
+    /* The model is loaded by the running pipeline. */
+    g_mlops_share_count++;
+    if (share->measured)
+      g_mlops_share_saved_time += share->load_time;
+    else
+      share->pending++;
+
+    g_free (framework);
+    g_free (model);
+  } else {
+    share = g_new0 (mlops_share_s, 1);
+    share->framework = framework;
+    share->model = model;
+    g_hash_table_insert (g_mlops_share_table, g_strdup (key), share);
+
+    loaded = (GPtrArray *) g_object_get_data (G_OBJECT (pipeline), MLOPS_SHARE_LOADED_KEY);
+    if (!loaded) {
+      loaded = g_ptr_array_new_with_free_func (g_free);
+      g_object_set_data_full (G_OBJECT (pipeline), MLOPS_SHARE_LOADED_KEY,
+          loaded, (GDestroyNotify) g_ptr_array_unref);
+    }
+    g_ptr_array_add (loaded, g_strdup (key));
+  }
+  share->refcount++;
+  G_UNLOCK (mlops_share);
+
+  /* The reference is released when the filter is released. */
+  g_object_set_data_full (G_OBJECT (filter), MLOPS_SHARE_FILTER_KEY, key, _mlops_share_release);
+}
+
+/**
+ * @brief Set the shared key to the filters in the pipeline. This should be called before the pipeline is paused.
+ */
+void
+mlops_node_share_attach (GstElement * pipeline)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  gboolean done = FALSE;
+
+  g_return_if_fail (pipeline != NULL);
+
+  if (!GST_IS_BIN (pipeline)) {
+    _mlops_share_attach_filter (pipeline, pipeline);
+    return;
+  }
+
+  it = gst_bin_iterate_recurse (GST_BIN (pipeline));
+  while (!done) {
+    switch (gst_iterator_next (it, &item)) {
+      case GST_ITERATOR_OK:
+        _mlops_share_attach_filter (pipeline, GST_ELEMENT (g_value_get_object (&item)));
+        g_value_reset (&item);
+        break;
+      case GST_ITERATOR_RESYNC:
+        /* The filter which has the key already is skipped. */
+        gst_iterator_resync (it);
+        break;
+      default:
+        done = TRUE;
+        break;
+    }
+  }
+
+  g_value_unset (&item);
+  gst_iterator_free (it);
+}
+
+/**
+ * @brief Check the filter shares the model instance by the shared key set in mlops node.
+ */
+gboolean
+mlops_node_share_is_attached (GstElement * filter)
+{
+  g_return_val_if_fail (filter != NULL, FALSE);
+
+  return (g_object_get_data (G_OBJECT (filter), MLOPS_SHARE_FILTER_KEY) != NULL);
+}
+
+/**
+ * @brief Record the time (in microseconds) and memory (in kilobytes) to load the models of the pipeline.
+ */
+void
+mlops_node_share_set_cost (GstElement * pipeline, const gint64 load_time, const guint64 memory_kb)
+{
+  GPtrArray *loaded;
+  guint i;
+
+  g_return_if_fail (pipeline != NULL);
+
+  loaded = (GPtrArray *) g_object_get_data (G_OBJECT (pipeline), MLOPS_SHARE_LOADED_KEY);
+  if (!loaded || loaded->len == 0U)
+    return;
+
+  G_LOCK (mlops_share);
+  for (i = 0; i < loaded->len; i++) {
+    mlops_share_s *share = g_mlops_share_table ? (mlops_share_s *)
+        g_hash_table_lookup (g_mlops_share_table, g_ptr_array_index (loaded, i)) : NULL;
+
+    if (!share || share->measured)
+      continue;
+
+    share->measured = TRUE;
+    share->load_time = load_time / loaded->len;
+    share->memory_kb = memory_kb / loaded->len;
+
+    /* The filters shared the model while it is loaded. */
+    g_mlops_share_saved_time += share->load_time * share->pending;
+    share->pending = 0U;
+  }
+  G_UNLOCK (mlops_share);
+
+  g_object_set_data (G_OBJECT (pipeline), MLOPS_SHARE_LOADED_KEY, NULL);
+}
+
+/**
+ * @brief Get the statistics of the shared models in JSON string.
+ */
+int
+mlops_node_share_get_stats (gchar ** stats)
+{
+  JsonBuilder *builder;
+  JsonNode *root;
+  GHashTableIter iter;
+  gpointer value;
+  guint64 saved_kb = 0U;
+
+  g_return_val_if_fail (stats != NULL, -EINVAL);
+
+  builder = json_builder_new ();
+  json_builder_begin_object (builder);
+
+  G_LOCK (mlops_share);
+  json_builder_set_member_name (builder, "models");
+  json_builder_begin_array (builder);
+  if (g_mlops_share_table) {
+    g_hash_table_iter_init (&iter, g_mlops_share_table);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+      mlops_share_s *share = (mlops_share_s *) value;
+
+      /* The memory is allocated once for the filters using the model. */
+      saved_kb += share->memory_kb * (share->refcount - 1U);
+
+      json_builder_begin_object (builder);
+      json_builder_set_member_name (builder, "framework");
+      json_builder_add_string_value (builder, share->framework);
+      json_builder_set_member_name (builder, "model");
+      json_builder_add_string_value (builder, share->model);
+      json_builder_set_member_name (builder, "users");
+      json_builder_add_int_value (builder, share->refcount);
+      json_builder_set_member_name (builder, "load_time_us");
+      json_builder_add_int_value (builder, share->load_time);
+      json_builder_set_member_name (builder, "memory_kb");
+      json_builder_add_int_value (builder, (gint64) share->memory_kb);
+      json_builder_end_object (builder);
+    }
+  }
+  json_builder_end_array (builder);
+
+  json_builder_set_member_name (builder, "shares");
+  json_builder_add_int_value (builder, (gint64) g_mlops_share_count);
+  json_builder_set_member_name (builder, "saved_load_time_us");
+  json_builder_add_int_value (builder, g_mlops_share_saved_time);
+  json_builder_set_member_name (builder, "saved_memory_kb");
+  json_builder_add_int_value (builder, (gint64) saved_kb);
+  G_UNLOCK (mlops_share);
+
+  json_builder_end_object (builder);
+
+  root = json_builder_get_root (builder);
+  *stats = json_to_string (root, FALSE);
+
+  json_node_unref (root);
+  g_object_unref (builder);
+  return 0;
+}
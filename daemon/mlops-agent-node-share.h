@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-share.h
+ * @date      18 October 2026
+ * @brief     Shared model instances of the filters in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The filters loading the same model with the same framework and options share one loaded instance
+ *            using the shared key of tensor_filter, so the model is loaded once while the pipelines using it are running.
+ */
+
+#ifndef _MLOPS_AGENT_NODE_SHARE_H_
+#define _MLOPS_AGENT_NODE_SHARE_H_
+
+#include <glib.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Set the shared key to the filters in the pipeline. This should be called before the pipeline is paused.
+ * @details The filter which has the shared key given by the description is not changed.
+ *          The reference of the shared model is released when the filter is released.
+ */
+void mlops_node_share_attach (GstElement *pipeline);
+
+/**
+ * @brief Check the filter shares the model instance by the shared key set in mlops node.
+ * @details The model of the shared filter should not be reloaded in place, tensor_filter replaces the model of all filters with the key.
+ *          The pipeline is built again instead, then the key is made from the new model and the reference of the old key is released with the old filter.
+ */
+gboolean mlops_node_share_is_attached (GstElement *filter);
+
+/**
+ * @brief Record the time (in microseconds) and memory (in kilobytes) to load the models of the pipeline.
+ * @details The cost is divided by the models loaded by the pipeline, and counted as saved when the model is shared.
+ */
+void mlops_node_share_set_cost (GstElement *pipeline, const gint64 load_time, const guint64 memory_kb);
+
+/**
+ * @brief Get the statistics of the shared models in JSON string.
+ */
+int mlops_node_share_get_stats (gchar **stats);
+
+G_END_DECLS
+#endif /* _MLOPS_AGENT_NODE_SHARE_H_ */
@@ -0,0 +1,697 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-source.c
+ * @date      18 October 2026
+ * @brief     Shared source of the pipelines in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The reference of the source is replaced with appsrc named with the source. The source pipeline ends with fakesink,
+ *            and the probe on the sink pushes the buffer to the receivers. The receiver gets the buffer sharing the memory,
+ *            only the metadata is copied so that the receiver sets the timestamp on its own clock.
+ *            The receiver in the pipeline which is not playing, or whose queue is full, skips the buffer.
+ *            The source pipeline is launched when the first receiver starts playing, and the source is removed when the last receiver is released.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <json-glib/json-glib.h>
+
+#include "log.h"
+#include "mlops-agent-internal.h"
+#include "mlops-agent-node-source.h"
+#include "mlops-agent-node-taskpool.h"
+#include "service-db-util.h"
+
+/**
+ * @brief The prefix of the name of the receiver, followed by the name of the source.
+ */
+#define MLOPS_SOURCE_RECEIVER_PREFIX "mlops-source-"
+
+/**
+ * @brief The key of the receiver attached to the element.
+ */
+#define MLOPS_SOURCE_RECEIVER_KEY "mlops-node-source"
+
+/**
+ * @brief The name of the sink at the end of the source pipeline.
+ */
+#define MLOPS_SOURCE_SINK_NAME "mlops_source_sink"
+
+/**
+ * @brief Structure for the shared source.
+ */
+typedef struct
+{
+  gchar *name;
+  GMutex lock;          /**< The lock to launch and stop the source pipeline */
+  GCond cond;           /**< Signalled when the stopping source pipeline is stopped */
+  GstElement *pipeline; /**< The source pipeline, NULL if no receiver is playing */
+  gboolean stopping;    /**< The source pipeline is being stopped in the other thread */
+  GstCaps *caps;        /**< The caps of the buffers from the source */
+  GList *receivers;     /**< The receivers connected to the source */
+  guint64 buffers;      /**< The number of the buffers from the source */
+  guint64 dropped;      /**< The number of the buffers skipped by the receivers */
+} mlops_source_s;
+
+/**
+ * @brief Structure for the receiver connected to the shared source.
+ */
+typedef struct
+{
+  mlops_source_s *source;       /**< The source, NULL if the source is released */
+  GWeakRef element;     /**< The appsrc in the pipeline, the source does not hold its reference */
+} mlops_source_receiver_s;
+
+static GHashTable *g_mlops_source_table = NULL;
+static GHashTable *g_mlops_source_descs = NULL;
+G_LOCK_DEFINE_STATIC (mlops_source);
+
+/**
+ * @brief Internal function to release the shared source. The source pipeline should be stopped.
+ */
+static void
+_mlops_source_free (gpointer data)
+{
+  mlops_source_s *source = (mlops_source_s *) data;
+
+  g_free (source->name);
+  g_mutex_clear (&source->lock);
+  g_cond_clear (&source->cond);
+  gst_caps_replace (&source->caps, NULL);
+  g_list_free (source->receivers);
+  g_free (source);
+}
+
+/**
+ * @brief Internal function to remove the source from the table if it has no receiver and its pipeline is stopped. Should be called with the lock.
+ * @return TRUE if the source is removed, the caller should release it.
+ */
+static gboolean
+_mlops_source_steal_unused_locked (mlops_source_s * source)
+{
+  if (source->receivers || source->pipeline || source->stopping)
+    return FALSE;
+
+  /* The table is released when finalizing. */
+  if (!g_mlops_source_table ||
+      g_hash_table_lookup (g_mlops_source_table, source->name) != source)
+    return FALSE;
+
+  return g_hash_table_steal (g_mlops_source_table, source->name);
+}
+
+/**
+ * @brief Internal function to get the receivers of the source. Should be called with the source lock.
+ */
+static GList *
+_mlops_source_get_receivers_locked (mlops_source_s * source)
+{
+  GList *elements = NULL, *l;
+
+  for (l = source->receivers; l != NULL; l = l->next) {
+    mlops_source_receiver_s *receiver = (mlops_source_receiver_s *) l->data;
+    GstElement *element = (GstElement *) g_weak_ref_get (&receiver->element);
+
+    if (element)
+      elements = g_list_prepend (elements, element);
+  }
+
+  return elements;
+}
+
+/**
+ * @brief Internal function to check the receiver takes the buffer, the pipeline is playing and the queue is not full.
+ */
+static gboolean
+_mlops_source_is_receiving (GstElement * element)
+{
+  GstState state;
+  guint64 level = 0U, max = 0U;
+
+  GST_OBJECT_LOCK (element);
+  state = GST_STATE (element);
+  GST_OBJECT_UNLOCK (element);
+
+  if (state != GST_STATE_PLAYING)
+    return FALSE;
+
+  g_object_get (element, "current-level-bytes", &level, "max-bytes", &max, NULL);
+  return (max == 0U || level < max);
+}
+
+/**
+ * @brief Internal function to pass the buffers and caps of the source pipeline to the receivers.
+ */
+static GstPadProbeReturn
+_mlops_source_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  mlops_source_s *source = (mlops_source_s *) user_data;
+  GList *elements, *l;
+  GstBuffer *buffer, *shared;
+  GstCaps *caps = NULL;
+  GstFlowReturn ret;
+  guint64 dropped = 0U;
+
+  if (info->type & GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM) {
+    GstEvent *event = GST_PAD_PROBE_INFO_EVENT (info);
+
+    if (GST_EVENT_TYPE (event) != GST_EVENT_CAPS)
+      return GST_PAD_PROBE_OK;
+
+    gst_event_parse_caps (event, &caps);
+
+    G_LOCK (mlops_source);
+    gst_caps_replace (&source->caps, caps);
+    elements = _mlops_source_get_receivers_locked (source);
+    G_UNLOCK (mlops_source);
+
+    for (l = elements; l != NULL; l = l->next)
+      g_object_set (l->data, "caps", caps, NULL);
+
+    g_list_free_full (elements, gst_object_unref);
+    return GST_PAD_PROBE_OK;
+  }
+
+  buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+
+  G_LOCK (mlops_source);
+  source->buffers++;
+  elements = _mlops_source_get_receivers_locked (source);
+  G_UNLOCK (mlops_source);
+
+  for (l = elements; l != NULL; l = l->next) {
+    if (!_mlops_source_is_receiving (GST_ELEMENT (l->data))) {
+      dropped++;
+      continue;
+    }
+
+    /* The memory is shared, the receiver sets the timestamp with the running time of its pipeline. */
+    shared = gst_buffer_copy (buffer);
+    GST_BUFFER_PTS (shared) = GST_CLOCK_TIME_NONE;
+    GST_BUFFER_DTS (shared) = GST_CLOCK_TIME_NONE;
+
+    g_signal_emit_by_name (l->data, "push-buffer", shared, &ret);
+    gst_buffer_unref (shared);
+  }
+
+  if (dropped > 0U) {
+    G_LOCK (mlops_source);
+    source->dropped += dropped;
+    G_UNLOCK (mlops_source);
+  }
+
+  /* The receiver may be released here, the source pipeline is stopped in the other thread. */
+  g_list_free_full (elements, gst_object_unref);
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Internal function to handle the bus messages of the source pipeline.
+ */
+static GstBusSyncReply
+_mlops_source_bus_sync_handler (GstBus * bus, GstMessage * msg, gpointer user_data)
+{
+  mlops_source_s *source = (mlops_source_s *) user_data;
+  GError *err = NULL;
+
+  switch (GST_MESSAGE_TYPE (msg)) {
+    case GST_MESSAGE_STREAM_STATUS:
+      mlops_node_task_pool_handle_message (msg);
+      break;
+    case GST_MESSAGE_ERROR:
+      gst_message_parse_error (msg, &err, NULL);
+      ml_loge ("The shared source '%s' posted an error: %s", source->name,
+          err ? err->message : "unknown reason");
+      g_clear_error (&err);
+      break;
+    default:
+      break;
+  }
+
+  return GST_BUS_DROP;
+}
+
+/**
+ * @brief Internal function to launch the source pipeline. Should be called with the lock of the source.
+ * @details The device of the source may be opened by the previous pipeline, wait until it is stopped.
+ */
+static int
+_mlops_source_start (mlops_source_s * source)
+{
+  GstElement *pipeline, *sink;
+  GstPad *pad;
+  GstBus *bus;
+  GError *err = NULL;
+  const gchar *stored;
+  gchar *desc = NULL;
+
+  while (source->stopping)
+    g_cond_wait (&source->cond, &source->lock);
+
+  /* The description updated while the source is running is used when it is launched again. */
+  G_LOCK (mlops_source);
+  stored = g_mlops_source_descs ?
+      (const gchar *) g_hash_table_lookup (g_mlops_source_descs, source->name) : NULL;
+  if (stored) {
+    desc = g_strdup_printf ("%s ! fakesink name=%s sync=false async=false",
+        stored, MLOPS_SOURCE_SINK_NAME);
+  }
+  G_UNLOCK (mlops_source);
+
+  if (!desc) {
+    ml_loge ("The shared source '%s' is not prepared.", source->name);
+    return -ENOENT;
+  }
+
+  pipeline = gst_parse_launch (desc, &err);
+  if (!pipeline || err) {
+    ml_loge ("Failed to launch the shared source '%s' (error msg: %s).",
+        source->name, (err) ? err->message : "unknown reason");
+    g_clear_error (&err);
+    g_free (desc);
+
+    if (pipeline)
+      gst_object_unref (pipeline);
+    return -ESTRPIPE;
+  }
+  g_free (desc);
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), MLOPS_SOURCE_SINK_NAME);
+  pad = gst_element_get_static_pad (sink, "sink");
+  gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM,
+      _mlops_source_probe, source, NULL);
+  gst_object_unref (pad);
+  gst_object_unref (sink);
+
+  bus = gst_element_get_bus (pipeline);
+  gst_bus_set_sync_handler (bus, _mlops_source_bus_sync_handler, source, NULL);
+  gst_object_unref (bus);
+
+  if (gst_element_set_state (pipeline, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+    ml_loge ("Failed to start the shared source '%s'.", source->name);
+    gst_element_set_state (pipeline, GST_STATE_NULL);
+    gst_object_unref (pipeline);
+    return -ESTRPIPE;
+  }
+
+  G_LOCK (mlops_source);
+  source->pipeline = pipeline;
+  G_UNLOCK (mlops_source);
+
+  ml_logi ("The shared source '%s' is launched.", source->name);
+  return 0;
+}
+
+/**
+ * @brief Internal function to stop and release the source pipeline, called in the thread pool of GStreamer.
+ * @details The source is removed if no receiver is connected while stopping, otherwise the new receiver launches it again.
+ */
+static void
+_mlops_source_stop_async (GstElement * pipeline, gpointer user_data)
+{
+  mlops_source_s *source = (mlops_source_s *) user_data;
+  gboolean removed;
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  ml_logi ("The shared source '%s' is stopped, there is no receiver.", source->name);
+
+  g_mutex_lock (&source->lock);
+  G_LOCK (mlops_source);
+  source->stopping = FALSE;
+  removed = _mlops_source_steal_unused_locked (source);
+  G_UNLOCK (mlops_source);
+
+  g_cond_broadcast (&source->cond);
+  g_mutex_unlock (&source->lock);
+
+  if (removed)
+    _mlops_source_free (source);
+}
+
+/**
+ * @brief Internal function to stop the source pipeline and remove the source if there is no receiver.
+ */
+static void
+_mlops_source_release_unused (mlops_source_s * source)
+{
+  GstElement *pipeline = NULL;
+  gboolean removed = FALSE;
+
+  g_mutex_lock (&source->lock);
+  G_LOCK (mlops_source);
+  if (!source->receivers) {
+    pipeline = source->pipeline;
+    source->pipeline = NULL;
+
+    if (pipeline)
+      source->stopping = TRUE;
+    else
+      removed = _mlops_source_steal_unused_locked (source);
+  }
+  G_UNLOCK (mlops_source);
+
+  if (pipeline) {
+    /* The last receiver may be released in the streaming thread of the source pipeline. */
+    gst_element_call_async (pipeline, _mlops_source_stop_async, source, NULL);
+    gst_object_unref (pipeline);
+  }
+  g_mutex_unlock (&source->lock);
+
+  if (removed)
+    _mlops_source_free (source);
+}
+
+/**
+ * @brief Internal function to launch the source pipeline when the receiver starts playing.
+ * @details The live appsrc requests the data only in the playing state, the source pipeline is not launched while the pipeline is prerolled.
+ */
+static void
+_mlops_source_need_data (GstElement * element, guint length, gpointer user_data)
+{
+  mlops_source_receiver_s *receiver = (mlops_source_receiver_s *) user_data;
+  mlops_source_s *source;
+  gboolean running;
+  gint result = 0;
+
+  G_LOCK (mlops_source);
+  source = receiver->source;
+  running = (source && source->pipeline);
+  G_UNLOCK (mlops_source);
+
+  if (!source || running)
+    return;
+
+  g_mutex_lock (&source->lock);
+  if (!source->pipeline)
+    result = _mlops_source_start (source);
+  g_mutex_unlock (&source->lock);
+
+  if (result != 0) {
+    GST_ELEMENT_ERROR (element, RESOURCE, OPEN_READ,
+        ("Failed to launch the shared source '%s'.", source->name), (NULL));
+  }
+}
+
+/**
+ * @brief Internal function to disconnect the receiver when the element is released.
+ */
+static void
+_mlops_source_receiver_free (gpointer data)
+{
+  mlops_source_receiver_s *receiver = (mlops_source_receiver_s *) data;
+  mlops_source_s *source;
+
+  G_LOCK (mlops_source);
+  source = receiver->source;
+  if (source)
+    source->receivers = g_list_remove (source->receivers, receiver);
+  G_UNLOCK (mlops_source);
+
+  if (source)
+    _mlops_source_release_unused (source);
+
+  g_weak_ref_clear (&receiver->element);
+  g_free (receiver);
+}
+
+/**
+ * @brief Internal function to connect the receiver to the source, the source pipeline is launched when the receiver starts playing.
+ * @details The source being stopped is reused, and it is launched again after the previous pipeline is stopped.
+ */
+static int
+_mlops_source_connect (GstElement * element, const gchar * name)
+{
+  mlops_source_receiver_s *receiver;
+  mlops_source_s *source = NULL;
+
+  G_LOCK (mlops_source);
+  if (!g_mlops_source_descs || !g_hash_table_contains (g_mlops_source_descs, name)) {
+    G_UNLOCK (mlops_source);
+    ml_loge ("The shared source '%s' is not prepared.", name);
+    return -ENOENT;
+  }
+
+  if (!g_mlops_source_table) {
+    g_mlops_source_table = g_hash_table_new_full (g_str_hash, g_str_equal,
+        NULL, _mlops_source_free);
+  }
+
+  source = (mlops_source_s *) g_hash_table_lookup (g_mlops_source_table, name);
+  if (!source) {
+    source = g_new0 (mlops_source_s, 1);
+    source->name = g_strdup (name);
+    g_mutex_init (&source->lock);
+    g_cond_init (&source->cond);
+    g_hash_table_insert (g_mlops_source_table, source->name, source);
+  }
+
+  receiver = g_new0 (mlops_source_receiver_s, 1);
+  receiver->source = source;
+  g_weak_ref_init (&receiver->element, element);
+  source->receivers = g_list_prepend (source->receivers, receiver);
+
+  if (source->caps)
+    g_object_set (element, "caps", source->caps, NULL);
+  G_UNLOCK (mlops_source);
+
+  /* The receiver is disconnected when the pipeline is released. */
+  g_object_set_data_full (G_OBJECT (element), MLOPS_SOURCE_RECEIVER_KEY,
+      receiver, _mlops_source_receiver_free);
+  g_signal_connect (element, "need-data", G_CALLBACK (_mlops_source_need_data), receiver);
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to get the description of the element receiving the data from the source.
+ */
+static gchar *
+_mlops_source_get_receiver (const gchar * name)
+{
+  return g_strdup_printf ("appsrc name=" MLOPS_SOURCE_RECEIVER_PREFIX
+      "%s is-live=true format=time do-timestamp=true", name);
+}
+
+/**
+ * @brief Read the description of the shared source from the database, and get the element receiving the data from the source.
+ */
+int
+mlops_node_source_prepare (const gchar * name, gchar ** element)
+{
+  gchar *desc = NULL;
+  const gchar *c;
+  gint result;
+
+  g_return_val_if_fail (STR_IS_VALID (name), -EINVAL);
+  g_return_val_if_fail (element != NULL, -EINVAL);
+
+  /* The name is used as the name of the element. */
+  for (c = name; *c != '\0'; c++) {
+    if (!g_ascii_isalnum (*c) && !strchr ("_-.", *c)) {
+      ml_loge ("Invalid name of the shared source '%s'.", name);
+      return -EINVAL;
+    }
+  }
+
+  result = svcdb_pipeline_get (name, &desc);
+  if (result != 0) {
+    ml_loge ("Failed to get the description of the shared source '%s'.", name);
+    return result;
+  }
+
+  /* The description is kept apart from the source, which is added when the receiver is connected and removed with the last receiver. */
+  G_LOCK (mlops_source);
+  if (!g_mlops_source_descs)
+    g_mlops_source_descs = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+
+  g_hash_table_replace (g_mlops_source_descs, g_strdup (name), desc);
+  G_UNLOCK (mlops_source);
+
+  *element = _mlops_source_get_receiver (name);
+  return 0;
+}
+
+/**
+ * @brief Get the element receiving the data from the shared source prepared already.
+ */
+int
+mlops_node_source_get_element (const gchar * name, gchar ** element)
+{
+  gboolean prepared;
+
+  g_return_val_if_fail (STR_IS_VALID (name), -EINVAL);
+  g_return_val_if_fail (element != NULL, -EINVAL);
+
+  G_LOCK (mlops_source);
+  prepared = (g_mlops_source_descs && g_hash_table_contains (g_mlops_source_descs, name));
+  G_UNLOCK (mlops_source);
+
+  if (!prepared)
+    return -ENOENT;
+
+  *element = _mlops_source_get_receiver (name);
+  return 0;
+}
+
+/**
+ * @brief Connect the receivers in the pipeline to the shared sources.
+ */
+int
+mlops_node_source_attach (GstElement * pipeline)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  GList *elements = NULL, *l;
+  gboolean done = FALSE;
+  gint result = 0;
+
+  g_return_val_if_fail (pipeline != NULL, -EINVAL);
+
+  if (!GST_IS_BIN (pipeline))
+    return 0;
+
+  it = gst_bin_iterate_recurse (GST_BIN (pipeline));
+  while (!done) {
+    switch (gst_iterator_next (it, &item)) {
+      case GST_ITERATOR_OK:
+      {
+        GstElement *element = GST_ELEMENT (g_value_get_object (&item));
+
+        if (g_str_has_prefix (GST_ELEMENT_NAME (element), MLOPS_SOURCE_RECEIVER_PREFIX) &&
+            g_signal_lookup ("push-buffer", G_OBJECT_TYPE (element)) != 0)
+          elements = g_list_prepend (elements, gst_object_ref (element));
+
+        g_value_reset (&item);
+        break;
+      }
+      case GST_ITERATOR_RESYNC:
+        g_list_free_full (elements, gst_object_unref);
+        elements = NULL;
+        gst_iterator_resync (it);
+        break;
+      default:
+        done = TRUE;
+        break;
+    }
+  }
+
+  g_value_unset (&item);
+  gst_iterator_free (it);
+
+  for (l = elements; l != NULL && result == 0; l = l->next) {
+    GstElement *element = GST_ELEMENT (l->data);
+
+    result = _mlops_source_connect (element,
+        GST_ELEMENT_NAME (element) + strlen (MLOPS_SOURCE_RECEIVER_PREFIX));
+  }
+
+  g_list_free_full (elements, gst_object_unref);
+  return result;
+}
+
+/**
+ * @brief Get the statistics of the shared sources in JSON string.
+ */
+int
+mlops_node_source_get_stats (gchar ** stats)
+{
+  JsonBuilder *builder;
+  JsonNode *root;
+  GHashTableIter iter;
+  gpointer key, value;
+
+  g_return_val_if_fail (stats != NULL, -EINVAL);
+
+  builder = json_builder_new ();
+  json_builder_begin_object (builder);
+
+  G_LOCK (mlops_source);
+  if (g_mlops_source_table) {
+    g_hash_table_iter_init (&iter, g_mlops_source_table);
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+      mlops_source_s *source = (mlops_source_s *) value;
+
+      json_builder_set_member_name (builder, (const gchar *) key);
+      json_builder_begin_object (builder);
+      json_builder_set_member_name (builder, "running");
+      json_builder_add_boolean_value (builder, source->pipeline != NULL);
+      json_builder_set_member_name (builder, "receivers");
+      json_builder_add_int_value (builder, g_list_length (source->receivers));
+      json_builder_set_member_name (builder, "buffers");
+      json_builder_add_int_value (builder, (gint64) source->buffers);
+      json_builder_set_member_name (builder, "dropped");
+      json_builder_add_int_value (builder, (gint64) source->dropped);
+      json_builder_end_object (builder);
+    }
+  }
+  G_UNLOCK (mlops_source);
+
+  json_builder_end_object (builder);
+
+  root = json_builder_get_root (builder);
+  *stats = json_to_string (root, FALSE);
+
+  json_node_unref (root);
+  g_object_unref (builder);
+  return 0;
+}
+
+/**
+ * @brief Stop the shared sources and release them.
+ */
+void
+mlops_node_source_finalize (void)
+{
+  GHashTable *table, *descs;
+  GHashTableIter iter;
+  gpointer value;
+  GList *l;
+
+  G_LOCK (mlops_source);
+  table = g_mlops_source_table;
+  g_mlops_source_table = NULL;
+  descs = g_mlops_source_descs;
+  g_mlops_source_descs = NULL;
+
+  /* The receivers still alive are not connected to the source any more. */
+  if (table) {
+    g_hash_table_iter_init (&iter, table);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+      mlops_source_s *source = (mlops_source_s *) value;
+
+      for (l = source->receivers; l != NULL; l = l->next)
+        ((mlops_source_receiver_s *) l->data)->source = NULL;
+    }
+  }
+  G_UNLOCK (mlops_source);
+
+  if (descs)
+    g_hash_table_destroy (descs);
+
+  if (!table)
+    return;
+
+  g_hash_table_iter_init (&iter, table);
+  while (g_hash_table_iter_next (&iter, NULL, &value)) {
+    mlops_source_s *source = (mlops_source_s *) value;
+
+    g_mutex_lock (&source->lock);
+    while (source->stopping)
+      g_cond_wait (&source->cond, &source->lock);
+
+    if (source->pipeline) {
+      gst_element_set_state (source->pipeline, GST_STATE_NULL);
+      gst_object_unref (source->pipeline);
+      source->pipeline = NULL;
+    }
+    g_mutex_unlock (&source->lock);
+  }
+
+  g_hash_table_destroy (table);
+}
@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-source.h
+ * @date      18 October 2026
+ * @brief     Shared source of the pipelines in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The description of the service may refer the stored source with '${source:name}', e.g., '${source:camera} ! tensor_converter ! ...'.
+ *            The source pipeline is launched once while the pipelines referring it are alive,
+ *            and its buffers are passed to the pipelines in the process without copying the data.
+ */
+
+#ifndef _MLOPS_AGENT_NODE_SOURCE_H_
+#define _MLOPS_AGENT_NODE_SOURCE_H_
+
+#include <glib.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Read the description of the shared source from the database, and get the element receiving the data from the source.
+ * @details This accesses the database. The description of the source should end with the source pad, e.g., 'v4l2src ! videoconvert'.
+ * @param[out] element The description of the element to replace the reference of the source.
+ * @return 0 on success, -EINVAL if the name is invalid, or the error to get the description.
+ */
+int mlops_node_source_prepare (const gchar *name, gchar **element);
+
+/**
+ * @brief Get the element receiving the data from the shared source prepared already.
+ * @details This does not access the database.
+ * @return 0 on success, -ENOENT if the source is not prepared with mlops_node_source_prepare().
+ */
+int mlops_node_source_get_element (const gchar *name, gchar **element);
+
+/**
+ * @brief Connect the receivers in the pipeline to the shared sources.
+ * @details This does not access the database. The source pipeline is launched when the first receiver starts playing,
+ *          and the receiver posts an error if it is failed to launch. The receiver gets the data while its pipeline is playing,
+ *          and the source pipeline is stopped when the last receiver is released.
+ * @return 0 on success, -ENOENT if the source is not prepared.
+ */
+int mlops_node_source_attach (GstElement *pipeline);
+
+/**
+ * @brief Get the statistics of the shared sources in JSON string.
+ */
+int mlops_node_source_get_stats (gchar **stats);
+
+/**
+ * @brief Stop the shared sources and release them.
+ */
+void mlops_node_source_finalize (void);
+
+G_END_DECLS
+#endif /* _MLOPS_AGENT_NODE_SOURCE_H_ */
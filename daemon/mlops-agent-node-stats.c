@@ -0,0 +1,495 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-stats.c
+ * @date      18 October 2026
+ * @brief     Runtime statistics of the pipeline in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   This collects the runtime statistics of the pipeline with the pad probes and the bus messages.
+ *            The pads added after launching the pipeline (e.g., the sometimes pads of demuxer) are not counted.
+ */
+
+#include <string.h>
+
+#include "log.h"
+#include "mlops-agent-node-stats.h"
+
+/**
+ * @brief Structure for the counters of the element, these are updated in the streaming thread.
+ */
+typedef struct
+{
+  guint64 buffers_in;
+  guint64 bytes_in;
+  guint64 buffers_out;
+  guint64 bytes_out;
+  gint64 enter_time;    /**< The time when the last buffer entered the element, reset when the buffer leaves the element */
+  gint64 last_time;     /**< The time when the last buffer entered the element, to detect the stalled sink */
+  guint64 latency_sum;
+  guint64 latency_count;
+  gint64 latency_max;
+  guint64 qos_processed;
+  guint64 qos_dropped;
+} mlops_element_counters_s;
+
+/**
+ * @brief Structure for the statistics of the element in the pipeline.
+ */
+typedef struct
+{
+  mlops_node_stats_s *stats;    /**< The statistics of the pipeline, not referenced */
+  gchar *name;
+  GWeakRef element;
+  gboolean is_sink;
+  gboolean is_queue;    /**< The element has the level properties of the queue */
+
+  GMutex lock;
+  mlops_element_counters_s counters;
+} mlops_element_stats_s;
+
+/**
+ * @brief Structure for the statistics of the pipeline.
+ */
+struct _mlops_node_stats_s
+{
+  gint refcount;        /**< The pad probes hold the reference, the statistics may live longer than the node */
+  GPtrArray *elements;  /**< The statistics of the elements, this is not changed after created */
+  GHashTable *table;    /**< The statistics of the elements with the element pointer as the key */
+  gboolean probe;       /**< The pad probes are added to count the buffers */
+
+  GMutex lock;
+  gint64 created;
+  GstState state;
+  gint64 state_since;
+  gint64 state_time[GST_STATE_PLAYING + 1];     /**< The time (in microseconds) spent in each state */
+};
+
+/**
+ * @brief Internal function to release the statistics of the element.
+ */
+static void
+_mlops_element_stats_free (gpointer data)
+{
+  mlops_element_stats_s *entry = (mlops_element_stats_s *) data;
+
+  g_free (entry->name);
+  g_weak_ref_clear (&entry->element);
+  g_mutex_clear (&entry->lock);
+  g_free (entry);
+}
+
+/**
+ * @brief Internal function to get the number of buffers and bytes of the probed data.
+ */
+static void
+_mlops_stats_get_size (GstPadProbeInfo * info, guint64 * buffers, guint64 * bytes)
+{
+  if (info->type & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+    GstBufferList *list = GST_PAD_PROBE_INFO_BUFFER_LIST (info);
+
+    *buffers = gst_buffer_list_length (list);
+    *bytes = gst_buffer_list_calculate_size (list);
+  } else {
+    *buffers = 1;
+    *bytes = gst_buffer_get_size (GST_PAD_PROBE_INFO_BUFFER (info));
+  }
+}
+
+/**
+ * @brief Pad probe to count the buffers entering the element.
+ */
+static GstPadProbeReturn
+_mlops_stats_sink_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  mlops_element_stats_s *entry = (mlops_element_stats_s *) user_data;
+  guint64 buffers, bytes;
+
+  _mlops_stats_get_size (info, &buffers, &bytes);
+
+  g_mutex_lock (&entry->lock);
+  entry->counters.buffers_in += buffers;
+  entry->counters.bytes_in += bytes;
+  entry->counters.enter_time = entry->counters.last_time = g_get_monotonic_time ();
+  g_mutex_unlock (&entry->lock);
+
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Pad probe to count the buffers leaving the element and measure the processing latency.
+ */
+static GstPadProbeReturn
+_mlops_stats_src_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  mlops_element_stats_s *entry = (mlops_element_stats_s *) user_data;
+  mlops_element_counters_s *counters = &entry->counters;
+  guint64 buffers, bytes;
+  gint64 now = g_get_monotonic_time ();
+
+  _mlops_stats_get_size (info, &buffers, &bytes);
+
+  g_mutex_lock (&entry->lock);
+  counters->buffers_out += buffers;
+  counters->bytes_out += bytes;
+
+  /* The queue pushes the buffer in the other thread, skip the waiting time in the queue. */
+  if (counters->enter_time > 0 && !entry->is_queue) {
+    gint64 latency = now - counters->enter_time;
+
+    counters->latency_sum += latency;
+    counters->latency_count++;
+    if (latency > counters->latency_max)
+      counters->latency_max = latency;
+
+    counters->enter_time = 0;
+  }
+  g_mutex_unlock (&entry->lock);
+
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Internal function to release the reference of the pad probe.
+ */
+static void
+_mlops_stats_probe_removed (gpointer data)
+{
+  mlops_element_stats_s *entry = (mlops_element_stats_s *) data;
+
+  mlops_node_stats_unref (entry->stats);
+}
+
+/**
+ * @brief Internal function to add the pad probe to the pad of the element.
+ */
+static gboolean
+_mlops_stats_add_probe (GstElement * element, GstPad * pad, gpointer user_data)
+{
+  mlops_element_stats_s *entry = (mlops_element_stats_s *) user_data;
+  GstPadProbeCallback probe;
+
+  probe = (GST_PAD_DIRECTION (pad) == GST_PAD_SINK) ?
+      _mlops_stats_sink_probe : _mlops_stats_src_probe;
+
+  g_atomic_int_inc (&entry->stats->refcount);
+  gst_pad_add_probe (pad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      probe, entry, _mlops_stats_probe_removed);
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to add the statistics of the element.
+ */
+static void
+_mlops_stats_add_element (mlops_node_stats_s * stats, GstElement * element)
+{
+  mlops_element_stats_s *entry;
+
+  /* The bin does not process the data, count the elements in the bin. */
+  if (GST_IS_BIN (element) || g_hash_table_contains (stats->table, element))
+    return;
+
+  entry = g_new0 (mlops_element_stats_s, 1);
+  entry->stats = stats;
+  entry->name = gst_element_get_name (element);
+  entry->is_sink = GST_OBJECT_FLAG_IS_SET (element, GST_ELEMENT_FLAG_SINK);
+  entry->is_queue = (g_object_class_find_property (G_OBJECT_GET_CLASS (element),
+          "current-level-buffers") != NULL);
+  g_weak_ref_init (&entry->element, element);
+  g_mutex_init (&entry->lock);
+
+  g_ptr_array_add (stats->elements, entry);
+  g_hash_table_insert (stats->table, element, entry);
+
+  if (stats->probe)
+    gst_element_foreach_pad (element, _mlops_stats_add_probe, entry);
+}
+
+/**
+ * @brief Create the statistics of the pipeline, and add the pad probes to the elements in the pipeline.
+ */
+mlops_node_stats_s *
+mlops_node_stats_new (GstElement * pipeline, gboolean probe)
+{
+  mlops_node_stats_s *stats;
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  gboolean done = FALSE;
+
+  g_return_val_if_fail (GST_IS_ELEMENT (pipeline), NULL);
+
+  stats = g_new0 (mlops_node_stats_s, 1);
+  stats->refcount = 1;
+  stats->elements = g_ptr_array_new_with_free_func (_mlops_element_stats_free);
+  stats->table = g_hash_table_new (g_direct_hash, g_direct_equal);
+  stats->probe = probe;
+  g_mutex_init (&stats->lock);
+
+  stats->created = stats->state_since = g_get_monotonic_time ();
+  stats->state = GST_STATE (pipeline);
+
+  if (!GST_IS_BIN (pipeline)) {
+    _mlops_stats_add_element (stats, pipeline);
+    return stats;
+  }
+
+  it = gst_bin_iterate_recurse (GST_BIN (pipeline));
+  while (!done) {
+    switch (gst_iterator_next (it, &item)) {
+      case GST_ITERATOR_OK:
+        _mlops_stats_add_element (stats, GST_ELEMENT (g_value_get_object (&item)));
+        g_value_reset (&item);
+        break;
+      case GST_ITERATOR_RESYNC:
+        /* The elements already added are skipped. */
+        gst_iterator_resync (it);
+        break;
+      default:
+        done = TRUE;
+        break;
+    }
+  }
+
+  g_value_unset (&item);
+  gst_iterator_free (it);
+
+  return stats;
+}
+
+/**
+ * @brief Decrease the reference count of the statistics, and release it if this is the last reference.
+ */
+void
+mlops_node_stats_unref (mlops_node_stats_s * stats)
+{
+  if (!stats || !g_atomic_int_dec_and_test (&stats->refcount))
+    return;
+
+  g_hash_table_destroy (stats->table);
+  g_ptr_array_free (stats->elements, TRUE);
+  g_mutex_clear (&stats->lock);
+  g_free (stats);
+}
+
+/**
+ * @brief Update the time spent in each state with the new state of the pipeline.
+ */
+void
+mlops_node_stats_set_state (mlops_node_stats_s * stats, GstState state)
+{
+  gint64 now = g_get_monotonic_time ();
+
+  g_return_if_fail (stats != NULL);
+
+  g_mutex_lock (&stats->lock);
+  if (stats->state != state) {
+    if (stats->state <= GST_STATE_PLAYING)
+      stats->state_time[stats->state] += now - stats->state_since;
+
+    stats->state = state;
+    stats->state_since = now;
+  }
+  g_mutex_unlock (&stats->lock);
+}
+
+/**
+ * @brief Update the statistics with the bus message of the pipeline, e.g., QoS.
+ */
+void
+mlops_node_stats_handle_message (mlops_node_stats_s * stats, GstMessage * msg)
+{
+  mlops_element_stats_s *entry;
+  GstFormat format;
+  guint64 processed, dropped;
+
+  g_return_if_fail (stats != NULL);
+
+  if (GST_MESSAGE_TYPE (msg) != GST_MESSAGE_QOS)
+    return;
+
+  /* The table is not changed after created, this does not need the lock. */
+  entry = (mlops_element_stats_s *) g_hash_table_lookup (stats->table, GST_MESSAGE_SRC (msg));
+  if (!entry)
+    return;
+
+  /* The element posts the total number of the processed and dropped data. */
+  gst_message_parse_qos_stats (msg, &format, &processed, &dropped);
+  if (format != GST_FORMAT_BUFFERS && format != GST_FORMAT_DEFAULT)
+    return;
+
+  g_mutex_lock (&entry->lock);
+  entry->counters.qos_processed = processed;
+  entry->counters.qos_dropped = dropped;
+  g_mutex_unlock (&entry->lock);
+}
+
+/**
+ * @brief Get the monotonic time when the last buffer entered the sinks of the pipeline.
+ */
+gint64
+mlops_node_stats_get_last_buffer (mlops_node_stats_s * stats)
+{
+  gint64 last = 0;
+  guint i;
+
+  g_return_val_if_fail (stats != NULL, 0);
+
+  for (i = 0; i < stats->elements->len; i++) {
+    mlops_element_stats_s *entry = (mlops_element_stats_s *) g_ptr_array_index (stats->elements, i);
+
+    if (!entry->is_sink)
+      continue;
+
+    g_mutex_lock (&entry->lock);
+    last = MAX (last, entry->counters.last_time);
+    g_mutex_unlock (&entry->lock);
+  }
+
+  return last;
+}
+
+/**
+ * @brief Internal function to get the rate per second.
+ */
+static gdouble
+_mlops_stats_get_rate (guint64 count, gint64 duration)
+{
+  return (duration > 0) ? ((gdouble) count * G_USEC_PER_SEC / (gdouble) duration) : 0.0;
+}
+
+/**
+ * @brief Internal function to add the level of the queue into the JSON object being built.
+ */
+static void
+_mlops_stats_build_queue_level (mlops_element_stats_s * entry, JsonBuilder * builder)
+{
+  GstElement *element = (GstElement *) g_weak_ref_get (&entry->element);
+  guint level_buffers = 0, level_bytes = 0, max_buffers = 0;
+  guint64 level_time = 0;
+
+  if (!element)
+    return;
+
+  g_object_get (element, "current-level-buffers", &level_buffers,
+      "current-level-bytes", &level_bytes, "current-level-time", &level_time,
+      "max-size-buffers", &max_buffers, NULL);
+  gst_object_unref (element);
+
+  json_builder_set_member_name (builder, "level_buffers");
+  json_builder_add_int_value (builder, level_buffers);
+  json_builder_set_member_name (builder, "level_bytes");
+  json_builder_add_int_value (builder, level_bytes);
+  json_builder_set_member_name (builder, "level_time_ns");
+  json_builder_add_int_value (builder, (gint64) level_time);
+  json_builder_set_member_name (builder, "max_buffers");
+  json_builder_add_int_value (builder, max_buffers);
+}
+
+/**
+ * @brief Add the statistics into the JSON object being built.
+ */
+void
+mlops_node_stats_build (mlops_node_stats_s * stats, JsonBuilder * builder)
+{
+  gint64 state_time[GST_STATE_PLAYING + 1];
+  gint64 now = g_get_monotonic_time ();
+  guint64 sink_buffers = 0, sink_bytes = 0, dropped = 0;
+  gint64 uptime;
+  guint i;
+
+  g_return_if_fail (stats != NULL);
+  g_return_if_fail (builder != NULL);
+
+  g_mutex_lock (&stats->lock);
+  memcpy (state_time, stats->state_time, sizeof (state_time));
+  if (stats->state <= GST_STATE_PLAYING)
+    state_time[stats->state] += now - stats->state_since;
+  uptime = now - stats->created;
+  g_mutex_unlock (&stats->lock);
+
+  json_builder_set_member_name (builder, "uptime_ms");
+  json_builder_add_int_value (builder, uptime / G_TIME_SPAN_MILLISECOND);
+
+  json_builder_set_member_name (builder, "probe");
+  json_builder_add_boolean_value (builder, stats->probe);
+
+  json_builder_set_member_name (builder, "state_time_ms");
+  json_builder_begin_object (builder);
+  for (i = GST_STATE_NULL; i <= GST_STATE_PLAYING; i++) {
+    json_builder_set_member_name (builder, gst_element_state_get_name ((GstState) i));
+    json_builder_add_int_value (builder, state_time[i] / G_TIME_SPAN_MILLISECOND);
+  }
+  json_builder_end_object (builder);
+
+  /* The rates are calculated with the time spent in the playing state. */
+  json_builder_set_member_name (builder, "elements");
+  json_builder_begin_array (builder);
+  for (i = 0; i < stats->elements->len; i++) {
+    mlops_element_stats_s *entry = (mlops_element_stats_s *) g_ptr_array_index (stats->elements, i);
+    mlops_element_counters_s snapshot;
+
+    g_mutex_lock (&entry->lock);
+    memcpy (&snapshot, &entry->counters, sizeof (snapshot));
+    g_mutex_unlock (&entry->lock);
+
+    if (entry->is_sink) {
+      sink_buffers += snapshot.buffers_in;
+      sink_bytes += snapshot.bytes_in;
+    }
+    dropped += snapshot.qos_dropped;
+
+    json_builder_begin_object (builder);
+    json_builder_set_member_name (builder, "name");
+    json_builder_add_string_value (builder, entry->name);
+    json_builder_set_member_name (builder, "buffers_in");
+    json_builder_add_int_value (builder, (gint64) snapshot.buffers_in);
+    json_builder_set_member_name (builder, "bytes_in");
+    json_builder_add_int_value (builder, (gint64) snapshot.bytes_in);
+    json_builder_set_member_name (builder, "buffers_out");
+    json_builder_add_int_value (builder, (gint64) snapshot.buffers_out);
+    json_builder_set_member_name (builder, "bytes_out");
+    json_builder_add_int_value (builder, (gint64) snapshot.bytes_out);
+    json_builder_set_member_name (builder, "buffers_per_sec");
+    json_builder_add_double_value (builder, _mlops_stats_get_rate (entry->is_sink ?
+            snapshot.buffers_in : snapshot.buffers_out, state_time[GST_STATE_PLAYING]));
+    json_builder_set_member_name (builder, "bytes_per_sec");
+    json_builder_add_double_value (builder, _mlops_stats_get_rate (entry->is_sink ?
+            snapshot.bytes_in : snapshot.bytes_out, state_time[GST_STATE_PLAYING]));
+
+    if (snapshot.latency_count > 0) {
+      json_builder_set_member_name (builder, "latency_avg_us");
+      json_builder_add_int_value (builder,
+          (gint64) (snapshot.latency_sum / snapshot.latency_count));
+      json_builder_set_member_name (builder, "latency_max_us");
+      json_builder_add_int_value (builder, snapshot.latency_max);
+    }
+
+    json_builder_set_member_name (builder, "qos_processed");
+    json_builder_add_int_value (builder, (gint64) snapshot.qos_processed);
+    json_builder_set_member_name (builder, "qos_dropped");
+    json_builder_add_int_value (builder, (gint64) snapshot.qos_dropped);
+
+    if (entry->is_queue)
+      _mlops_stats_build_queue_level (entry, builder);
+
+    json_builder_end_object (builder);
+  }
+  json_builder_end_array (builder);
+
+  json_builder_set_member_name (builder, "buffers_per_sec");
+  json_builder_add_double_value (builder,
+      _mlops_stats_get_rate (sink_buffers, state_time[GST_STATE_PLAYING]));
+  json_builder_set_member_name (builder, "bytes_per_sec");
+  json_builder_add_double_value (builder,
+      _mlops_stats_get_rate (sink_bytes, state_time[GST_STATE_PLAYING]));
+  json_builder_set_member_name (builder, "dropped");
+  json_builder_add_int_value (builder, (gint64) dropped);
+}
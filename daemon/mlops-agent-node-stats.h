@@ -0,0 +1,63 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-stats.h
+ * @date      18 October 2026
+ * @brief     Runtime statistics of the pipeline in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   This collects the runtime statistics of the pipeline with the pad probes and the bus messages.
+ */
+
+#ifndef _MLOPS_AGENT_NODE_STATS_H_
+#define _MLOPS_AGENT_NODE_STATS_H_
+
+#include <glib.h>
+#include <gst/gst.h>
+#include <json-glib/json-glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct _mlops_node_stats_s mlops_node_stats_s;
+
+/**
+ * @brief Create the statistics of the pipeline, and add the pad probes to the elements in the pipeline.
+ * @param pipeline The pipeline to collect the statistics.
+ * @param probe FALSE not to add the pad probes, the buffers and the latency of the elements are not counted.
+ */
+mlops_node_stats_s *mlops_node_stats_new (GstElement *pipeline, gboolean probe);
+
+/**
+ * @brief Decrease the reference count of the statistics, and release it if this is the last reference.
+ */
+void mlops_node_stats_unref (mlops_node_stats_s *stats);
+
+/**
+ * @brief Update the time spent in each state with the new state of the pipeline.
+ */
+void mlops_node_stats_set_state (mlops_node_stats_s *stats, GstState state);
+
+/**
+ * @brief Update the statistics with the bus message of the pipeline, e.g., QoS.
+ */
+void mlops_node_stats_handle_message (mlops_node_stats_s *stats, GstMessage *msg);
+
+/**
+ * @brief Get the monotonic time when the last buffer entered the sinks of the pipeline.
+ * @details The time is recorded by the pad probes counting the buffers, this does not add the probe.
+ * @return The time in microseconds, 0 if no buffer entered the sinks.
+ */
+gint64 mlops_node_stats_get_last_buffer (mlops_node_stats_s *stats);
+
+/**
+ * @brief Add the statistics into the JSON object being built.
+ */
+void mlops_node_stats_build (mlops_node_stats_s *stats, JsonBuilder *builder);
+
+G_END_DECLS
+#endif /* _MLOPS_AGENT_NODE_STATS_H_ */
@@ -0,0 +1,492 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-taskpool.c
+ * @date      18 October 2026
+ * @brief     Shared streaming thread pool of the pipelines in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The streaming task of GStreamer keeps its thread until the task is stopped. The tasks run in the workers up to the bound,
+ *            and the task over the bound waits in the queue until a worker finishes its task. The task stopped while it is waiting
+ *            is run in the reaper thread, where it exits immediately, so stopping the pipeline does not wait for the other pipelines.
+ */
+
+#include <errno.h>
+#include <json-glib/json-glib.h>
+
+#include "log.h"
+#include "mlops-agent-node-taskpool.h"
+
+/**
+ * @brief The default number of the workers for each core.
+ * @details The streaming task blocks the worker while the pipeline is running, so the pool has more workers than the cores.
+ */
+#define MLOPS_TASK_POOL_THREADS_PER_CORE (4U)
+
+/**
+ * @brief The interval (in microseconds) to check the waiting tasks are stopped.
+ */
+#define MLOPS_TASK_POOL_REAP_INTERVAL (10 * G_TIME_SPAN_MILLISECOND)
+
+/**
+ * @brief Structure for the shared task pool.
+ */
+typedef struct
+{
+  GstTaskPool parent;
+
+  GThreadPool *workers; /**< The threads to run the tasks, up to the bound */
+  GThread *reaper;      /**< The thread to run the waiting tasks which are stopped */
+  GMutex lock;
+  GCond cond;           /**< Signalled when the task is queued or the pool is closed */
+  GQueue pending;       /**< The tasks (mlops_task_s) waiting for the worker */
+  gboolean closing;
+  guint bound;          /**< The maximum number of the workers running the tasks */
+  guint active;         /**< The number of the workers running the tasks */
+  guint peak;           /**< The maximum number of the workers running the tasks */
+  guint64 tasks;        /**< The number of the tasks pushed to the pool */
+  guint64 threads;      /**< The number of the threads of the workers which have run the tasks */
+  guint64 queued;       /**< The number of the tasks queued because the workers are busy */
+  guint64 cancelled;    /**< The number of the tasks stopped while waiting for the worker */
+  gboolean warned;
+} MLOpsTaskPool;
+
+/**
+ * @brief Structure for the class of the shared task pool.
+ */
+typedef struct
+{
+  GstTaskPoolClass parent_class;
+} MLOpsTaskPoolClass;
+
+/**
+ * @brief Structure for the task pushed to the shared task pool.
+ */
+typedef struct
+{
+  GstTaskPoolFunction func;
+  gpointer user_data;   /**< The streaming task (GstTask) */
+} mlops_task_s;
+
+GType mlops_task_pool_get_type (void);
+G_DEFINE_TYPE (MLOpsTaskPool, mlops_task_pool, GST_TYPE_TASK_POOL);
+
+static GPrivate g_mlops_task_thread = G_PRIVATE_INIT (NULL);
+static GstTaskPool *g_mlops_task_pool = NULL;
+static guint g_mlops_task_pool_bound = 0U;
+G_LOCK_DEFINE_STATIC (mlops_task_pool);
+
+/**
+ * @brief Internal function to get the bound of the pool, the default is proportional to the number of the cores.
+ */
+static guint
+_mlops_task_pool_get_bound (void)
+{
+  guint bound;
+
+  G_LOCK (mlops_task_pool);
+  bound = g_mlops_task_pool_bound;
+  G_UNLOCK (mlops_task_pool);
+
+  if (bound == 0U)
+    bound = MAX (g_get_num_processors (), 1) * MLOPS_TASK_POOL_THREADS_PER_CORE;
+
+  return bound;
+}
+
+/**
+ * @brief Internal function to run the task and release it.
+ */
+static void
+_mlops_task_pool_run_task (mlops_task_s * task)
+{
+  task->func (task->user_data);
+  g_free (task);
+}
+
+/**
+ * @brief Internal function to run the task in the thread of the workers.
+ * @details The worker takes the waiting task when its task is finished, the number of the running workers does not exceed the bound.
+ */
+static void
+_mlops_task_pool_run (gpointer data, gpointer user_data)
+{
+  MLOpsTaskPool *self = (MLOpsTaskPool *) user_data;
+  mlops_task_s *task = (mlops_task_s *) data;
+
+  if (g_private_get (&g_mlops_task_thread) == NULL) {
+    g_private_set (&g_mlops_task_thread, GINT_TO_POINTER (1));
+
+    g_mutex_lock (&self->lock);
+    self->threads++;
+    g_mutex_unlock (&self->lock);
+  }
+
+  while (task) {
+    _mlops_task_pool_run_task (task);
+
+    g_mutex_lock (&self->lock);
+    task = (self->active <= self->bound) ?
+        (mlops_task_s *) g_queue_pop_head (&self->pending) : NULL;
+    if (!task) {
+      self->active--;
+      self->warned = FALSE;
+    }
+    g_mutex_unlock (&self->lock);
+  }
+}
+
+/**
+ * @brief Internal function to check the streaming task is stopped before it is run.
+ */
+static gboolean
+_mlops_task_pool_is_stopped (mlops_task_s * task)
+{
+  return (GST_IS_TASK (task->user_data) &&
+      GST_TASK_STATE (GST_TASK (task->user_data)) == GST_TASK_STOPPED);
+}
+
+/**
+ * @brief Internal function to run the waiting tasks which are stopped.
+ * @details The thread joining the stopped task waits until its function returns, the function of the stopped task returns immediately.
+ */
+static gpointer
+_mlops_task_pool_reap (gpointer data)
+{
+  MLOpsTaskPool *self = (MLOpsTaskPool *) data;
+  GList *stopped, *l, *next;
+
+  g_mutex_lock (&self->lock);
+  while (!self->closing) {
+    if (g_queue_is_empty (&self->pending)) {
+      g_cond_wait (&self->cond, &self->lock);
+      continue;
+    }
+
+    g_cond_wait_until (&self->cond, &self->lock,
+        g_get_monotonic_time () + MLOPS_TASK_POOL_REAP_INTERVAL);
+
+    stopped = NULL;
+    for (l = self->pending.head; l != NULL; l = next) {
+      next = l->next;
+
+      if (_mlops_task_pool_is_stopped ((mlops_task_s *) l->data)) {
+        stopped = g_list_prepend (stopped, l->data);
+        g_queue_delete_link (&self->pending, l);
+        self->cancelled++;
+      }
+    }
+
+    if (!stopped)
+      continue;
+
+    g_mutex_unlock (&self->lock);
+    g_list_free_full (stopped, (GDestroyNotify) _mlops_task_pool_run_task);
+    g_mutex_lock (&self->lock);
+  }
+  g_mutex_unlock (&self->lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Prepare the workers of the shared task pool.
+ */
+static void
+mlops_task_pool_prepare (GstTaskPool * pool, GError ** error)
+{
+  MLOpsTaskPool *self = (MLOpsTaskPool *) pool;
+
+  /* The workers are not exclusive, the idle threads follow the limit of GLib for all thread pools. */
+  self->workers = g_thread_pool_new (_mlops_task_pool_run, self, (gint) self->bound, FALSE, error);
+  if (!self->workers)
+    return;
+
+  self->reaper = g_thread_try_new ("mlops-task-reaper", _mlops_task_pool_reap, self, error);
+  if (!self->reaper) {
+    g_thread_pool_free (self->workers, TRUE, FALSE);
+    self->workers = NULL;
+  }
+}
+
+/**
+ * @brief Release the workers of the shared task pool, after the running tasks are finished.
+ */
+static void
+mlops_task_pool_cleanup (GstTaskPool * pool)
+{
+  MLOpsTaskPool *self = (MLOpsTaskPool *) pool;
+
+  if (self->reaper) {
+    g_mutex_lock (&self->lock);
+    self->closing = TRUE;
+    g_cond_broadcast (&self->cond);
+    g_mutex_unlock (&self->lock);
+
+    g_thread_join (self->reaper);
+    self->reaper = NULL;
+  }
+
+  if (self->workers) {
+    g_thread_pool_free (self->workers, FALSE, TRUE);
+    self->workers = NULL;
+  }
+}
+
+/**
+ * @brief Push the task to the pool.
+ * @details The streaming task keeps the worker until it is stopped. The task over the bound is not run in the new thread,
+ *          it waits in the queue until a worker finishes its task. The pipeline whose task is waiting does not stream,
+ *          and stopping it does not wait for the worker because the reaper runs the stopped task.
+ * @return NULL, the task is joined by GstTask when its function returns.
+ */
+static gpointer
+mlops_task_pool_push (GstTaskPool * pool, GstTaskPoolFunction func,
+    gpointer user_data, GError ** error)
+{
+  MLOpsTaskPool *self = (MLOpsTaskPool *) pool;
+  mlops_task_s *task;
+  gboolean pooled, warn = FALSE;
+  guint active;
+
+  task = g_new0 (mlops_task_s, 1);
+  task->func = func;
+  task->user_data = user_data;
+
+  g_mutex_lock (&self->lock);
+  self->tasks++;
+  pooled = (self->active < self->bound);
+  if (pooled) {
+    self->active++;
+    self->peak = MAX (self->peak, self->active);
+  } else {
+    g_queue_push_tail (&self->pending, task);
+    g_cond_signal (&self->cond);
+    self->queued++;
+    warn = !self->warned;
+    self->warned = TRUE;
+  }
+  active = self->active;
+  g_mutex_unlock (&self->lock);
+
+  if (!pooled) {
+    if (warn) {
+      ml_logw ("The running streaming tasks (%u) reach the bound of the pool (%u), the task waits for the worker.",
+          active, self->bound);
+    }
+    return NULL;
+  }
+
+  if (!g_thread_pool_push (self->workers, task, error)) {
+    g_mutex_lock (&self->lock);
+    self->active--;
+    g_mutex_unlock (&self->lock);
+
+    g_free (task);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Initialize the class of the shared task pool.
+ */
+static void
+mlops_task_pool_class_init (MLOpsTaskPoolClass * klass)
+{
+  GstTaskPoolClass *pool_class = GST_TASK_POOL_CLASS (klass);
+
+  pool_class->prepare = mlops_task_pool_prepare;
+  pool_class->cleanup = mlops_task_pool_cleanup;
+  pool_class->push = mlops_task_pool_push;
+}
+
+/**
+ * @brief Initialize the shared task pool.
+ */
+static void
+mlops_task_pool_init (MLOpsTaskPool * self)
+{
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond);
+  g_queue_init (&self->pending);
+  self->bound = _mlops_task_pool_get_bound ();
+}
+
+/**
+ * @brief Internal function to create the shared task pool once in the process.
+ */
+static gpointer
+_mlops_task_pool_create (gpointer data)
+{
+  GstTaskPool *pool;
+  GError *err = NULL;
+
+  pool = (GstTaskPool *) g_object_new (mlops_task_pool_get_type (), NULL);
+  gst_object_ref_sink (pool);
+
+  gst_task_pool_prepare (pool, &err);
+  if (err) {
+    ml_loge ("Failed to prepare the shared task pool: %s", err->message);
+    g_clear_error (&err);
+    gst_object_unref (pool);
+    return NULL;
+  }
+
+  G_LOCK (mlops_task_pool);
+  g_mlops_task_pool = pool;
+  G_UNLOCK (mlops_task_pool);
+
+  return pool;
+}
+
+/**
+ * @brief Get the shared task pool. The caller should release the returned pool using gst_object_unref().
+ */
+GstTaskPool *
+mlops_node_task_pool_get (void)
+{
+  static GOnce once = G_ONCE_INIT;
+  GstTaskPool *pool;
+
+  /* The pool is kept until the process exits, the tasks of the released pipelines may still refer it. */
+  pool = (GstTaskPool *) g_once (&once, _mlops_task_pool_create, NULL);
+
+  return pool ? (GstTaskPool *) gst_object_ref (pool) : NULL;
+}
+
+/**
+ * @brief Set the maximum number of the workers running the streaming tasks.
+ */
+void
+mlops_node_task_pool_set_bound (const guint bound)
+{
+  MLOpsTaskPool *self;
+  GstTaskPool *pool;
+  GList *started = NULL, *l;
+  guint max;
+
+  /* The pool is created with the bound when the first pipeline is built, GStreamer may not be initialized yet. */
+  G_LOCK (mlops_task_pool);
+  g_mlops_task_pool_bound = bound;
+  pool = g_mlops_task_pool ? (GstTaskPool *) gst_object_ref (g_mlops_task_pool) : NULL;
+  G_UNLOCK (mlops_task_pool);
+
+  if (!pool)
+    return;
+
+  self = (MLOpsTaskPool *) pool;
+  max = _mlops_task_pool_get_bound ();
+
+  /* The running tasks are kept, and the waiting tasks are started if the bound is increased. */
+  g_mutex_lock (&self->lock);
+  self->bound = max;
+  self->peak = self->active;
+  while (self->active < self->bound && !g_queue_is_empty (&self->pending)) {
+    started = g_list_append (started, g_queue_pop_head (&self->pending));
+    self->active++;
+  }
+  g_mutex_unlock (&self->lock);
+
+  g_thread_pool_set_max_threads (self->workers, (gint) max, NULL);
+
+  for (l = started; l != NULL; l = l->next) {
+    if (!g_thread_pool_push (self->workers, l->data, NULL)) {
+      g_mutex_lock (&self->lock);
+      g_queue_push_head (&self->pending, l->data);
+      self->active--;
+      g_mutex_unlock (&self->lock);
+    }
+  }
+
+  g_list_free (started);
+  gst_object_unref (pool);
+}
+
+/**
+ * @brief Set the shared task pool to the streaming task in the stream-status message.
+ */
+void
+mlops_node_task_pool_handle_message (GstMessage * msg)
+{
+  GstStreamStatusType type;
+  GstElement *owner = NULL;
+  const GValue *value;
+  GstTaskPool *pool;
+
+  g_return_if_fail (msg != NULL);
+
+  if (GST_MESSAGE_TYPE (msg) != GST_MESSAGE_STREAM_STATUS)
+    return;
+
+  gst_message_parse_stream_status (msg, &type, &owner);
+  if (type != GST_STREAM_STATUS_TYPE_CREATE)
+    return;
+
+  value = gst_message_get_stream_status_object (msg);
+  if (!value || !G_VALUE_HOLDS (value, GST_TYPE_TASK))
+    return;
+
+  pool = mlops_node_task_pool_get ();
+  if (pool) {
+    gst_task_set_pool (GST_TASK (g_value_get_object (value)), pool);
+    gst_object_unref (pool);
+  }
+}
+
+/**
+ * @brief Get the statistics of the shared task pool in JSON string.
+ */
+int
+mlops_node_task_pool_get_stats (gchar ** stats)
+{
+  MLOpsTaskPool *self;
+  GstTaskPool *pool;
+  JsonBuilder *builder;
+  JsonNode *root;
+
+  g_return_val_if_fail (stats != NULL, -EINVAL);
+
+  pool = mlops_node_task_pool_get ();
+  if (!pool)
+    return -EIO;
+
+  self = (MLOpsTaskPool *) pool;
+
+  builder = json_builder_new ();
+  json_builder_begin_object (builder);
+
+  g_mutex_lock (&self->lock);
+  json_builder_set_member_name (builder, "bound");
+  json_builder_add_int_value (builder, self->bound);
+  json_builder_set_member_name (builder, "active");
+  json_builder_add_int_value (builder, self->active);
+  json_builder_set_member_name (builder, "pending");
+  json_builder_add_int_value (builder, self->pending.length);
+  json_builder_set_member_name (builder, "peak");
+  json_builder_add_int_value (builder, self->peak);
+  json_builder_set_member_name (builder, "tasks");
+  json_builder_add_int_value (builder, (gint64) self->tasks);
+  json_builder_set_member_name (builder, "threads");
+  json_builder_add_int_value (builder, (gint64) self->threads);
+  json_builder_set_member_name (builder, "queued");
+  json_builder_add_int_value (builder, (gint64) self->queued);
+  json_builder_set_member_name (builder, "cancelled");
+  json_builder_add_int_value (builder, (gint64) self->cancelled);
+  g_mutex_unlock (&self->lock);
+
+  json_builder_end_object (builder);
+
+  root = json_builder_get_root (builder);
+  *stats = json_to_string (root, FALSE);
+
+  json_node_unref (root);
+  g_object_unref (builder);
+  gst_object_unref (pool);
+  return 0;
+}
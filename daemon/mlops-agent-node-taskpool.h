@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-taskpool.h
+ * @date      18 October 2026
+ * @brief     Shared streaming thread pool of the pipelines in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The streaming tasks of all pipelines launched by mlops node run on one task pool,
+ *            so that the threads are reused across the pipelines and accounted in one place.
+ *            The workers of the pool are bounded, and the tasks over the bound wait for the worker.
+ */
+
+#ifndef _MLOPS_AGENT_NODE_TASKPOOL_H_
+#define _MLOPS_AGENT_NODE_TASKPOOL_H_
+
+#include <glib.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Get the shared task pool. The caller should release the returned pool using gst_object_unref().
+ */
+GstTaskPool *mlops_node_task_pool_get (void);
+
+/**
+ * @brief Set the maximum number of the workers running the streaming tasks.
+ * @details The streaming task keeps its worker until it is stopped, so the task over the bound waits until a running task is stopped,
+ *          and its pipeline does not stream meanwhile. The waiting task which is stopped is released without the worker.
+ *          Set 0 to use the default, 4 workers for each core. The running tasks are kept if the bound is decreased.
+ */
+void mlops_node_task_pool_set_bound (const guint bound);
+
+/**
+ * @brief Set the shared task pool to the streaming task in the stream-status message.
+ * @details This should be called in the sync handler of the bus, before the task is started.
+ */
+void mlops_node_task_pool_handle_message (GstMessage *msg);
+
+/**
+ * @brief Get the statistics of the shared task pool in JSON string.
+ */
+int mlops_node_task_pool_get_stats (gchar **stats);
+
+G_END_DECLS
+#endif /* _MLOPS_AGENT_NODE_TASKPOOL_H_ */
@@ -0,0 +1,743 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-template.c
+ * @date      18 October 2026
+ * @brief     Parameterized pipeline description in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The description is split into the tokens when the service is set, so launching the pipeline only joins
+ *            the tokens with the values of the parameters. The parsed description is kept with the name of the service.
+ *            The path and version of the activated model are kept until the model is changed.
+ *            The reference of the shared source is replaced with the element receiving the data from the source.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <json-glib/json-glib.h>
+
+#include "log.h"
+#include "mlops-agent-internal.h"
+#include "mlops-agent-node-source.h"
+#include "mlops-agent-node-template.h"
+#include "service-db-util.h"
+
+/**
+ * @brief The prefix of the placeholder for the path of the activated model.
+ * @details This is used in '${model:name}', or without the braces in the value of the model property, e.g., model=model:name.
+ */
+#define MLOPS_TEMPLATE_MODEL_PREFIX "model:"
+
+/**
+ * @brief The prefix of the placeholder for the shared source, e.g., '${source:name}'.
+ */
+#define MLOPS_TEMPLATE_SOURCE_PREFIX "source:"
+
+/**
+ * @brief The model property, the model reference without the braces is allowed only in its value.
+ */
+#define MLOPS_TEMPLATE_MODEL_PROPERTY "model="
+
+/**
+ * @brief The separator of the parameter name and its default value.
+ */
+#define MLOPS_TEMPLATE_DEFAULT_SEPARATOR ":-"
+
+/**
+ * @brief The type of the token in the description.
+ */
+typedef enum
+{
+  MLOPS_TEMPLATE_TOKEN_TEXT = 0,
+  MLOPS_TEMPLATE_TOKEN_PARAM,
+  MLOPS_TEMPLATE_TOKEN_MODEL,
+  MLOPS_TEMPLATE_TOKEN_SOURCE
+} mlops_template_token_e;
+
+/**
+ * @brief Structure for the token in the description.
+ */
+typedef struct
+{
+  mlops_template_token_e type;
+  gchar *text;          /**< The text, the name of the parameter, the name of the model or the name of the source */
+  gchar *value;         /**< The default value of the parameter, NULL if the parameter should be given */
+} mlops_template_token_s;
+
+/**
+ * @brief Structure for the parsed description of the service.
+ */
+typedef struct
+{
+  gint refcount;
+  gchar *source;        /**< The description of the service */
+  GPtrArray *tokens;    /**< The tokens of the description, NULL if the description does not have the placeholder */
+} mlops_template_s;
+
+static GHashTable *g_mlops_template_table = NULL;
+static GHashTable *g_mlops_template_models = NULL;
+G_LOCK_DEFINE_STATIC (mlops_template);
+
+/**
+ * @brief Internal function to release the token.
+ */
+static void
+_mlops_template_token_free (gpointer data)
+{
+  mlops_template_token_s *token = (mlops_template_token_s *) data;
+
+  g_free (token->text);
+  g_free (token->value);
+  g_free (token);
+}
+
+/**
+ * @brief Internal function to add the token into the parsed description.
+ */
+static void
+_mlops_template_add_token (GPtrArray * tokens, mlops_template_token_e type,
+    gchar * text, gchar * value)
+{
+  mlops_template_token_s *token = g_new0 (mlops_template_token_s, 1);
+
+  token->type = type;
+  token->text = text;
+  token->value = value;
+  g_ptr_array_add (tokens, token);
+}
+
+/**
+ * @brief Internal function to release the reference of the parsed description.
+ */
+static void
+_mlops_template_unref (gpointer data)
+{
+  mlops_template_s *tmpl = (mlops_template_s *) data;
+
+  if (!tmpl || !g_atomic_int_dec_and_test (&tmpl->refcount))
+    return;
+
+  if (tmpl->tokens)
+    g_ptr_array_unref (tmpl->tokens);
+  g_free (tmpl->source);
+  g_free (tmpl);
+}
+
+/**
+ * @brief Internal function to parse the placeholder, the string between '${' and '}'.
+ * @return 0 on success, -EINVAL if the string is not a valid placeholder. The token is not added in this case.
+ */
+static int
+_mlops_template_parse_placeholder (GPtrArray * tokens, const gchar * str, const gsize len)
+{
+  gchar *body = g_strndup (str, len);
+  const gchar *rest;
+  gsize i = 0;
+
+  while (g_ascii_isalnum (body[i]) || body[i] == '_')
+    i++;
+
+  rest = body + i;
+  if (i > 0 && *rest == '\0') {
+    _mlops_template_add_token (tokens, MLOPS_TEMPLATE_TOKEN_PARAM, g_strdup (body), NULL);
+  } else if (i > 0 && g_str_has_prefix (rest, MLOPS_TEMPLATE_DEFAULT_SEPARATOR)) {
+    _mlops_template_add_token (tokens, MLOPS_TEMPLATE_TOKEN_PARAM, g_strndup (body, i),
+        g_strdup (rest + strlen (MLOPS_TEMPLATE_DEFAULT_SEPARATOR)));
+  } else if (g_str_has_prefix (body, MLOPS_TEMPLATE_MODEL_PREFIX) &&
+      STR_IS_VALID (body + strlen (MLOPS_TEMPLATE_MODEL_PREFIX)) && !strpbrk (body, " \t\r\n")) {
+    _mlops_template_add_token (tokens, MLOPS_TEMPLATE_TOKEN_MODEL,
+        g_strdup (body + strlen (MLOPS_TEMPLATE_MODEL_PREFIX)), NULL);
+  } else if (g_str_has_prefix (body, MLOPS_TEMPLATE_SOURCE_PREFIX) &&
+      STR_IS_VALID (body + strlen (MLOPS_TEMPLATE_SOURCE_PREFIX)) && !strpbrk (body, " \t\r\n")) {
+    _mlops_template_add_token (tokens, MLOPS_TEMPLATE_TOKEN_SOURCE,
+        g_strdup (body + strlen (MLOPS_TEMPLATE_SOURCE_PREFIX)), NULL);
+  } else {
+    g_free (body);
+    return -EINVAL;
+  }
+
+  g_free (body);
+  return 0;
+}
+
+/**
+ * @brief Internal function to get the length of the model reference without the braces at @a ref, e.g., model:name.
+ * @return The length of the reference, 0 if @a ref is not the model reference.
+ */
+static gsize
+_mlops_template_model_ref_len (const gchar * ref)
+{
+  const gchar *model;
+  gsize n = 0;
+
+  if (!g_str_has_prefix (ref, MLOPS_TEMPLATE_MODEL_PREFIX))
+    return 0;
+
+  model = ref + strlen (MLOPS_TEMPLATE_MODEL_PREFIX);
+  while (model[n] != '\0' && (g_ascii_isalnum (model[n]) || strchr ("_-.", model[n])))
+    n++;
+
+  return (n > 0) ? (model - ref) + n : 0;
+}
+
+/**
+ * @brief Internal function to find the model reference without the braces from @a pos, e.g., model=model:name.
+ * @details The reference is allowed only at the start of the value of the model property, or after ',' in the value.
+ * @return The start of the reference, NULL if not found. @a len is the length of the reference.
+ */
+static const gchar *
+_mlops_template_find_model_ref (const gchar * desc, const gchar * pos, gsize * len)
+{
+  const gchar *found = desc;
+  const gchar *value, *ref;
+  gchar quote;
+  gsize n;
+
+  /* The property before @a pos may have the reference after @a pos, e.g., model=model:a,model:b. */
+  while ((found = strstr (found, MLOPS_TEMPLATE_MODEL_PROPERTY)) != NULL) {
+    value = found + strlen (MLOPS_TEMPLATE_MODEL_PROPERTY);
+
+    if (found != desc && !g_ascii_isspace (found[-1])) {
+      found = value;
+      continue;
+    }
+
+    quote = (*value == '"' || *value == '\'') ? *value : '\0';
+    if (quote)
+      value++;
+
+    /* The files of the model property are separated with ','. */
+    for (ref = value;; ref++) {
+      n = _mlops_template_model_ref_len (ref);
+      if (n > 0 && ref >= pos) {
+        *len = n;
+        return ref;
+      }
+
+      while (*ref != '\0' && *ref != ',' &&
+          (quote ? *ref != quote : (!g_ascii_isspace (*ref) && *ref != '!')))
+        ref++;
+
+      if (*ref != ',')
+        break;
+    }
+
+    found = value;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Internal function to split the description into the tokens.
+ * @details The text '${' which is not a valid placeholder is kept as it is, and '$${' is replaced with the literal '${'.
+ */
+static int
+_mlops_template_parse (const gchar * desc, mlops_template_s ** tmpl)
+{
+  GPtrArray *tokens = NULL;
+  const gchar *pos = desc;
+  const gchar *start, *end, *ref;
+  gsize ref_len = 0;
+
+  for (;;) {
+    start = strstr (pos, "${");
+    ref = _mlops_template_find_model_ref (desc, pos, &ref_len);
+
+    /* Most of the descriptions do not have the placeholder, keep the description only. */
+    if (!start && !ref)
+      break;
+
+    if (!tokens)
+      tokens = g_ptr_array_new_with_free_func (_mlops_template_token_free);
+
+    /* The escaped '$${' is not the placeholder, keep the text until the first '$' and skip the second one. */
+    if (start && start > pos && start[-1] == '$' && (!ref || start - 1 < ref)) {
+      _mlops_template_add_token (tokens, MLOPS_TEMPLATE_TOKEN_TEXT,
+          g_strndup (pos, start - pos), NULL);
+      pos = start + 1;
+      continue;
+    }
+
+    if (ref && (!start || ref < start))
+      start = ref;
+
+    if (start > pos) {
+      _mlops_template_add_token (tokens, MLOPS_TEMPLATE_TOKEN_TEXT,
+          g_strndup (pos, start - pos), NULL);
+    }
+
+    if (start == ref) {
+      _mlops_template_add_token (tokens, MLOPS_TEMPLATE_TOKEN_MODEL,
+          g_strndup (ref + strlen (MLOPS_TEMPLATE_MODEL_PREFIX),
+              ref_len - strlen (MLOPS_TEMPLATE_MODEL_PREFIX)), NULL);
+      pos = ref + ref_len;
+      continue;
+    }
+
+    end = strchr (start + 2, '}');
+    if (!end || _mlops_template_parse_placeholder (tokens, start + 2, end - start - 2) != 0) {
+      /* Keep the text, the description stored before the placeholder is supported may have it. */
+      ml_logw ("Not a valid placeholder in the pipeline description, keep it as it is: %s", start);
+      _mlops_template_add_token (tokens, MLOPS_TEMPLATE_TOKEN_TEXT, g_strdup ("${"), NULL);
+      pos = start + 2;
+      continue;
+    }
+
+    pos = end + 1;
+  }
+
+  if (tokens && *pos != '\0')
+    _mlops_template_add_token (tokens, MLOPS_TEMPLATE_TOKEN_TEXT, g_strdup (pos), NULL);
+
+  *tmpl = g_new0 (mlops_template_s, 1);
+  (*tmpl)->refcount = 1;
+  (*tmpl)->source = g_strdup (desc);
+  (*tmpl)->tokens = tokens;
+  return 0;
+}
+
+/**
+ * @brief Internal function to get the parsed description of the service, parse and keep it if the description is not kept.
+ * @details If the kept description is different, the parsed one is used for this launch only.
+ */
+static int
+_mlops_template_get (const gchar * name, const gchar * desc, mlops_template_s ** tmpl)
+{
+  mlops_template_s *found = NULL;
+  mlops_template_s *kept, *parsed = NULL;
+  gint result;
+
+  G_LOCK (mlops_template);
+  if (g_mlops_template_table)
+    found = (mlops_template_s *) g_hash_table_lookup (g_mlops_template_table, name);
+  if (found && g_str_equal (found->source, desc))
+    g_atomic_int_inc (&found->refcount);
+  else
+    found = NULL;
+  G_UNLOCK (mlops_template);
+
+  if (found) {
+    *tmpl = found;
+    return 0;
+  }
+
+  /* The description is set before the daemon starts, or changed in the database directly. */
+  result = _mlops_template_parse (desc, &found);
+  if (result != 0)
+    return result;
+
+  G_LOCK (mlops_template);
+  if (!g_mlops_template_table) {
+    g_mlops_template_table = g_hash_table_new_full (g_str_hash, g_str_equal,
+        g_free, _mlops_template_unref);
+  }
+
+  /* The description may be set while parsing, do not replace it. It may be newer than the one read by the caller. */
+  kept = (mlops_template_s *) g_hash_table_lookup (g_mlops_template_table, name);
+  if (!kept) {
+    g_atomic_int_inc (&found->refcount);
+    g_hash_table_insert (g_mlops_template_table, g_strdup (name), found);
+  } else if (g_str_equal (kept->source, desc)) {
+    g_atomic_int_inc (&kept->refcount);
+    parsed = found;
+    found = kept;
+  }
+  G_UNLOCK (mlops_template);
+
+  _mlops_template_unref (parsed);
+
+  *tmpl = found;
+  return 0;
+}
+
+/**
+ * @brief Internal function to check the value of the parameter does not change the structure of the pipeline.
+ */
+static gboolean
+_mlops_template_is_valid_value (const gchar * value)
+{
+  const gchar *c;
+
+  for (c = value; *c != '\0'; c++) {
+    if (g_ascii_isspace (*c) || g_ascii_iscntrl (*c) || strchr ("!\"'\\", *c))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Release the activated model.
+ */
+void
+mlops_node_template_model_free (gpointer data)
+{
+  mlops_node_model_s *info = (mlops_node_model_s *) data;
+
+  if (info) {
+    g_free (info->path);
+    g_free (info);
+  }
+}
+
+/**
+ * @brief Internal function to get the path and version of the activated model which is read already.
+ * @return 0 on success, -ENOENT if the model is not read from the database.
+ */
+static int
+_mlops_template_get_kept_model (const gchar * model, gchar ** path, guint * version)
+{
+  mlops_node_model_s *info = NULL;
+
+  G_LOCK (mlops_template);
+  if (g_mlops_template_models)
+    info = (mlops_node_model_s *) g_hash_table_lookup (g_mlops_template_models, model);
+  if (info) {
+    *path = g_strdup (info->path);
+    *version = info->version;
+  }
+  G_UNLOCK (mlops_template);
+
+  return info ? 0 : -ENOENT;
+}
+
+/**
+ * @brief Get the path and version of the activated model.
+ * @details The model is read from the database once, and kept until the model is changed.
+ */
+int
+mlops_node_template_get_model (const gchar * model, gchar ** path, guint * version)
+{
+  g_autofree gchar *model_info = NULL;
+  mlops_node_model_s *info = NULL;
+  JsonNode *node;
+  JsonObject *object;
+  const gchar *value = NULL;
+  gint result;
+
+  if (_mlops_template_get_kept_model (model, path, version) == 0)
+    return 0;
+
+  result = svcdb_model_get_activated (model, &model_info);
+  if (result != 0) {
+    ml_loge ("Failed to get the activated model '%s'.", model);
+    return result;
+  }
+
+  node = json_from_string (model_info, NULL);
+  object = (node && JSON_NODE_HOLDS_OBJECT (node)) ? json_node_get_object (node) : NULL;
+  if (object && json_object_has_member (object, "path"))
+    value = json_object_get_string_member (object, "path");
+
+  if (STR_IS_VALID (value)) {
+    info = g_new0 (mlops_node_model_s, 1);
+    info->path = g_strdup (value);
+
+    /* The version is a string in the model information. */
+    value = json_object_has_member (object, "version") ?
+        json_object_get_string_member (object, "version") : NULL;
+    if (value)
+      info->version = (guint) g_ascii_strtoull (value, NULL, 10);
+
+    *path = g_strdup (info->path);
+    *version = info->version;
+
+    G_LOCK (mlops_template);
+    if (!g_mlops_template_models) {
+      g_mlops_template_models = g_hash_table_new_full (g_str_hash, g_str_equal,
+          g_free, mlops_node_template_model_free);
+    }
+    g_hash_table_insert (g_mlops_template_models, g_strdup (model), info);
+    G_UNLOCK (mlops_template);
+  } else {
+    ml_loge ("Failed to get the path of the activated model '%s'.", model);
+    result = -EINVAL;
+  }
+
+  if (node)
+    json_node_free (node);
+
+  return result;
+}
+
+/**
+ * @brief Parse the description of the service and keep it to launch the pipeline.
+ */
+int
+mlops_node_template_set (const gchar * name, const gchar * desc)
+{
+  mlops_template_s *tmpl = NULL;
+  gint result;
+
+  g_return_val_if_fail (name != NULL, -EINVAL);
+
+  if (desc) {
+    result = _mlops_template_parse (desc, &tmpl);
+    if (result != 0)
+      return result;
+  }
+
+  G_LOCK (mlops_template);
+  if (tmpl && !g_mlops_template_table) {
+    g_mlops_template_table = g_hash_table_new_full (g_str_hash, g_str_equal,
+        g_free, _mlops_template_unref);
+  }
+
+  if (tmpl)
+    g_hash_table_insert (g_mlops_template_table, g_strdup (name), tmpl);
+  else if (g_mlops_template_table)
+    g_hash_table_remove (g_mlops_template_table, name);
+  G_UNLOCK (mlops_template);
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to join the tokens of the description with the parameters, the activated models and the shared sources.
+ * @details If @a kept is TRUE, this does not access the database, and returns -ENOENT if the model or the source is not read yet.
+ */
+static int
+_mlops_template_expand_tokens (const gchar * name, mlops_template_s * tmpl,
+    GHashTable * params, const gboolean kept, gchar ** expanded, GHashTable ** models)
+{
+  GHashTable *resolved = NULL;
+  GString *str;
+  guint i;
+  gint result = 0;
+
+  if (!tmpl->tokens) {
+    *expanded = g_strdup (tmpl->source);
+    return 0;
+  }
+
+  str = g_string_sized_new (strlen (tmpl->source));
+
+  for (i = 0; result == 0 && i < tmpl->tokens->len; i++) {
+    mlops_template_token_s *token =
+        (mlops_template_token_s *) g_ptr_array_index (tmpl->tokens, i);
+    const gchar *value = NULL;
+    mlops_node_model_s *info;
+    gchar *element = NULL;
+    gchar *path = NULL;
+    guint version = 0U;
+
+    switch (token->type) {
+      case MLOPS_TEMPLATE_TOKEN_TEXT:
+        g_string_append (str, token->text);
+        break;
+      case MLOPS_TEMPLATE_TOKEN_PARAM:
+        if (params)
+          value = (const gchar *) g_hash_table_lookup (params, token->text);
+
+        if (value && !_mlops_template_is_valid_value (value)) {
+          ml_loge ("Invalid value '%s' of the parameter '%s' of '%s'.", value, token->text, name);
+          result = -EINVAL;
+          break;
+        }
+
+        if (!value)
+          value = token->value;
+
+        if (!value) {
+          ml_loge ("The parameter '%s' of '%s' is not given.", token->text, name);
+          result = -EINVAL;
+          break;
+        }
+
+        g_string_append (str, value);
+        break;
+      case MLOPS_TEMPLATE_TOKEN_MODEL:
+        if (kept)
+          result = _mlops_template_get_kept_model (token->text, &path, &version);
+        else
+          result = mlops_node_template_get_model (token->text, &path, &version);
+        if (result != 0)
+          break;
+
+        g_string_append (str, path);
+
+        if (!resolved) {
+          resolved = g_hash_table_new_full (g_str_hash, g_str_equal,
+              g_free, mlops_node_template_model_free);
+        }
+
+        info = g_new0 (mlops_node_model_s, 1);
+        info->path = path;
+        info->version = version;
+        g_hash_table_insert (resolved, g_strdup (token->text), info);
+        break;
+      case MLOPS_TEMPLATE_TOKEN_SOURCE:
+        if (kept)
+          result = mlops_node_source_get_element (token->text, &element);
+        else
+          result = mlops_node_source_prepare (token->text, &element);
+        if (result != 0)
+          break;
+
+        g_string_append (str, element);
+        g_free (element);
+        break;
+      default:
+        result = -EINVAL;
+        break;
+    }
+  }
+
+  if (result != 0) {
+    g_string_free (str, TRUE);
+    if (resolved)
+      g_hash_table_unref (resolved);
+    return result;
+  }
+
+  *expanded = g_string_free (str, FALSE);
+
+  if (models)
+    *models = resolved;
+  else if (resolved)
+    g_hash_table_unref (resolved);
+
+  return 0;
+}
+
+/**
+ * @brief Get the description of the service, the placeholders are replaced with the parameters and the activated models.
+ */
+int
+mlops_node_template_expand (const gchar * name, const gchar * desc,
+    GHashTable * params, gchar ** expanded, GHashTable ** models)
+{
+  mlops_template_s *tmpl = NULL;
+  gint result;
+
+  g_return_val_if_fail (name != NULL, -EINVAL);
+  g_return_val_if_fail (desc != NULL, -EINVAL);
+  g_return_val_if_fail (expanded != NULL, -EINVAL);
+
+  if (models)
+    *models = NULL;
+
+  result = _mlops_template_get (name, desc, &tmpl);
+  if (result != 0)
+    return result;
+
+  result = _mlops_template_expand_tokens (name, tmpl, params, FALSE, expanded, models);
+  _mlops_template_unref (tmpl);
+
+  return result;
+}
+
+/**
+ * @brief Read the activated models and the shared sources referred by the kept description of the service.
+ */
+int
+mlops_node_template_resolve (const gchar * name)
+{
+  mlops_template_s *tmpl = NULL;
+  gchar *path, *element;
+  guint version, i;
+  gint result = 0;
+
+  g_return_val_if_fail (name != NULL, -EINVAL);
+
+  G_LOCK (mlops_template);
+  if (g_mlops_template_table)
+    tmpl = (mlops_template_s *) g_hash_table_lookup (g_mlops_template_table, name);
+  if (tmpl)
+    g_atomic_int_inc (&tmpl->refcount);
+  G_UNLOCK (mlops_template);
+
+  if (!tmpl)
+    return -ENOENT;
+
+  for (i = 0; result == 0 && tmpl->tokens && i < tmpl->tokens->len; i++) {
+    mlops_template_token_s *token =
+        (mlops_template_token_s *) g_ptr_array_index (tmpl->tokens, i);
+
+    path = element = NULL;
+
+    if (token->type == MLOPS_TEMPLATE_TOKEN_MODEL)
+      result = mlops_node_template_get_model (token->text, &path, &version);
+    else if (token->type == MLOPS_TEMPLATE_TOKEN_SOURCE)
+      result = mlops_node_source_prepare (token->text, &element);
+
+    g_free (path);
+    g_free (element);
+  }
+
+  _mlops_template_unref (tmpl);
+  return result;
+}
+
+/**
+ * @brief Get the description of the service from the kept description, the placeholders are replaced with the parameters.
+ */
+int
+mlops_node_template_expand_kept (const gchar * name, GHashTable * params,
+    gchar ** expanded, GHashTable ** models)
+{
+  mlops_template_s *tmpl = NULL;
+  gint result;
+
+  g_return_val_if_fail (name != NULL, -EINVAL);
+  g_return_val_if_fail (expanded != NULL, -EINVAL);
+
+  if (models)
+    *models = NULL;
+
+  G_LOCK (mlops_template);
+  if (g_mlops_template_table)
+    tmpl = (mlops_template_s *) g_hash_table_lookup (g_mlops_template_table, name);
+  if (tmpl)
+    g_atomic_int_inc (&tmpl->refcount);
+  G_UNLOCK (mlops_template);
+
+  if (!tmpl)
+    return -ENOENT;
+
+  result = _mlops_template_expand_tokens (name, tmpl, params, TRUE, expanded, models);
+  _mlops_template_unref (tmpl);
+
+  return result;
+}
+
+/**
+ * @brief Drop the path and version of the activated model, the model is read from the database when launching the pipeline.
+ */
+void
+mlops_node_template_model_changed (const gchar * model)
+{
+  G_LOCK (mlops_template);
+  if (g_mlops_template_models) {
+    if (model)
+      g_hash_table_remove (g_mlops_template_models, model);
+    else
+      g_hash_table_remove_all (g_mlops_template_models);
+  }
+  G_UNLOCK (mlops_template);
+}
+
+/**
+ * @brief Release the parsed descriptions.
+ */
+void
+mlops_node_template_finalize (void)
+{
+  G_LOCK (mlops_template);
+  if (g_mlops_template_table) {
+    g_hash_table_destroy (g_mlops_template_table);
+    g_mlops_template_table = NULL;
+  }
+
+  if (g_mlops_template_models) {
+    g_hash_table_destroy (g_mlops_template_models);
+    g_mlops_template_models = NULL;
+  }
+  G_UNLOCK (mlops_template);
+}
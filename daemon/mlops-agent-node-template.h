@@ -0,0 +1,92 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      mlops-agent-node-template.h
+ * @date      18 October 2026
+ * @brief     Parameterized pipeline description in mlops node.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug       No known bugs except for NYI items
+ * @details   The description of the service may have the placeholders, which are replaced when launching the pipeline.
+ *            '${name}' is the parameter given by the application, '${name:-value}' is the parameter with the default value,
+ *            and '${model:name}' is the path of the activated model with the given name.
+ *            The model reference is also allowed without the braces in the value of the model property, e.g., 'tensor_filter model=model:name'.
+ *            '${source:name}' is the shared source, the stored pipeline of the given name (see mlops-agent-node-source.h).
+ *            The text '${' which is not a valid placeholder is kept as it is, so the existing descriptions are not rejected,
+ *            and '$${' is the escape of the literal '${', e.g., '$${name}' is launched as '${name}'.
+ */
+
+#ifndef _MLOPS_AGENT_NODE_TEMPLATE_H_
+#define _MLOPS_AGENT_NODE_TEMPLATE_H_
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Structure for the activated model referred by the description.
+ */
+typedef struct
+{
+  gchar *path;          /**< The path of the model */
+  guint version;        /**< The version of the model */
+} mlops_node_model_s;
+
+/**
+ * @brief Parse the description of the service and keep it to launch the pipeline.
+ * @details If @a desc is NULL, the parsed description of the service is removed.
+ * @return 0 on success, otherwise a negative error value.
+ */
+int mlops_node_template_set (const gchar *name, const gchar *desc);
+
+/**
+ * @brief Get the description of the service, the placeholders are replaced with the parameters, the activated models and the shared sources.
+ * @details This accesses the database to get the activated model which is not read yet, and the description of the shared source.
+ * @param[in] params The parameters (string to string) to replace the placeholders, NULL to use the default values.
+ * @param[out] models The activated models (mlops_node_model_s) with the name, NULL if the description does not refer the model.
+ * @return 0 on success, -EINVAL if the parameter is not given or invalid, or the error to get the activated model.
+ */
+int mlops_node_template_expand (const gchar *name, const gchar *desc, GHashTable *params, gchar **expanded, GHashTable **models);
+
+/**
+ * @brief Read the activated models and the shared sources referred by the kept description of the service.
+ * @details This accesses the database for the models and sources which are not read yet, so that mlops_node_template_expand_kept() does not.
+ * @return 0 on success, -ENOENT if the description of the service is not kept, or the error to get the model or the source.
+ */
+int mlops_node_template_resolve (const gchar *name);
+
+/**
+ * @brief Get the description of the service from the kept description, the placeholders are replaced with the parameters.
+ * @details This does not access the database, the models and sources should be read with mlops_node_template_resolve() in advance.
+ * @return 0 on success, -ENOENT if the description, the model or the source is not kept, or -EINVAL if the parameter is not given or invalid.
+ */
+int mlops_node_template_expand_kept (const gchar *name, GHashTable *params, gchar **expanded, GHashTable **models);
+
+/**
+ * @brief Get the path and version of the activated model.
+ * @details The model is read from the database once, and kept until the model is changed.
+ */
+int mlops_node_template_get_model (const gchar *model, gchar **path, guint *version);
+
+/**
+ * @brief Release the activated model.
+ */
+void mlops_node_template_model_free (gpointer data);
+
+/**
+ * @brief Drop the path and version of the activated model. This should be called when the model is registered, activated or deleted.
+ * @param[in] model The name of the model, NULL to drop all models.
+ */
+void mlops_node_template_model_changed (const gchar *model);
+
+/**
+ * @brief Release the parsed descriptions.
+ */
+void mlops_node_template_finalize (void);
+
+G_END_DECLS
+#endif /* _MLOPS_AGENT_NODE_TEMPLATE_H_ */
@@ -14,282 +14,3915 @@
  * @details   This implements the node information to run a pipeline.
  */
 
+#include <string.h>
+#include <json-glib/json-glib.h>
+
 #include "log.h"
+#include "mlops-agent-internal.h"
 #include "mlops-agent-node.h"
+#include "mlops-agent-node-admission.h"
+#include "mlops-agent-node-composite.h"
+#include "mlops-agent-node-config.h"
+#include "mlops-agent-node-profile.h"
+#include "mlops-agent-node-sched.h"
+#include "mlops-agent-node-share.h"
+#include "mlops-agent-node-source.h"
+#include "mlops-agent-node-stats.h"
+#include "mlops-agent-node-taskpool.h"
+#include "mlops-agent-node-template.h"
 #include "service-db-util.h"
 
-static GHashTable *g_mlops_node_table = NULL;
-G_LOCK_DEFINE_STATIC (mlops_node_table);
+/**
+ * @brief The number of shards of the node registry. This should be a power of 2.
+ */
+#define MLOPS_NODE_SHARDS (16)
+
+/**
+ * @brief Structure for the shard of the node registry.
+ */
+typedef struct
+{
+  GRWLock lock;
+  GHashTable *table;    /**< The nodes whose id is mapped to this shard */
+} mlops_node_shard_s;
+
+static mlops_node_shard_s g_mlops_node_shards[MLOPS_NODE_SHARDS];
+static gint64 g_mlops_node_id_base = 0;
+static gint g_mlops_node_id_seq = 0;
+G_LOCK_DEFINE_STATIC (mlops_node_registry);
+
+/**
+ * @brief Structure for the policy to restart the pipeline which posted an error or stalled.
+ */
+typedef struct
+{
+  guint max_retries;    /**< The maximum number of consecutive restarts, 0 if the pipeline is not restarted */
+  guint backoff_ms;     /**< The delay of the first restart, doubled for each consecutive restart */
+  guint backoff_max_ms; /**< The maximum delay of the restart */
+  gboolean rebuild;     /**< The new pipeline is built, otherwise the pipeline is prerolled again */
+  guint stall_ms;       /**< The time without the buffer to the sinks of the playing pipeline, 0 if the stall is not detected */
+  gboolean stall_restart;       /**< The stalled pipeline is restarted */
+} mlops_restart_policy_s;
+
+/**
+ * @brief Structure for mlops node.
+ */
+typedef struct
+{
+  mlops_node_type_e type;
+  gint64 id;
+  gint refcount;        /**< The node is released when the last reference is dropped */
+  GMutex lock;          /**< The lock for the pipeline of the node */
+  GstElement *element;
+  gchar *service_name;
+  gchar *description;
+  GHashTable *models;   /**< The versions of the activated models referred by the description, NULL if there is no model */
+  GHashTable *params;   /**< The parameters given to launch the pipeline, NULL if the default values are used */
+
+  /* The state record updated by the bus messages, these are accessed atomically. */
+  gint state;           /**< The current state of the pipeline, GST_STATE_VOID_PENDING while launching */
+  gint pending;         /**< The pending state of the pipeline */
+  gint error;           /**< The pipeline posted an error since the last state change request */
+  gint eos;             /**< The pipeline posted an end-of-stream since the last state change request */
+  gint target;          /**< The state requested by the last state change, the swapped pipeline is set to this state */
+
+  mlops_node_stats_s *stats;    /**< The runtime statistics of the pipeline */
+  const mlops_node_sched_s *sched;      /**< The scheduling attributes attached to the pipeline */
+  const mlops_node_config_s *config;    /**< The configuration attached to the pipeline */
+
+  /* The admission of the node, the cost is released when the node is released. */
+  gchar *app;           /**< The application launched the node, NULL if unknown */
+  mlops_node_cost_s cost;       /**< The estimated cost reserved for the node */
+  gint priority;        /**< The priority of the service to admit the pipeline built again */
+  gboolean admitted;    /**< The cost is reserved, FALSE while the launch request is queued */
+
+  /* The usage of the pipeline to learn the cost of the service, these are accessed with the usage lock. */
+  gint64 cpu_time;      /**< The CPU time of the streaming threads in nanoseconds */
+  gint64 playing_since; /**< The monotonic time when the pipeline is set to PLAYING, 0 if not playing */
+  gint64 playing_time;  /**< The time spent in PLAYING state in microseconds */
+  gint64 idle_since;    /**< The monotonic time when the pipeline is stopped, 0 if playing */
+  guint64 memory_kb;    /**< The memory allocated while building the pipeline */
+  gboolean memory_measured;     /**< The memory is measured without the other pipelines built concurrently */
+
+  /* The idle pipeline is released and the node keeps the configuration to build it again. */
+  gboolean reclaimed;   /**< The pipeline is released, it is built again when the node is started */
+  gboolean releasing;   /**< The released pipeline is being stopped in the worker */
+  GCond released;       /**< Signalled when the released pipeline is stopped and its budget is returned */
+  mlops_node_sched_s *reclaimed_sched;  /**< The scheduling attributes of the released pipeline */
+  mlops_node_config_s reclaimed_config; /**< The configuration of the released pipeline */
+  guint reclaim_count;  /**< The number of times the pipeline is released */
+  guint rebuild_count;  /**< The number of times the pipeline is built again */
+  guint64 reclaimed_kb; /**< The resident memory freed by releasing the pipeline */
+
+  /* The pipeline is switched to the activated model or the changed description, these are accessed with the node lock. */
+  guint swap_count;     /**< The number of times the pipeline is switched */
+  gint64 swap_gap;      /**< The time (in microseconds) the stream is interrupted by the last switch */
+  const gchar *swap_method;     /**< The way of the last switch, NULL if the pipeline is not switched */
+
+  /* The pipeline is restarted when it posts an error, these are accessed with the restart lock. */
+  mlops_restart_policy_s restart;       /**< The restart policy of the service */
+  guint restart_count;  /**< The number of times the pipeline is recovered */
+  guint restart_attempts;       /**< The number of consecutive restarts, reset when the pipeline runs stably */
+  gint64 restart_deadline;      /**< The monotonic time to restart the pipeline, 0 if the restart is not scheduled */
+  gboolean restart_running;     /**< The pipeline is being restarted in the worker */
+  gint64 restart_last;  /**< The monotonic time when the pipeline is restarted last */
+  gint64 restart_time;  /**< The time (in microseconds) to recover the pipeline by the last restart */
+  gchar *error_source;  /**< The name of the element posted the last error */
+  gchar *error_message; /**< The message of the last error */
+  gint64 error_time;    /**< The real time (in microseconds) when the last error is posted */
+  gboolean stall_watched;       /**< The pipeline is checked by the shared stall timer */
+  gboolean stalled;     /**< No buffer entered the sinks of the playing pipeline for the stall threshold */
+  guint stall_count;    /**< The number of times the pipeline is stalled */
+} mlops_node_s;
+
+G_LOCK_DEFINE_STATIC (mlops_node_usage);
+
+/**
+ * @brief Structure for the notification of the state change of the node.
+ */
+typedef struct
+{
+  gint64 id;
+  GstState state;
+} mlops_node_state_notify_s;
+
+/**
+ * @brief Structure for the measured cost of the released node, the estimated cost of the service is updated in the main context.
+ */
+typedef struct
+{
+  gchar *service_name;
+  mlops_node_cost_s measured;
+} mlops_node_learn_s;
+
+/**
+ * @brief The name of the pipeline attribute for the number of prerolled pipelines to keep.
+ */
+#define MLOPS_POOL_SIZE_ATTR "pool_size"
+
+/**
+ * @brief The name of the pipeline attribute for the policy when the description is changed.
+ * @details If the value is "seamless", the running pipelines are switched to the changed description.
+ */
+#define MLOPS_RELOAD_ATTR "reload"
+
+/**
+ * @brief The names of the pipeline attributes for the policy to restart the pipeline which posted an error.
+ */
+#define MLOPS_RESTART_MAX_RETRIES_ATTR "restart_max_retries"
+#define MLOPS_RESTART_BACKOFF_ATTR "restart_backoff_ms"
+#define MLOPS_RESTART_BACKOFF_MAX_ATTR "restart_backoff_max_ms"
+#define MLOPS_RESTART_STRATEGY_ATTR "restart_strategy"
+
+/**
+ * @brief The names of the pipeline attributes for the stall detection.
+ * @details If no buffer enters the sinks of the playing pipeline for the threshold, the stall is notified and the pipeline is restarted optionally.
+ */
+#define MLOPS_STALL_THRESHOLD_ATTR "stall_threshold_ms"
+#define MLOPS_STALL_RESTART_ATTR "stall_restart"
+
+/**
+ * @brief The interval (in seconds) of the shared timer to check the stall of all pipelines.
+ * @details The timer is coarse to coalesce the wakeups, the stall is notified within the threshold and this interval.
+ */
+#define MLOPS_STALL_CHECK_INTERVAL_S (1U)
+
+/**
+ * @brief The number of restarts of the stalled pipeline if 'stall_restart' is set without 'restart_max_retries'.
+ */
+#define MLOPS_STALL_DEFAULT_RETRIES (3U)
+
+/**
+ * @brief The default delay (in milliseconds) of the first restart and the maximum delay.
+ */
+#define MLOPS_RESTART_DEFAULT_BACKOFF_MS (10U)
+#define MLOPS_RESTART_DEFAULT_BACKOFF_MAX_MS (5000U)
+
+/**
+ * @brief The time (in microseconds) the restarted pipeline runs without error to count the restarts from the beginning.
+ */
+#define MLOPS_RESTART_STABLE_TIME (30 * G_TIME_SPAN_SECOND)
+
+/**
+ * @brief The maximum number of threads to build the pipelines in the pool.
+ */
+#define MLOPS_POOL_MAX_THREADS (2)
+
+/**
+ * @brief The maximum number of threads to launch the pipelines asynchronously.
+ */
+#define MLOPS_LAUNCH_MAX_THREADS (4)
+
+/**
+ * @brief The timeout to wait for the pipeline to be prerolled.
+ */
+#define MLOPS_NODE_PREROLL_TIMEOUT (10 * GST_SECOND)
+
+/**
+ * @brief The key of the memory (in kilobytes) allocated while building the pipeline.
+ * @details This is set only if no other pipeline is built concurrently, because the memory is measured for the process.
+ */
+#define MLOPS_NODE_MEMORY_KEY "mlops-node-memory"
+
+/**
+ * @brief The minimum time (in microseconds) in PLAYING state to learn the cost of the service.
+ */
+#define MLOPS_NODE_LEARN_MIN_TIME (G_USEC_PER_SEC)
+
+/**
+ * @brief Structure for the pool of prerolled pipelines of the service.
+ */
+typedef struct
+{
+  gchar *description;   /**< The description of the pipelines in the pool */
+  mlops_node_sched_s *sched;    /**< The scheduling attributes of the pipelines in the pool */
+  mlops_node_config_s config;   /**< The latest configuration, the pipelines in the pool are kept when it is changed */
+  guint size;           /**< The number of pipelines to keep */
+  guint building;       /**< The number of pipelines being built in the worker */
+  GQueue ready;         /**< The prerolled pipelines */
+  guint64 hits;         /**< The number of launches using the pipeline in the pool */
+  guint64 misses;       /**< The number of launches building the pipeline */
+} mlops_pool_s;
+
+/**
+ * @brief Structure for the task to build the pipeline in the pool.
+ */
+typedef struct
+{
+  gchar *service_name;
+  gchar *description;
+  mlops_node_sched_s *sched;
+  mlops_node_config_s config;
+} mlops_pool_task_s;
+
+/**
+ * @brief Structure for the task to launch the pipeline asynchronously.
+ */
+typedef struct
+{
+  gint64 id;
+  gchar *description;
+  mlops_node_sched_s *sched;
+  mlops_node_config_s config;
+  gchar *app;
+  mlops_node_cost_s cost;
+  GstElement *pipeline;
+  gboolean wait_preroll;
+  gint result;
+  mlops_node_launch_cb cb;
+  void *user_data;
+} mlops_launch_task_s;
+
+static GHashTable *g_mlops_pool_table = NULL;
+static GThreadPool *g_mlops_pool_workers = NULL;
+static gint g_mlops_pool_closing = 0;
+G_LOCK_DEFINE_STATIC (mlops_pool);
+
+static GThreadPool *g_mlops_launch_workers = NULL;
+static gint g_mlops_launch_closing = 0;
+G_LOCK_DEFINE_STATIC (mlops_launch);
+
+/**
+ * @brief The maximum number of threads to change the state of the nodes in the batch.
+ */
+#define MLOPS_BATCH_MAX_THREADS (16)
+
+typedef struct _mlops_batch_s mlops_batch_s;
+
+/**
+ * @brief Structure for the operation on a node in the batch.
+ */
+typedef struct
+{
+  mlops_batch_s *batch;
+  mlops_node_s *node;   /**< The node to change the state */
+  gchar *description;   /**< The description to build the pipeline for the launch */
+  GHashTable *models;   /**< The versions of the activated models in the description */
+  mlops_node_sched_s *sched;
+  mlops_node_config_s config;
+  GstElement *pipeline;
+  mlops_node_cost_s cost;
+  gint priority;
+  mlops_restart_policy_s restart;
+  gboolean admitted;
+  gint result;
+} mlops_batch_item_s;
+
+/**
+ * @brief Structure for the batch of the operations.
+ * @details The caller waits until all operations are done, or the callback is called in the main context if the batch is asynchronous.
+ */
+struct _mlops_batch_s
+{
+  GMutex lock;
+  GCond cond;
+  guint remaining;
+
+  mlops_batch_item_s *items;
+  guint count;
+  gboolean build;       /**< Launch the pipelines, @a op is ignored */
+  mlops_node_batch_op_e op;
+  gchar **names;        /**< The service names to launch the pipelines */
+  gchar *app;           /**< The application requesting the launch for the per-app quota */
+  int64_t *ids;
+  int *results;
+  mlops_node_batch_cb cb;       /**< The callback of the asynchronous batch, NULL if the caller waits */
+  void *user_data;
+};
+
+static GThreadPool *g_mlops_batch_workers = NULL;
+G_LOCK_DEFINE_STATIC (mlops_batch);
+
+static mlops_node_state_cb g_mlops_state_cb = NULL;
+static void *g_mlops_state_cb_data = NULL;
+G_LOCK_DEFINE_STATIC (mlops_state_cb);
+
+static mlops_node_stall_cb g_mlops_stall_cb = NULL;
+static void *g_mlops_stall_cb_data = NULL;
+G_LOCK_DEFINE_STATIC (mlops_stall_cb);
+
+static guint g_mlops_reclaim_timeout = 0U;
+static guint g_mlops_reclaim_source = 0U;
+G_LOCK_DEFINE_STATIC (mlops_reclaim);
+
+/**
+ * @brief The maximum number of threads to switch the pipelines to the activated model.
+ */
+#define MLOPS_SWAP_MAX_THREADS (2)
+
+/**
+ * @brief Structure for the task to switch the pipeline of the node to the activated model or the changed description.
+ */
+typedef struct
+{
+  mlops_node_s *node;
+  gchar *model;         /**< The name of the activated model, NULL if the description is changed */
+  gchar *path;          /**< The path of the activated model */
+  guint version;        /**< The version of the activated model */
+  gchar *description;   /**< The changed description expanded with the parameters of the node, NULL to expand it in the worker */
+  GHashTable *models;   /**< The activated models referred by the changed description */
+  gboolean restart;     /**< The pipeline posted an error and is restarted with the description of the node */
+
+  /* The idle pipeline detached from the node is released in the worker. */
+  GstElement *reclaim;  /**< The idle pipeline to release, NULL if the task does not release the pipeline */
+  mlops_node_stats_s *stats;    /**< The statistics of the released pipeline */
+  const mlops_node_sched_s *sched;      /**< The scheduling attributes of the released pipeline */
+  gboolean admitted;    /**< The budget of the admission control is released with the pipeline */
+} mlops_swap_task_s;
+
+static GThreadPool *g_mlops_swap_workers = NULL;
+static gint g_mlops_swap_closing = 0;
+G_LOCK_DEFINE_STATIC (mlops_swap);
+
+static guint g_mlops_stall_source = 0U;
+static guint g_mlops_stall_nodes = 0U;
+static GQueue g_mlops_restart_queue = G_QUEUE_INIT;
+static GCond g_mlops_restart_cond;
+static GThreadPool *g_mlops_restart_timer = NULL;
+static gboolean g_mlops_restart_timer_running = FALSE;
+static gboolean g_mlops_restart_closing = FALSE;
+G_LOCK_DEFINE_STATIC (mlops_restart);
+
+static gint g_mlops_build_running = 0;
+static gint g_mlops_build_seq = 0;
+
+/**
+ * @brief Internal function to record the CPU time of the streaming thread entering the task.
+ * @return The CPU time in nanoseconds spent by the streaming thread leaving the task, 0 otherwise.
+ */
+static gint64
+_mlops_node_handle_thread_status (GstMessage * msg)
+{
+  GstStreamStatusType type;
+  GstElement *owner = NULL;
+
+  if (GST_MESSAGE_TYPE (msg) != GST_MESSAGE_STREAM_STATUS)
+    return 0;
+
+  gst_message_parse_stream_status (msg, &type, &owner);
+
+  switch (type) {
+    case GST_STREAM_STATUS_TYPE_ENTER:
+      mlops_node_admission_thread_enter ();
+      break;
+    case GST_STREAM_STATUS_TYPE_LEAVE:
+      return mlops_node_admission_thread_leave ();
+    default:
+      break;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to handle the bus messages of the pipeline until the pipeline is set to the node.
+ */
+static GstBusSyncReply
+_mlops_node_build_sync_handler (GstBus * bus, GstMessage * msg, gpointer user_data)
+{
+  const mlops_node_sched_s *sched = (const mlops_node_sched_s *) user_data;
+
+  mlops_node_task_pool_handle_message (msg);
+  mlops_node_sched_handle_message (sched, msg);
+  _mlops_node_handle_thread_status (msg);
+  return GST_BUS_PASS;
+}
+
+/**
+ * @brief Internal function to parse the description and set the pipeline as paused state.
+ * @details The scheduling attributes are attached to the pipeline, and applied to its streaming threads.
+ *          The configuration is attached to the pipeline too.
+ */
+static int
+_mlops_node_build_paused (const gchar * desc, const mlops_node_sched_s * sched,
+    const mlops_node_config_s * config, GstElement ** element, gint64 * load_time)
+{
+  GstElement *pipeline;
+  GstBus *bus;
+  GError *err = NULL;
+  GstStateChangeReturn ret;
+  gint result;
+
+  pipeline = gst_parse_launch (desc, &err);
+  if (!pipeline || err) {
+    ml_loge ("Failed to launch pipeline '%s' (error msg: %s).",
+        desc, (err) ? err->message : "unknown reason");
+    g_clear_error (&err);
+
+    if (pipeline)
+      gst_object_unref (pipeline);
+    return -ESTRPIPE;
+  }
+
+  /* The streaming tasks are created when the pipeline is paused, run them on the shared task pool. */
+  mlops_node_sched_attach (pipeline, sched);
+  mlops_node_config_attach (pipeline, config);
+
+  /* The filters load the model when the pipeline is paused, share the model loaded by the other pipelines if the service allows it. */
+  if (config->share_model)
+    mlops_node_share_attach (pipeline);
+
+  /* Connect the receivers to the shared sources, the source is launched when the pipeline starts playing. */
+  result = mlops_node_source_attach (pipeline);
+
+  /* Link the pipelines of the composite service, the buffers of the upstream are pushed to the downstream. */
+  if (result == 0)
+    result = mlops_node_composite_attach (pipeline);
+
+  if (result != 0) {
+    gst_object_unref (pipeline);
+    return result;
+  }
+
+  bus = gst_element_get_bus (pipeline);
+  gst_bus_set_sync_handler (bus, _mlops_node_build_sync_handler,
+      (gpointer) mlops_node_sched_get (pipeline), NULL);
+  gst_object_unref (bus);
+
+  /* Set pipeline as paused state. */
+  *load_time = g_get_monotonic_time ();
+  ret = gst_element_set_state (pipeline, GST_STATE_PAUSED);
+  *load_time = g_get_monotonic_time () - *load_time;
+  if (ret == GST_STATE_CHANGE_FAILURE) {
+    ml_loge
+        ("Failed to set the state of the pipeline to PAUSED. For the detail, please check the GStreamer log message.");
+
+    gst_element_set_state (pipeline, GST_STATE_NULL);
+    gst_object_unref (pipeline);
+    return -ESTRPIPE;
+  }
+
+  *element = pipeline;
+  return 0;
+}
+
+/**
+ * @brief Internal function to build the pipeline and set it as paused state.
+ * @details The memory allocated while building the pipeline, e.g., the model loaded by the filter, is measured for the process.
+ *          It is recorded only if no other pipeline is built meanwhile, otherwise the cost of the service is not learned from it.
+ */
+static int
+_mlops_node_build_pipeline (const gchar * desc, const mlops_node_sched_s * sched,
+    const mlops_node_config_s * config, GstElement ** element)
+{
+  GstElement *pipeline = NULL;
+  gint64 rss, load_time = 0;
+  gboolean exclusive;
+  gint seq, result;
+  guint64 *memory;
+
+  exclusive = (g_atomic_int_add (&g_mlops_build_running, 1) == 0);
+  seq = g_atomic_int_add (&g_mlops_build_seq, 1) + 1;
+  rss = mlops_node_admission_get_rss ();
+
+  result = _mlops_node_build_paused (desc, sched, config, &pipeline, &load_time);
+
+  /* The memory is not measured exclusively if the other pipeline started building meanwhile. */
+  rss = mlops_node_admission_get_rss () - rss;
+  exclusive = exclusive && (g_atomic_int_get (&g_mlops_build_seq) == seq);
+  g_atomic_int_add (&g_mlops_build_running, -1);
+
+  if (result != 0)
+    return result;
+
+  if (exclusive) {
+    memory = g_new (guint64, 1);
+    *memory = (guint64) MAX (rss, 0);
+    g_object_set_data_full (G_OBJECT (pipeline), MLOPS_NODE_MEMORY_KEY, memory, g_free);
+    mlops_node_share_set_cost (pipeline, load_time, *memory);
+  }
+
+  *element = pipeline;
+  return 0;
+}
+
+/**
+ * @brief Internal function to release the pipelines.
+ */
+static void
+_mlops_pool_release_pipelines (GList * pipelines)
+{
+  GList *l;
+
+  for (l = pipelines; l != NULL; l = l->next) {
+    GstElement *pipeline = GST_ELEMENT (l->data);
+
+    gst_element_set_state (pipeline, GST_STATE_NULL);
+    gst_object_unref (pipeline);
+  }
+
+  g_list_free (pipelines);
+}
+
+/**
+ * @brief Internal function to take out the pipelines over the pool size. Should be called with the pool lock.
+ */
+static GList *
+_mlops_pool_trim_locked (mlops_pool_s * pool)
+{
+  GList *removed = NULL;
+
+  while (g_queue_get_length (&pool->ready) > pool->size)
+    removed = g_list_prepend (removed, g_queue_pop_tail (&pool->ready));
+
+  return removed;
+}
+
+/**
+ * @brief Internal function to release the pool.
+ */
+static void
+_mlops_pool_free (gpointer data)
+{
+  mlops_pool_s *pool = (mlops_pool_s *) data;
+
+  _mlops_pool_release_pipelines (pool->ready.head);
+  g_queue_init (&pool->ready);
+
+  g_free (pool->description);
+  mlops_node_sched_free (pool->sched);
+  g_free (pool);
+}
+
+/**
+ * @brief Internal function to release the task.
+ */
+static void
+_mlops_pool_task_free (mlops_pool_task_s * task)
+{
+  g_free (task->service_name);
+  g_free (task->description);
+  mlops_node_sched_free (task->sched);
+  g_free (task);
+}
+
+/**
+ * @brief Worker to build the pipeline and wait for preroll. This does not access the database.
+ */
+static void
+_mlops_pool_worker (gpointer data, gpointer user_data)
+{
+  mlops_pool_task_s *task = (mlops_pool_task_s *) data;
+  GstElement *pipeline = NULL;
+  mlops_pool_s *pool;
+  gboolean added = FALSE;
+
+  /* Skip the queued tasks when finalizing. */
+  if (g_atomic_int_get (&g_mlops_pool_closing)) {
+    _mlops_pool_task_free (task);
+    return;
+  }
+
+  if (_mlops_node_build_pipeline (task->description, task->sched, &task->config, &pipeline) == 0) {
+    if (gst_element_get_state (pipeline, NULL, NULL,
+            MLOPS_NODE_PREROLL_TIMEOUT) == GST_STATE_CHANGE_FAILURE) {
+      ml_logw ("Failed to preroll the pipeline of '%s' in the pool.", task->service_name);
+      _mlops_pool_release_pipelines (g_list_append (NULL, pipeline));
+      pipeline = NULL;
+    }
+  }
+
+  G_LOCK (mlops_pool);
+  pool = g_mlops_pool_table ?
+      (mlops_pool_s *) g_hash_table_lookup (g_mlops_pool_table, task->service_name) : NULL;
+  if (pool) {
+    pool->building--;
+
+    /* Drop the pipeline if the description or the scheduling is changed, or the pool is already full. */
+    if (pipeline && g_strcmp0 (pool->description, task->description) == 0 &&
+        mlops_node_sched_equal (pool->sched, task->sched) &&
+        g_queue_get_length (&pool->ready) < pool->size) {
+      g_queue_push_tail (&pool->ready, pipeline);
+      added = TRUE;
+    }
+  }
+  G_UNLOCK (mlops_pool);
+
+  if (pipeline && !added)
+    _mlops_pool_release_pipelines (g_list_append (NULL, pipeline));
+
+  _mlops_pool_task_free (task);
+}
+
+/**
+ * @brief Internal function to request the worker to fill the pool. Should be called with the pool lock.
+ */
+static void
+_mlops_pool_refill_locked (const gchar * name, mlops_pool_s * pool)
+{
+  guint count = g_queue_get_length (&pool->ready) + pool->building;
+
+  if (!pool->description || count >= pool->size)
+    return;
+
+  if (!g_mlops_pool_workers) {
+    g_mlops_pool_workers = g_thread_pool_new (_mlops_pool_worker, NULL,
+        MLOPS_POOL_MAX_THREADS, FALSE, NULL);
+    if (!g_mlops_pool_workers) {
+      ml_loge ("Failed to create the thread pool to build the pipelines.");
+      return;
+    }
+  }
+
+  for (; count < pool->size; count++) {
+    mlops_pool_task_s *task = g_new0 (mlops_pool_task_s, 1);
+
+    task->service_name = g_strdup (name);
+    task->description = g_strdup (pool->description);
+    task->sched = mlops_node_sched_copy (pool->sched);
+    task->config = pool->config;
+
+    pool->building++;
+    g_thread_pool_push (g_mlops_pool_workers, task, NULL);
+  }
+}
+
+/**
+ * @brief Internal function to put the prerolled pipeline back to the pool, the launch request taking it is rejected.
+ * @details The pipeline is released if the pool is changed or already full.
+ */
+static void
+_mlops_pool_put_back (const gchar * name, const gchar * desc, GstElement * pipeline)
+{
+  mlops_pool_s *pool;
+  gboolean added = FALSE;
+
+  G_LOCK (mlops_pool);
+  pool = g_mlops_pool_table ?
+      (mlops_pool_s *) g_hash_table_lookup (g_mlops_pool_table, name) : NULL;
+  if (pool && g_strcmp0 (pool->description, desc) == 0 &&
+      mlops_node_sched_equal (pool->sched, mlops_node_sched_get (pipeline)) &&
+      g_queue_get_length (&pool->ready) < pool->size) {
+    g_queue_push_head (&pool->ready, pipeline);
+    if (pool->hits > 0)
+      pool->hits--;
+    added = TRUE;
+  }
+  G_UNLOCK (mlops_pool);
+
+  if (!added)
+    _mlops_pool_release_pipelines (g_list_append (NULL, pipeline));
+}
+
+/**
+ * @brief Internal function to get the pool size of the service from the database.
+ */
+static guint
+_mlops_pool_get_size (const gchar * name)
+{
+  g_autofree gchar *value = NULL;
+  gint64 size = 0;
+
+  if (svcdb_pipeline_get_attribute (name, MLOPS_POOL_SIZE_ATTR, &value) == 0 && value)
+    size = g_ascii_strtoll (value, NULL, 10);
+
+  return (size > 0) ? (guint) MIN (size, G_MAXUINT8) : 0U;
+}
+
+/**
+ * @brief Internal function to update the pool of the service. Should be called with the pool lock.
+ * @return The pipelines to be released out of the lock.
+ */
+static GList *
+_mlops_pool_update_locked (const gchar * name, const gchar * desc,
+    const mlops_node_sched_s * sched, const mlops_node_config_s * config, const guint size)
+{
+  mlops_pool_s *pool;
+  GList *removed = NULL;
+
+  if (!g_mlops_pool_table) {
+    if (size == 0)
+      return NULL;
+
+    g_mlops_pool_table = g_hash_table_new_full (g_str_hash, g_str_equal,
+        g_free, _mlops_pool_free);
+  }
+
+  pool = (mlops_pool_s *) g_hash_table_lookup (g_mlops_pool_table, name);
+  if (!pool) {
+    if (size == 0)
+      return NULL;
+
+    pool = g_new0 (mlops_pool_s, 1);
+    g_queue_init (&pool->ready);
+    g_hash_table_insert (g_mlops_pool_table, g_strdup (name), pool);
+  }
+
+  /* The description or the scheduling is changed, drop the pipelines in the pool. */
+  if (g_strcmp0 (pool->description, desc) != 0 ||
+      !mlops_node_sched_equal (pool->sched, sched)) {
+    removed = pool->ready.head;
+    g_queue_init (&pool->ready);
+
+    g_free (pool->description);
+    pool->description = g_strdup (desc);
+
+    mlops_node_sched_free (pool->sched);
+    pool->sched = mlops_node_sched_copy (sched);
+  }
+
+  /* The configuration is attached again when the pipeline is taken, the pool is not dropped. */
+  pool->config = *config;
+  pool->size = size;
+  removed = g_list_concat (removed, _mlops_pool_trim_locked (pool));
+
+  return removed;
+}
+
+/**
+ * @brief Internal function to call the state callback in the main context.
+ */
+static gboolean
+_mlops_node_state_notify (gpointer data)
+{
+  mlops_node_state_notify_s *notify = (mlops_node_state_notify_s *) data;
+  mlops_node_state_cb cb;
+  void *cb_data;
+
+  G_LOCK (mlops_state_cb);
+  cb = g_mlops_state_cb;
+  cb_data = g_mlops_state_cb_data;
+  G_UNLOCK (mlops_state_cb);
+
+  if (cb)
+    cb (notify->id, notify->state, cb_data);
+
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Internal function to update the state record of the node from the pipeline. This does not block.
+ */
+static void
+_mlops_node_update_state (mlops_node_s * node, GstElement * pipeline)
+{
+  mlops_node_state_notify_s *notify;
+  GstState current, pending;
+  gint old;
+  gboolean has_cb;
+
+  GST_OBJECT_LOCK (pipeline);
+  current = GST_STATE (pipeline);
+  pending = GST_STATE_PENDING (pipeline);
+  GST_OBJECT_UNLOCK (pipeline);
+
+  g_atomic_int_set (&node->pending, (gint) pending);
+  old = g_atomic_int_get (&node->state);
+  g_atomic_int_set (&node->state, (gint) current);
+
+  if (old == (gint) current)
+    return;
+
+  if (node->stats)
+    mlops_node_stats_set_state (node->stats, current);
+
+  G_LOCK (mlops_node_usage);
+  if (current == GST_STATE_PLAYING) {
+    if (node->playing_since == 0)
+      node->playing_since = g_get_monotonic_time ();
+    node->idle_since = 0;
+  } else {
+    if (node->playing_since > 0) {
+      node->playing_time += g_get_monotonic_time () - node->playing_since;
+      node->playing_since = 0;
+    }
+    if (node->idle_since == 0)
+      node->idle_since = g_get_monotonic_time ();
+  }
+  G_UNLOCK (mlops_node_usage);
+
+  G_LOCK (mlops_state_cb);
+  has_cb = (g_mlops_state_cb != NULL);
+  G_UNLOCK (mlops_state_cb);
+
+  if (has_cb) {
+    notify = g_new0 (mlops_node_state_notify_s, 1);
+    notify->id = node->id;
+    notify->state = current;
+
+    g_idle_add_full (G_PRIORITY_DEFAULT, _mlops_node_state_notify, notify, g_free);
+  }
+}
+
+static void _mlops_restart_handle_error (mlops_node_s * node, GstObject * src, GError * err);
+
+/**
+ * @brief Internal function to handle the bus messages of the pipeline in the thread posting the message.
+ * @details This updates the state record of the node and drops the message, so the messages are not queued in the bus.
+ */
+static GstBusSyncReply
+_mlops_node_bus_sync_handler (GstBus * bus, GstMessage * msg, gpointer user_data)
+{
+  mlops_node_s *node = (mlops_node_s *) user_data;
+  GstObject *src = GST_MESSAGE_SRC (msg);
+  GError *err = NULL;
+  gint64 cpu_time;
+
+  switch (GST_MESSAGE_TYPE (msg)) {
+    case GST_MESSAGE_STATE_CHANGED:
+    case GST_MESSAGE_ASYNC_DONE:
+      /* Only the state of the top-level pipeline is recorded. */
+      if (src && GST_IS_ELEMENT (src) && GST_OBJECT_PARENT (src) == NULL)
+        _mlops_node_update_state (node, GST_ELEMENT (src));
+      break;
+    case GST_MESSAGE_ERROR:
+      gst_message_parse_error (msg, &err, NULL);
+      ml_loge ("The pipeline with ID %" G_GINT64_FORMAT " posted an error from %s: %s",
+          node->id, src ? GST_OBJECT_NAME (src) : "unknown",
+          err ? err->message : "unknown reason");
+
+      g_atomic_int_set (&node->error, 1);
+      _mlops_restart_handle_error (node, src, err);
+      g_clear_error (&err);
+      break;
+    case GST_MESSAGE_EOS:
+      g_atomic_int_set (&node->eos, 1);
+      break;
+    case GST_MESSAGE_QOS:
+      if (node->stats)
+        mlops_node_stats_handle_message (node->stats, msg);
+      break;
+    case GST_MESSAGE_STREAM_STATUS:
+      mlops_node_task_pool_handle_message (msg);
+      mlops_node_sched_handle_message (node->sched, msg);
+
+      cpu_time = _mlops_node_handle_thread_status (msg);
+      if (cpu_time > 0) {
+        G_LOCK (mlops_node_usage);
+        node->cpu_time += cpu_time;
+        G_UNLOCK (mlops_node_usage);
+      }
+      break;
+    default:
+      break;
+  }
+
+  return GST_BUS_DROP;
+}
+
+/**
+ * @brief Internal function to set the pipeline of the node and start tracking its state. Should be called with the node lock.
+ */
+static void
+_mlops_node_attach_pipeline (mlops_node_s * node, GstElement * pipeline)
+{
+  GstBus *bus;
+  GstMessage *msg;
+  guint64 *memory;
+
+  node->element = pipeline;
+  node->sched = mlops_node_sched_get (pipeline);
+  node->config = mlops_node_config_get (pipeline);
+  node->stats = mlops_node_stats_new (pipeline, node->config->stats);
+  memory = (guint64 *) g_object_get_data (G_OBJECT (pipeline), MLOPS_NODE_MEMORY_KEY);
+  node->memory_kb = memory ? *memory : 0U;
+  node->memory_measured = (memory != NULL);
+
+  bus = gst_element_get_bus (pipeline);
+  gst_bus_set_sync_handler (bus, _mlops_node_bus_sync_handler, node, NULL);
+
+  /* Drop the messages posted before the node is set, e.g., the pipeline in the pool. */
+  while ((msg = gst_bus_pop (bus)) != NULL)
+    gst_message_unref (msg);
+
+  gst_object_unref (bus);
+
+  _mlops_node_update_state (node, pipeline);
+}
+
+/**
+ * @brief Internal function to stop tracking the state of the pipeline.
+ */
+static void
+_mlops_node_detach_pipeline (GstElement * pipeline)
+{
+  GstBus *bus;
+
+  bus = gst_element_get_bus (pipeline);
+  gst_bus_set_sync_handler (bus, NULL, NULL, NULL);
+  gst_object_unref (bus);
+}
+
+/**
+ * @brief Internal function to get the shard of the node registry with given id.
+ */
+static mlops_node_shard_s *
+_mlops_node_get_shard (const gint64 id)
+{
+  guint64 key = (guint64) id;
+
+  return &g_mlops_node_shards[(key ^ (key >> 32)) & (MLOPS_NODE_SHARDS - 1)];
+}
+
+/**
+ * @brief Internal function to increase the reference count of the node.
+ */
+static mlops_node_s *
+_mlops_node_ref (mlops_node_s * node)
+{
+  g_atomic_int_inc (&node->refcount);
+  return node;
+}
+
+static void _mlops_node_free (mlops_node_s * node);
+static void _mlops_restart_schedule_locked (mlops_node_s * node);
+static int _mlops_swap_push (GList * tasks);
+static int _mlops_node_expand_kept (mlops_node_s * node, gchar ** desc, GHashTable ** models);
+
+/**
+ * @brief Internal function to decrease the reference count of the node, and release it if this is the last reference.
+ */
+static void
+_mlops_node_unref (gpointer data)
+{
+  mlops_node_s *node = (mlops_node_s *) data;
+
+  if (node && g_atomic_int_dec_and_test (&node->refcount))
+    _mlops_node_free (node);
+}
+
+/**
+ * @brief Internal function to get node info. The caller should release the reference of the node.
+ */
+static mlops_node_s *
+_mlops_node_get (const int64_t id)
+{
+  mlops_node_shard_s *shard = _mlops_node_get_shard (id);
+  mlops_node_s *node = NULL;
+
+  g_rw_lock_reader_lock (&shard->lock);
+  if (shard->table) {
+    node = (mlops_node_s *) g_hash_table_lookup (shard->table, &id);
+    if (node)
+      _mlops_node_ref (node);
+  }
+  g_rw_lock_reader_unlock (&shard->lock);
+
+  if (!node) {
+    ml_loge ("There is no pipeline matched with ID %" G_GINT64_FORMAT, id);
+  }
+
+  return node;
+}
+
+/**
+ * @brief Internal function to cancel the scheduled restart and the stall detection, and not to restart the pipeline of the node any more.
+ */
+static void
+_mlops_restart_cancel (mlops_node_s * node)
+{
+  gboolean scheduled;
+
+  G_LOCK (mlops_restart);
+  scheduled = (node->restart_deadline > 0 && g_queue_remove (&g_mlops_restart_queue, node));
+  node->restart_deadline = 0;
+  node->restart.max_retries = 0U;
+  if (node->stall_watched) {
+    node->stall_watched = FALSE;
+    g_mlops_stall_nodes--;
+  }
+  G_UNLOCK (mlops_restart);
+
+  /* The queue of the scheduled restarts holds the reference of the node. */
+  if (scheduled)
+    _mlops_node_unref (node);
+}
+
+/**
+ * @brief Internal function to remove the node from the registry. The caller should release the reference of the node.
+ */
+static mlops_node_s *
+_mlops_node_steal (const int64_t id)
+{
+  mlops_node_shard_s *shard = _mlops_node_get_shard (id);
+  mlops_node_s *node = NULL;
+
+  g_rw_lock_writer_lock (&shard->lock);
+  if (shard->table) {
+    node = (mlops_node_s *) g_hash_table_lookup (shard->table, &id);
+    if (node)
+      g_hash_table_steal (shard->table, &id);
+  }
+  g_rw_lock_writer_unlock (&shard->lock);
+
+  if (node)
+    _mlops_restart_cancel (node);
+
+  return node;
+}
+
+/**
+ * @brief Internal function to build the released pipeline of the node again with the configuration of the node.
+ * @details The budget of the admission control is acquired again, this returns -EBUSY if the budget is exceeded.
+ *          If the released pipeline is being stopped in the worker, this waits until it is done,
+ *          so the node does not run two pipelines holding the device and the budget at once.
+ */
+static int
+_mlops_node_rebuild (mlops_node_s * node, GstElement ** pipeline)
+{
+  gchar *desc;
+  mlops_node_sched_s *sched;
+  mlops_node_config_s config;
+  GstElement *element = NULL;
+  gint ret;
+
+  g_mutex_lock (&node->lock);
+  /* Wait until the released pipeline is stopped in the worker, it may still hold the device and the budget. */
+  while (node->releasing)
+    g_cond_wait (&node->released, &node->lock);
+
+  desc = g_strdup (node->description);
+  sched = mlops_node_sched_copy (node->reclaimed_sched);
+  config = node->reclaimed_config;
+  g_mutex_unlock (&node->lock);
+
+  ret = mlops_node_admission_acquire (node->app, &node->cost, node->priority, NULL, NULL, NULL);
+  if (ret != 0)
+    goto done;
+
+  ret = _mlops_node_build_pipeline (desc, sched, &config, &element);
+  if (ret != 0) {
+    mlops_node_admission_release (node->app, &node->cost);
+    goto done;
+  }
+
+  g_mutex_lock (&node->lock);
+  if (node->element || !node->reclaimed) {
+    /* The pipeline is built by the other request, use it. */
+    _mlops_pool_release_pipelines (g_list_append (NULL, element));
+    mlops_node_admission_release (node->app, &node->cost);
+  } else {
+    _mlops_node_attach_pipeline (node, element);
+    node->reclaimed = FALSE;
+    node->admitted = TRUE;
+    node->rebuild_count++;
+
+    ml_logi ("The released pipeline with ID %" G_GINT64_FORMAT " is built again.", node->id);
+  }
+
+  *pipeline = node->element ? gst_object_ref (node->element) : NULL;
+  g_mutex_unlock (&node->lock);
+
+done:
+  g_free (desc);
+  mlops_node_sched_free (sched);
+  return ret;
+}
+
+/**
+ * @brief Internal function to change pipeline state.
+ */
+static int
+_mlops_node_set_pipeline_state (mlops_node_s * node, GstState state)
+{
+  GstStateChangeReturn ret;
+  GstElement *pipeline;
+  gboolean reclaimed;
+  gint64 nid;
+  gint ret_val;
+
+  g_return_val_if_fail (node != NULL, -EINVAL);
+
+  g_mutex_lock (&node->lock);
+  nid = node->id;
+  pipeline = node->element ? gst_object_ref (node->element) : NULL;
+  reclaimed = node->reclaimed;
+  g_mutex_unlock (&node->lock);
+
+  if (!pipeline && reclaimed) {
+    /* The released pipeline is already stopped, build it again only to start it. */
+    if (state != GST_STATE_PLAYING)
+      return 0;
+
+    ret_val = _mlops_node_rebuild (node, &pipeline);
+    if (ret_val != 0)
+      return ret_val;
+  }
+
+  if (!pipeline) {
+    ml_loge ("The pipeline with ID %" G_GINT64_FORMAT " is not launched yet.", nid);
+    return -EAGAIN;
+  }
+
+  /* Do not hold the node lock, the state change may take a long time. */
+  g_atomic_int_set (&node->error, 0);
+  g_atomic_int_set (&node->eos, 0);
+  g_atomic_int_set (&node->target, (gint) state);
+  ret = gst_element_set_state (pipeline, state);
+  gst_object_unref (pipeline);
+
+  if (ret == GST_STATE_CHANGE_FAILURE) {
+    ml_loge ("Failed to set the state of the pipeline to %s with ID %"
+        G_GINT64_FORMAT, gst_element_state_get_name (state), nid);
+    return -ESTRPIPE;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to release the measured cost.
+ */
+static void
+_mlops_node_learn_free (gpointer data)
+{
+  mlops_node_learn_s *learn = (mlops_node_learn_s *) data;
+
+  g_free (learn->service_name);
+  g_free (learn);
+}
+
+/**
+ * @brief Internal function to update the estimated cost of the service in the main context, the workers do not access the database.
+ */
+static gboolean
+_mlops_node_learn_cb (gpointer data)
+{
+  mlops_node_learn_s *learn = (mlops_node_learn_s *) data;
+
+  mlops_node_admission_learn (learn->service_name, &learn->measured);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Internal function to release mlops node.
+ * @details The last reference may be dropped in any thread, the measured cost is applied to the service in the main context.
+ */
+static void
+_mlops_node_free (mlops_node_s * node)
+{
+  mlops_node_cost_s measured = { 0U, 0U };
+  mlops_node_learn_s *learn = NULL;
+  gint64 playing_time;
+
+  /* The pipeline is not set if the node is destroyed while launching. */
+  if (node->element)
+    _mlops_node_set_pipeline_state (node, GST_STATE_NULL);
+
+  /* The streaming threads have left the task, measure the usage of the pipeline. */
+  G_LOCK (mlops_node_usage);
+  playing_time = node->playing_time;
+  if (node->playing_since > 0)
+    playing_time += g_get_monotonic_time () - node->playing_since;
+
+  if (playing_time >= MLOPS_NODE_LEARN_MIN_TIME)
+    measured.cpu = (guint) MIN (node->cpu_time / 10 / playing_time, G_MAXINT);
+  G_UNLOCK (mlops_node_usage);
+
+  g_mutex_lock (&node->lock);
+
+  /* Keep the estimated memory if it is not measured, the other pipelines were built concurrently. */
+  measured.memory_kb = node->memory_measured ? node->memory_kb : node->cost.memory_kb;
+
+  /* Release the budget and learn the cost of the service. */
+  if (node->admitted)
+    mlops_node_admission_release (node->app, &node->cost);
+
+  if (playing_time >= MLOPS_NODE_LEARN_MIN_TIME && node->service_name) {
+    learn = g_new0 (mlops_node_learn_s, 1);
+    learn->service_name = g_strdup (node->service_name);
+    learn->measured = measured;
+  }
+
+  node->type = MLOPS_NODE_TYPE_NONE;
+  node->id = 0;
+  if (node->element) {
+    _mlops_node_detach_pipeline (node->element);
+    gst_object_unref (node->element);
+    node->element = NULL;
+  }
+  node->sched = NULL;
+  node->config = NULL;
+  mlops_node_stats_unref (node->stats);
+  node->stats = NULL;
+  g_free (node->service_name);
+  node->service_name = NULL;
+  g_free (node->description);
+  node->description = NULL;
+  if (node->models) {
+    g_hash_table_unref (node->models);
+    node->models = NULL;
+  }
+  if (node->params) {
+    g_hash_table_unref (node->params);
+    node->params = NULL;
+  }
+  g_free (node->app);
+  node->app = NULL;
+  g_free (node->error_source);
+  node->error_source = NULL;
+  g_free (node->error_message);
+  node->error_message = NULL;
+  mlops_node_sched_free (node->reclaimed_sched);
+  node->reclaimed_sched = NULL;
+
+  g_mutex_unlock (&node->lock);
+
+  g_mutex_clear (&node->lock);
+  g_cond_clear (&node->released);
+  g_free (node);
+
+  if (learn)
+    g_idle_add_full (G_PRIORITY_DEFAULT_IDLE, _mlops_node_learn_cb, learn, _mlops_node_learn_free);
+
+  ml_agent_idle_uninhibit ();
+}
+
+/**
+ * @brief Internal function to detach the pipeline from the node if it is not played for the timeout (in microseconds).
+ * @details The node keeps the description and the scheduling attributes to build the pipeline again.
+ *          The pipeline is not stopped here, the returned task releases it in the worker.
+ * @return The task to release the pipeline, NULL if the pipeline is not idle.
+ */
+static mlops_swap_task_s *
+_mlops_node_reclaim_select (mlops_node_s * node, const gint64 timeout)
+{
+  mlops_swap_task_s *task;
+  gint64 idle_since;
+
+  G_LOCK (mlops_node_usage);
+  idle_since = node->idle_since;
+  G_UNLOCK (mlops_node_usage);
+
+  if (idle_since == 0 || g_get_monotonic_time () - idle_since < timeout)
+    return NULL;
+
+  g_mutex_lock (&node->lock);
+  if (!node->element || g_atomic_int_get (&node->pending) == GST_STATE_PLAYING) {
+    g_mutex_unlock (&node->lock);
+    return NULL;
+  }
+
+  task = g_new0 (mlops_swap_task_s, 1);
+  task->node = _mlops_node_ref (node);
+  task->reclaim = node->element;
+  task->stats = node->stats;
+  task->sched = node->sched;
+  task->admitted = node->admitted;
+
+  node->element = NULL;
+  node->reclaimed = TRUE;
+  node->releasing = TRUE;
+  mlops_node_sched_free (node->reclaimed_sched);
+  node->reclaimed_sched = mlops_node_sched_copy (node->sched);
+  node->reclaimed_config = *node->config;
+  node->stats = NULL;
+  node->admitted = FALSE;
+  g_mutex_unlock (&node->lock);
+
+  return task;
+}
+
+/**
+ * @brief Internal function to release the idle pipeline detached from the node. This is called in the worker.
+ */
+static void
+_mlops_node_reclaim_pipeline (mlops_swap_task_s * task)
+{
+  mlops_node_s *node = task->node;
+  GstElement *pipeline = task->reclaim;
+  GstBus *bus;
+  gint64 rss;
+
+  task->reclaim = NULL;
+
+  /* The node is not built again until this is done, restore the threads without changing the state record. */
+  bus = gst_element_get_bus (pipeline);
+  gst_bus_set_sync_handler (bus, _mlops_node_build_sync_handler,
+      (gpointer) mlops_node_sched_get (pipeline), NULL);
+  gst_object_unref (bus);
+
+  rss = mlops_node_admission_get_rss ();
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+
+  g_mutex_lock (&node->lock);
+  if (!node->element) {
+    _mlops_node_update_state (node, pipeline);
+    node->config = NULL;
+  }
+  if (node->sched == task->sched)
+    node->sched = NULL;
+  g_mutex_unlock (&node->lock);
+
+  _mlops_node_detach_pipeline (pipeline);
+  gst_object_unref (pipeline);
+  mlops_node_stats_unref (task->stats);
+  task->stats = NULL;
+  rss = MAX (rss - mlops_node_admission_get_rss (), 0);
+
+  g_mutex_lock (&node->lock);
+  node->reclaim_count++;
+  node->reclaimed_kb += (guint64) rss;
+  g_mutex_unlock (&node->lock);
+
+  if (task->admitted)
+    mlops_node_admission_release (node->app, &node->cost);
+
+  /* The device and the budget are released, wake up the request to build the pipeline again. */
+  g_mutex_lock (&node->lock);
+  node->releasing = FALSE;
+  g_cond_broadcast (&node->released);
+  g_mutex_unlock (&node->lock);
+
+  ml_logi ("The pipeline with ID %" G_GINT64_FORMAT " is idle, released it (%"
+      G_GINT64_FORMAT " KB reclaimed).", node->id, rss);
+}
+
+/**
+ * @brief Release the pipelines which are not played for the reclaim timeout.
+ */
+guint
+mlops_node_reclaim_idle (void)
+{
+  GList *nodes = NULL, *tasks = NULL, *l;
+  GHashTableIter iter;
+  gpointer value;
+  mlops_swap_task_s *task;
+  gint64 timeout;
+  guint i, count;
+
+  G_LOCK (mlops_reclaim);
+  timeout = (gint64) g_mlops_reclaim_timeout * G_USEC_PER_SEC;
+  G_UNLOCK (mlops_reclaim);
+
+  if (timeout == 0)
+    return 0U;
+
+  for (i = 0; i < MLOPS_NODE_SHARDS; i++) {
+    mlops_node_shard_s *shard = &g_mlops_node_shards[i];
+
+    g_rw_lock_reader_lock (&shard->lock);
+    if (shard->table) {
+      g_hash_table_iter_init (&iter, shard->table);
+      while (g_hash_table_iter_next (&iter, NULL, &value))
+        nodes = g_list_prepend (nodes, _mlops_node_ref ((mlops_node_s *) value));
+    }
+    g_rw_lock_reader_unlock (&shard->lock);
+  }
+
+  /* Only select the idle pipelines here, stopping the pipeline takes a long time. */
+  for (l = nodes; l != NULL; l = l->next) {
+    task = _mlops_node_reclaim_select ((mlops_node_s *) l->data, timeout);
+    if (task)
+      tasks = g_list_prepend (tasks, task);
+  }
+
+  g_list_free_full (nodes, _mlops_node_unref);
+
+  count = g_list_length (tasks);
+  if (tasks)
+    _mlops_swap_push (tasks);
+
+  return count;
+}
+
+/**
+ * @brief Internal function to select the idle pipelines periodically in the main context, they are released in the worker.
+ */
+static gboolean
+_mlops_node_reclaim_cb (gpointer user_data)
+{
+  mlops_node_reclaim_idle ();
+  return G_SOURCE_CONTINUE;
+}
+
+/**
+ * @brief Set the time (in seconds) to release the pipeline which is not played.
+ */
+void
+mlops_node_set_reclaim_timeout (const guint seconds)
+{
+  G_LOCK (mlops_reclaim);
+  g_mlops_reclaim_timeout = seconds;
+
+  if (g_mlops_reclaim_source > 0U) {
+    g_source_remove (g_mlops_reclaim_source);
+    g_mlops_reclaim_source = 0U;
+  }
+
+  /* Check the idle pipelines at half of the timeout, the pipeline is released within 1.5 times of the timeout. */
+  if (seconds > 0U)
+    g_mlops_reclaim_source = g_timeout_add_seconds (MAX (seconds / 2, 1U), _mlops_node_reclaim_cb, NULL);
+  G_UNLOCK (mlops_reclaim);
+}
+
+/**
+ * @brief Internal function to release the task to switch the pipeline.
+ */
+static void
+_mlops_swap_task_free (mlops_swap_task_s * task)
+{
+  /* The detached pipeline should be released even if the task is not run. */
+  if (task->reclaim)
+    _mlops_node_reclaim_pipeline (task);
+
+  _mlops_node_unref (task->node);
+  g_free (task->model);
+  g_free (task->path);
+  g_free (task->description);
+  if (task->models)
+    g_hash_table_unref (task->models);
+  g_free (task);
+}
+
+/**
+ * @brief Internal function to check the model property of the filter has the path, the files are separated with ','.
+ */
+static gboolean
+_mlops_swap_has_model (const gchar * model, const gchar * path)
+{
+  gchar **files;
+  gboolean found;
+
+  files = g_strsplit (model, ",", -1);
+  found = g_strv_contains ((const gchar * const *) files, path);
+  g_strfreev (files);
+
+  return found;
+}
+
+/**
+ * @brief Internal function to replace the file of the model property which is same as the old path.
+ */
+static gchar *
+_mlops_swap_replace_model (const gchar * model, const gchar * old_path, const gchar * new_path)
+{
+  gchar **files;
+  gchar *replaced;
+  guint i;
+
+  files = g_strsplit (model, ",", -1);
+  for (i = 0; files[i] != NULL; i++) {
+    if (g_str_equal (files[i], old_path)) {
+      g_free (files[i]);
+      files[i] = g_strdup (new_path);
+    }
+  }
+
+  replaced = g_strjoinv (",", files);
+  g_strfreev (files);
+
+  return replaced;
+}
+
+/**
+ * @brief Internal function to find the filters loading the model in the pipeline.
+ * @return TRUE if the model is loaded and all filters loading it can reload the model in place.
+ */
+static gboolean
+_mlops_swap_find_filters (GstElement * pipeline, const gchar * path, GList ** filters)
+{
+  GstIterator *it;
+  GValue item = G_VALUE_INIT;
+  gboolean done = FALSE;
+  gboolean updatable = TRUE;
+
+  if (!GST_IS_BIN (pipeline))
+    return FALSE;
+
+  it = gst_bin_iterate_recurse (GST_BIN (pipeline));
+  while (!done) {
+    switch (gst_iterator_next (it, &item)) {
+      case GST_ITERATOR_OK:
+      {
+        GstElement *element = GST_ELEMENT (g_value_get_object (&item));
+        GObjectClass *klass = G_OBJECT_GET_CLASS (element);
+        gchar *model = NULL;
+        gboolean is_updatable = FALSE;
+
+        /* The filter reloads the model when the model property is changed, if it is updatable. */
+        if (g_object_class_find_property (klass, "model") &&
+            g_object_class_find_property (klass, "is-updatable")) {
+          g_object_get (element, "model", &model, "is-updatable", &is_updatable, NULL);
+
+          /* The shared filter is not reloaded, it would replace the model of the other pipelines sharing the key. */
+          if (model && _mlops_swap_has_model (model, path)) {
+            if (is_updatable && !mlops_node_share_is_attached (element))
+              *filters = g_list_prepend (*filters, gst_object_ref (element));
+            else
+              updatable = FALSE;
+          }
+
+          g_free (model);
+        }
+
+        g_value_reset (&item);
+        break;
+      }
+      case GST_ITERATOR_RESYNC:
+        g_list_free_full (*filters, gst_object_unref);
+        *filters = NULL;
+        updatable = TRUE;
+        gst_iterator_resync (it);
+        break;
+      default:
+        done = TRUE;
+        break;
+    }
+  }
+
+  g_value_unset (&item);
+  gst_iterator_free (it);
+
+  return (updatable && *filters != NULL);
+}
+
+/**
+ * @brief Internal function to reload the model of the filters in place.
+ * @return The time (in microseconds) the stream is interrupted.
+ */
+static gint64
+_mlops_swap_reload_filters (GList * filters, const gchar * old_path, const gchar * new_path)
+{
+  GList *l;
+  gint64 start;
+
+  start = g_get_monotonic_time ();
+
+  for (l = filters; l != NULL; l = l->next) {
+    GstElement *element = GST_ELEMENT (l->data);
+    gchar *model = NULL;
+    gchar *replaced;
+
+    g_object_get (element, "model", &model, NULL);
+    replaced = _mlops_swap_replace_model (model, old_path, new_path);
+    g_object_set (element, "model", replaced, NULL);
+
+    g_free (model);
+    g_free (replaced);
+  }
+
+  return g_get_monotonic_time () - start;
+}
+
+/**
+ * @brief Internal function to replace the pipeline of the node with the pipeline of the new description.
+ * @details The new pipeline is built and prerolled while the old one is running, and the stream is interrupted only while switching them.
+ *          If the new pipeline cannot be built while the old one is running, e.g., the device is opened exclusively,
+ *          the old pipeline is stopped before building the new one.
+ * @return 0 on success, -ECANCELED if the pipeline of the node is changed while switching.
+ */
+static int
+_mlops_swap_pipeline (mlops_node_s * node, GstElement * old, const gchar * desc,
+    const gchar ** method, gint64 * gap)
+{
+  GstElement *pipeline = NULL;
+  GstBus *bus;
+  mlops_node_stats_s *stats = NULL;
+  mlops_node_sched_s *sched;
+  mlops_node_config_s config;
+  GstState target;
+  gboolean swapped = FALSE;
+  gint64 start;
+  gint ret;
+
+  g_mutex_lock (&node->lock);
+  sched = mlops_node_sched_copy (node->sched);
+  config = *node->config;
+  g_mutex_unlock (&node->lock);
+
+  target = (GstState) g_atomic_int_get (&node->target);
+  if (target != GST_STATE_PLAYING)
+    target = GST_STATE_PAUSED;
+
+  *method = "shadow";
+  ret = _mlops_node_build_pipeline (desc, sched, &config, &pipeline);
+  if (ret == 0 && gst_element_get_state (pipeline, NULL, NULL,
+          MLOPS_NODE_PREROLL_TIMEOUT) == GST_STATE_CHANGE_FAILURE) {
+    _mlops_pool_release_pipelines (g_list_append (NULL, pipeline));
+    pipeline = NULL;
+    ret = -ESTRPIPE;
+  }
+
+  start = g_get_monotonic_time ();
+
+  if (ret == 0) {
+    /* Stop the data flow of the old pipeline, it is released after the new one is running. */
+    gst_element_set_state (old, GST_STATE_PAUSED);
+  } else {
+    ml_logw ("Failed to build the pipeline with ID %" G_GINT64_FORMAT
+        " while running, stop it and build again.", node->id);
+
+    *method = "restart";
+    gst_element_set_state (old, GST_STATE_NULL);
+
+    ret = _mlops_node_build_pipeline (desc, sched, &config, &pipeline);
+    if (ret != 0) {
+      /* Keep the old pipeline. */
+      gst_element_set_state (old, target);
+      goto done;
+    }
+  }
+
+  g_mutex_lock (&node->lock);
+  if (node->element == old) {
+    /* The old pipeline is not tracked any more, the scheduling attributes of its threads are restored when it is stopped. */
+    bus = gst_element_get_bus (old);
+    gst_bus_set_sync_handler (bus, _mlops_node_build_sync_handler,
+        (gpointer) mlops_node_sched_get (old), NULL);
+    gst_object_unref (bus);
+
+    stats = node->stats;
+    _mlops_node_attach_pipeline (node, pipeline);
+    swapped = TRUE;
+  }
+  g_mutex_unlock (&node->lock);
+
+  if (!swapped) {
+    /* The node is released or destroyed while switching. */
+    _mlops_pool_release_pipelines (g_list_append (NULL, pipeline));
+    ret = -ECANCELED;
+    goto done;
+  }
+
+  /* The state may be changed while switching, follow the last request. */
+  target = (g_atomic_int_get (&node->target) == GST_STATE_PLAYING) ?
+      GST_STATE_PLAYING : GST_STATE_PAUSED;
+
+  gst_element_set_state (pipeline, target);
+  gst_element_get_state (pipeline, NULL, NULL, MLOPS_NODE_PREROLL_TIMEOUT);
+  *gap = g_get_monotonic_time () - start;
+
+  /* Release the old pipeline, the node holds the reference of the new one. */
+  gst_element_set_state (old, GST_STATE_NULL);
+  gst_object_unref (old);
+  mlops_node_stats_unref (stats);
+
+done:
+  mlops_node_sched_free (sched);
+  return ret;
+}
+
+/**
+ * @brief Internal function to switch the pipeline of the node to the activated model.
+ */
+static void
+_mlops_swap_model (mlops_swap_task_s * task)
+{
+  mlops_node_s *node = task->node;
+  mlops_node_model_s *info;
+  GHashTable *models;
+  GstElement *pipeline = NULL;
+  GList *filters = NULL;
+  gchar *old_path = NULL;
+  const gchar *method = NULL;
+  gint64 gap = 0;
+  gint ret = 0;
+
+  g_mutex_lock (&node->lock);
+  info = node->models ?
+      (mlops_node_model_s *) g_hash_table_lookup (node->models, task->model) : NULL;
+  if (node->id == 0 || !info || info->version == task->version) {
+    g_mutex_unlock (&node->lock);
+    goto done;
+  }
+
+  old_path = g_strdup (info->path);
+
+  if (node->element) {
+    pipeline = gst_object_ref (node->element);
+  } else if (node->reclaimed) {
+    /* The released pipeline is built with the new description when the node is started. */
+    method = "rebuild";
+  }
+  g_mutex_unlock (&node->lock);
+
+  if (!pipeline && !method) {
+    ml_logw ("The pipeline with ID %" G_GINT64_FORMAT
+        " is launching, it keeps the previous version of the model '%s'.",
+        node->id, task->model);
+    goto done;
+  }
+
+  if (pipeline) {
+    if (_mlops_swap_find_filters (pipeline, old_path, &filters)) {
+      method = "reload";
+      gap = _mlops_swap_reload_filters (filters, old_path, task->path);
+      gst_object_unref (pipeline);
+    } else {
+      /* The reference of the old pipeline is released after switching. */
+      ret = _mlops_swap_pipeline (node, pipeline, task->description, &method, &gap);
+      if (ret != 0)
+        gst_object_unref (pipeline);
+    }
+
+    g_list_free_full (filters, gst_object_unref);
+  }
+
+  if (ret != 0) {
+    ml_loge ("Failed to switch the pipeline with ID %" G_GINT64_FORMAT
+        " to the version %u of the model '%s'.", node->id, task->version, task->model);
+    goto done;
+  }
+
+  g_mutex_lock (&node->lock);
+  g_free (node->description);
+  node->description = g_strdup (task->description);
+  models = node->models;
+  node->models = task->models ? g_hash_table_ref (task->models) : NULL;
+  node->swap_count++;
+  node->swap_gap = gap;
+  node->swap_method = method;
+  g_mutex_unlock (&node->lock);
+
+  if (models)
+    g_hash_table_unref (models);
+
+  ml_logi ("The pipeline with ID %" G_GINT64_FORMAT " is switched to the version %u of the model '%s' (%s, %"
+      G_GINT64_FORMAT " us interrupted).", node->id, task->version, task->model, method, gap);
+
+done:
+  g_free (old_path);
+}
+
+/**
+ * @brief Internal function to switch the pipeline of the node to the changed description.
+ */
+static void
+_mlops_swap_description (mlops_swap_task_s * task)
+{
+  mlops_node_s *node = task->node;
+  GstElement *pipeline = NULL;
+  GHashTable *models;
+  const gchar *method = NULL;
+  gint64 gap = 0;
+  gint ret = 0;
+
+  if (!task->description) {
+    ret = _mlops_node_expand_kept (node, &task->description, &task->models);
+    if (ret != 0) {
+      ml_logw ("Failed to get the changed description of the pipeline with ID %" G_GINT64_FORMAT
+          ", it keeps the previous one.", node->id);
+      return;
+    }
+  }
+
+  g_mutex_lock (&node->lock);
+  if (node->id == 0 || g_strcmp0 (node->description, task->description) == 0) {
+    g_mutex_unlock (&node->lock);
+    return;
+  }
+
+  if (node->element) {
+    pipeline = gst_object_ref (node->element);
+  } else if (node->reclaimed) {
+    /* The released pipeline is built with the new description when the node is started. */
+    method = "rebuild";
+  }
+  g_mutex_unlock (&node->lock);
+
+  if (!pipeline && !method) {
+    ml_logw ("The pipeline with ID %" G_GINT64_FORMAT
+        " is launching, it keeps the previous description.", node->id);
+    return;
+  }
+
+  if (pipeline) {
+    /* The reference of the old pipeline is released after switching. */
+    ret = _mlops_swap_pipeline (node, pipeline, task->description, &method, &gap);
+    if (ret != 0) {
+      gst_object_unref (pipeline);
+      ml_loge ("Failed to switch the pipeline with ID %" G_GINT64_FORMAT
+          " to the changed description.", node->id);
+      return;
+    }
+  }
+
+  g_mutex_lock (&node->lock);
+  g_free (node->description);
+  node->description = g_strdup (task->description);
+  models = node->models;
+  node->models = task->models ? g_hash_table_ref (task->models) : NULL;
+  node->swap_count++;
+  node->swap_gap = gap;
+  node->swap_method = method;
+  g_mutex_unlock (&node->lock);
+
+  if (models)
+    g_hash_table_unref (models);
+
+  ml_logi ("The pipeline with ID %" G_GINT64_FORMAT " is switched to the changed description (%s, %"
+      G_GINT64_FORMAT " us interrupted).", node->id, method, gap);
+}
+
+/**
+ * @brief Internal function to restart the pipeline which posted an error.
+ * @details The pipeline is prerolled again and set to the state requested last, or the new pipeline replaces it if the policy is to rebuild.
+ *          If the pipeline is not recovered, the next restart is scheduled until the maximum number of retries.
+ */
+static void
+_mlops_restart_pipeline (mlops_swap_task_s * task)
+{
+  mlops_node_s *node = task->node;
+  GstElement *pipeline = NULL;
+  gchar *desc = NULL;
+  const gchar *method = NULL;
+  GstState target;
+  gboolean rebuild;
+  gint64 start, gap = 0;
+  gint ret = -ESTRPIPE;
+
+  start = g_get_monotonic_time ();
+
+  G_LOCK (mlops_restart);
+  rebuild = node->restart.rebuild;
+  G_UNLOCK (mlops_restart);
+
+  g_mutex_lock (&node->lock);
+  if (node->id != 0 && node->element) {
+    pipeline = gst_object_ref (node->element);
+    desc = g_strdup (node->description);
+  }
+  g_mutex_unlock (&node->lock);
+
+  target = (GstState) g_atomic_int_get (&node->target);
+  if (!pipeline || target < GST_STATE_PAUSED) {
+    /* The pipeline is stopped or released, or the node is destroyed. */
+    G_LOCK (mlops_restart);
+    node->restart_running = FALSE;
+    G_UNLOCK (mlops_restart);
+
+    if (pipeline)
+      gst_object_unref (pipeline);
+    g_free (desc);
+    return;
+  }
+
+  g_atomic_int_set (&node->error, 0);
+
+  if (rebuild) {
+    ret = _mlops_swap_pipeline (node, pipeline, desc, &method, &gap);
+    if (ret != 0)
+      gst_object_unref (pipeline);
+  } else {
+    gst_element_set_state (pipeline, GST_STATE_NULL);
+
+    if (gst_element_set_state (pipeline, target) != GST_STATE_CHANGE_FAILURE &&
+        gst_element_get_state (pipeline, NULL, NULL,
+            MLOPS_NODE_PREROLL_TIMEOUT) != GST_STATE_CHANGE_FAILURE)
+      ret = 0;
+
+    gst_object_unref (pipeline);
+  }
+
+  G_LOCK (mlops_restart);
+  node->restart_running = FALSE;
+
+  /* The restarted pipeline posted an error again, the error after this is handled by the bus handler. */
+  if (ret == 0 && g_atomic_int_get (&node->error))
+    ret = -ESTRPIPE;
+
+  node->restart_last = g_get_monotonic_time ();
+  if (ret == 0) {
+    node->restart_count++;
+    node->restart_time = node->restart_last - start;
+  } else {
+    _mlops_restart_schedule_locked (node);
+  }
+  G_UNLOCK (mlops_restart);
+
+  if (ret == 0) {
+    ml_logi ("The pipeline with ID %" G_GINT64_FORMAT " is restarted (%s, %"
+        G_GINT64_FORMAT " us).", node->id, rebuild ? "rebuild" : "repreroll",
+        g_get_monotonic_time () - start);
+  } else {
+    ml_loge ("Failed to restart the pipeline with ID %" G_GINT64_FORMAT ".", node->id);
+  }
+
+  g_free (desc);
+}
+
+/**
+ * @brief Worker to switch the pipeline of the node. This does not access the database.
+ */
+static void
+_mlops_swap_worker (gpointer data, gpointer user_data)
+{
+  mlops_swap_task_s *task = (mlops_swap_task_s *) data;
+
+  /* Skip the queued tasks when finalizing, the detached pipeline is released in any case. */
+  if (task->reclaim) {
+    _mlops_node_reclaim_pipeline (task);
+  } else if (!g_atomic_int_get (&g_mlops_swap_closing)) {
+    if (task->restart)
+      _mlops_restart_pipeline (task);
+    else if (task->model)
+      _mlops_swap_model (task);
+    else
+      _mlops_swap_description (task);
+  } else if (task->restart) {
+    G_LOCK (mlops_restart);
+    task->node->restart_running = FALSE;
+    G_UNLOCK (mlops_restart);
+  }
+
+  _mlops_swap_task_free (task);
+}
+
+/**
+ * @brief Internal function to push the tasks to switch the pipelines to the workers.
+ * @return 0 on success, -EIO if failed to create the workers.
+ */
+static int
+_mlops_swap_push (GList * tasks)
+{
+  GList *l;
+
+  G_LOCK (mlops_swap);
+  if (!g_mlops_swap_workers) {
+    g_mlops_swap_workers = g_thread_pool_new (_mlops_swap_worker, NULL,
+        MLOPS_SWAP_MAX_THREADS, FALSE, NULL);
+    if (!g_mlops_swap_workers) {
+      G_UNLOCK (mlops_swap);
+      ml_loge ("Failed to create the thread pool to switch the pipelines.");
+      g_list_free_full (tasks, (GDestroyNotify) _mlops_swap_task_free);
+      return -EIO;
+    }
+  }
+
+  for (l = tasks; l != NULL; l = l->next)
+    g_thread_pool_push (g_mlops_swap_workers, l->data, NULL);
+  G_UNLOCK (mlops_swap);
+
+  g_list_free (tasks);
+  return 0;
+}
+
+/**
+ * @brief Internal function to get the stall threshold of the service. This accesses the database.
+ */
+static void
+_mlops_stall_get_policy (const gchar * name, mlops_restart_policy_s * policy)
+{
+  g_autofree gchar *threshold = NULL;
+  g_autofree gchar *restart = NULL;
+  gint64 value;
+
+  policy->stall_ms = 0U;
+  policy->stall_restart = FALSE;
+
+  if (svcdb_pipeline_get_attribute (name, MLOPS_STALL_THRESHOLD_ATTR, &threshold) != 0 || !threshold)
+    return;
+
+  value = g_ascii_strtoll (threshold, NULL, 10);
+  policy->stall_ms = (value > 0) ? (guint) MIN (value, G_MAXINT32) : 0U;
+
+  if (svcdb_pipeline_get_attribute (name, MLOPS_STALL_RESTART_ATTR, &restart) == 0)
+    policy->stall_restart = (g_strcmp0 (restart, "true") == 0);
+}
+
+/**
+ * @brief Internal function to get the restart policy of the service. This accesses the database.
+ */
+static void
+_mlops_restart_get_policy (const gchar * name, mlops_restart_policy_s * policy)
+{
+  g_autofree gchar *retries = NULL;
+  g_autofree gchar *backoff = NULL;
+  g_autofree gchar *backoff_max = NULL;
+  g_autofree gchar *strategy = NULL;
+  gint64 value;
+
+  policy->max_retries = 0U;
+  policy->backoff_ms = MLOPS_RESTART_DEFAULT_BACKOFF_MS;
+  policy->backoff_max_ms = MLOPS_RESTART_DEFAULT_BACKOFF_MAX_MS;
+  policy->rebuild = FALSE;
+
+  _mlops_stall_get_policy (name, policy);
+
+  if (svcdb_pipeline_get_attribute (name, MLOPS_RESTART_MAX_RETRIES_ATTR, &retries) == 0 && retries) {
+    value = g_ascii_strtoll (retries, NULL, 10);
+    policy->max_retries = (value > 0) ? (guint) MIN (value, G_MAXUINT8) : 0U;
+  }
+
+  /* The stalled pipeline cannot be restarted without the retries. */
+  if (policy->max_retries == 0U && policy->stall_restart) {
+    ml_logi ("The service '%s' restarts the stalled pipeline without '%s', restart %u times.",
+        name, MLOPS_RESTART_MAX_RETRIES_ATTR, MLOPS_STALL_DEFAULT_RETRIES);
+    policy->max_retries = MLOPS_STALL_DEFAULT_RETRIES;
+  }
+
+  if (policy->max_retries == 0U)
+    return;
+
+  if (svcdb_pipeline_get_attribute (name, MLOPS_RESTART_BACKOFF_ATTR, &backoff) == 0 && backoff) {
+    value = g_ascii_strtoll (backoff, NULL, 10);
+    if (value > 0)
+      policy->backoff_ms = (guint) MIN (value, G_MAXINT32);
+  }
+
+  if (svcdb_pipeline_get_attribute (name, MLOPS_RESTART_BACKOFF_MAX_ATTR, &backoff_max) == 0 && backoff_max) {
+    value = g_ascii_strtoll (backoff_max, NULL, 10);
+    if (value > 0)
+      policy->backoff_max_ms = (guint) MIN (value, G_MAXINT32);
+  }
+
+  policy->backoff_max_ms = MAX (policy->backoff_max_ms, policy->backoff_ms);
+
+  if (svcdb_pipeline_get_attribute (name, MLOPS_RESTART_STRATEGY_ATTR, &strategy) == 0)
+    policy->rebuild = (g_strcmp0 (strategy, "rebuild") == 0);
+}
+
+/**
+ * @brief Internal function to compare the time to restart the pipelines of the nodes.
+ */
+static gint
+_mlops_restart_compare (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+  const mlops_node_s *na = (const mlops_node_s *) a;
+  const mlops_node_s *nb = (const mlops_node_s *) b;
+
+  return (na->restart_deadline > nb->restart_deadline) - (na->restart_deadline < nb->restart_deadline);
+}
+
+/**
+ * @brief Internal function to restart the pipeline in the swap worker when the backoff is expired.
+ * @details The node is popped from the queue, and the swap task takes its reference.
+ */
+static void
+_mlops_restart_run (mlops_node_s * node)
+{
+  mlops_swap_task_s *task;
+
+  task = g_new0 (mlops_swap_task_s, 1);
+  task->node = node;
+  task->restart = TRUE;
+
+  if (_mlops_swap_push (g_list_append (NULL, task)) != 0) {
+    G_LOCK (mlops_restart);
+    node->restart_running = FALSE;
+    G_UNLOCK (mlops_restart);
+  }
+}
+
+/**
+ * @brief Timer to wait for the backoff of the scheduled restarts. This does not depend on the main loop.
+ * @details This returns to the pool when no restart is scheduled.
+ */
+static void
+_mlops_restart_timer (gpointer data, gpointer user_data)
+{
+  mlops_node_s *node;
+
+  G_LOCK (mlops_restart);
+  while (!g_mlops_restart_closing) {
+    node = (mlops_node_s *) g_queue_peek_head (&g_mlops_restart_queue);
+    if (!node)
+      break;
+
+    if (node->restart_deadline > g_get_monotonic_time ()) {
+      g_cond_wait_until (&g_mlops_restart_cond, &G_LOCK_NAME (mlops_restart),
+          node->restart_deadline);
+      continue;
+    }
+
+    g_queue_pop_head (&g_mlops_restart_queue);
+    node->restart_deadline = 0;
+    node->restart_running = TRUE;
+    G_UNLOCK (mlops_restart);
+
+    _mlops_restart_run (node);
+    G_LOCK (mlops_restart);
+  }
+  g_mlops_restart_timer_running = FALSE;
+  G_UNLOCK (mlops_restart);
+}
+
+/**
+ * @brief Internal function to schedule the restart of the pipeline. Should be called with the restart lock.
+ * @details The delay is doubled for each consecutive restart, and the count is reset when the pipeline runs without error for a while.
+ *          The node is queued with the time to restart, and the timer in the thread pool pushes the restart to the swap worker.
+ */
+static void
+_mlops_restart_schedule_locked (mlops_node_s * node)
+{
+  guint delay;
+  guint i;
+
+  if (node->restart.max_retries == 0U || node->restart_deadline > 0 ||
+      node->restart_running || g_mlops_restart_closing)
+    return;
+
+  if (node->restart_last > 0 &&
+      g_get_monotonic_time () - node->restart_last > MLOPS_RESTART_STABLE_TIME)
+    node->restart_attempts = 0U;
+
+  if (node->restart_attempts >= node->restart.max_retries) {
+    ml_loge ("The pipeline with ID %" G_GINT64_FORMAT " is not recovered after %u restarts.",
+        node->id, node->restart_attempts);
+    return;
+  }
+
+  if (!g_mlops_restart_timer) {
+    g_mlops_restart_timer = g_thread_pool_new (_mlops_restart_timer, NULL, 1, FALSE, NULL);
+    if (!g_mlops_restart_timer) {
+      ml_loge ("Failed to create the timer to restart the pipelines.");
+      return;
+    }
+  }
+
+  delay = node->restart.backoff_ms;
+  for (i = 0; i < node->restart_attempts && delay < node->restart.backoff_max_ms; i++)
+    delay *= 2U;
+  delay = MIN (delay, node->restart.backoff_max_ms);
+
+  node->restart_attempts++;
+  node->restart_deadline = g_get_monotonic_time () + (gint64) delay * G_TIME_SPAN_MILLISECOND;
+  g_queue_insert_sorted (&g_mlops_restart_queue, _mlops_node_ref (node),
+      _mlops_restart_compare, NULL);
+
+  if (g_mlops_restart_timer_running) {
+    g_cond_signal (&g_mlops_restart_cond);
+  } else {
+    g_mlops_restart_timer_running = TRUE;
+    g_thread_pool_push (g_mlops_restart_timer, GINT_TO_POINTER (1), NULL);
+  }
+}
+
+/**
+ * @brief Internal function to record the error posted by the pipeline and schedule the restart. This does not block.
+ */
+static void
+_mlops_restart_handle_error (mlops_node_s * node, GstObject * src, GError * err)
+{
+  G_LOCK (mlops_restart);
+  g_free (node->error_source);
+  node->error_source = g_strdup (src ? GST_OBJECT_NAME (src) : NULL);
+  g_free (node->error_message);
+  node->error_message = g_strdup (err ? err->message : NULL);
+  node->error_time = g_get_real_time ();
+
+  /* The error while restarting is handled when the restart is done. */
+  _mlops_restart_schedule_locked (node);
+  G_UNLOCK (mlops_restart);
+}
+
+/**
+ * @brief Internal function to check the time since the last buffer entered the sinks of the playing pipeline. This is called in the main context.
+ * @details The stall is notified once until the buffer enters the sinks again, and the pipeline is restarted if the policy is set.
+ *          The pipeline which posted an end-of-stream does not receive the buffer any more, it is not stalled.
+ */
+static void
+_mlops_stall_check_node (mlops_node_s * node)
+{
+  mlops_node_stall_cb cb;
+  void *cb_data;
+  gint64 now, since, last = 0, idle;
+  gboolean notify = FALSE;
+  gboolean probe;
+
+  if (g_atomic_int_get (&node->state) != GST_STATE_PLAYING || g_atomic_int_get (&node->eos)) {
+    G_LOCK (mlops_restart);
+    node->stalled = FALSE;
+    G_UNLOCK (mlops_restart);
+    return;
+  }
+
+  G_LOCK (mlops_node_usage);
+  since = node->playing_since;
+  G_UNLOCK (mlops_node_usage);
+
+  g_mutex_lock (&node->lock);
+  probe = (!node->config || node->config->stats);
+  if (node->stats)
+    last = mlops_node_stats_get_last_buffer (node->stats);
+  g_mutex_unlock (&node->lock);
+
+  /* The last buffer is not recorded if the service disables the pad probes. */
+  if (!probe)
+    return;
+
+  /* The pipeline may not receive the buffer yet after it is played. */
+  now = g_get_monotonic_time ();
+  idle = (since > 0) ? now - MAX (last, since) : 0;
+
+  G_LOCK (mlops_restart);
+  if (idle >= (gint64) node->restart.stall_ms * G_TIME_SPAN_MILLISECOND) {
+    if (!node->stalled) {
+      node->stalled = TRUE;
+      node->stall_count++;
+      notify = TRUE;
+
+      if (node->restart.stall_restart)
+        _mlops_restart_schedule_locked (node);
+    }
+  } else if (node->stalled) {
+    node->stalled = FALSE;
+    ml_logi ("The pipeline with ID %" G_GINT64_FORMAT " is not stalled any more.", node->id);
+  }
+  G_UNLOCK (mlops_restart);
+
+  if (notify) {
+    ml_logw ("The pipeline with ID %" G_GINT64_FORMAT " is stalled, no buffer for %"
+        G_GINT64_FORMAT " ms.", node->id, idle / G_TIME_SPAN_MILLISECOND);
+
+    G_LOCK (mlops_stall_cb);
+    cb = g_mlops_stall_cb;
+    cb_data = g_mlops_stall_cb_data;
+    G_UNLOCK (mlops_stall_cb);
+
+    if (cb)
+      cb (node->id, idle / G_TIME_SPAN_MILLISECOND, cb_data);
+  }
+}
+
+/**
+ * @brief Internal function to check the stall of all pipelines with the stall threshold. This is called in the main context.
+ * @details The shared timer is removed when no pipeline has the stall threshold.
+ */
+static gboolean
+_mlops_stall_check_cb (gpointer data)
+{
+  GList *nodes = NULL;
+  GList *iter_node;
+  GHashTableIter iter;
+  gpointer value;
+  mlops_node_s *node;
+  guint i;
+
+  G_LOCK (mlops_restart);
+  if (g_mlops_stall_nodes == 0U) {
+    g_mlops_stall_source = 0U;
+    G_UNLOCK (mlops_restart);
+    return G_SOURCE_REMOVE;
+  }
+  G_UNLOCK (mlops_restart);
+
+  for (i = 0; i < MLOPS_NODE_SHARDS; i++) {
+    mlops_node_shard_s *shard = &g_mlops_node_shards[i];
+
+    g_rw_lock_reader_lock (&shard->lock);
+    if (shard->table) {
+      g_hash_table_iter_init (&iter, shard->table);
+      while (g_hash_table_iter_next (&iter, NULL, &value)) {
+        node = (mlops_node_s *) value;
+
+        G_LOCK (mlops_restart);
+        if (node->stall_watched)
+          nodes = g_list_prepend (nodes, _mlops_node_ref (node));
+        G_UNLOCK (mlops_restart);
+      }
+    }
+    g_rw_lock_reader_unlock (&shard->lock);
+  }
+
+  for (iter_node = nodes; iter_node; iter_node = g_list_next (iter_node))
+    _mlops_stall_check_node ((mlops_node_s *) iter_node->data);
+
+  g_list_free_full (nodes, _mlops_node_unref);
+  return G_SOURCE_CONTINUE;
+}
+
+/**
+ * @brief Internal function to start checking the stall of the pipeline, if the stall threshold of the service is set.
+ * @details All pipelines share one timer, it is added when the first pipeline with the stall threshold is added.
+ */
+static void
+_mlops_stall_start (mlops_node_s * node)
+{
+  G_LOCK (mlops_restart);
+  if (node->restart.stall_ms > 0U && !node->stall_watched) {
+    node->stall_watched = TRUE;
+    g_mlops_stall_nodes++;
+
+    if (g_mlops_stall_source == 0U)
+      g_mlops_stall_source = g_timeout_add_seconds (MLOPS_STALL_CHECK_INTERVAL_S,
+          _mlops_stall_check_cb, NULL);
+  }
+  G_UNLOCK (mlops_restart);
+}
+
+/**
+ * @brief Internal function to cancel the scheduled restarts and the stall detection of all nodes.
+ */
+static void
+_mlops_restart_cancel_all (void)
+{
+  GList *nodes = NULL, *scheduled = NULL;
+  GList *iter_node;
+  GHashTableIter iter;
+  GThreadPool *timer;
+  mlops_node_s *node;
+  gpointer value;
+  guint i, source;
+
+  for (i = 0; i < MLOPS_NODE_SHARDS; i++) {
+    mlops_node_shard_s *shard = &g_mlops_node_shards[i];
+
+    g_rw_lock_reader_lock (&shard->lock);
+    if (shard->table) {
+      g_hash_table_iter_init (&iter, shard->table);
+      while (g_hash_table_iter_next (&iter, NULL, &value))
+        nodes = g_list_prepend (nodes, _mlops_node_ref ((mlops_node_s *) value));
+    }
+    g_rw_lock_reader_unlock (&shard->lock);
+  }
+
+  for (iter_node = nodes; iter_node; iter_node = g_list_next (iter_node))
+    _mlops_restart_cancel ((mlops_node_s *) iter_node->data);
+
+  g_list_free_full (nodes, _mlops_node_unref);
+
+  /* Stop the timer, the restart is not scheduled until it is stopped. */
+  G_LOCK (mlops_restart);
+  source = g_mlops_stall_source;
+  g_mlops_stall_source = 0U;
+  timer = g_mlops_restart_timer;
+  g_mlops_restart_timer = NULL;
+  g_mlops_restart_closing = TRUE;
+  g_cond_broadcast (&g_mlops_restart_cond);
+  G_UNLOCK (mlops_restart);
+
+  if (timer)
+    g_thread_pool_free (timer, FALSE, TRUE);
+
+  G_LOCK (mlops_restart);
+  g_mlops_restart_closing = FALSE;
+  while ((node = (mlops_node_s *) g_queue_pop_head (&g_mlops_restart_queue)) != NULL) {
+    node->restart_deadline = 0;
+    scheduled = g_list_prepend (scheduled, node);
+  }
+  G_UNLOCK (mlops_restart);
+
+  g_list_free_full (scheduled, _mlops_node_unref);
+
+  if (source > 0U)
+    g_source_remove (source);
+}
+
+/**
+ * @brief Internal function to get the description of the node from the tokens of its service, with the parameters of the node and the activated models.
+ * @details This accesses the database to get the description of the service.
+ */
+static int
+_mlops_node_expand (mlops_node_s * node, gchar ** desc, GHashTable ** models)
+{
+  g_autofree gchar *stored = NULL;
+  mlops_node_type_e type;
+  GHashTable *params;
+  gchar *service_name;
+  gint result = -ECANCELED;
+
+  g_mutex_lock (&node->lock);
+  type = node->type;
+  service_name = g_strdup (node->service_name);
+  params = node->params ? g_hash_table_ref (node->params) : NULL;
+  g_mutex_unlock (&node->lock);
+
+  if (type == MLOPS_NODE_TYPE_COMPOSITE) {
+    result = mlops_node_composite_expand (service_name, params, desc, models);
+  } else if (type == MLOPS_NODE_TYPE_PIPELINE) {
+    result = svcdb_pipeline_get (service_name, &stored);
+    if (result == 0)
+      result = mlops_node_template_expand (service_name, stored, params, desc, models);
+  }
+
+  g_free (service_name);
+  if (params)
+    g_hash_table_unref (params);
+
+  return result;
+}
+
+/**
+ * @brief Internal function to get the description of the node from the kept description of its service, with the parameters of the node.
+ * @details This does not access the database, the models and sources of the service should be read in advance.
+ */
+static int
+_mlops_node_expand_kept (mlops_node_s * node, gchar ** desc, GHashTable ** models)
+{
+  mlops_node_type_e type;
+  GHashTable *params;
+  gchar *service_name;
+  gint result = -ECANCELED;
+
+  g_mutex_lock (&node->lock);
+  type = node->type;
+  service_name = g_strdup (node->service_name);
+  params = node->params ? g_hash_table_ref (node->params) : NULL;
+  g_mutex_unlock (&node->lock);
+
+  if (!service_name)
+    result = -ECANCELED;
+  else if (type == MLOPS_NODE_TYPE_COMPOSITE)
+    result = mlops_node_composite_expand_kept (service_name, params, desc, models);
+  else if (type == MLOPS_NODE_TYPE_PIPELINE)
+    result = mlops_node_template_expand_kept (service_name, params, desc, models);
+
+  g_free (service_name);
+  if (params)
+    g_hash_table_unref (params);
+
+  return result;
+}
+
+/**
+ * @brief Switch the running pipelines referring the model to the activated version.
+ */
+int
+mlops_node_model_update (const gchar * model)
+{
+  GList *nodes = NULL, *tasks = NULL, *l;
+  GHashTableIter iter;
+  gpointer value;
+  gchar *path = NULL;
+  guint version = 0U;
+  guint i;
+  gint ret;
+
+  g_return_val_if_fail (model != NULL, -EINVAL);
+
+  /* Drop the cached model and read the activated one in the caller. */
+  mlops_node_template_model_changed (model);
+
+  ret = mlops_node_template_get_model (model, &path, &version);
+  if (ret != 0)
+    return ret;
+
+  for (i = 0; i < MLOPS_NODE_SHARDS; i++) {
+    mlops_node_shard_s *shard = &g_mlops_node_shards[i];
+
+    g_rw_lock_reader_lock (&shard->lock);
+    if (shard->table) {
+      g_hash_table_iter_init (&iter, shard->table);
+      while (g_hash_table_iter_next (&iter, NULL, &value)) {
+        mlops_node_s *node = (mlops_node_s *) value;
+        mlops_node_model_s *info;
+
+        g_mutex_lock (&node->lock);
+        info = node->models ?
+            (mlops_node_model_s *) g_hash_table_lookup (node->models, model) : NULL;
+        if (info && info->version != version)
+          nodes = g_list_prepend (nodes, _mlops_node_ref (node));
+        g_mutex_unlock (&node->lock);
+      }
+    }
+    g_rw_lock_reader_unlock (&shard->lock);
+  }
+
+  /* Build the description from the tokens of the service with the activated models in the caller, this accesses the database. */
+  for (l = nodes; l != NULL; l = l->next) {
+    mlops_node_s *node = (mlops_node_s *) l->data;
+    mlops_swap_task_s *task;
+    gchar *desc = NULL;
+    GHashTable *models = NULL;
+
+    if (_mlops_node_expand (node, &desc, &models) != 0) {
+      ml_logw ("Failed to get the description of the pipeline with ID %" G_GINT64_FORMAT
+          ", it keeps the previous version of the model '%s'.", node->id, model);
+      _mlops_node_unref (node);
+      continue;
+    }
+
+    task = g_new0 (mlops_swap_task_s, 1);
+    task->node = node;
+    task->model = g_strdup (model);
+    task->path = g_strdup (path);
+    task->version = version;
+    task->description = desc;
+    task->models = models;
+    tasks = g_list_prepend (tasks, task);
+  }
+
+  g_list_free (nodes);
+
+  if (tasks)
+    ret = _mlops_swap_push (tasks);
+
+  g_free (path);
+  return ret;
+}
+
+/**
+ * @brief Switch the running pipelines of the service to the changed description, if the reload policy of the service is set.
+ * @details Only the nodes of the service and the composite services including it are switched.
+ *          The models and sources of the changed description are read in the caller, and the description is expanded in the worker.
+ */
+int
+mlops_node_description_update (const gchar * name)
+{
+  g_autofree gchar *policy = NULL;
+  GHashTable *composites = NULL;
+  GList *nodes = NULL, *tasks = NULL, *l;
+  GHashTableIter iter;
+  gpointer key, value;
+  guint i;
+  gint ret;
+
+  g_return_val_if_fail (STR_IS_VALID (name), -EINVAL);
+
+  for (i = 0; i < MLOPS_NODE_SHARDS; i++) {
+    mlops_node_shard_s *shard = &g_mlops_node_shards[i];
+
+    g_rw_lock_reader_lock (&shard->lock);
+    if (shard->table) {
+      g_hash_table_iter_init (&iter, shard->table);
+      while (g_hash_table_iter_next (&iter, NULL, &value)) {
+        mlops_node_s *node = (mlops_node_s *) value;
+
+        if (!node->service_name)
+          continue;
+
+        if (node->type == MLOPS_NODE_TYPE_PIPELINE && g_str_equal (node->service_name, name)) {
+          nodes = g_list_prepend (nodes, _mlops_node_ref (node));
+        } else if (node->type == MLOPS_NODE_TYPE_COMPOSITE &&
+            mlops_node_composite_has_pipeline (node->service_name, name)) {
+          if (!composites)
+            composites = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+          g_hash_table_add (composites, g_strdup (node->service_name));
+          nodes = g_list_prepend (nodes, _mlops_node_ref (node));
+        }
+      }
+    }
+    g_rw_lock_reader_unlock (&shard->lock);
+  }
+
+  /* Most of the changed descriptions are not running, do not access the database. */
+  if (!nodes)
+    return 0;
+
+  /* The running pipelines keep the previous description unless the service opts in. */
+  if (svcdb_pipeline_get_attribute (name, MLOPS_RELOAD_ATTR, &policy) != 0 ||
+      g_strcmp0 (policy, "seamless") != 0) {
+    ret = 0;
+    goto done;
+  }
+
+  /* Read the models and sources in the caller, the workers expand the kept descriptions and do not access the database. */
+  ret = mlops_node_template_resolve (name);
+  if (ret == 0 && composites) {
+    g_hash_table_iter_init (&iter, composites);
+    while (ret == 0 && g_hash_table_iter_next (&iter, &key, NULL))
+      ret = mlops_node_composite_resolve ((const gchar *) key);
+  }
+
+  if (ret != 0) {
+    ml_logw ("Failed to get the changed description of '%s', the pipelines keep the previous one.", name);
+    goto done;
+  }
+
+  for (l = nodes; l != NULL; l = l->next) {
+    mlops_swap_task_s *task = g_new0 (mlops_swap_task_s, 1);
+
+    task->node = (mlops_node_s *) l->data;
+    tasks = g_list_prepend (tasks, task);
+  }
+
+  g_list_free (nodes);
+  nodes = NULL;
+
+  ret = _mlops_swap_push (tasks);
+
+done:
+  g_list_free_full (nodes, _mlops_node_unref);
+  if (composites)
+    g_hash_table_destroy (composites);
+
+  return ret;
+}
+
+/**
+ * @brief Initialize mlops node info.
+ */
+int
+mlops_node_initialize (void)
+{
+  guint i;
+
+  G_LOCK (mlops_node_registry);
+  /* The id is unique in the process, even if the registry is initialized again. */
+  if (g_mlops_node_id_base == 0)
+    g_mlops_node_id_base = g_get_monotonic_time ();
+
+  for (i = 0; i < MLOPS_NODE_SHARDS; i++) {
+    mlops_node_shard_s *shard = &g_mlops_node_shards[i];
+
+    g_rw_lock_writer_lock (&shard->lock);
+    if (!shard->table) {
+      shard->table = g_hash_table_new_full (g_int64_hash, g_int64_equal,
+          NULL, _mlops_node_unref);
+    }
+    g_rw_lock_writer_unlock (&shard->lock);
+  }
+  G_UNLOCK (mlops_node_registry);
+
+  return 0;
+}
+
+/**
+ * @brief Finalize mlops node info.
+ */
+void
+mlops_node_finalize (void)
+{
+  GThreadPool *workers;
+  guint i;
+
+  G_LOCK (mlops_pool);
+  workers = g_mlops_pool_workers;
+  g_mlops_pool_workers = NULL;
+  G_UNLOCK (mlops_pool);
+
+  /* Skip the queued tasks and wait for the pipelines being built. */
+  if (workers) {
+    g_atomic_int_set (&g_mlops_pool_closing, 1);
+    g_thread_pool_free (workers, FALSE, TRUE);
+    g_atomic_int_set (&g_mlops_pool_closing, 0);
+  }
+
+  G_LOCK (mlops_launch);
+  workers = g_mlops_launch_workers;
+  g_mlops_launch_workers = NULL;
+  G_UNLOCK (mlops_launch);
+
+  if (workers) {
+    g_atomic_int_set (&g_mlops_launch_closing, 1);
+    g_thread_pool_free (workers, FALSE, TRUE);
+    g_atomic_int_set (&g_mlops_launch_closing, 0);
+  }
+
+  G_LOCK (mlops_batch);
+  workers = g_mlops_batch_workers;
+  g_mlops_batch_workers = NULL;
+  G_UNLOCK (mlops_batch);
+
+  /* The batch is not running, the caller of the batch waits for all operations. */
+  if (workers)
+    g_thread_pool_free (workers, FALSE, TRUE);
+
+  /* The pipelines are not restarted or checked after finalizing. */
+  _mlops_restart_cancel_all ();
+
+  G_LOCK (mlops_swap);
+  workers = g_mlops_swap_workers;
+  g_mlops_swap_workers = NULL;
+  G_UNLOCK (mlops_swap);
+
+  if (workers) {
+    g_atomic_int_set (&g_mlops_swap_closing, 1);
+    g_thread_pool_free (workers, FALSE, TRUE);
+    g_atomic_int_set (&g_mlops_swap_closing, 0);
+  }
+
+  mlops_node_profile_finalize ();
+  mlops_node_template_finalize ();
+  mlops_node_composite_finalize ();
+
+  /* Drop the queued launch requests, the budget is not used after finalizing. */
+  mlops_node_admission_finalize ();
+
+  G_LOCK (mlops_pool);
+  if (g_mlops_pool_table) {
+    g_hash_table_destroy (g_mlops_pool_table);
+    g_mlops_pool_table = NULL;
+  }
+  G_UNLOCK (mlops_pool);
+
+  G_LOCK (mlops_node_registry);
+  for (i = 0; i < MLOPS_NODE_SHARDS; i++) {
+    mlops_node_shard_s *shard = &g_mlops_node_shards[i];
+    GHashTable *table;
+
+    g_rw_lock_writer_lock (&shard->lock);
+    table = shard->table;
+    shard->table = NULL;
+    g_rw_lock_writer_unlock (&shard->lock);
+
+    /* Release the nodes out of the lock, this changes the state of the pipelines. */
+    if (table)
+      g_hash_table_destroy (table);
+  }
+  G_UNLOCK (mlops_node_registry);
+
+  /* Stop the shared sources after the pipelines receiving the data are released. */
+  mlops_node_source_finalize ();
+}
+
+/**
+ * @brief Internal function to get the description, the scheduling attributes and the configuration of the service, and take the prerolled pipeline from the pool.
+ * @details The pipeline is NULL if the pool is empty. This requests to refill the pool.
+ *          The pool is not used if @a params is given, the pipelines in the pool are built with the default values.
+ *          @a models is the versions of the activated models referred by the description.
+ */
+static int
+_mlops_node_prepare (const gchar * name, const mlops_node_type_e type,
+    GHashTable * params, gchar ** desc, GHashTable ** models,
+    mlops_node_sched_s ** sched, mlops_node_config_s * config, GstElement ** pipeline)
+{
+  g_autofree gchar *stored = NULL;
+  GList *removed;
+  mlops_pool_s *pool;
+  guint pool_size;
+  gint result;
+
+  /* The bus name is released and the process exits, the client launches the pipeline in the new instance. */
+  if (ml_agent_is_exiting ()) {
+    ml_logw ("mlops-agent is exiting on idle, reject the request to launch '%s'.", name);
+    return -EAGAIN;
+  }
+
+  switch (type) {
+    case MLOPS_NODE_TYPE_PIPELINE:
+    {
+      result = svcdb_pipeline_get (name, &stored);
+      if (result == 0)
+        result = mlops_node_template_expand (name, stored, params, desc, models);
+
+      if (result != 0) {
+        ml_loge ("Failed to launch pipeline of '%s'.", name);
+        return result;
+      }
+
+      *sched = mlops_node_sched_new (name);
+      mlops_node_config_load (name, config);
+      break;
+    }
+    case MLOPS_NODE_TYPE_COMPOSITE:
+    {
+      result = mlops_node_composite_expand (name, params, desc, models);
+      if (result != 0) {
+        ml_loge ("Failed to launch composite service of '%s'.", name);
+        return result;
+      }
+
+      /* The composite service is not pooled, the pool is kept with the name of the pipeline. */
+      *sched = mlops_node_sched_new (name);
+      mlops_node_config_load (name, config);
+      return 0;
+    }
+    default:
+      return -EINVAL;
+  }
+
+  if (params && g_hash_table_size (params) > 0)
+    return 0;
+
+  /* Take the prerolled pipeline from the pool, and request to refill it. */
+  pool_size = _mlops_pool_get_size (name);
+
+  G_LOCK (mlops_pool);
+  removed = _mlops_pool_update_locked (name, *desc, *sched, config, pool_size);
+  pool = g_mlops_pool_table ?
+      (mlops_pool_s *) g_hash_table_lookup (g_mlops_pool_table, name) : NULL;
+  if (pool && pool->size > 0) {
+    *pipeline = (GstElement *) g_queue_pop_head (&pool->ready);
+    if (*pipeline)
+      pool->hits++;
+    else
+      pool->misses++;
+
+    _mlops_pool_refill_locked (name, pool);
+  }
+  G_UNLOCK (mlops_pool);
+
+  /* The pipeline in the pool may be built with the old configuration. */
+  if (*pipeline)
+    mlops_node_config_attach (*pipeline, config);
+
+  _mlops_pool_release_pipelines (removed);
+  return 0;
+}
+
+/**
+ * @brief Internal function to add node info into hash table. The pipeline is NULL if the node is being launched.
+ * @details If @a admitted is TRUE, the cost is released when the node is released.
+ * @return The id of the node.
+ */
+static gint64
+_mlops_node_add (const gchar * name, const mlops_node_type_e type,
+    const gchar * desc, GHashTable * models, GHashTable * params, const gchar * app,
+    const mlops_node_cost_s * cost, const gint priority, const gboolean admitted,
+    const mlops_restart_policy_s * restart, GstElement * pipeline)
+{
+  mlops_node_shard_s *shard;
+  mlops_node_s *node;
+  gint64 id;
+
+  /* The id is allocated without the lock, and does not collide under the parallel launches. */
+  id = g_mlops_node_id_base + (guint) g_atomic_int_add (&g_mlops_node_id_seq, 1) + 1;
+
+  node = g_new0 (mlops_node_s, 1);
+  node->type = type;
+  node->id = id;
+  node->refcount = 1;
+  node->service_name = g_strdup (name);
+  node->description = g_strdup (desc);
+  node->models = models ? g_hash_table_ref (models) : NULL;
+  node->params = (params && g_hash_table_size (params) > 0) ? g_hash_table_ref (params) : NULL;
+  node->app = g_strdup (app);
+  node->cost = *cost;
+  node->priority = priority;
+  node->admitted = admitted;
+  node->restart = *restart;
+  node->state = GST_STATE_VOID_PENDING;
+  node->pending = GST_STATE_VOID_PENDING;
+  g_mutex_init (&node->lock);
+  g_cond_init (&node->released);
+
+  if (pipeline)
+    _mlops_node_attach_pipeline (node, pipeline);
+
+  /* Do not exit on idle while the pipeline exists. */
+  ml_agent_idle_inhibit ();
+
+  shard = _mlops_node_get_shard (id);
+  g_rw_lock_writer_lock (&shard->lock);
+  if (shard->table)
+    g_hash_table_insert (shard->table, &node->id, node);
+  else
+    ml_logw ("The node registry is not initialized, internal error?");
+  g_rw_lock_writer_unlock (&shard->lock);
+
+  _mlops_stall_start (node);
+  return id;
+}
+
+/**
+ * @brief Check service name and launch the pipeline.
+ */
+int
+mlops_node_create (const gchar * name, const mlops_node_type_e type,
+    int64_t * id)
+{
+  return mlops_node_create_with_params (name, type, NULL, NULL, id);
+}
+
+/**
+ * @brief Check service name and launch the pipeline, the placeholders in the description are replaced with the parameters.
+ */
+int
+mlops_node_create_with_params (const gchar * name,
+    const mlops_node_type_e type, const gchar * app, GHashTable * params, int64_t * id)
+{
+  gint result;
+  gchar *desc = NULL;
+  GHashTable *models = NULL;
+  mlops_node_sched_s *sched = NULL;
+  mlops_node_config_s config;
+  GstElement *pipeline = NULL;
+  mlops_node_cost_s cost;
+  mlops_restart_policy_s restart;
+  gint priority;
+
+  g_return_val_if_fail (id != NULL, -EINVAL);
+
+  result = _mlops_node_prepare (name, type, params, &desc, &models, &sched, &config, &pipeline);
+  if (result != 0)
+    goto error;
+
+  /* The caller cannot wait in the queue, reject the request over the budget or the quota of the application. */
+  mlops_node_admission_get_cost (name, &cost, &priority);
+  result = mlops_node_admission_acquire (app, &cost, priority, NULL, NULL, NULL);
+  if (result != 0)
+    goto error;
+
+  if (!pipeline) {
+    result = _mlops_node_build_pipeline (desc, sched, &config, &pipeline);
+    if (result != 0) {
+      mlops_node_admission_release (app, &cost);
+      goto error;
+    }
+  }
+
+  /* Final step, add node info into hash table. */
+  _mlops_restart_get_policy (name, &restart);
+  *id = _mlops_node_add (name, type, desc, models, params, app, &cost, priority, TRUE, &restart, pipeline);
+  pipeline = NULL;
+
+error:
+  /* The pipeline is taken from the pool if the request is rejected. */
+  if (pipeline)
+    _mlops_pool_put_back (name, desc, pipeline);
+
+  g_free (desc);
+  if (models)
+    g_hash_table_unref (models);
+  mlops_node_sched_free (sched);
+  return result;
+}
+
+/**
+ * @brief Internal function to release the task to launch the pipeline.
+ */
+static void
+_mlops_launch_task_free (gpointer data)
+{
+  mlops_launch_task_s *task = (mlops_launch_task_s *) data;
+
+  if (task->pipeline)
+    _mlops_pool_release_pipelines (g_list_append (NULL, task->pipeline));
+
+  g_free (task->description);
+  mlops_node_sched_free (task->sched);
+  g_free (task->app);
+  g_free (task);
+}
+
+/**
+ * @brief Internal function to notify the result of the launch in the main context.
+ */
+static gboolean
+_mlops_launch_notify (gpointer data)
+{
+  mlops_launch_task_s *task = (mlops_launch_task_s *) data;
+
+  task->cb (task->id, task->result, task->user_data);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Internal function to set the pipeline of the node being launched.
+ * @return 0 on success, -ECANCELED if the node is destroyed while launching.
+ */
+static int
+_mlops_launch_publish (mlops_launch_task_s * task)
+{
+  mlops_node_shard_s *shard = _mlops_node_get_shard (task->id);
+  mlops_node_s *node;
+
+  /* Hold the reader lock while setting the pipeline, so the node is not destroyed in the middle. */
+  g_rw_lock_reader_lock (&shard->lock);
+  node = shard->table ?
+      (mlops_node_s *) g_hash_table_lookup (shard->table, &task->id) : NULL;
+  if (node && task->result == 0) {
+    g_mutex_lock (&node->lock);
+    _mlops_node_attach_pipeline (node, task->pipeline);
+    task->pipeline = NULL;
+    g_mutex_unlock (&node->lock);
+  }
+  g_rw_lock_reader_unlock (&shard->lock);
+
+  if (!node)
+    return -ECANCELED;
+
+  /* Release the node, the caller is notified with the error. */
+  if (task->result != 0)
+    _mlops_node_unref (_mlops_node_steal (task->id));
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to set the pipeline of the node and notify the result of the launch.
+ */
+static void
+_mlops_launch_finish (mlops_launch_task_s * task)
+{
+  if (_mlops_launch_publish (task) != 0) {
+    ml_logw ("The pipeline with ID %" G_GINT64_FORMAT " is destroyed while launching.", task->id);
+    task->result = -ECANCELED;
+  }
+
+  g_idle_add_full (G_PRIORITY_DEFAULT, _mlops_launch_notify, task, _mlops_launch_task_free);
+}
+
+/**
+ * @brief Worker to build the pipeline of the node and wait for preroll. This does not access the database.
+ */
+static void
+_mlops_launch_worker (gpointer data, gpointer user_data)
+{
+  mlops_launch_task_s *task = (mlops_launch_task_s *) data;
+  GstStateChangeReturn ret;
+
+  /* Skip the queued tasks when finalizing. */
+  if (g_atomic_int_get (&g_mlops_launch_closing)) {
+    _mlops_launch_task_free (task);
+    return;
+  }
+
+  task->result = _mlops_node_build_pipeline (task->description, task->sched, &task->config, &task->pipeline);
+
+  if (task->result == 0 && task->wait_preroll) {
+    ret = gst_element_get_state (task->pipeline, NULL, NULL, MLOPS_NODE_PREROLL_TIMEOUT);
+
+    if (ret == GST_STATE_CHANGE_FAILURE) {
+      ml_loge ("Failed to preroll the pipeline with ID %" G_GINT64_FORMAT, task->id);
+      task->result = -ESTRPIPE;
+    } else if (ret == GST_STATE_CHANGE_ASYNC) {
+      /* The pipeline may wait for the data from the application, e.g., appsrc. */
+      ml_logw ("The pipeline with ID %" G_GINT64_FORMAT " is not prerolled in time.", task->id);
+    }
+  }
+
+  _mlops_launch_finish (task);
+}
+
+/**
+ * @brief Internal function to start launching the pipeline when the queued request is admitted or rejected.
+ */
+static void
+_mlops_launch_admitted (const int result, void *user_data)
+{
+  mlops_launch_task_s *task = (mlops_launch_task_s *) user_data;
+  mlops_node_shard_s *shard = _mlops_node_get_shard (task->id);
+  mlops_node_s *node = NULL;
+
+  task->result = result;
+
+  if (result == 0) {
+    /* Hand over the budget to the node, release it if the node is destroyed while queued. */
+    g_rw_lock_reader_lock (&shard->lock);
+    node = shard->table ?
+        (mlops_node_s *) g_hash_table_lookup (shard->table, &task->id) : NULL;
+    if (node) {
+      g_mutex_lock (&node->lock);
+      node->admitted = TRUE;
+      g_mutex_unlock (&node->lock);
+    }
+    g_rw_lock_reader_unlock (&shard->lock);
+
+    if (!node) {
+      mlops_node_admission_release (task->app, &task->cost);
+      task->result = -ECANCELED;
+    }
+  }
+
+  if (task->result == 0 && !task->pipeline) {
+    G_LOCK (mlops_launch);
+    if (g_mlops_launch_workers) {
+      g_thread_pool_push (g_mlops_launch_workers, task, NULL);
+      G_UNLOCK (mlops_launch);
+      return;
+    }
+    G_UNLOCK (mlops_launch);
+
+    task->result = -ECANCELED;
+  }
+
+  _mlops_launch_finish (task);
+}
+
+/**
+ * @brief Check service name and launch the pipeline in the worker.
+ */
+int
+mlops_node_create_async (const gchar * name, const mlops_node_type_e type,
+    const gchar * app, GHashTable * params, const gboolean wait_preroll,
+    mlops_node_launch_cb cb, void *user_data, int64_t * id)
+{
+  mlops_launch_task_s *task;
+  gint result;
+  gchar *desc = NULL;
+  GHashTable *models = NULL;
+  mlops_node_sched_s *sched = NULL;
+  mlops_node_config_s config;
+  GstElement *pipeline = NULL;
+  mlops_node_cost_s cost;
+  mlops_restart_policy_s restart;
+  gint priority;
+  gint64 nid;
+
+  g_return_val_if_fail (cb != NULL, -EINVAL);
+  g_return_val_if_fail (id != NULL, -EINVAL);
+
+  result = _mlops_node_prepare (name, type, params, &desc, &models, &sched, &config, &pipeline);
+  if (result != 0)
+    goto error;
+
+  G_LOCK (mlops_launch);
+  if (!pipeline && !g_mlops_launch_workers) {
+    g_mlops_launch_workers = g_thread_pool_new (_mlops_launch_worker, NULL,
+        MLOPS_LAUNCH_MAX_THREADS, FALSE, NULL);
+    if (!g_mlops_launch_workers) {
+      G_UNLOCK (mlops_launch);
+      ml_loge ("Failed to create the thread pool to launch the pipelines.");
+      result = -EIO;
+      goto error;
+    }
+  }
+  G_UNLOCK (mlops_launch);
+
+  mlops_node_admission_get_cost (name, &cost, &priority);
+  _mlops_restart_get_policy (name, &restart);
+
+  /* The node without the pipeline is added, the pipeline is set when the request is admitted and the pipeline is ready. */
+  task = g_new0 (mlops_launch_task_s, 1);
+  task->id = _mlops_node_add (name, type, desc, models, params, app, &cost, priority, FALSE, &restart, NULL);
+  task->description = desc;
+  task->sched = sched;
+  task->config = config;
+  task->app = g_strdup (app);
+  task->cost = cost;
+  task->pipeline = pipeline;
+  task->wait_preroll = wait_preroll;
+  task->cb = cb;
+  task->user_data = user_data;
+  desc = NULL;
+  sched = NULL;
+  nid = task->id;
+
+  result = mlops_node_admission_acquire (app, &cost, priority,
+      _mlops_launch_admitted, task, _mlops_launch_task_free);
+  if (result == 0) {
+    /* The pipeline in the pool is already prerolled, the worker builds the pipeline otherwise. */
+    _mlops_launch_admitted (0, task);
+  } else if (result == -EINPROGRESS) {
+    ml_logi ("The launch request of '%s' is queued, the launched pipelines exceed the budget.", name);
+    result = 0;
+  } else {
+    _mlops_node_unref (_mlops_node_steal (nid));
+    if (task->pipeline) {
+      _mlops_pool_put_back (name, task->description, task->pipeline);
+      task->pipeline = NULL;
+    }
+    _mlops_launch_task_free (task);
+    goto error;
+  }
+
+  *id = nid;
+
+error:
+  g_free (desc);
+  if (models)
+    g_hash_table_unref (models);
+  mlops_node_sched_free (sched);
+  return result;
+}
+
+/**
+ * @brief Update the pool of the prerolled pipelines with the description and pool size in the database.
+ */
+int
+mlops_node_pool_update (const gchar * name)
+{
+  g_autofree gchar *stored = NULL;
+  g_autofree gchar *desc = NULL;
+  mlops_node_sched_s *sched = NULL;
+  mlops_node_config_s config;
+  GList *removed;
+  mlops_pool_s *pool;
+  guint pool_size = 0;
+
+  g_return_val_if_fail (name != NULL, -EINVAL);
+
+  /* Drop the pool if the pipeline is deleted, or the template cannot be built with the default values. */
+  if (svcdb_pipeline_get (name, &stored) == 0) {
+    pool_size = _mlops_pool_get_size (name);
+    if (pool_size > 0 && mlops_node_template_expand (name, stored, NULL, &desc, NULL) != 0)
+      pool_size = 0;
+
+    sched = mlops_node_sched_new (name);
+  }
+
+  mlops_node_config_load (name, &config);
+
+  G_LOCK (mlops_pool);
+  removed = _mlops_pool_update_locked (name, desc, sched, &config, pool_size);
+  pool = g_mlops_pool_table ?
+      (mlops_pool_s *) g_hash_table_lookup (g_mlops_pool_table, name) : NULL;
+  if (pool)
+    _mlops_pool_refill_locked (name, pool);
+  G_UNLOCK (mlops_pool);
+
+  _mlops_pool_release_pipelines (removed);
+  mlops_node_sched_free (sched);
+  return 0;
+}
+
+/**
+ * @brief Drop the prerolled pipelines in the pool of the service.
+ */
+void
+mlops_node_pool_flush (const gchar * name)
+{
+  GList *removed = NULL;
+  mlops_pool_s *pool;
+
+  g_return_if_fail (name != NULL);
+
+  G_LOCK (mlops_pool);
+  pool = g_mlops_pool_table ?
+      (mlops_pool_s *) g_hash_table_lookup (g_mlops_pool_table, name) : NULL;
+  if (pool) {
+    removed = pool->ready.head;
+    g_queue_init (&pool->ready);
+
+    /* The pipelines being built are dropped when the worker is done. */
+    g_free (pool->description);
+    pool->description = NULL;
+  }
+  G_UNLOCK (mlops_pool);
+
+  _mlops_pool_release_pipelines (removed);
+}
+
+/**
+ * @brief Get the statistics of the pools in JSON string.
+ */
+int
+mlops_node_pool_get_stats (gchar ** stats)
+{
+  JsonBuilder *builder;
+  JsonNode *root;
+  GHashTableIter iter;
+  gpointer key, value;
+
+  g_return_val_if_fail (stats != NULL, -EINVAL);
+
+  builder = json_builder_new ();
+  json_builder_begin_object (builder);
+
+  G_LOCK (mlops_pool);
+  if (g_mlops_pool_table) {
+    g_hash_table_iter_init (&iter, g_mlops_pool_table);
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+      mlops_pool_s *pool = (mlops_pool_s *) value;
+      guint64 total = pool->hits + pool->misses;
+
+      json_builder_set_member_name (builder, (const gchar *) key);
+      json_builder_begin_object (builder);
+      json_builder_set_member_name (builder, "size");
+      json_builder_add_int_value (builder, pool->size);
+      json_builder_set_member_name (builder, "ready");
+      json_builder_add_int_value (builder, g_queue_get_length (&pool->ready));
+      json_builder_set_member_name (builder, "building");
+      json_builder_add_int_value (builder, pool->building);
+      json_builder_set_member_name (builder, "hits");
+      json_builder_add_int_value (builder, (gint64) pool->hits);
+      json_builder_set_member_name (builder, "misses");
+      json_builder_add_int_value (builder, (gint64) pool->misses);
+      json_builder_set_member_name (builder, "hit_rate");
+      json_builder_add_double_value (builder,
+          (total > 0) ? ((gdouble) pool->hits / (gdouble) total) : 0.0);
+      json_builder_end_object (builder);
+    }
+  }
+  G_UNLOCK (mlops_pool);
+
+  json_builder_end_object (builder);
+
+  root = json_builder_get_root (builder);
+  *stats = json_to_string (root, FALSE);
+
+  json_node_unref (root);
+  g_object_unref (builder);
+  return 0;
+}
+
+/**
+ * @brief Start the pipeline with given id.
+ */
+int
+mlops_node_start (const int64_t id)
+{
+  mlops_node_s *node = NULL;
+  int ret;
+
+  node = _mlops_node_get (id);
+  g_return_val_if_fail (node != NULL, -EINVAL);
+
+  ret = _mlops_node_set_pipeline_state (node, GST_STATE_PLAYING);
+  _mlops_node_unref (node);
+
+  return ret;
+}
 
 /**
- * @brief Structure for mlops node.
+ * @brief Stop the pipeline with given id.
  */
-typedef struct
+int
+mlops_node_stop (const int64_t id)
 {
-  mlops_node_type_e type;
-  gint64 id;
-  GMutex lock;
-  GstElement *element;
-  gchar *service_name;
-  gchar *description;
-} mlops_node_s;
+  mlops_node_s *node = NULL;
+  int ret;
+
+  node = _mlops_node_get (id);
+  g_return_val_if_fail (node != NULL, -EINVAL);
+
+  ret = _mlops_node_set_pipeline_state (node, GST_STATE_PAUSED);
+  _mlops_node_unref (node);
+
+  return ret;
+}
 
 /**
- * @brief Internal function to get node info.
+ * @brief Destroy the pipeline with given id.
  */
-static mlops_node_s *
-_mlops_node_get (const int64_t id)
+int
+mlops_node_destroy (const int64_t id)
 {
   mlops_node_s *node = NULL;
 
-  G_LOCK (mlops_node_table);
-  node = (mlops_node_s *) g_hash_table_lookup (g_mlops_node_table, &id);
-  G_UNLOCK (mlops_node_table);
-
+  node = _mlops_node_steal (id);
   if (!node) {
     ml_loge ("There is no pipeline matched with ID %" G_GINT64_FORMAT, id);
+    return -EINVAL;
   }
 
-  return node;
+  /* The pipeline is released when the other threads using the node are done. */
+  _mlops_node_unref (node);
+  return 0;
 }
 
 /**
- * @brief Internal function to change pipeline state.
+ * @brief Internal function to release the batch.
  */
-static int
-_mlops_node_set_pipeline_state (mlops_node_s * node, GstState state)
+static void
+_mlops_batch_free (mlops_batch_s * batch)
 {
-  GstStateChangeReturn ret;
-  gint64 nid;
+  g_cond_clear (&batch->cond);
+  g_mutex_clear (&batch->lock);
+  g_strfreev (batch->names);
+  g_free (batch->app);
+  g_free (batch->items);
+  g_free (batch->ids);
+  g_free (batch->results);
+  g_free (batch);
+}
 
-  g_return_val_if_fail (node != NULL, -EINVAL);
+/**
+ * @brief Internal function to create the batch with given number of the operations.
+ */
+static mlops_batch_s *
+_mlops_batch_new (const guint count, mlops_node_batch_cb cb, void *user_data)
+{
+  mlops_batch_s *batch;
+  guint i;
 
-  g_mutex_lock (&node->lock);
-  nid = node->id;
-  ret = gst_element_set_state (node->element, state);
-  g_mutex_unlock (&node->lock);
+  batch = g_new0 (mlops_batch_s, 1);
+  g_mutex_init (&batch->lock);
+  g_cond_init (&batch->cond);
+  batch->count = count;
+  batch->items = g_new0 (mlops_batch_item_s, count);
+  batch->ids = g_new (int64_t, count);
+  batch->results = g_new0 (int, count);
+  batch->cb = cb;
+  batch->user_data = user_data;
 
-  if (ret == GST_STATE_CHANGE_FAILURE) {
-    ml_loge ("Failed to set the state of the pipeline to %s with ID %"
-        G_GINT64_FORMAT, gst_element_state_get_name (state), nid);
-    return -ESTRPIPE;
+  for (i = 0; i < count; i++) {
+    batch->items[i].batch = batch;
+    batch->ids[i] = -1;
   }
 
-  return 0;
+  return batch;
 }
 
 /**
- * @brief Internal function to release mlops node.
+ * @brief Internal function to add the launched pipelines or release the destroyed nodes, and get the result of the batch.
+ * @details This is called in the caller or the main context, the node may update the attributes of the service.
+ * @return 0 if all operations are done, otherwise the error of the first failed node.
  */
-static void
-_mlops_node_free (gpointer data)
+static int
+_mlops_batch_finish (mlops_batch_s * batch)
 {
-  mlops_node_s *node = (mlops_node_s *) data;
+  mlops_node_s *node;
+  gint ret = 0;
+  guint i;
 
-  if (!node) {
-    ml_logw ("The data pointer is null, internal error?");
-    return;
-  }
+  for (i = 0; i < batch->count; i++) {
+    mlops_batch_item_s *item = &batch->items[i];
+
+    if (batch->build) {
+      if (item->result == 0) {
+        batch->ids[i] = _mlops_node_add (batch->names[i], MLOPS_NODE_TYPE_PIPELINE,
+            item->description, item->models, NULL, batch->app, &item->cost, item->priority,
+            TRUE, &item->restart, item->pipeline);
+        item->pipeline = NULL;
+      } else {
+        batch->ids[i] = -1;
+        if (item->admitted)
+          mlops_node_admission_release (batch->app, &item->cost);
+      }
 
-  _mlops_node_set_pipeline_state (node, GST_STATE_NULL);
+      /* The pipeline taken from the pool is kept for the next launch if the request is rejected. */
+      if (item->pipeline) {
+        if (item->admitted)
+          _mlops_pool_release_pipelines (g_list_append (NULL, item->pipeline));
+        else
+          _mlops_pool_put_back (batch->names[i], item->description, item->pipeline);
+      }
 
-  g_mutex_lock (&node->lock);
+      g_free (item->description);
+      if (item->models)
+        g_hash_table_unref (item->models);
+      mlops_node_sched_free (item->sched);
+    } else if (item->node) {
+      if (batch->op == MLOPS_NODE_BATCH_DESTROY && item->result == 0) {
+        node = _mlops_node_steal (batch->ids[i]);
+        if (node)
+          _mlops_node_unref (node);
+        else
+          item->result = -EINVAL;
+      }
 
-  node->type = MLOPS_NODE_TYPE_NONE;
-  node->id = 0;
-  if (node->element) {
-    gst_object_unref (node->element);
-    node->element = NULL;
+      _mlops_node_unref (item->node);
+    }
+
+    batch->results[i] = item->result;
+    if (ret == 0 && item->result != 0)
+      ret = item->result;
   }
-  g_free (node->service_name);
-  node->service_name = NULL;
-  g_free (node->description);
-  node->description = NULL;
 
-  g_mutex_unlock (&node->lock);
+  /* The launched pipelines inhibit the idle state now. */
+  if (batch->build)
+    ml_agent_idle_uninhibit ();
 
-  g_mutex_clear (&node->lock);
-  g_free (node);
+  return ret;
 }
 
 /**
- * @brief Initialize mlops node info.
+ * @brief Internal function to finish the asynchronous batch and call the callback in the main context.
  */
-int
-mlops_node_initialize (void)
+static gboolean
+_mlops_batch_notify (gpointer data)
 {
-  int ret = 0;
+  mlops_batch_s *batch = (mlops_batch_s *) data;
+  gint ret;
 
-  G_LOCK (mlops_node_table);
-  if (!g_mlops_node_table) {
-    g_mlops_node_table = g_hash_table_new_full (g_int64_hash, g_int64_equal,
-        g_free, _mlops_node_free);
-  }
+  ret = _mlops_batch_finish (batch);
+  batch->cb (batch->ids, batch->results, batch->count, ret, batch->user_data);
+  _mlops_batch_free (batch);
+
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Worker to do the operation on a node in the batch.
+ */
+static void
+_mlops_batch_worker (gpointer data, gpointer user_data)
+{
+  mlops_batch_item_s *item = (mlops_batch_item_s *) data;
+  mlops_batch_s *batch = item->batch;
+  gboolean launched, done;
 
-  if (g_mlops_node_table == NULL) {
-    ml_logw ("Failed to initialize mlops-agent node table.");
-    ret = -EIO;
+  if (item->result == 0) {
+    if (batch->build) {
+      if (!item->pipeline)
+        item->result = _mlops_node_build_pipeline (item->description, item->sched, &item->config, &item->pipeline);
+    } else {
+      switch (batch->op) {
+        case MLOPS_NODE_BATCH_START:
+          item->result = _mlops_node_set_pipeline_state (item->node, GST_STATE_PLAYING);
+          break;
+        case MLOPS_NODE_BATCH_STOP:
+          item->result = _mlops_node_set_pipeline_state (item->node, GST_STATE_PAUSED);
+          break;
+        case MLOPS_NODE_BATCH_DESTROY:
+          /* Stop the pipeline here, the node is released in the caller. */
+          g_mutex_lock (&item->node->lock);
+          launched = (item->node->element != NULL);
+          g_mutex_unlock (&item->node->lock);
+
+          if (launched)
+            _mlops_node_set_pipeline_state (item->node, GST_STATE_NULL);
+          break;
+        default:
+          item->result = -EINVAL;
+          break;
+      }
+    }
   }
-  G_UNLOCK (mlops_node_table);
 
-  return ret;
+  g_mutex_lock (&batch->lock);
+  done = (--batch->remaining == 0);
+  if (done && !batch->cb)
+    g_cond_signal (&batch->cond);
+  g_mutex_unlock (&batch->lock);
+
+  /* Do not access the batch after this, it is released in the main context. */
+  if (done && batch->cb)
+    g_idle_add (_mlops_batch_notify, batch);
 }
 
 /**
- * @brief Finalize mlops node info.
+ * @brief Internal function to do the operations in parallel.
+ * @details If the batch has the callback, this returns immediately and the callback is called in the main context when all operations are done.
+ *          Otherwise this waits until all operations are done.
  */
-void
-mlops_node_finalize (void)
+static void
+_mlops_batch_run (mlops_batch_s * batch)
 {
-  G_LOCK (mlops_node_table);
-  g_assert (g_mlops_node_table != NULL);
-  g_hash_table_destroy (g_mlops_node_table);
-  g_mlops_node_table = NULL;
-  G_UNLOCK (mlops_node_table);
+  GThreadPool *workers;
+  guint i;
+
+  batch->remaining = batch->count;
+
+  G_LOCK (mlops_batch);
+  if (!g_mlops_batch_workers) {
+    g_mlops_batch_workers = g_thread_pool_new (_mlops_batch_worker, NULL,
+        MLOPS_BATCH_MAX_THREADS, FALSE, NULL);
+  }
+  workers = g_mlops_batch_workers;
+
+  for (i = 0; i < batch->count; i++) {
+    /* Do the operation in the caller if the thread pool is not available. */
+    if (!workers || !g_thread_pool_push (workers, &batch->items[i], NULL))
+      _mlops_batch_worker (&batch->items[i], NULL);
+  }
+  G_UNLOCK (mlops_batch);
+
+  if (batch->cb)
+    return;
+
+  g_mutex_lock (&batch->lock);
+  while (batch->remaining > 0)
+    g_cond_wait (&batch->cond, &batch->lock);
+  g_mutex_unlock (&batch->lock);
 }
 
 /**
- * @brief Check service name and launch the pipeline.
+ * @brief Internal function to create the batch to launch the pipelines. This accesses the database.
+ * @details The database is read and the budget is checked in the caller, the workers only build the pipelines.
  */
-int
-mlops_node_create (const gchar * name, const mlops_node_type_e type,
-    int64_t * id)
+static mlops_batch_s *
+_mlops_batch_new_create (const gchar * const *names, const guint count,
+    const gchar * app, mlops_node_batch_cb cb, void *user_data)
 {
-  mlops_node_s *node = NULL;
-  gint result = -EIO;
-  gint64 *node_id = NULL;
-  gchar *desc = NULL;
-  GstElement *pipeline = NULL;
-  GError *err = NULL;
-  GstStateChangeReturn ret;
+  mlops_batch_s *batch;
+  guint i;
 
-  g_return_val_if_fail (id != NULL, -EINVAL);
+  batch = _mlops_batch_new (count, cb, user_data);
+  batch->build = TRUE;
+  batch->names = g_new0 (gchar *, count + 1);
+  batch->app = g_strdup (app);
 
-  switch (type) {
-    case MLOPS_NODE_TYPE_PIPELINE:
-    {
-      result = svcdb_pipeline_get (name, &desc);
-      if (result != 0) {
-        ml_loge ("Failed to launch pipeline of '%s'.", name);
-        goto error;
-      }
-      break;
+  /* Do not exit on idle while the pipelines are built in the workers, the nodes are added when the batch is done. */
+  ml_agent_idle_inhibit ();
+
+  for (i = 0; i < count; i++) {
+    mlops_batch_item_s *item = &batch->items[i];
+
+    batch->names[i] = g_strdup (names[i]);
+
+    if (!STR_IS_VALID (names[i])) {
+      item->result = -EINVAL;
+      continue;
     }
-    default:
-      return -EINVAL;
-  }
 
-  pipeline = gst_parse_launch (desc, &err);
-  if (!pipeline || err) {
-    ml_loge ("Failed to launch pipeline '%s' (error msg: %s).",
-        desc, (err) ? err->message : "unknown reason");
-    g_clear_error (&err);
+    item->result = _mlops_node_prepare (names[i], MLOPS_NODE_TYPE_PIPELINE, NULL,
+        &item->description, &item->models, &item->sched, &item->config, &item->pipeline);
+    if (item->result != 0)
+      continue;
 
-    result = -ESTRPIPE;
-    goto error;
+    mlops_node_admission_get_cost (names[i], &item->cost, &item->priority);
+    _mlops_restart_get_policy (names[i], &item->restart);
+
+    /* The caller cannot wait in the queue, reject the request over the budget or the quota of the application. */
+    item->result = mlops_node_admission_acquire (app, &item->cost, item->priority, NULL, NULL, NULL);
+    item->admitted = (item->result == 0);
   }
 
-  /* Set pipeline as paused state. */
-  ret = gst_element_set_state (pipeline, GST_STATE_PAUSED);
-  if (ret == GST_STATE_CHANGE_FAILURE) {
-    ml_loge
-        ("Failed to set the state of the pipeline to PAUSED. For the detail, please check the GStreamer log message.");
+  return batch;
+}
 
-    result = -ESTRPIPE;
-    goto error;
+/**
+ * @brief Internal function to create the batch to start, stop or destroy the pipelines.
+ */
+static mlops_batch_s *
+_mlops_batch_new_op (const mlops_node_batch_op_e op, const int64_t * ids,
+    const guint count, mlops_node_batch_cb cb, void *user_data)
+{
+  mlops_batch_s *batch;
+  guint i;
+
+  batch = _mlops_batch_new (count, cb, user_data);
+  batch->op = op;
+
+  for (i = 0; i < count; i++) {
+    batch->ids[i] = ids[i];
+    batch->items[i].node = _mlops_node_get (ids[i]);
+    if (!batch->items[i].node)
+      batch->items[i].result = -EINVAL;
   }
 
-  /* Final step, add node info into hash table. */
-  node = g_new0 (mlops_node_s, 1);
-  node->type = type;
-  node->id = g_get_monotonic_time ();
-  node->element = pipeline;
-  node->service_name = g_strdup (name);
-  node->description = g_strdup (desc);
-  g_mutex_init (&node->lock);
+  return batch;
+}
 
-  node_id = g_new (gint64, 1);
-  *node_id = node->id;
+/**
+ * @brief Internal function to run the batch in the caller, and copy the ids and the results.
+ */
+static int
+_mlops_batch_run_sync (mlops_batch_s * batch, int64_t * ids, int *results)
+{
+  gint ret;
 
-  G_LOCK (mlops_node_table);
-  g_hash_table_insert (g_mlops_node_table, node_id, node);
-  G_UNLOCK (mlops_node_table);
+  _mlops_batch_run (batch);
+  ret = _mlops_batch_finish (batch);
 
-  *id = node->id;
+  if (ids)
+    memcpy (ids, batch->ids, sizeof (int64_t) * batch->count);
+  memcpy (results, batch->results, sizeof (int) * batch->count);
 
-error:
-  if (result != 0) {
-    if (pipeline)
-      gst_object_unref (pipeline);
-  }
+  _mlops_batch_free (batch);
+  return ret;
+}
 
-  g_free (desc);
-  return result;
+/**
+ * @brief Check service names and launch the pipelines in parallel.
+ */
+int
+mlops_node_create_batch (const gchar * const *names, const guint count,
+    const gchar * app, int64_t * ids, int *results)
+{
+  g_return_val_if_fail (names != NULL, -EINVAL);
+  g_return_val_if_fail (count > 0, -EINVAL);
+  g_return_val_if_fail (ids != NULL, -EINVAL);
+  g_return_val_if_fail (results != NULL, -EINVAL);
+
+  return _mlops_batch_run_sync (_mlops_batch_new_create (names, count, app, NULL, NULL),
+      ids, results);
 }
 
 /**
- * @brief Start the pipeline with given id.
+ * @brief Check service names and launch the pipelines in parallel, the callback is called in the main context when all pipelines are launched.
  */
 int
-mlops_node_start (const int64_t id)
+mlops_node_create_batch_async (const gchar * const *names, const guint count,
+    const gchar * app, mlops_node_batch_cb cb, void *user_data)
 {
-  mlops_node_s *node = NULL;
+  g_return_val_if_fail (names != NULL, -EINVAL);
+  g_return_val_if_fail (count > 0, -EINVAL);
+  g_return_val_if_fail (cb != NULL, -EINVAL);
 
-  node = _mlops_node_get (id);
-  return _mlops_node_set_pipeline_state (node, GST_STATE_PLAYING);
+  _mlops_batch_run (_mlops_batch_new_create (names, count, app, cb, user_data));
+  return 0;
 }
 
 /**
- * @brief Stop the pipeline with given id.
+ * @brief Start, stop or destroy the pipelines with given ids in parallel.
  */
 int
-mlops_node_stop (const int64_t id)
+mlops_node_batch (const mlops_node_batch_op_e op, const int64_t * ids,
+    const guint count, int *results)
 {
-  mlops_node_s *node = NULL;
+  g_return_val_if_fail (ids != NULL, -EINVAL);
+  g_return_val_if_fail (count > 0, -EINVAL);
+  g_return_val_if_fail (results != NULL, -EINVAL);
 
-  node = _mlops_node_get (id);
-  return _mlops_node_set_pipeline_state (node, GST_STATE_PAUSED);
+  return _mlops_batch_run_sync (_mlops_batch_new_op (op, ids, count, NULL, NULL),
+      NULL, results);
 }
 
 /**
- * @brief Destroy the pipeline with given id.
+ * @brief Start, stop or destroy the pipelines with given ids in parallel, the callback is called in the main context when all operations are done.
  */
 int
-mlops_node_destroy (const int64_t id)
+mlops_node_batch_async (const mlops_node_batch_op_e op, const int64_t * ids,
+    const guint count, mlops_node_batch_cb cb, void *user_data)
+{
+  g_return_val_if_fail (ids != NULL, -EINVAL);
+  g_return_val_if_fail (count > 0, -EINVAL);
+  g_return_val_if_fail (cb != NULL, -EINVAL);
+
+  _mlops_batch_run (_mlops_batch_new_op (op, ids, count, cb, user_data));
+  return 0;
+}
+
+/**
+ * @brief Get the state of pipeline with given id.
+ */
+int
+mlops_node_get_state (const int64_t id, GstState * state)
 {
   mlops_node_s *node = NULL;
+  gboolean error;
+
+  g_return_val_if_fail (state != NULL, -EINVAL);
 
   node = _mlops_node_get (id);
-  if (node) {
-    G_LOCK (mlops_node_table);
-    g_hash_table_remove (g_mlops_node_table, &id);
-    G_UNLOCK (mlops_node_table);
+  g_return_val_if_fail (node != NULL, -EINVAL);
+
+  /* Read the state record, this does not wait for the pipeline. */
+  *state = (GstState) g_atomic_int_get (&node->state);
+  error = (g_atomic_int_get (&node->error) != 0);
+  _mlops_node_unref (node);
+
+  if (error) {
+    ml_loge ("Failed to get the state of the pipeline with ID %"
+        G_GINT64_FORMAT ", the pipeline posted an error.", id);
+    return -ESTRPIPE;
   }
 
-  return node ? 0 : -EINVAL;
+  return 0;
 }
 
 /**
- * @brief Get the state of pipeline with given id.
+ * @brief Get the runtime statistics of the pipeline with given id in JSON string.
  */
 int
-mlops_node_get_state (const int64_t id, GstState * state)
+mlops_node_get_statistics (const int64_t id, gchar ** stats)
 {
   mlops_node_s *node = NULL;
-  GstStateChangeReturn ret;
+  JsonBuilder *builder;
+  JsonNode *root;
+
+  g_return_val_if_fail (stats != NULL, -EINVAL);
 
   node = _mlops_node_get (id);
   g_return_val_if_fail (node != NULL, -EINVAL);
 
+  builder = json_builder_new ();
+  json_builder_begin_object (builder);
+
+  json_builder_set_member_name (builder, "id");
+  json_builder_add_int_value (builder, node->id);
+  json_builder_set_member_name (builder, "service_name");
+  json_builder_add_string_value (builder, node->service_name);
+  json_builder_set_member_name (builder, "type");
+  json_builder_add_string_value (builder,
+      (node->type == MLOPS_NODE_TYPE_COMPOSITE) ? "composite" : "pipeline");
+  json_builder_set_member_name (builder, "state");
+  json_builder_add_string_value (builder,
+      gst_element_state_get_name ((GstState) g_atomic_int_get (&node->state)));
+
+  /* The statistics is created when the pipeline is launched. */
   g_mutex_lock (&node->lock);
-  ret = gst_element_get_state (node->element, state, NULL, GST_MSECOND);
+  json_builder_set_member_name (builder, "reclaim");
+  json_builder_begin_object (builder);
+  json_builder_set_member_name (builder, "released");
+  json_builder_add_boolean_value (builder, node->reclaimed);
+  json_builder_set_member_name (builder, "count");
+  json_builder_add_int_value (builder, node->reclaim_count);
+  json_builder_set_member_name (builder, "rebuilds");
+  json_builder_add_int_value (builder, node->rebuild_count);
+  json_builder_set_member_name (builder, "memory_kb");
+  json_builder_add_int_value (builder, (gint64) node->reclaimed_kb);
+  json_builder_end_object (builder);
+
+  json_builder_set_member_name (builder, "swap");
+  json_builder_begin_object (builder);
+  json_builder_set_member_name (builder, "count");
+  json_builder_add_int_value (builder, node->swap_count);
+  json_builder_set_member_name (builder, "gap_us");
+  json_builder_add_int_value (builder, node->swap_gap);
+  json_builder_set_member_name (builder, "method");
+  json_builder_add_string_value (builder, node->swap_method ? node->swap_method : "none");
+  json_builder_end_object (builder);
+
+  /* The versions of the activated models used by the pipeline. */
+  if (node->models) {
+    GHashTableIter iter;
+    gpointer key, value;
+
+    json_builder_set_member_name (builder, "models");
+    json_builder_begin_object (builder);
+    g_hash_table_iter_init (&iter, node->models);
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+      json_builder_set_member_name (builder, (const gchar *) key);
+      json_builder_add_int_value (builder, ((mlops_node_model_s *) value)->version);
+    }
+    json_builder_end_object (builder);
+  }
+
+  if (node->stats)
+    mlops_node_stats_build (node->stats, builder);
   g_mutex_unlock (&node->lock);
 
-  if (ret == GST_STATE_CHANGE_FAILURE) {
-    ml_loge ("Failed to get the state of the pipeline with ID %"
-        G_GINT64_FORMAT, id);
-    return -ESTRPIPE;
+  json_builder_end_object (builder);
+  _mlops_node_unref (node);
+
+  root = json_builder_get_root (builder);
+  *stats = json_to_string (root, FALSE);
+
+  json_node_unref (root);
+  g_object_unref (builder);
+  return 0;
+}
+
+/**
+ * @brief Get the restart policy, the number of restarts and the last error of the pipeline with given id in JSON string.
+ */
+int
+mlops_node_get_restart_info (const int64_t id, gchar ** info)
+{
+  mlops_node_s *node = NULL;
+  JsonBuilder *builder;
+  JsonNode *root;
+
+  g_return_val_if_fail (info != NULL, -EINVAL);
+
+  node = _mlops_node_get (id);
+  g_return_val_if_fail (node != NULL, -EINVAL);
+
+  builder = json_builder_new ();
+  json_builder_begin_object (builder);
+
+  json_builder_set_member_name (builder, "id");
+  json_builder_add_int_value (builder, node->id);
+
+  G_LOCK (mlops_restart);
+  json_builder_set_member_name (builder, "policy");
+  json_builder_begin_object (builder);
+  json_builder_set_member_name (builder, "max_retries");
+  json_builder_add_int_value (builder, node->restart.max_retries);
+  json_builder_set_member_name (builder, "backoff_ms");
+  json_builder_add_int_value (builder, node->restart.backoff_ms);
+  json_builder_set_member_name (builder, "backoff_max_ms");
+  json_builder_add_int_value (builder, node->restart.backoff_max_ms);
+  json_builder_set_member_name (builder, "strategy");
+  json_builder_add_string_value (builder, node->restart.rebuild ? "rebuild" : "repreroll");
+  json_builder_end_object (builder);
+
+  json_builder_set_member_name (builder, "count");
+  json_builder_add_int_value (builder, node->restart_count);
+  json_builder_set_member_name (builder, "attempts");
+  json_builder_add_int_value (builder, node->restart_attempts);
+  json_builder_set_member_name (builder, "pending");
+  json_builder_add_boolean_value (builder,
+      (node->restart_deadline > 0 || node->restart_running));
+  json_builder_set_member_name (builder, "recovery_us");
+  json_builder_add_int_value (builder, node->restart_time);
+
+  json_builder_set_member_name (builder, "stall");
+  json_builder_begin_object (builder);
+  json_builder_set_member_name (builder, "threshold_ms");
+  json_builder_add_int_value (builder, node->restart.stall_ms);
+  json_builder_set_member_name (builder, "restart");
+  json_builder_add_boolean_value (builder, node->restart.stall_restart);
+  json_builder_set_member_name (builder, "stalled");
+  json_builder_add_boolean_value (builder, node->stalled);
+  json_builder_set_member_name (builder, "count");
+  json_builder_add_int_value (builder, node->stall_count);
+  json_builder_end_object (builder);
+
+  json_builder_set_member_name (builder, "last_error");
+  if (node->error_time > 0) {
+    json_builder_begin_object (builder);
+    json_builder_set_member_name (builder, "source");
+    json_builder_add_string_value (builder, node->error_source ? node->error_source : "unknown");
+    json_builder_set_member_name (builder, "message");
+    json_builder_add_string_value (builder, node->error_message ? node->error_message : "unknown reason");
+    json_builder_set_member_name (builder, "timestamp_ms");
+    json_builder_add_int_value (builder, node->error_time / 1000);
+    json_builder_end_object (builder);
+  } else {
+    json_builder_add_null_value (builder);
   }
+  G_UNLOCK (mlops_restart);
+
+  json_builder_end_object (builder);
+  _mlops_node_unref (node);
+
+  root = json_builder_get_root (builder);
+  *info = json_to_string (root, FALSE);
 
+  json_node_unref (root);
+  g_object_unref (builder);
   return 0;
 }
+
+/**
+ * @brief Set the callback to be called in the main context when the state of the pipeline is changed.
+ */
+void
+mlops_node_set_state_cb (mlops_node_state_cb cb, void *user_data)
+{
+  G_LOCK (mlops_state_cb);
+  g_mlops_state_cb = cb;
+  g_mlops_state_cb_data = user_data;
+  G_UNLOCK (mlops_state_cb);
+}
+
+/**
+ * @brief Set the callback to be called in the main context when the pipeline is stalled.
+ */
+void
+mlops_node_set_stall_cb (mlops_node_stall_cb cb, void *user_data)
+{
+  G_LOCK (mlops_stall_cb);
+  g_mlops_stall_cb = cb;
+  g_mlops_stall_cb_data = user_data;
+  G_UNLOCK (mlops_stall_cb);
+}
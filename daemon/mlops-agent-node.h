@@ -29,9 +29,42 @@ typedef enum
 {
   MLOPS_NODE_TYPE_NONE = 0,
   MLOPS_NODE_TYPE_PIPELINE,
+  MLOPS_NODE_TYPE_COMPOSITE,
   MLOPS_NODE_TYPE_MAX
 } mlops_node_type_e;
 
+/**
+ * @brief Enumeration for the operation on the nodes in the batch.
+ */
+typedef enum
+{
+  MLOPS_NODE_BATCH_START = 0,
+  MLOPS_NODE_BATCH_STOP,
+  MLOPS_NODE_BATCH_DESTROY
+} mlops_node_batch_op_e;
+
+/**
+ * @brief Callback to notify the result of the pipeline launched asynchronously. This is called in the main context.
+ */
+typedef void (*mlops_node_launch_cb) (const int64_t id, const int result, void *user_data);
+
+/**
+ * @brief Callback to notify the result of the batch. This is called in the main context.
+ * @details @a ids and @a results have @a count elements, these are released after the callback returns.
+ *          @a result is 0 if all operations are done, otherwise the error of the first failed node.
+ */
+typedef void (*mlops_node_batch_cb) (const int64_t *ids, const int *results, const guint count, const int result, void *user_data);
+
+/**
+ * @brief Callback to notify the state change of the pipeline. This is called in the main context.
+ */
+typedef void (*mlops_node_state_cb) (const int64_t id, const GstState state, void *user_data);
+
+/**
+ * @brief Callback to notify the pipeline is stalled, no buffer entered the sinks for @a idle_ms. This is called in the main context.
+ */
+typedef void (*mlops_node_stall_cb) (const int64_t id, const int64_t idle_ms, void *user_data);
+
 /**
  * @brief Initialize mlops node info.
  */
@@ -44,11 +77,65 @@ void mlops_node_finalize (void);
 
 /**
  * @brief Check service name and launch the pipeline.
+ * @details Returns -EBUSY if the launched pipelines exceed the budget of the admission control.
  */
 int mlops_node_create (const gchar *name, const mlops_node_type_e type, int64_t *id);
 
+/**
+ * @brief Check service name and launch the pipeline, the placeholders in the description are replaced with @a params.
+ * @details @a params is the hash table of the parameters (string to string), NULL to use the default values.
+ *          The pipeline is not taken from the pool if the parameters are given.
+ *          @a app is the application requesting the launch for the per-app quota, NULL if unknown.
+ *          Returns -EINVAL if the parameter without the default value is not given.
+ */
+int mlops_node_create_with_params (const gchar *name, const mlops_node_type_e type, const gchar *app, GHashTable *params, int64_t *id);
+
+/**
+ * @brief Check service name and launch the pipeline in the worker.
+ * @details The id is given immediately, and the state of the node is GST_STATE_VOID_PENDING until the pipeline is ready.
+ *          If @a wait_preroll is TRUE, the worker waits for the pipeline to be prerolled before calling @a cb.
+ *          The node is released if launching the pipeline is failed.
+ *          If the launched pipelines exceed the budget, the request is queued with the priority of the service,
+ *          and @a cb is called with -EBUSY if it is not admitted in the queue timeout. @a app is the application
+ *          requesting the launch for the per-app quota, NULL if unknown.
+ *          @a params replaces the placeholders in the description, same as mlops_node_create_with_params().
+ */
+int mlops_node_create_async (const gchar *name, const mlops_node_type_e type, const gchar *app, GHashTable *params, const gboolean wait_preroll, mlops_node_launch_cb cb, void *user_data, int64_t *id);
+
+/**
+ * @brief Check service names and launch the pipelines in parallel.
+ * @details The pipelines are built in the workers, and this returns when all pipelines are launched.
+ *          @a ids and @a results should have @a count elements, the id is -1 if the launch is failed.
+ *          @a app is the application requesting the launch for the per-app quota, NULL if unknown.
+ * @return 0 if all pipelines are launched, otherwise the error of the first failed pipeline.
+ */
+int mlops_node_create_batch (const gchar *const *names, const guint count, const gchar *app, int64_t *ids, int *results);
+
+/**
+ * @brief Check service names and launch the pipelines in parallel without blocking the caller.
+ * @details The database is read and the budget is checked in the caller, then the pipelines are built in the workers.
+ *          @a cb is called in the main context with the ids and the results when all pipelines are launched.
+ *          @a app is the application requesting the launch for the per-app quota, NULL if unknown.
+ */
+int mlops_node_create_batch_async (const gchar *const *names, const guint count, const gchar *app, mlops_node_batch_cb cb, void *user_data);
+
+/**
+ * @brief Start, stop or destroy the pipelines with given ids in parallel.
+ * @details The state of the pipelines is changed in the workers, and this returns when all operations are done.
+ *          @a results should have @a count elements.
+ * @return 0 if all operations are done, otherwise the error of the first failed node.
+ */
+int mlops_node_batch (const mlops_node_batch_op_e op, const int64_t *ids, const guint count, int *results);
+
+/**
+ * @brief Start, stop or destroy the pipelines with given ids in parallel without blocking the caller.
+ * @details @a cb is called in the main context with the results when all operations are done.
+ */
+int mlops_node_batch_async (const mlops_node_batch_op_e op, const int64_t *ids, const guint count, mlops_node_batch_cb cb, void *user_data);
+
 /**
  * @brief Start the pipeline with given id.
+ * @details If the idle pipeline is released, it is built again with the description when the node is launched.
  */
 int mlops_node_start (const int64_t id);
 
@@ -62,10 +149,95 @@ int mlops_node_stop (const int64_t id);
  */
 int mlops_node_destroy (const int64_t id);
 
-/*
+/**
  * @brief Get the state of pipeline with given id.
+ * @details This reads the state record updated by the bus messages of the pipeline, and does not block.
+ *          Returns -ESTRPIPE if the pipeline posted an error since the last state change request.
  */
 int mlops_node_get_state (const int64_t id, GstState *state);
 
+/**
+ * @brief Get the runtime statistics of the pipeline with given id in JSON string.
+ * @details The statistics has the time spent in each state, the throughput, and the statistics of each element
+ *          (buffers and bytes, processing latency, QoS and the level of the queue).
+ */
+int mlops_node_get_statistics (const int64_t id, gchar **stats);
+
+/**
+ * @brief Get the restart policy, the number of restarts and the last error of the pipeline with given id in JSON string.
+ * @details The pipeline which posted an error is restarted with the exponential backoff, if the restart policy of the service is set.
+ *          The policy is read from the pipeline attributes 'restart_max_retries', 'restart_backoff_ms', 'restart_backoff_max_ms' and 'restart_strategy'
+ *          when the pipeline is launched. The strategy is "repreroll" (default) to preroll the pipeline again, or "rebuild" to build the new pipeline.
+ *          'stall' has the stall threshold, whether the pipeline is stalled now and the number of times the pipeline is stalled.
+ */
+int mlops_node_get_restart_info (const int64_t id, gchar **info);
+
+/**
+ * @brief Set the callback to be called in the main context when the state of the pipeline is changed.
+ * @details Set NULL to remove the callback.
+ */
+void mlops_node_set_state_cb (mlops_node_state_cb cb, void *user_data);
+
+/**
+ * @brief Set the callback to be called in the main context when the pipeline is stalled.
+ * @details The stall is detected if the pipeline attribute 'stall_threshold_ms' is set, and notified once until the buffer enters the sinks again.
+ *          The pipelines are checked every second, and the pipeline after the end-of-stream is not stalled.
+ *          If 'stall_restart' is "true", the stalled pipeline is restarted with the restart policy of the service, 3 times if 'restart_max_retries' is not set.
+ *          Set NULL to remove the callback.
+ */
+void mlops_node_set_stall_cb (mlops_node_stall_cb cb, void *user_data);
+
+/**
+ * @brief Update the pool of the prerolled pipelines with the description and pool size in the database.
+ * @details The pool size is the pipeline attribute 'pool_size'. The pipelines are built in the background.
+ */
+int mlops_node_pool_update (const gchar *name);
+
+/**
+ * @brief Drop the prerolled pipelines in the pool of the service.
+ */
+void mlops_node_pool_flush (const gchar *name);
+
+/**
+ * @brief Get the statistics of the pools in JSON string.
+ */
+int mlops_node_pool_get_stats (gchar **stats);
+
+/**
+ * @brief Set the time (in seconds) to release the pipeline which is not played.
+ * @details The released pipeline is set to NULL state and freed, but the node keeps its id and configuration.
+ *          The pipeline is built again when the node is started. Set 0 to keep the idle pipelines.
+ */
+void mlops_node_set_reclaim_timeout (const guint seconds);
+
+/**
+ * @brief Release the pipelines which are not played for the reclaim timeout.
+ * @details This is called periodically in the main context if the reclaim timeout is set.
+ *          The idle pipelines are detached from the nodes here, and stopped and freed in the worker.
+ * @return The number of the pipelines to release.
+ */
+guint mlops_node_reclaim_idle (void);
+
+/**
+ * @brief Switch the running pipelines referring the model to the activated version. This should be called when the model is activated.
+ * @details This accesses the database to get the activated model, and the pipelines are switched in the worker.
+ *          The filter loading the model is reloaded in place if it is updatable and does not share the model, otherwise the new pipeline is built and prerolled
+ *          while the old one is running, and replaces the old one. The node keeps its id and state.
+ *          The time the stream is interrupted is recorded in the statistics of the node.
+ * @return 0 on success, a negative error value if failed to get the activated model.
+ */
+int mlops_node_model_update (const gchar *model);
+
+/**
+ * @brief Switch the running pipelines of the service to the changed description, if the reload policy of the service is set.
+ * @details The policy is the pipeline attribute 'reload', the pipelines are switched only if it is "seamless".
+ *          Only the running nodes of the service and the composite services including it are switched, and the database is not accessed if there is none.
+ *          The changed description should be kept with mlops_node_template_set(). This reads the models and sources it refers in the caller,
+ *          and the description is expanded with the parameters of each node and switched in the worker.
+ *          The new pipeline is built and prerolled while the old one is running, and replaces the old one. The node keeps its id and state.
+ * @return 0 on success, a negative error value if failed to get the description.
+ */
+int mlops_node_description_update (const gchar *name);
+
 G_END_DECLS
 #endif /* _MLOPS_AGENT_NODE_H_ */
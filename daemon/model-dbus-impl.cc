@@ -17,6 +17,9 @@
 #include "dbus-interface.h"
 #include "gdbus-util.h"
 #include "log.h"
+#include "mlops-agent-internal.h"
+#include "mlops-agent-node.h"
+#include "mlops-agent-node-template.h"
 #include "model-dbus.h"
 #include "modules.h"
 #include "service-db-util.h"
@@ -60,7 +63,13 @@ gdbus_cb_model_register (MachinelearningServiceModel *obj,
   gint ret = 0;
   guint version = 0U;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
   ret = svcdb_model_add (name, path, is_active, description, app_info, &version);
+  if (ret == 0 && is_active)
+    mlops_node_model_update (name);
+
   machinelearning_service_model_complete_register (obj, invoc, version, ret);
 
   return TRUE;
@@ -83,6 +92,9 @@ gdbus_cb_model_update_description (MachinelearningServiceModel *obj,
 {
   gint ret = 0;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
   ret = svcdb_model_update_description (name, version, description);
   machinelearning_service_model_complete_update_description (obj, invoc, ret);
 
@@ -104,7 +116,13 @@ gdbus_cb_model_activate (MachinelearningServiceModel *obj,
 {
   gint ret = 0;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
   ret = svcdb_model_activate (name, version);
+  if (ret == 0)
+    mlops_node_model_update (name);
+
   machinelearning_service_model_complete_activate (obj, invoc, ret);
 
   return TRUE;
@@ -125,6 +143,9 @@ gdbus_cb_model_get (MachinelearningServiceModel *obj,
   gint ret = 0;
   g_autofree gchar *model_info = NULL;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
   ret = svcdb_model_get (name, version, &model_info);
   machinelearning_service_model_complete_get (obj, invoc, model_info, ret);
 
@@ -146,6 +167,9 @@ gdbus_cb_model_get_activated (MachinelearningServiceModel *obj,
   gint ret = 0;
   g_autofree gchar *model_info = NULL;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
   ret = svcdb_model_get_activated (name, &model_info);
   machinelearning_service_model_complete_get_activated (obj, invoc, model_info, ret);
 
@@ -167,6 +191,9 @@ gdbus_cb_model_get_all (MachinelearningServiceModel *obj,
   gint ret = 0;
   g_autofree gchar *model_info = NULL;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
   ret = svcdb_model_get_all (name, &model_info);
   machinelearning_service_model_complete_get_all (obj, invoc, model_info, ret);
 
@@ -189,7 +216,13 @@ gdbus_cb_model_delete (MachinelearningServiceModel *obj,
 {
   gint ret = 0;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
   ret = svcdb_model_delete (name, version, force);
+  if (ret == 0)
+    mlops_node_template_model_changed (name);
+
   machinelearning_service_model_complete_delete (obj, invoc, ret);
 
   return TRUE;
@@ -285,15 +318,6 @@ out:
   return ret;
 }
 
-/**
- * @brief The callback function for initializing Model Interface module.
- */
-static void
-init_model_module (void *data)
-{
-  gdbus_initialize ();
-}
-
 /**
  * @brief The callback function for exiting Model Interface module.
  */
@@ -307,8 +331,9 @@ exit_model_module (void *data)
 static const struct module_ops model_ops = {
   .name = "model-interface",
   .probe = probe_model_module,
-  .init = init_model_module,
   .exit = exit_model_module,
+  .path = DBUS_MODEL_PATH,
+  .get_info = machinelearning_service_model_interface_info,
 };
 
 MODULE_OPS_REGISTER (&model_ops)
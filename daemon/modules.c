@@ -10,14 +10,46 @@
  * @bug     No known bugs except for NYI items
  */
 
+#include <errno.h>
 #include <glib.h>
 #include <stdio.h>
 
 #include "common.h"
+#include "gdbus-util.h"
 #include "modules.h"
 #include "log.h"
 
+/**
+ * @brief Internal structure for the state of the added module.
+ */
+typedef struct
+{
+  const struct module_ops *ops;
+  guint stub_id;        /**< Registration id of the stub, 0 if the module is not pending */
+  gboolean active;      /**< TRUE if the module is probed and initialized */
+  gint64 probe_time;    /**< Time (in microseconds) to probe and initialize the module */
+} module_entry_s;
+
 static GList *module_head = NULL;
+static void *module_data = NULL;
+
+/**
+ * @brief Find the entry of the module.
+ */
+static module_entry_s *
+_find_module (const struct module_ops *module)
+{
+  GList *elem;
+
+  for (elem = module_head; elem != NULL; elem = elem->next) {
+    module_entry_s *entry = (module_entry_s *) elem->data;
+
+    if (entry->ops == module)
+      return entry;
+  }
+
+  return NULL;
+}
 
 /**
  * @brief Add the specific DBus interface into the Machine Learning agent daemon.
@@ -25,7 +57,10 @@ static GList *module_head = NULL;
 void
 add_module (const struct module_ops *module)
 {
-  module_head = g_list_append (module_head, (gpointer) module);
+  module_entry_s *entry = g_new0 (module_entry_s, 1);
+
+  entry->ops = module;
+  module_head = g_list_append (module_head, entry);
 }
 
 /**
@@ -34,7 +69,102 @@ add_module (const struct module_ops *module)
 void
 remove_module (const struct module_ops *module)
 {
-  module_head = g_list_remove (module_head, (gconstpointer) module);
+  module_entry_s *entry = _find_module (module);
+
+  if (entry) {
+    module_head = g_list_remove (module_head, entry);
+    g_free (entry);
+  }
+}
+
+/**
+ * @brief Probe and initialize the module.
+ */
+static int
+_activate_module (module_entry_s *entry)
+{
+  const struct module_ops *module = entry->ops;
+  gint64 start = g_get_monotonic_time ();
+
+  if (module->probe && module->probe (module_data) != 0) {
+    ml_loge ("[%s] probe fail", module->name);
+    return -EIO;
+  }
+
+  if (module->init)
+    module->init (module_data);
+
+  entry->active = TRUE;
+  entry->probe_time = g_get_monotonic_time () - start;
+
+  ml_logi ("[%s] activated in %" G_GINT64_FORMAT ".%03d ms", module->name,
+      entry->probe_time / 1000, (int) (entry->probe_time % 1000));
+  return 0;
+}
+
+static void _module_stub_method_call (GDBusConnection *connection, const gchar *sender,
+    const gchar *object_path, const gchar *interface_name,
+    const gchar *method_name, GVariant *parameters,
+    GDBusMethodInvocation *invocation, gpointer user_data);
+
+static const GDBusInterfaceVTable module_stub_vtable = {
+  _module_stub_method_call, NULL, NULL, { 0 }
+};
+
+/**
+ * @brief Handle the first method call to the stub, and dispatch it to the module after activating it.
+ */
+static void
+_module_stub_method_call (GDBusConnection *connection, const gchar *sender,
+    const gchar *object_path, const gchar *interface_name,
+    const gchar *method_name, GVariant *parameters,
+    GDBusMethodInvocation *invocation, gpointer user_data)
+{
+  module_entry_s *entry = (module_entry_s *) user_data;
+  const struct module_ops *module = entry->ops;
+
+  /* The module exports its own interface at the same object path. */
+  gdbus_unregister_object (entry->stub_id);
+  entry->stub_id = 0;
+
+  if (_activate_module (entry) != 0) {
+    /* Register the stub again, the next method call retries the activation. */
+    if (gdbus_register_object (module->path, module->get_info (),
+            &module_stub_vtable, entry, &entry->stub_id) != 0)
+      ml_loge ("[%s] cannot register the stub again", module->name);
+
+    g_dbus_method_invocation_return_error (invocation, G_DBUS_ERROR,
+        G_DBUS_ERROR_FAILED, "Failed to activate the module '%s'.", module->name);
+    return;
+  }
+
+  if (!gdbus_dispatch_invocation (invocation)) {
+    g_dbus_method_invocation_return_error (invocation, G_DBUS_ERROR,
+        G_DBUS_ERROR_UNKNOWN_OBJECT, "The object '%s' is not exported.", object_path);
+  }
+}
+
+/**
+ * @brief Get the time to activate the module.
+ */
+gboolean
+get_module_probe_time (const char *name, gint64 *probe_time)
+{
+  GList *elem;
+
+  g_return_val_if_fail (name != NULL, FALSE);
+
+  for (elem = module_head; elem != NULL; elem = elem->next) {
+    module_entry_s *entry = (module_entry_s *) elem->data;
+
+    if (g_strcmp0 (entry->ops->name, name) == 0) {
+      if (entry->active && probe_time)
+        *probe_time = entry->probe_time;
+      return entry->active;
+    }
+  }
+
+  return FALSE;
 }
 
 /**
@@ -44,22 +174,33 @@ void
 init_modules (void *data)
 {
   GList *elem, *elem_n;
+  module_entry_s *entry;
   const struct module_ops *module;
 
+  module_data = data;
+
   elem = module_head;
   while (elem != NULL) {
-    module = elem->data;
+    entry = (module_entry_s *) elem->data;
+    module = entry->ops;
     elem_n = elem->next;
 
-    if (module->probe && module->probe (data) != 0) {
-      ml_loge ("[%s] probe fail", module->name);
-      module_head = g_list_remove (module_head, (gconstpointer) module);
-      elem = elem_n;
-      continue;
+    /* Register the stub and defer the activation until the first method call. */
+    if (module->path && module->get_info) {
+      if (gdbus_register_object (module->path, module->get_info (),
+              &module_stub_vtable, entry, &entry->stub_id) == 0) {
+        elem = elem_n;
+        continue;
+      }
+
+      ml_logw ("[%s] cannot register the stub, activate the module now", module->name);
+    }
+
+    if (_activate_module (entry) != 0) {
+      module_head = g_list_remove (module_head, entry);
+      g_free (entry);
     }
 
-    if (module->init)
-      module->init (data);
     elem = elem_n;
   }
 }
@@ -71,11 +212,18 @@ void
 exit_modules (void *data)
 {
   GList *elem;
-  const struct module_ops *module;
+  module_entry_s *entry;
 
   for (elem = module_head; elem != NULL; elem = elem->next) {
-    module = elem->data;
-    if (module->exit)
-      module->exit (data);
+    entry = (module_entry_s *) elem->data;
+
+    if (entry->stub_id > 0) {
+      gdbus_unregister_object (entry->stub_id);
+      entry->stub_id = 0;
+    }
+
+    if (entry->active && entry->ops->exit)
+      entry->ops->exit (data);
+    entry->active = FALSE;
   }
 }
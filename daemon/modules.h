@@ -18,6 +18,8 @@
 #ifndef __MODULES_H__
 #define __MODULES_H__
 
+#include <gio/gio.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -31,6 +33,8 @@ struct module_ops
   int (*probe) (void *data);    /**< Callback function for probing the DBus Interface */
   void (*init) (void *data);    /**< Callback function for initializing the DBus Interface */
   void (*exit) (void *data);    /**< Callback function for exiting the DBus Interface */
+  const char *path;     /**< Object path of the DBus Interface. If set with get_info, the module is activated on the first method call. */
+  GDBusInterfaceInfo *(*get_info) (void);       /**< Callback function for getting the introspection information of the DBus Interface */
 };
 
 /**
@@ -48,6 +52,8 @@ static void __DESTRUCTOR__ module_exit(void)	\
 
 /**
  * @brief Initialize all added modules by calling probe and init callback functions.
+ * @details The module with the object path registers the stub of its DBus interface,
+ *          and it is probed and initialized when the first method is called.
  * @param[in/out] data user data for passing the callback functions.
  */
 void init_modules (void *data);
@@ -58,6 +64,14 @@ void init_modules (void *data);
  */
 void exit_modules (void *data);
 
+/**
+ * @brief Get the time to activate the module.
+ * @param[in] name The name of the module.
+ * @param[out] probe_time The time (in microseconds) to probe and initialize the module.
+ * @return TRUE if the module is activated, FALSE if the module is not activated yet or not added.
+ */
+gboolean get_module_probe_time (const char *name, gint64 *probe_time);
+
 /**
  * @brief Add the specific DBus interface into the Machine Learning agent daemon.
  * @param[in] module DBus interface information.
@@ -24,13 +24,42 @@
 #include "dbus-interface.h"
 #include "gdbus-util.h"
 #include "log.h"
+#include "mlops-agent-internal.h"
 #include "mlops-agent-node.h"
+#include "mlops-agent-node-composite.h"
+#include "mlops-agent-node-profile.h"
+#include "mlops-agent-node-share.h"
+#include "mlops-agent-node-template.h"
 #include "modules.h"
 #include "pipeline-dbus.h"
 #include "service-db-util.h"
 
 static MachinelearningServicePipeline *g_gdbus_instance = NULL;
 
+/**
+ * @brief The number of requests which are dropped or failed because the caller has already given up.
+ */
+static guint64 g_deadline_misses = 0;
+G_LOCK_DEFINE_STATIC (deadline_misses);
+
+/**
+ * @brief Check the deadline of the request and count the deadline miss.
+ * @param deadline The monotonic time (in microseconds) when the caller gives up. 0 means there is no deadline.
+ * @return TRUE if the deadline is already expired.
+ */
+static gboolean
+_is_deadline_expired (gint64 deadline)
+{
+  if (deadline <= 0 || g_get_monotonic_time () < deadline)
+    return FALSE;
+
+  G_LOCK (deadline_misses);
+  g_deadline_misses++;
+  G_UNLOCK (deadline_misses);
+
+  return TRUE;
+}
+
 /**
  * @brief Get the skeleton object of the DBus interface.
  */
@@ -58,7 +87,17 @@ dbus_cb_core_set_pipeline (MachinelearningServicePipeline *obj, GDBusMethodInvoc
 {
   gint result = 0;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
+  /* Keep the parsed description once it is stored. */
   result = svcdb_pipeline_set (service_name, pipeline_desc);
+  if (result == 0) {
+    mlops_node_template_set (service_name, pipeline_desc);
+    mlops_node_pool_flush (service_name);
+    mlops_node_description_update (service_name);
+  }
+
   machinelearning_service_pipeline_complete_set_pipeline (obj, invoc, result);
 
   return TRUE;
@@ -74,6 +113,9 @@ dbus_cb_core_get_pipeline (MachinelearningServicePipeline *obj,
   gint result = 0;
   g_autofree gchar *desc = NULL;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
   result = svcdb_pipeline_get (service_name, &desc);
   machinelearning_service_pipeline_complete_get_pipeline (obj, invoc, result, desc);
 
@@ -89,28 +131,365 @@ dbus_cb_core_delete_pipeline (MachinelearningServicePipeline *obj,
 {
   gint result = 0;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
   result = svcdb_pipeline_delete (service_name);
+  if (result == 0) {
+    mlops_node_template_set (service_name, NULL);
+    mlops_node_pool_flush (service_name);
+  }
+
   machinelearning_service_pipeline_complete_delete_pipeline (obj, invoc, result);
 
   return TRUE;
 }
 
+/**
+ * @brief Function to complete the call to launch the pipeline.
+ */
+typedef void (*launch_complete_f) (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, gint result, gint64 id);
+
+/**
+ * @brief Structure for the request to launch the pipeline.
+ */
+typedef struct
+{
+  MachinelearningServicePipeline *obj;
+  GDBusMethodInvocation *invoc; /**< The invocation to be completed, NULL for the asynchronous launch. */
+  launch_complete_f complete;   /**< The function to complete the invocation. */
+  gchar *service_name;
+  gint64 deadline;
+} launch_request_s;
+
+/**
+ * @brief Create the request to launch the pipeline.
+ */
+static launch_request_s *
+_launch_request_new (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *service_name, gint64 deadline)
+{
+  launch_request_s *req = g_new0 (launch_request_s, 1);
+
+  req->obj = (MachinelearningServicePipeline *) g_object_ref (obj);
+  req->invoc = invoc;
+  req->complete = machinelearning_service_pipeline_complete_launch_pipeline;
+  req->service_name = g_strdup (service_name);
+  req->deadline = deadline;
+
+  return req;
+}
+
+/**
+ * @brief Release the request to launch the pipeline.
+ */
+static void
+_launch_request_free (launch_request_s *req)
+{
+  g_object_unref (req->obj);
+  g_free (req->service_name);
+  g_free (req);
+}
+
+/**
+ * @brief Complete the call to launch the pipeline when the pipeline is launched in the worker.
+ */
+static void
+_launch_pipeline_done (const int64_t id, const int result, void *user_data)
+{
+  launch_request_s *req = (launch_request_s *) user_data;
+  gint ret = result;
+  gint64 nid = (result == 0) ? id : -1;
+
+  /* Nobody receives the id of the launched pipeline, release it. */
+  if (ret == 0 && _is_deadline_expired (req->deadline)) {
+    ml_logw ("The caller has already given up, destroy the pipeline of '%s'.", req->service_name);
+    mlops_node_destroy (id);
+    nid = -1;
+    ret = -ETIMEDOUT;
+  }
+
+  req->complete (req->obj, req->invoc, ret, nid);
+  _launch_request_free (req);
+}
+
+/**
+ * @brief Emit the signal when the pipeline launched asynchronously is ready or failed.
+ */
+static void
+_launch_pipeline_async_done (const int64_t id, const int result, void *user_data)
+{
+  launch_request_s *req = (launch_request_s *) user_data;
+
+  if (result == 0) {
+    machinelearning_service_pipeline_emit_node_ready (req->obj, id, req->service_name);
+  } else {
+    ml_logw ("Failed to launch the pipeline of '%s' with ID %" G_GINT64_FORMAT,
+        req->service_name, (gint64) id);
+    machinelearning_service_pipeline_emit_node_failed (req->obj, id, req->service_name, result);
+  }
+
+  _launch_request_free (req);
+}
+
+/**
+ * @brief Internal function to launch the pipeline in the worker, the call is completed with @a complete when the pipeline is launched.
+ */
+static void
+_launch_pipeline (MachinelearningServicePipeline *obj, GDBusMethodInvocation *invoc,
+    const gchar *service_name, gint64 deadline, launch_complete_f complete)
+{
+  gint result = 0;
+  gint64 id = -1;
+  launch_request_s *req;
+
+  if (_is_deadline_expired (deadline)) {
+    ml_logw ("The caller has already given up, drop the request to launch '%s'.", service_name);
+    result = -ETIMEDOUT;
+    goto done;
+  }
+
+  req = _launch_request_new (obj, invoc, service_name, deadline);
+  req->complete = complete;
+  result = mlops_node_create_async (service_name, MLOPS_NODE_TYPE_PIPELINE,
+      g_dbus_method_invocation_get_sender (invoc), NULL, FALSE, _launch_pipeline_done, req, &id);
+  if (result == 0)
+    return;
+
+  _launch_request_free (req);
+  id = -1;
+
+done:
+  complete (obj, invoc, result, id);
+}
+
 /**
  * @brief Launch the pipeline with given description. Return the call result and its id.
+ * @details The pipeline is built in the worker, and the call is completed when the pipeline is launched.
  */
 static gboolean
 dbus_cb_core_launch_pipeline (MachinelearningServicePipeline *obj,
     GDBusMethodInvocation *invoc, const gchar *service_name, gpointer user_data)
+{
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_ALL))
+    return TRUE;
+
+  _launch_pipeline (obj, invoc, service_name, 0,
+      machinelearning_service_pipeline_complete_launch_pipeline);
+
+  return TRUE;
+}
+
+/**
+ * @brief Launch the pipeline with given description and the deadline of the caller. Return the call result and its id.
+ * @details The request is dropped if the caller has already given up, and the pipeline launched after the deadline is destroyed.
+ */
+static gboolean
+dbus_cb_core_launch_pipeline_with_deadline (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *service_name, gint64 deadline,
+    gpointer user_data)
+{
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_ALL))
+    return TRUE;
+
+  _launch_pipeline (obj, invoc, service_name, deadline,
+      machinelearning_service_pipeline_complete_launch_pipeline_with_deadline);
+
+  return TRUE;
+}
+
+/**
+ * @brief Launch the pipeline with given description asynchronously. Return the call result and its id.
+ * @details NodeReady or NodeFailed signal is emitted when the pipeline is prerolled in the worker.
+ */
+static gboolean
+dbus_cb_core_launch_pipeline_async (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *service_name, gint64 deadline,
+    gpointer user_data)
+{
+  gint result = 0;
+  gint64 id = -1;
+  launch_request_s *req;
+
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_ALL))
+    return TRUE;
+
+  if (_is_deadline_expired (deadline)) {
+    ml_logw ("The caller has already given up, drop the request to launch '%s'.", service_name);
+    result = -ETIMEDOUT;
+    goto done;
+  }
+
+  req = _launch_request_new (obj, NULL, service_name, deadline);
+  result = mlops_node_create_async (service_name, MLOPS_NODE_TYPE_PIPELINE,
+      g_dbus_method_invocation_get_sender (invoc), NULL, TRUE, _launch_pipeline_async_done, req, &id);
+  if (result != 0) {
+    _launch_request_free (req);
+    id = -1;
+  }
+
+done:
+  machinelearning_service_pipeline_complete_launch_pipeline_async (obj, invoc, result, id);
+
+  return TRUE;
+}
+
+/**
+ * @brief Launch the pipeline with given description and parameters. Return the call result and its id.
+ * @details The placeholders in the description are replaced with the parameters, and the call is completed when the pipeline is launched.
+ */
+static gboolean
+dbus_cb_core_launch_pipeline_with_params (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *service_name, GVariant *params,
+    gint64 deadline, gpointer user_data)
+{
+  gint result = 0;
+  gint64 id = -1;
+  launch_request_s *req;
+  GHashTable *table;
+  GVariantIter iter;
+  gchar *key, *value;
+
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_ALL))
+    return TRUE;
+
+  if (_is_deadline_expired (deadline)) {
+    ml_logw ("The caller has already given up, drop the request to launch '%s'.", service_name);
+    machinelearning_service_pipeline_complete_launch_pipeline_with_params (obj, invoc, -ETIMEDOUT, id);
+    return TRUE;
+  }
+
+  table = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+  g_variant_iter_init (&iter, params);
+  while (g_variant_iter_next (&iter, "{ss}", &key, &value))
+    g_hash_table_insert (table, key, value);
+
+  req = _launch_request_new (obj, invoc, service_name, deadline);
+  req->complete = machinelearning_service_pipeline_complete_launch_pipeline_with_params;
+  result = mlops_node_create_async (service_name, MLOPS_NODE_TYPE_PIPELINE,
+      g_dbus_method_invocation_get_sender (invoc), table, FALSE, _launch_pipeline_done, req, &id);
+  g_hash_table_unref (table);
+
+  if (result != 0) {
+    _launch_request_free (req);
+    machinelearning_service_pipeline_complete_launch_pipeline_with_params (obj, invoc, result, -1);
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Set the composite service with given definition. Return the call result.
+ */
+static gboolean
+dbus_cb_core_set_composite (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *composite_name,
+    const gchar *definition, gpointer user_data)
+{
+  gint result = 0;
+
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
+  /* Reject the definition with the unknown pipeline in the link or the cycle. */
+  result = mlops_node_composite_validate (definition);
+  if (result == 0)
+    result = svcdb_composite_set (composite_name, definition);
+
+  machinelearning_service_pipeline_complete_set_composite (obj, invoc, result);
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the definition of the given composite service. Return the call result and the definition.
+ */
+static gboolean
+dbus_cb_core_get_composite (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *composite_name, gpointer user_data)
+{
+  gint result = 0;
+  g_autofree gchar *definition = NULL;
+
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
+  result = svcdb_composite_get (composite_name, &definition);
+  machinelearning_service_pipeline_complete_get_composite (
+      obj, invoc, result, definition ? definition : "");
+
+  return TRUE;
+}
+
+/**
+ * @brief Delete the definition of the given composite service. Return the call result.
+ */
+static gboolean
+dbus_cb_core_delete_composite (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *composite_name, gpointer user_data)
+{
+  gint result = 0;
+
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
+  result = svcdb_composite_delete (composite_name);
+  machinelearning_service_pipeline_complete_delete_composite (obj, invoc, result);
+
+  return TRUE;
+}
+
+/**
+ * @brief Launch the composite service with given name. Return the call result and its id.
+ * @details The pipelines of the composite service are launched as one node, which is started, stopped and destroyed with its id.
+ */
+static gboolean
+dbus_cb_core_launch_composite (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *composite_name, gint64 deadline,
+    gpointer user_data)
 {
   gint result = 0;
   gint64 id = -1;
+  launch_request_s *req;
 
-  result = mlops_node_create (service_name, MLOPS_NODE_TYPE_PIPELINE, &id);
-  machinelearning_service_pipeline_complete_launch_pipeline (obj, invoc, result, id);
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_ALL))
+    return TRUE;
+
+  if (_is_deadline_expired (deadline)) {
+    ml_logw ("The caller has already given up, drop the request to launch '%s'.", composite_name);
+    machinelearning_service_pipeline_complete_launch_composite (obj, invoc, -ETIMEDOUT, id);
+    return TRUE;
+  }
+
+  req = _launch_request_new (obj, invoc, composite_name, deadline);
+  req->complete = machinelearning_service_pipeline_complete_launch_composite;
+  result = mlops_node_create_async (composite_name, MLOPS_NODE_TYPE_COMPOSITE,
+      g_dbus_method_invocation_get_sender (invoc), NULL, FALSE, _launch_pipeline_done, req, &id);
+
+  if (result != 0) {
+    _launch_request_free (req);
+    machinelearning_service_pipeline_complete_launch_composite (obj, invoc, result, -1);
+  }
 
   return TRUE;
 }
 
+/**
+ * @brief Internal function to start or stop the pipeline with given id, if the caller has not given up.
+ */
+static gint
+_set_pipeline_state (gint64 id, gint64 deadline, gboolean start)
+{
+  if (_is_deadline_expired (deadline)) {
+    ml_logw ("The caller has already given up, drop the request to %s the pipeline with ID %"
+        G_GINT64_FORMAT, start ? "start" : "stop", id);
+    return -ETIMEDOUT;
+  }
+
+  return start ? mlops_node_start (id) : mlops_node_stop (id);
+}
+
 /**
  * @brief Start the pipeline with given id. Return the call result.
  */
@@ -118,10 +497,21 @@ static gboolean
 dbus_cb_core_start_pipeline (MachinelearningServicePipeline *obj,
     GDBusMethodInvocation *invoc, gint64 id, gpointer user_data)
 {
-  gint result = 0;
+  machinelearning_service_pipeline_complete_start_pipeline (
+      obj, invoc, _set_pipeline_state (id, 0, TRUE));
 
-  result = mlops_node_start (id);
-  machinelearning_service_pipeline_complete_start_pipeline (obj, invoc, result);
+  return TRUE;
+}
+
+/**
+ * @brief Start the pipeline with given id and the deadline of the caller. Return the call result.
+ */
+static gboolean
+dbus_cb_core_start_pipeline_with_deadline (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, gint64 id, gint64 deadline, gpointer user_data)
+{
+  machinelearning_service_pipeline_complete_start_pipeline_with_deadline (
+      obj, invoc, _set_pipeline_state (id, deadline, TRUE));
 
   return TRUE;
 }
@@ -133,10 +523,21 @@ static gboolean
 dbus_cb_core_stop_pipeline (MachinelearningServicePipeline *obj,
     GDBusMethodInvocation *invoc, gint64 id, gpointer user_data)
 {
-  gint result = 0;
+  machinelearning_service_pipeline_complete_stop_pipeline (
+      obj, invoc, _set_pipeline_state (id, 0, FALSE));
 
-  result = mlops_node_stop (id);
-  machinelearning_service_pipeline_complete_stop_pipeline (obj, invoc, result);
+  return TRUE;
+}
+
+/**
+ * @brief Stop the pipeline with given id and the deadline of the caller. Return the call result.
+ */
+static gboolean
+dbus_cb_core_stop_pipeline_with_deadline (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, gint64 id, gint64 deadline, gpointer user_data)
+{
+  machinelearning_service_pipeline_complete_stop_pipeline_with_deadline (
+      obj, invoc, _set_pipeline_state (id, deadline, FALSE));
 
   return TRUE;
 }
@@ -172,6 +573,485 @@ dbus_cb_core_get_state (MachinelearningServicePipeline *obj,
   return TRUE;
 }
 
+/**
+ * @brief Get the number of requests which are dropped or failed because of the deadline. Return the call result and the count.
+ */
+static gboolean
+dbus_cb_core_get_deadline_misses (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, gpointer user_data)
+{
+  guint64 count;
+
+  G_LOCK (deadline_misses);
+  count = g_deadline_misses;
+  G_UNLOCK (deadline_misses);
+
+  machinelearning_service_pipeline_complete_get_deadline_misses (obj, invoc, 0, count);
+
+  return TRUE;
+}
+
+/**
+ * @brief Set the attributes of the pipeline. Return the call result.
+ */
+static gboolean
+dbus_cb_core_set_pipeline_attributes (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *service_name,
+    const gchar *attributes, gpointer user_data)
+{
+  gint result = 0;
+
+  /* The pool is filled with the new attributes, GStreamer is required. */
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_ALL))
+    return TRUE;
+
+  result = svcdb_pipeline_set_attributes (service_name, attributes);
+  if (result == 0)
+    mlops_node_pool_update (service_name);
+
+  machinelearning_service_pipeline_complete_set_pipeline_attributes (obj, invoc, result);
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the attributes of the pipeline. Return the call result and the attributes.
+ */
+static gboolean
+dbus_cb_core_get_pipeline_attributes (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *service_name, gpointer user_data)
+{
+  gint result = 0;
+  g_autofree gchar *attributes = NULL;
+
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
+  result = svcdb_pipeline_get_attributes (service_name, &attributes);
+  machinelearning_service_pipeline_complete_get_pipeline_attributes (
+      obj, invoc, result, attributes ? attributes : "");
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the statistics of the prerolled pipeline pools. Return the call result and the statistics.
+ */
+static gboolean
+dbus_cb_core_get_pool_stats (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, gpointer user_data)
+{
+  gint result = 0;
+  g_autofree gchar *stats = NULL;
+
+  result = mlops_node_pool_get_stats (&stats);
+  machinelearning_service_pipeline_complete_get_pool_stats (
+      obj, invoc, result, stats ? stats : "");
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the statistics of the models shared by the launched pipelines. Return the call result and the statistics.
+ */
+static gboolean
+dbus_cb_core_get_share_stats (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, gpointer user_data)
+{
+  gint result = 0;
+  g_autofree gchar *stats = NULL;
+
+  result = mlops_node_share_get_stats (&stats);
+  machinelearning_service_pipeline_complete_get_share_stats (
+      obj, invoc, result, stats ? stats : "");
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the runtime statistics of the pipeline with given id. Return the call result and the statistics.
+ */
+static gboolean
+dbus_cb_core_get_statistics (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, gint64 id, gpointer user_data)
+{
+  gint result = 0;
+  g_autofree gchar *stats = NULL;
+
+  result = mlops_node_get_statistics (id, &stats);
+  machinelearning_service_pipeline_complete_get_statistics (
+      obj, invoc, result, stats ? stats : "");
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the restart policy, the number of restarts and the last error of the pipeline with given id.
+ */
+static gboolean
+dbus_cb_core_get_restart_info (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, gint64 id, gpointer user_data)
+{
+  gint result = 0;
+  g_autofree gchar *info = NULL;
+
+  result = mlops_node_get_restart_info (id, &info);
+  machinelearning_service_pipeline_complete_get_restart_info (
+      obj, invoc, result, info ? info : "");
+
+  return TRUE;
+}
+
+/**
+ * @brief Function to complete the call to profile the pipeline.
+ */
+typedef void (*profile_complete_f) (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, gint result, const gchar *report);
+
+/**
+ * @brief Structure for the request to profile the pipeline.
+ */
+typedef struct
+{
+  MachinelearningServicePipeline *obj;
+  GDBusMethodInvocation *invoc;
+  profile_complete_f complete;  /**< The function to complete the invocation. */
+  gint64 deadline;
+} profile_request_s;
+
+/**
+ * @brief Complete the call to profile the pipeline when the benchmark is done in the worker.
+ */
+static void
+_profile_pipeline_done (const int result, const gchar *report, void *user_data)
+{
+  profile_request_s *req = (profile_request_s *) user_data;
+
+  /* The benchmark is dropped in the worker if the caller has given up while queued. */
+  if (result == -ETIMEDOUT)
+    _is_deadline_expired (req->deadline);
+
+  req->complete (req->obj, req->invoc, result, report ? report : "");
+  g_object_unref (req->obj);
+  g_free (req);
+}
+
+/**
+ * @brief Internal function to run the benchmark in the worker, the call is completed with @a complete when the benchmark is done.
+ */
+static void
+_profile_pipeline (MachinelearningServicePipeline *obj, GDBusMethodInvocation *invoc,
+    const gchar *service_name, guint num_buffers, const gchar *options,
+    gint64 deadline, profile_complete_f complete)
+{
+  gint result = 0;
+  profile_request_s *req;
+
+  if (_is_deadline_expired (deadline)) {
+    ml_logw ("The caller has already given up, drop the request to profile '%s'.", service_name);
+    complete (obj, invoc, -ETIMEDOUT, "");
+    return;
+  }
+
+  req = g_new0 (profile_request_s, 1);
+  req->obj = (MachinelearningServicePipeline *) g_object_ref (obj);
+  req->invoc = invoc;
+  req->complete = complete;
+  req->deadline = deadline;
+
+  result = mlops_node_profile_async (service_name, num_buffers, options,
+      deadline, _profile_pipeline_done, req);
+  if (result != 0) {
+    complete (obj, invoc, result, "");
+    g_object_unref (req->obj);
+    g_free (req);
+  }
+}
+
+/**
+ * @brief Run the pipeline of the service in the benchmark mode. Return the call result and the report.
+ * @details The benchmark runs in the worker, and the call is completed when the benchmark is done.
+ */
+static gboolean
+dbus_cb_core_profile_pipeline (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *service_name, guint num_buffers,
+    const gchar *options, gpointer user_data)
+{
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_ALL))
+    return TRUE;
+
+  _profile_pipeline (obj, invoc, service_name, num_buffers, options, 0,
+      machinelearning_service_pipeline_complete_profile_pipeline);
+
+  return TRUE;
+}
+
+/**
+ * @brief Run the pipeline of the service in the benchmark mode with the deadline of the caller. Return the call result and the report.
+ * @details The request is dropped if the caller has already given up before the benchmark starts.
+ */
+static gboolean
+dbus_cb_core_profile_pipeline_with_deadline (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *service_name, guint num_buffers,
+    const gchar *options, gint64 deadline, gpointer user_data)
+{
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_ALL))
+    return TRUE;
+
+  _profile_pipeline (obj, invoc, service_name, num_buffers, options, deadline,
+      machinelearning_service_pipeline_complete_profile_pipeline_with_deadline);
+
+  return TRUE;
+}
+
+/**
+ * @brief Create the array of the results of the batch.
+ */
+static GVariant *
+_new_batch_results (const gint *results, gsize count)
+{
+  if (!results || count == 0)
+    return g_variant_new_array (G_VARIANT_TYPE_INT32, NULL, 0);
+
+  return g_variant_new_fixed_array (G_VARIANT_TYPE_INT32, results, count, sizeof (gint32));
+}
+
+/**
+ * @brief Structure for the request of the batch.
+ */
+typedef struct
+{
+  MachinelearningServicePipeline *obj;
+  GDBusMethodInvocation *invoc;
+  mlops_node_batch_op_e op;
+  gboolean launch; /**< The request to launch the pipelines, @a op is ignored. */
+  gint64 deadline;
+} batch_request_s;
+
+/**
+ * @brief Create the request of the batch.
+ */
+static batch_request_s *
+_batch_request_new (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, mlops_node_batch_op_e op, gint64 deadline)
+{
+  batch_request_s *req = g_new0 (batch_request_s, 1);
+
+  req->obj = (MachinelearningServicePipeline *) g_object_ref (obj);
+  req->invoc = invoc;
+  req->op = op;
+  req->deadline = deadline;
+
+  return req;
+}
+
+/**
+ * @brief Release the request of the batch.
+ */
+static void
+_batch_request_free (batch_request_s *req)
+{
+  g_object_unref (req->obj);
+  g_free (req);
+}
+
+/**
+ * @brief Complete the call of the batch with the results.
+ */
+static void
+_batch_complete (batch_request_s *req, gint result, GVariant *ids_v, GVariant *results_v)
+{
+  if (req->launch) {
+    if (!ids_v)
+      ids_v = g_variant_new_array (G_VARIANT_TYPE_INT64, NULL, 0);
+
+    machinelearning_service_pipeline_complete_launch_pipelines (
+        req->obj, req->invoc, result, ids_v, results_v);
+    return;
+  }
+
+  switch (req->op) {
+    case MLOPS_NODE_BATCH_START:
+      machinelearning_service_pipeline_complete_start_pipelines (
+          req->obj, req->invoc, result, results_v);
+      break;
+    case MLOPS_NODE_BATCH_STOP:
+      machinelearning_service_pipeline_complete_stop_pipelines (
+          req->obj, req->invoc, result, results_v);
+      break;
+    default:
+      machinelearning_service_pipeline_complete_destroy_pipelines (
+          req->obj, req->invoc, result, results_v);
+      break;
+  }
+}
+
+/**
+ * @brief Complete the call of the batch when all operations are done in the workers.
+ */
+static void
+_batch_done (const int64_t *ids, const int *results, const guint count,
+    const int result, void *user_data)
+{
+  batch_request_s *req = (batch_request_s *) user_data;
+  g_autofree gint64 *nids = g_new (gint64, count);
+  g_autofree gint *rets = g_new (gint, count);
+  GVariant *ids_v = NULL;
+  gint ret = result;
+  guint i;
+
+  for (i = 0; i < count; i++) {
+    nids[i] = ids[i];
+    rets[i] = results[i];
+  }
+
+  /* Nobody receives the ids of the launched pipelines, release them. */
+  if (req->launch && _is_deadline_expired (req->deadline)) {
+    ml_logw ("The caller has already given up, destroy %u launched pipelines.", count);
+    for (i = 0; i < count; i++) {
+      if (rets[i] == 0)
+        mlops_node_destroy (nids[i]);
+      nids[i] = -1;
+      rets[i] = -ETIMEDOUT;
+    }
+    ret = -ETIMEDOUT;
+  }
+
+  if (req->launch)
+    ids_v = g_variant_new_fixed_array (G_VARIANT_TYPE_INT64, nids, count, sizeof (gint64));
+
+  _batch_complete (req, ret, ids_v, _new_batch_results (rets, count));
+  _batch_request_free (req);
+}
+
+/**
+ * @brief Launch the pipelines of the given services in parallel. Return the call result, the ids and the result of each pipeline.
+ * @details The pipelines are built in the workers, and the call is completed when all pipelines are launched.
+ */
+static gboolean
+dbus_cb_core_launch_pipelines (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *const *service_names,
+    gint64 deadline, gpointer user_data)
+{
+  gint result = 0;
+  guint count;
+  batch_request_s *req;
+
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_ALL))
+    return TRUE;
+
+  count = service_names ? g_strv_length ((gchar **) service_names) : 0;
+
+  if (count == 0) {
+    result = -EINVAL;
+  } else if (_is_deadline_expired (deadline)) {
+    ml_logw ("The caller has already given up, drop the request to launch %u pipelines.", count);
+    result = -ETIMEDOUT;
+  } else {
+    req = _batch_request_new (obj, invoc, MLOPS_NODE_BATCH_START, deadline);
+    req->launch = TRUE;
+
+    result = mlops_node_create_batch_async (service_names, count,
+        g_dbus_method_invocation_get_sender (invoc), _batch_done, req);
+    if (result == 0)
+      return TRUE;
+
+    _batch_request_free (req);
+  }
+
+  machinelearning_service_pipeline_complete_launch_pipelines (obj, invoc, result,
+      g_variant_new_array (G_VARIANT_TYPE_INT64, NULL, 0), _new_batch_results (NULL, 0));
+
+  return TRUE;
+}
+
+/**
+ * @brief Do the operation on the pipelines with given ids in parallel.
+ * @details The state of the pipelines is changed in the workers, and the call is completed when all operations are done.
+ */
+static void
+_run_batch (MachinelearningServicePipeline *obj, GDBusMethodInvocation *invoc,
+    mlops_node_batch_op_e op, GVariant *ids, gint64 deadline)
+{
+  const gint64 *values;
+  gsize count = 0;
+  gint result;
+  batch_request_s *req;
+
+  req = _batch_request_new (obj, invoc, op, deadline);
+
+  values = (const gint64 *) g_variant_get_fixed_array (ids, &count, sizeof (gint64));
+  if (count == 0) {
+    result = -EINVAL;
+  } else if (_is_deadline_expired (deadline)) {
+    ml_logw ("The caller has already given up, drop the request for %u pipelines.", (guint) count);
+    result = -ETIMEDOUT;
+  } else {
+    result = mlops_node_batch_async (op, values, (guint) count, _batch_done, req);
+    if (result == 0)
+      return;
+  }
+
+  _batch_complete (req, result, NULL, _new_batch_results (NULL, 0));
+  _batch_request_free (req);
+}
+
+/**
+ * @brief Start the pipelines with given ids in parallel. Return the call result and the result of each pipeline.
+ */
+static gboolean
+dbus_cb_core_start_pipelines (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, GVariant *ids, gint64 deadline, gpointer user_data)
+{
+  _run_batch (obj, invoc, MLOPS_NODE_BATCH_START, ids, deadline);
+
+  return TRUE;
+}
+
+/**
+ * @brief Stop the pipelines with given ids in parallel. Return the call result and the result of each pipeline.
+ */
+static gboolean
+dbus_cb_core_stop_pipelines (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, GVariant *ids, gint64 deadline, gpointer user_data)
+{
+  _run_batch (obj, invoc, MLOPS_NODE_BATCH_STOP, ids, deadline);
+
+  return TRUE;
+}
+
+/**
+ * @brief Destroy the pipelines with given ids in parallel. Return the call result and the result of each pipeline.
+ */
+static gboolean
+dbus_cb_core_destroy_pipelines (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, GVariant *ids, gpointer user_data)
+{
+  _run_batch (obj, invoc, MLOPS_NODE_BATCH_DESTROY, ids, 0);
+
+  return TRUE;
+}
+
+/**
+ * @brief Emit the signal when the state of the pipeline is changed.
+ */
+static void
+_pipeline_state_changed (const int64_t id, const GstState state, void *user_data)
+{
+  if (g_gdbus_instance)
+    machinelearning_service_pipeline_emit_state_changed (g_gdbus_instance, id, (gint) state);
+}
+
+/**
+ * @brief Emit the signal when no buffer entered the sinks of the playing pipeline for the stall threshold.
+ */
+static void
+_pipeline_stalled (const int64_t id, const int64_t idle_ms, void *user_data)
+{
+  if (g_gdbus_instance)
+    machinelearning_service_pipeline_emit_pipeline_stalled (g_gdbus_instance, id, idle_ms);
+}
+
 static struct gdbus_signal_info handler_infos[] = {
   {
       .signal_name = DBUS_PIPELINE_I_SET_HANDLER,
@@ -209,6 +1089,24 @@ static struct gdbus_signal_info handler_infos[] = {
       .cb_data = NULL,
       .handler_id = 0,
   },
+  {
+      .signal_name = DBUS_PIPELINE_I_LAUNCH_DEADLINE_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_launch_pipeline_with_deadline),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_START_DEADLINE_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_start_pipeline_with_deadline),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_STOP_DEADLINE_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_stop_pipeline_with_deadline),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
   {
       .signal_name = DBUS_PIPELINE_I_DESTROY_HANDLER,
       .cb = G_CALLBACK (dbus_cb_core_destroy_pipeline),
@@ -221,6 +1119,120 @@ static struct gdbus_signal_info handler_infos[] = {
       .cb_data = NULL,
       .handler_id = 0,
   },
+  {
+      .signal_name = DBUS_PIPELINE_I_GET_DEADLINE_MISSES_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_get_deadline_misses),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_SET_ATTRIBUTES_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_set_pipeline_attributes),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_GET_ATTRIBUTES_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_get_pipeline_attributes),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_GET_POOL_STATS_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_get_pool_stats),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_LAUNCH_ASYNC_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_launch_pipeline_async),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_GET_STATISTICS_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_get_statistics),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_GET_RESTART_INFO_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_get_restart_info),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_PROFILE_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_profile_pipeline),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_PROFILE_DEADLINE_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_profile_pipeline_with_deadline),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_LAUNCH_BATCH_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_launch_pipelines),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_START_BATCH_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_start_pipelines),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_STOP_BATCH_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_stop_pipelines),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_DESTROY_BATCH_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_destroy_pipelines),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_LAUNCH_WITH_PARAMS_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_launch_pipeline_with_params),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_GET_SHARE_STATS_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_get_share_stats),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_SET_COMPOSITE_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_set_composite),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_GET_COMPOSITE_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_get_composite),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_DELETE_COMPOSITE_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_delete_composite),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_PIPELINE_I_LAUNCH_COMPOSITE_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_launch_composite),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
 };
 
 /**
@@ -269,6 +1281,8 @@ static void
 init_pipeline_module (void *data)
 {
   gdbus_initialize ();
+  mlops_node_set_state_cb (_pipeline_state_changed, NULL);
+  mlops_node_set_stall_cb (_pipeline_stalled, NULL);
 }
 
 /**
@@ -277,6 +1291,8 @@ init_pipeline_module (void *data)
 static void
 exit_pipeline_module (void *data)
 {
+  mlops_node_set_state_cb (NULL, NULL);
+  mlops_node_set_stall_cb (NULL, NULL);
   gdbus_disconnect_signal (g_gdbus_instance, ARRAY_SIZE (handler_infos), handler_infos);
   gdbus_put_pipeline_instance (&g_gdbus_instance);
 }
@@ -286,6 +1302,8 @@ static const struct module_ops pipeline_ops = {
   .probe = probe_pipeline_module,
   .init = init_pipeline_module,
   .exit = exit_pipeline_module,
+  .path = DBUS_PIPELINE_PATH,
+  .get_info = machinelearning_service_pipeline_interface_info,
 };
 
 MODULE_OPS_REGISTER (&pipeline_ops)
@@ -17,6 +17,7 @@
 #include "dbus-interface.h"
 #include "gdbus-util.h"
 #include "log.h"
+#include "mlops-agent-internal.h"
 #include "modules.h"
 #include "resource-dbus.h"
 #include "service-db-util.h"
@@ -56,6 +57,9 @@ gdbus_cb_resource_add (MachinelearningServiceResource *obj, GDBusMethodInvocatio
 {
   gint ret = 0;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
   ret = svcdb_resource_add (name, path, description, app_info);
   machinelearning_service_resource_complete_add (obj, invoc, ret);
 
@@ -76,6 +80,9 @@ gdbus_cb_resource_get (MachinelearningServiceResource *obj,
   gint ret = 0;
   g_autofree gchar *res_info = NULL;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
   ret = svcdb_resource_get (name, &res_info);
   machinelearning_service_resource_complete_get (obj, invoc, res_info, ret);
 
@@ -95,6 +102,9 @@ gdbus_cb_resource_delete (MachinelearningServiceResource *obj,
 {
   gint ret = 0;
 
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_DB))
+    return TRUE;
+
   ret = svcdb_resource_delete (name);
   machinelearning_service_resource_complete_delete (obj, invoc, ret);
 
@@ -169,15 +179,6 @@ out:
   return ret;
 }
 
-/**
- * @brief The callback function for initializing resource interface module.
- */
-static void
-init_resource_module (void *data)
-{
-  gdbus_initialize ();
-}
-
 /**
  * @brief The callback function for exiting resource interface module.
  */
@@ -192,8 +193,9 @@ exit_resource_module (void *data)
 static const struct module_ops resource_ops = {
   .name = "resource-interface",
   .probe = probe_resource_module,
-  .init = init_resource_module,
   .exit = exit_resource_module,
+  .path = DBUS_RESOURCE_PATH,
+  .get_info = machinelearning_service_resource_interface_info,
 };
 
 MODULE_OPS_REGISTER (&resource_ops)
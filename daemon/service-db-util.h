@@ -23,6 +23,9 @@ void svcdb_finalize (void);
 gint svcdb_pipeline_set (const gchar *name, const gchar *description);
 gint svcdb_pipeline_get (const gchar *name, gchar **description);
 gint svcdb_pipeline_delete (const gchar *name);
+gint svcdb_pipeline_set_attributes (const gchar *name, const gchar *attributes);
+gint svcdb_pipeline_get_attributes (const gchar *name, gchar **attributes);
+gint svcdb_pipeline_get_attribute (const gchar *name, const gchar *attr, gchar **value);
 gint svcdb_model_add (const gchar *name, const gchar *path, const bool is_active, const gchar *description, const gchar *app_info, guint *version);
 gint svcdb_model_update_description (const gchar *name, const guint version, const gchar *description);
 gint svcdb_model_activate (const gchar *name, const guint version);
@@ -33,6 +36,9 @@ gint svcdb_model_delete (const gchar *name, const guint version, const gboolean
 gint svcdb_resource_add (const gchar *name, const gchar *path, const gchar *description, const gchar *app_info);
 gint svcdb_resource_get (const gchar *name, gchar **res_info);
 gint svcdb_resource_delete (const gchar *name);
+gint svcdb_composite_set (const gchar *name, const gchar *definition);
+gint svcdb_composite_get (const gchar *name, gchar **definition);
+gint svcdb_composite_delete (const gchar *name);
 
 G_END_DECLS
 #endif /* __SERVICE_DB_UTIL_H__ */
@@ -25,7 +25,7 @@
 /**
  * @brief The version of pipeline table schema. It should be a positive integer.
  */
-#define TBL_VER_PIPELINE_DESCRIPTION (1)
+#define TBL_VER_PIPELINE_DESCRIPTION (2)
 
 /**
  * @brief The version of model table schema. It should be a positive integer.
@@ -37,20 +37,27 @@
  */
 #define TBL_VER_RESOURCE_INFO (1)
 
+/**
+ * @brief The version of composite service table schema. It should be a positive integer.
+ */
+#define TBL_VER_COMPOSITE_INFO (1)
+
 typedef enum {
   TBL_DB_INFO = 0,
   TBL_PIPELINE_DESCRIPTION = 1,
   TBL_MODEL_INFO = 2,
   TBL_RESOURCE_INFO = 3,
+  TBL_COMPOSITE_INFO = 4,
 
   TBL_MAX
 } mlsvc_table_e;
 
 const char *g_mlsvc_table_schema_v1[] = {
   /* TBL_DB_INFO */ "tblMLDBInfo (name TEXT PRIMARY KEY NOT NULL, version INTEGER DEFAULT 1)",
-  /* TBL_PIPELINE_DESCRIPTION */ "tblPipeline (key TEXT PRIMARY KEY NOT NULL, description TEXT, CHECK (length(description) > 0))",
+  /* TBL_PIPELINE_DESCRIPTION */ "tblPipeline (key TEXT PRIMARY KEY NOT NULL, description TEXT, attributes TEXT, CHECK (length(description) > 0))",
   /* TBL_MODEL_INFO */ "tblModel (key TEXT NOT NULL, version INTEGER DEFAULT 1, active TEXT DEFAULT 'F', path TEXT, description TEXT, app_info TEXT, PRIMARY KEY (key, version), CHECK (length(path) > 0), CHECK (active IN ('T', 'F')))",
   /* TBL_RESOURCE_INFO */ "tblResource (key TEXT NOT NULL, path TEXT, description TEXT, app_info TEXT, PRIMARY KEY (key, path), CHECK (length(path) > 0))",
+  /* TBL_COMPOSITE_INFO */ "tblComposite (key TEXT PRIMARY KEY NOT NULL, definition TEXT, CHECK (length(definition) > 0))",
   /* Sentinel */ NULL
 };
 
@@ -105,8 +112,10 @@ MLServiceDB::initDB ()
   if ((tbl_ver = get_table_version ("tblPipeline", TBL_VER_PIPELINE_DESCRIPTION)) < 0)
     return;
 
-  if (tbl_ver != TBL_VER_PIPELINE_DESCRIPTION) {
-    /** @todo update pipeline table if table schema is changed */
+  if (tbl_ver < 2) {
+    /* Version 2 adds the attributes (JSON object) of the pipeline. */
+    if (!alter_table ("tblPipeline ADD COLUMN attributes TEXT"))
+      return;
   }
 
   if (!set_table_version ("tblPipeline", TBL_VER_PIPELINE_DESCRIPTION))
@@ -134,6 +143,17 @@ MLServiceDB::initDB ()
   if (!set_table_version ("tblResource", TBL_VER_RESOURCE_INFO))
     return;
 
+  /* Check composite table. */
+  if ((tbl_ver = get_table_version ("tblComposite", TBL_VER_COMPOSITE_INFO)) < 0)
+    return;
+
+  if (tbl_ver != TBL_VER_COMPOSITE_INFO) {
+    /** @todo update composite table if table schema is changed */
+  }
+
+  if (!set_table_version ("tblComposite", TBL_VER_COMPOSITE_INFO))
+    return;
+
   if (!set_transaction (false))
     return;
 
@@ -244,6 +264,26 @@ MLServiceDB::create_table (const std::string tbl_name)
   return true;
 }
 
+/**
+ * @brief Alter DB table.
+ */
+bool
+MLServiceDB::alter_table (const std::string statement)
+{
+  int rc;
+  char *errmsg = nullptr;
+  std::string sql = "ALTER TABLE " + statement;
+
+  rc = sqlite3_exec (_db, sql.c_str (), nullptr, nullptr, &errmsg);
+  if (rc != SQLITE_OK) {
+    ml_logw ("Failed to alter table %s: %s (%d)", statement.c_str (), errmsg, rc);
+    sqlite3_clear_errmsg (errmsg);
+    return false;
+  }
+
+  return true;
+}
+
 /**
  * @brief Begin/end transaction.
  */
@@ -283,7 +323,8 @@ MLServiceDB::set_pipeline (const std::string name, const std::string description
     throw std::runtime_error ("Failed to begin transaction.");
 
   if (sqlite3_prepare_v2 (_db,
-          "INSERT OR REPLACE INTO tblPipeline VALUES (?1, ?2)", -1, &res, nullptr)
+          "INSERT OR REPLACE INTO tblPipeline VALUES (?1, ?2, (SELECT attributes FROM tblPipeline WHERE key = ?1))",
+          -1, &res, nullptr)
           != SQLITE_OK
       || sqlite3_bind_text (res, 1, key_with_prefix.c_str (), -1, nullptr) != SQLITE_OK
       || sqlite3_bind_text (res, 2, description.c_str (), -1, nullptr) != SQLITE_OK
@@ -360,6 +401,130 @@ MLServiceDB::delete_pipeline (const std::string name)
   }
 }
 
+/**
+ * @brief Set the attributes of the pipeline with the given name.
+ * @note The attributes are merged into the existing attributes (JSON merge patch), a member with null value is removed.
+ * @param[in] name The unique name of the pipeline.
+ * @param[in] attributes The attributes (JSON object) to be merged.
+ */
+void
+MLServiceDB::set_pipeline_attributes (const std::string name, const std::string attributes)
+{
+  sqlite3_stmt *res;
+  bool is_object = false;
+
+  if (name.empty () || attributes.empty ())
+    throw std::invalid_argument ("Invalid name or attributes parameters!");
+
+  std::string key_with_prefix = DB_KEY_PREFIX + std::string ("_pipeline_");
+  key_with_prefix += name;
+
+  if (sqlite3_prepare_v2 (_db,
+          "SELECT CASE WHEN json_valid(?1) THEN json_type(?1) = 'object' ELSE 0 END",
+          -1, &res, nullptr)
+          == SQLITE_OK
+      && sqlite3_bind_text (res, 1, attributes.c_str (), -1, nullptr) == SQLITE_OK
+      && sqlite3_step (res) == SQLITE_ROW)
+    is_object = (sqlite3_column_int (res, 0) != 0);
+
+  sqlite3_finalize (res);
+
+  if (!is_object)
+    throw std::invalid_argument ("Invalid attributes, it should be a JSON object: " + attributes);
+
+  if (sqlite3_prepare_v2 (_db,
+          "UPDATE tblPipeline SET attributes = json_patch(IFNULL(attributes, '{}'), ?1) WHERE key = ?2",
+          -1, &res, nullptr)
+          != SQLITE_OK
+      || sqlite3_bind_text (res, 1, attributes.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_bind_text (res, 2, key_with_prefix.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_step (res) != SQLITE_DONE) {
+    sqlite3_finalize (res);
+    throw std::runtime_error ("Failed to set the attributes of pipeline " + name);
+  }
+
+  sqlite3_finalize (res);
+
+  if (sqlite3_changes (_db) == 0) {
+    throw std::invalid_argument ("There is no pipeline description of " + name);
+  }
+}
+
+/**
+ * @brief Get the attributes of the pipeline with the given name.
+ * @param[in] name The unique name of the pipeline.
+ * @param[out] attributes The attributes (JSON object) of the pipeline. Empty object if not set.
+ */
+void
+MLServiceDB::get_pipeline_attributes (const std::string name, gchar **attributes)
+{
+  char *value = nullptr;
+  sqlite3_stmt *res;
+
+  if (name.empty () || !attributes)
+    throw std::invalid_argument ("Invalid name or attributes parameter!");
+
+  std::string key_with_prefix = DB_KEY_PREFIX + std::string ("_pipeline_");
+  key_with_prefix += name;
+
+  if (sqlite3_prepare_v2 (_db,
+          "SELECT IFNULL(attributes, '{}') FROM tblPipeline WHERE key = ?1", -1, &res, nullptr)
+          == SQLITE_OK
+      && sqlite3_bind_text (res, 1, key_with_prefix.c_str (), -1, nullptr) == SQLITE_OK
+      && sqlite3_step (res) == SQLITE_ROW)
+    value = g_strdup_printf ("%s", sqlite3_column_text (res, 0));
+
+  sqlite3_finalize (res);
+
+  if (value) {
+    *attributes = value;
+  } else {
+    throw std::invalid_argument ("Failed to get the attributes of pipeline " + name);
+  }
+}
+
+/**
+ * @brief Get the value of the attribute of the pipeline.
+ * @param[in] name The unique name of the pipeline.
+ * @param[in] attr The name of the attribute.
+ * @param[out] value The value of the attribute in string. NULL if the attribute is not set.
+ */
+void
+MLServiceDB::get_pipeline_attribute (const std::string name, const std::string attr, gchar **value)
+{
+  sqlite3_stmt *res;
+  const unsigned char *text;
+  bool found = false;
+
+  if (name.empty () || attr.empty () || !value)
+    throw std::invalid_argument ("Invalid name, attribute or value parameter!");
+
+  std::string key_with_prefix = DB_KEY_PREFIX + std::string ("_pipeline_");
+  key_with_prefix += name;
+
+  /* Quote the attribute name in JSON path, not to be parsed as the path. */
+  g_autofree gchar *path = g_strdup_printf ("$.\"%s\"", attr.c_str ());
+
+  *value = nullptr;
+
+  if (sqlite3_prepare_v2 (_db,
+          "SELECT json_extract(attributes, ?1) FROM tblPipeline WHERE key = ?2", -1, &res, nullptr)
+          == SQLITE_OK
+      && sqlite3_bind_text (res, 1, path, -1, nullptr) == SQLITE_OK
+      && sqlite3_bind_text (res, 2, key_with_prefix.c_str (), -1, nullptr) == SQLITE_OK
+      && sqlite3_step (res) == SQLITE_ROW) {
+    found = true;
+    text = sqlite3_column_text (res, 0);
+    if (text)
+      *value = g_strdup ((const gchar *) text);
+  }
+
+  sqlite3_finalize (res);
+
+  if (!found)
+    throw std::invalid_argument ("Failed to get the attributes of pipeline " + name);
+}
+
 /**
  * @brief Check the model is registered.
  */
@@ -852,6 +1017,101 @@ MLServiceDB::delete_resource (const std::string name)
     throw std::invalid_argument ("There is no resource with name " + name);
 }
 
+/**
+ * @brief Set the definition of the composite service with the given name.
+ * @note If the name already exists, the definition is overwritten.
+ * @param[in] name Unique name to set the associated definition.
+ * @param[in] definition The definition (JSON object) of the composite service.
+ */
+void
+MLServiceDB::set_composite (const std::string name, const std::string definition)
+{
+  sqlite3_stmt *res;
+
+  if (name.empty () || definition.empty ())
+    throw std::invalid_argument ("Invalid name or definition parameters!");
+
+  std::string key_with_prefix = DB_KEY_PREFIX + std::string ("_composite_");
+  key_with_prefix += name;
+
+  if (!set_transaction (true))
+    throw std::runtime_error ("Failed to begin transaction.");
+
+  if (sqlite3_prepare_v2 (_db, "INSERT OR REPLACE INTO tblComposite VALUES (?1, ?2)", -1, &res, nullptr) != SQLITE_OK
+      || sqlite3_bind_text (res, 1, key_with_prefix.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_bind_text (res, 2, definition.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_step (res) != SQLITE_DONE) {
+    sqlite3_finalize (res);
+    throw std::runtime_error ("Failed to insert composite definition of " + name);
+  }
+
+  sqlite3_finalize (res);
+
+  if (!set_transaction (false))
+    throw std::runtime_error ("Failed to end transaction.");
+}
+
+/**
+ * @brief Get the definition of the composite service with the given name.
+ * @param[in] name The unique name to retrieve.
+ * @param[out] definition The definition corresponding with the given name.
+ */
+void
+MLServiceDB::get_composite (const std::string name, gchar **definition)
+{
+  char *value = nullptr;
+  sqlite3_stmt *res;
+
+  if (name.empty () || !definition)
+    throw std::invalid_argument ("Invalid name or definition parameter!");
+
+  std::string key_with_prefix = DB_KEY_PREFIX + std::string ("_composite_");
+  key_with_prefix += name;
+
+  if (sqlite3_prepare_v2 (_db, "SELECT definition FROM tblComposite WHERE key = ?1", -1, &res, nullptr)
+          == SQLITE_OK
+      && sqlite3_bind_text (res, 1, key_with_prefix.c_str (), -1, nullptr) == SQLITE_OK
+      && sqlite3_step (res) == SQLITE_ROW)
+    value = g_strdup_printf ("%s", sqlite3_column_text (res, 0));
+
+  sqlite3_finalize (res);
+
+  if (value) {
+    *definition = value;
+  } else {
+    throw std::invalid_argument ("Failed to get composite definition of " + name);
+  }
+}
+
+/**
+ * @brief Delete the definition of the composite service with a given name.
+ * @param[in] name The unique name to delete.
+ */
+void
+MLServiceDB::delete_composite (const std::string name)
+{
+  sqlite3_stmt *res;
+
+  if (name.empty ())
+    throw std::invalid_argument ("Invalid name parameters!");
+
+  std::string key_with_prefix = DB_KEY_PREFIX + std::string ("_composite_");
+  key_with_prefix += name;
+
+  if (sqlite3_prepare_v2 (_db, "DELETE FROM tblComposite WHERE key = ?1", -1, &res, nullptr) != SQLITE_OK
+      || sqlite3_bind_text (res, 1, key_with_prefix.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_step (res) != SQLITE_DONE) {
+    sqlite3_finalize (res);
+    throw std::runtime_error ("Failed to delete composite definition of " + name);
+  }
+
+  sqlite3_finalize (res);
+
+  if (sqlite3_changes (_db) == 0) {
+    throw std::invalid_argument ("There is no composite definition of " + name);
+  }
+}
+
 static MLServiceDB *g_svcdb_instance = nullptr;
 
 /**
@@ -955,6 +1215,82 @@ svcdb_pipeline_get (const gchar *name, gchar **description)
   return ret;
 }
 
+/**
+ * @brief Set the attributes of the pipeline with given name.
+ * @param[in] name The unique name of the pipeline.
+ * @param[in] attributes The attributes (JSON object) to be merged into the existing attributes.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_pipeline_set_attributes (const gchar *name, const gchar *attributes)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->set_pipeline_attributes (name, attributes);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Get the attributes of the pipeline with given name.
+ * @param[in] name The unique name of the pipeline.
+ * @param[out] attributes The attributes (JSON object) of the pipeline.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_pipeline_get_attributes (const gchar *name, gchar **attributes)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->get_pipeline_attributes (name, attributes);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Get the value of the attribute of the pipeline with given name.
+ * @param[in] name The unique name of the pipeline.
+ * @param[in] attr The name of the attribute.
+ * @param[out] value The value of the attribute in string. NULL if the attribute is not set.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_pipeline_get_attribute (const gchar *name, const gchar *attr, gchar **value)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->get_pipeline_attribute (name, attr, value);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
 /**
  * @brief Delete the pipeline description with a given name.
  * @param[in] name The unique name to delete.
@@ -1239,4 +1575,78 @@ svcdb_resource_delete (const gchar *name)
 
   return ret;
 }
+
+/**
+ * @brief Set the definition of the composite service with the given name.
+ * @param[in] name Unique name to set the associated definition.
+ * @param[in] definition The definition (JSON object) of the composite service.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_composite_set (const gchar *name, const gchar *definition)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->set_composite (name, definition);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Get the definition of the composite service with the given name.
+ * @param[in] name The unique name to retrieve.
+ * @param[out] definition The definition corresponding with the given name.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_composite_get (const gchar *name, gchar **definition)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->get_composite (name, definition);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Delete the definition of the composite service with a given name.
+ * @param[in] name The unique name to delete.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_composite_delete (const gchar *name)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->delete_composite (name);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
 G_END_DECLS
@@ -33,6 +33,9 @@ class MLServiceDB
   virtual void set_pipeline (const std::string name, const std::string description);
   virtual void get_pipeline (const std::string name, gchar **description);
   virtual void delete_pipeline (const std::string name);
+  virtual void set_pipeline_attributes (const std::string name, const std::string attributes);
+  virtual void get_pipeline_attributes (const std::string name, gchar **attributes);
+  virtual void get_pipeline_attribute (const std::string name, const std::string attr, gchar **value);
   virtual void set_model (const std::string name, const std::string model, const bool is_active,
       const std::string description, const std::string app_info, guint *version);
   virtual void update_model_description (const std::string name,
@@ -45,6 +48,9 @@ class MLServiceDB
       const std::string description, const std::string app_info);
   virtual void get_resource (const std::string name, gchar **resource);
   virtual void delete_resource (const std::string name);
+  virtual void set_composite (const std::string name, const std::string definition);
+  virtual void get_composite (const std::string name, gchar **definition);
+  virtual void delete_composite (const std::string name);
 
   MLServiceDB (std::string path);
   virtual ~MLServiceDB ();
@@ -54,6 +60,7 @@ class MLServiceDB
   int get_table_version (const std::string tbl_name, const int default_ver);
   bool set_table_version (const std::string tbl_name, const int tbl_ver);
   bool create_table (const std::string tbl_name);
+  bool alter_table (const std::string statement);
   bool set_transaction (bool begin);
   bool is_model_registered (const std::string key, const guint version);
   bool is_model_activated (const std::string key, const guint version);
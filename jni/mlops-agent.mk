@@ -10,4 +10,14 @@ MLOPS_AGENT_SRCS := \
     $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-android.c \
     $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-internal.c \
     $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-node.c \
+    $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-node-stats.c \
+    $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-node-profile.c \
+    $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-node-taskpool.c \
+    $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-node-sched.c \
+    $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-node-config.c \
+    $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-node-admission.c \
+    $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-node-template.c \
+    $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-node-share.c \
+    $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-node-source.c \
+    $(MLOPS_AGENT_ROOT)/daemon/mlops-agent-node-composite.c \
     $(MLOPS_AGENT_ROOT)/daemon/service-db.cc
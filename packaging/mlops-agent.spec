@@ -189,6 +189,7 @@ popd
 %if 0%{?unit_test}
 bash %{test_script} ./tests/daemon/unittest_ml_agent
 bash %{test_script} ./tests/daemon/unittest_service_db
+bash %{test_script} ./tests/daemon/unittest_mlops_node
 bash %{test_script} ./tests/daemon/unittest_gdbus_util
 bash %{test_script} ./tests/plugin-parser/unittest_mlops_plugin_parser
 %endif # unit_test
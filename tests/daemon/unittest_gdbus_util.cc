@@ -12,6 +12,12 @@
 #include "dbus-interface.h"
 #include "gdbus-util.h"
 #include "log.h"
+#include "mlops-agent-internal.h"
+#include "modules.h"
+#include "pipeline-dbus.h"
+
+#define TEST_DB_PATH "."
+#define TEST_MODULE_PATH "/Org/Tizen/MachineLearning/Service/Test"
 
 /**
  * @brief Test base class for GDbus.
@@ -82,6 +88,444 @@ TEST (GDbusInstanceNotInitialized, get_system_connection_n)
   EXPECT_EQ (-ENOSYS, ret);
 }
 
+/**
+ * @brief Internal structure for the result of the method call.
+ */
+typedef struct {
+  GVariant *reply;
+  GError *error;
+  gboolean done;
+} test_call_s;
+
+/**
+ * @brief Callback function called when the method call is done.
+ */
+static void
+_test_call_done (GObject *source, GAsyncResult *res, gpointer user_data)
+{
+  test_call_s *call = (test_call_s *) user_data;
+
+  call->reply = g_dbus_connection_call_finish (G_DBUS_CONNECTION (source), res, &call->error);
+  call->done = TRUE;
+}
+
+/**
+ * @brief Internal function to call the method of the pipeline interface at the object path, and wait for the reply.
+ * @details The method handler of mlops-agent runs in the default main context of this thread.
+ */
+static GVariant *
+_test_call_method (GDBusConnection *client, const gchar *obj_path,
+    const gchar *method, GVariant *params, GError **error)
+{
+  g_autoptr (GDBusConnection) conn = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, NULL);
+  test_call_s call = { NULL, NULL, FALSE };
+  guint i;
+
+  g_dbus_connection_call (client, g_dbus_connection_get_unique_name (conn), obj_path,
+      DBUS_PIPELINE_INTERFACE, method, params, NULL, G_DBUS_CALL_FLAGS_NONE, 5000,
+      NULL, _test_call_done, &call);
+
+  for (i = 0; i < 1000 && !call.done; i++)
+    g_main_context_iteration (NULL, TRUE);
+
+  if (error)
+    *error = call.error;
+  else
+    g_clear_error (&call.error);
+
+  return call.reply;
+}
+
+/**
+ * @brief Internal function to connect the client to the test bus.
+ */
+static GDBusConnection *
+_test_get_client (GTestDBus *dbus)
+{
+  return g_dbus_connection_new_for_address_sync (g_test_dbus_get_bus_address (dbus),
+      (GDBusConnectionFlags) (G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT
+          | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION),
+      NULL, NULL, NULL);
+}
+
+/**
+ * @brief Testcase for the lazy activation - the pipeline interface is activated on the first method call.
+ */
+TEST_F (GDbusTest, activate_pipeline_module)
+{
+  GDBusConnection *client;
+  GVariant *reply;
+  GError *error = NULL;
+  gint64 probe_time = 0;
+  gint result = -1;
+  gchar *desc = NULL;
+
+  ASSERT_EQ (ml_agent_initialize (TEST_DB_PATH), 0);
+  ASSERT_EQ (gdbus_get_system_connection (true), 0);
+  init_modules (NULL);
+
+  /* Only the stub is registered at the object path. */
+  EXPECT_FALSE (get_module_probe_time ("pipeline", NULL));
+
+  client = _test_get_client (dbus);
+  ASSERT_TRUE (client != nullptr);
+
+  reply = _test_call_method (client, DBUS_PIPELINE_PATH, "set_pipeline",
+      g_variant_new ("(ss)", "test-activate", "fakesrc ! fakesink"), &error);
+  ASSERT_TRUE (reply != nullptr) << (error ? error->message : "");
+  g_variant_get (reply, "(i)", &result);
+  EXPECT_EQ (result, 0);
+  g_variant_unref (reply);
+
+  /* The first method call is dispatched to the activated module. */
+  EXPECT_TRUE (get_module_probe_time ("pipeline", &probe_time));
+  EXPECT_GT (probe_time, 0);
+  EXPECT_FALSE (get_module_probe_time ("model-interface", NULL));
+
+  reply = _test_call_method (client, DBUS_PIPELINE_PATH, "get_pipeline",
+      g_variant_new ("(s)", "test-activate"), &error);
+  ASSERT_TRUE (reply != nullptr) << (error ? error->message : "");
+  g_variant_get (reply, "(is)", &result, &desc);
+  EXPECT_EQ (result, 0);
+  EXPECT_STREQ (desc, "fakesrc ! fakesink");
+  g_free (desc);
+  g_variant_unref (reply);
+
+  reply = _test_call_method (client, DBUS_PIPELINE_PATH, "delete_pipeline",
+      g_variant_new ("(s)", "test-activate"), NULL);
+  if (reply)
+    g_variant_unref (reply);
+
+  g_object_unref (client);
+  exit_modules (NULL);
+  gdbus_put_system_connection ();
+  ml_agent_finalize ();
+}
+
+static gint test_probe_count = 0;
+static MachinelearningServicePipeline *test_instance = NULL;
+
+/**
+ * @brief Method handler of the test module.
+ */
+static gboolean
+_test_handle_get_pipeline (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *service_name, gpointer user_data)
+{
+  machinelearning_service_pipeline_complete_get_pipeline (obj, invoc, 0, service_name);
+  return TRUE;
+}
+
+/**
+ * @brief Probe function of the test module, which fails at the first time.
+ */
+static int
+_test_probe_module (void *data)
+{
+  if (++test_probe_count == 1)
+    return -EIO;
+
+  test_instance = machinelearning_service_pipeline_skeleton_new ();
+  g_signal_connect (test_instance, "handle-get-pipeline",
+      G_CALLBACK (_test_handle_get_pipeline), NULL);
+
+  return gdbus_export_interface (test_instance, TEST_MODULE_PATH);
+}
+
+/**
+ * @brief Exit function of the test module.
+ */
+static void
+_test_exit_module (void *data)
+{
+  if (test_instance) {
+    g_dbus_interface_skeleton_unexport (G_DBUS_INTERFACE_SKELETON (test_instance));
+    g_clear_object (&test_instance);
+  }
+}
+
+static const struct module_ops test_module_ops = {
+  .name = "test-module",
+  .probe = _test_probe_module,
+  .init = NULL,
+  .exit = _test_exit_module,
+  .path = TEST_MODULE_PATH,
+  .get_info = machinelearning_service_pipeline_interface_info,
+};
+
+/**
+ * @brief Testcase for the lazy activation - the stub is kept until the module is activated.
+ */
+TEST_F (GDbusTest, activate_module_stub)
+{
+  GDBusConnection *client;
+  GVariant *reply;
+  GError *error = NULL;
+  gint result = -1;
+  gchar *desc = NULL;
+
+  test_probe_count = 0;
+  add_module (&test_module_ops);
+
+  ASSERT_EQ (ml_agent_initialize (TEST_DB_PATH), 0);
+  ASSERT_EQ (gdbus_get_system_connection (true), 0);
+  init_modules (NULL);
+
+  /* The module is not probed until the method is called. */
+  EXPECT_EQ (test_probe_count, 0);
+  EXPECT_FALSE (get_module_probe_time ("test-module", NULL));
+
+  client = _test_get_client (dbus);
+  ASSERT_TRUE (client != nullptr);
+
+  /* The activation fails, and the stub is registered again. */
+  reply = _test_call_method (client, TEST_MODULE_PATH, "get_pipeline",
+      g_variant_new ("(s)", "test-stub"), &error);
+  EXPECT_TRUE (reply == nullptr);
+  ASSERT_TRUE (error != nullptr);
+  EXPECT_TRUE (g_error_matches (error, G_DBUS_ERROR, G_DBUS_ERROR_FAILED));
+  g_clear_error (&error);
+  EXPECT_EQ (test_probe_count, 1);
+  EXPECT_FALSE (get_module_probe_time ("test-module", NULL));
+
+  /* The next method call retries the activation through the stub. */
+  reply = _test_call_method (client, TEST_MODULE_PATH, "get_pipeline",
+      g_variant_new ("(s)", "test-stub"), &error);
+  ASSERT_TRUE (reply != nullptr) << (error ? error->message : "");
+  g_variant_get (reply, "(is)", &result, &desc);
+  EXPECT_EQ (result, 0);
+  EXPECT_STREQ (desc, "test-stub");
+  g_free (desc);
+  g_variant_unref (reply);
+  EXPECT_EQ (test_probe_count, 2);
+  EXPECT_TRUE (get_module_probe_time ("test-module", NULL));
+
+  /* The module is not probed again once it is activated. */
+  reply = _test_call_method (client, TEST_MODULE_PATH, "get_pipeline",
+      g_variant_new ("(s)", "test-stub"), &error);
+  ASSERT_TRUE (reply != nullptr) << (error ? error->message : "");
+  g_variant_unref (reply);
+  EXPECT_EQ (test_probe_count, 2);
+
+  g_object_unref (client);
+  exit_modules (NULL);
+  remove_module (&test_module_ops);
+  gdbus_put_system_connection ();
+  ml_agent_finalize ();
+}
+
+static GPtrArray *test_handled = NULL;
+static guint test_deferred = 0;
+static gboolean test_deny = FALSE;
+
+/**
+ * @brief Method handler which is deferred until GStreamer is ready.
+ */
+static gboolean
+_test_handle_deferred (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, const gchar *service_name, gpointer user_data)
+{
+  if (gdbus_defer_invocation (obj, invoc, ML_AGENT_DEP_GST)) {
+    test_deferred++;
+    return TRUE;
+  }
+
+  g_ptr_array_add (test_handled, g_strdup (service_name));
+  machinelearning_service_pipeline_complete_get_pipeline (obj, invoc, 0, service_name);
+  return TRUE;
+}
+
+/**
+ * @brief Authorize the method, deny the service 'b' if test_deny is set.
+ */
+static gboolean
+_test_authorize_method (GDBusInterfaceSkeleton *skeleton,
+    GDBusMethodInvocation *invoc, gpointer user_data)
+{
+  const gchar *name = NULL;
+
+  g_variant_get (g_dbus_method_invocation_get_parameters (invoc), "(&s)", &name);
+  if (test_deny && g_strcmp0 (name, "b") == 0) {
+    g_dbus_method_invocation_return_error (
+        (GDBusMethodInvocation *) g_object_ref (invoc), G_DBUS_ERROR,
+        G_DBUS_ERROR_ACCESS_DENIED, "The service '%s' is denied.", name);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Testcase for the deferred invocation - the queued invocations are authorized again and dispatched in order.
+ */
+TEST_F (GDbusTest, defer_invocation_order)
+{
+  const gchar *names[] = { "a", "b", "c" };
+  test_call_s calls[3] = {};
+  MachinelearningServicePipeline *instance;
+  GDBusConnection *client;
+  g_autoptr (GDBusConnection) conn = NULL;
+  gint result = -1;
+  gchar *desc = NULL;
+  gint64 end;
+  guint i, done;
+
+  test_handled = g_ptr_array_new_with_free_func (g_free);
+  test_deferred = 0;
+  test_deny = FALSE;
+
+  /* GStreamer is not initialized until it is started. */
+  ASSERT_EQ (ml_agent_initialize_async (TEST_DB_PATH, NULL, NULL), 0);
+  ASSERT_EQ (gdbus_get_system_connection (true), 0);
+
+  instance = machinelearning_service_pipeline_skeleton_new ();
+  g_signal_connect (instance, "handle-get-pipeline", G_CALLBACK (_test_handle_deferred), NULL);
+  g_signal_connect (instance, "g-authorize-method", G_CALLBACK (_test_authorize_method), NULL);
+  ASSERT_EQ (gdbus_export_interface (instance, TEST_MODULE_PATH), 0);
+
+  client = _test_get_client (dbus);
+  ASSERT_TRUE (client != nullptr);
+  conn = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, NULL);
+
+  for (i = 0; i < 3; i++) {
+    g_dbus_connection_call (client, g_dbus_connection_get_unique_name (conn),
+        TEST_MODULE_PATH, DBUS_PIPELINE_INTERFACE, "get_pipeline",
+        g_variant_new ("(s)", names[i]), NULL, G_DBUS_CALL_FLAGS_NONE, 5000,
+        NULL, _test_call_done, &calls[i]);
+  }
+
+  end = g_get_monotonic_time () + 5 * G_TIME_SPAN_SECOND;
+  while (test_deferred < 3 && g_get_monotonic_time () < end) {
+    if (!g_main_context_iteration (NULL, FALSE))
+      g_usleep (1000);
+  }
+
+  EXPECT_EQ (test_deferred, 3U);
+  EXPECT_EQ (test_handled->len, 0U);
+
+  /* The service 'b' is denied when the invocation is dispatched again. */
+  test_deny = TRUE;
+  ml_agent_start_dependency (ML_AGENT_DEP_GST);
+
+  end = g_get_monotonic_time () + 10 * G_TIME_SPAN_SECOND;
+  do {
+    if (!g_main_context_iteration (NULL, FALSE))
+      g_usleep (1000);
+
+    for (i = 0, done = 0; i < 3; i++)
+      done += calls[i].done ? 1 : 0;
+  } while (done < 3 && g_get_monotonic_time () < end);
+
+  ASSERT_EQ (done, 3U);
+
+  /* The authorized invocations are handled in arrival order. */
+  ASSERT_EQ (test_handled->len, 2U);
+  EXPECT_STREQ ((const gchar *) g_ptr_array_index (test_handled, 0), "a");
+  EXPECT_STREQ ((const gchar *) g_ptr_array_index (test_handled, 1), "c");
+
+  ASSERT_TRUE (calls[0].reply != nullptr);
+  g_variant_get (calls[0].reply, "(is)", &result, &desc);
+  EXPECT_EQ (result, 0);
+  EXPECT_STREQ (desc, "a");
+  g_free (desc);
+
+  EXPECT_TRUE (calls[1].reply == nullptr);
+  EXPECT_TRUE (g_error_matches (calls[1].error, G_DBUS_ERROR, G_DBUS_ERROR_ACCESS_DENIED));
+
+  ASSERT_TRUE (calls[2].reply != nullptr);
+  g_variant_get (calls[2].reply, "(is)", &result, &desc);
+  EXPECT_EQ (result, 0);
+  EXPECT_STREQ (desc, "c");
+  g_free (desc);
+
+  for (i = 0; i < 3; i++) {
+    if (calls[i].reply)
+      g_variant_unref (calls[i].reply);
+    g_clear_error (&calls[i].error);
+  }
+
+  g_object_unref (client);
+  g_dbus_interface_skeleton_unexport (G_DBUS_INTERFACE_SKELETON (instance));
+  g_object_unref (instance);
+  g_clear_object (&conn);
+  gdbus_put_system_connection ();
+  ml_agent_finalize ();
+  g_ptr_array_free (test_handled, TRUE);
+  test_handled = NULL;
+}
+
+/**
+ * @brief Testcase for the idle exit - the launch request delivered after starting to exit is rejected.
+ */
+TEST_F (GDbusTest, idle_exit_reject_launch)
+{
+  GDBusConnection *client;
+  GVariant *reply;
+  GError *error = NULL;
+  gint64 id = -1;
+  gint result = -1;
+  guint i;
+
+  ASSERT_EQ (ml_agent_initialize (TEST_DB_PATH), 0);
+  ASSERT_EQ (gdbus_get_system_connection (true), 0);
+  init_modules (NULL);
+
+  client = _test_get_client (dbus);
+  ASSERT_TRUE (client != nullptr);
+
+  reply = _test_call_method (client, DBUS_PIPELINE_PATH, "set_pipeline",
+      g_variant_new ("(ss)", "test-exit", "fakesrc ! fakesink"), &error);
+  ASSERT_TRUE (reply != nullptr) << (error ? error->message : "");
+  g_variant_unref (reply);
+
+  /* The launched pipeline inhibits the idle exit. */
+  reply = _test_call_method (client, DBUS_PIPELINE_PATH, "launch_pipeline",
+      g_variant_new ("(s)", "test-exit"), &error);
+  ASSERT_TRUE (reply != nullptr) << (error ? error->message : "");
+  g_variant_get (reply, "(ix)", &result, &id);
+  g_variant_unref (reply);
+  EXPECT_EQ (result, 0);
+  EXPECT_GT (id, 0);
+
+  EXPECT_LT (ml_agent_idle_try_exit (0), 0);
+  EXPECT_FALSE (ml_agent_is_exiting ());
+
+  reply = _test_call_method (client, DBUS_PIPELINE_PATH, "destroy_pipeline",
+      g_variant_new ("(x)", id), NULL);
+  if (reply)
+    g_variant_unref (reply);
+
+  for (i = 0; i < 100 && ml_agent_get_idle_time () < 0; i++)
+    g_usleep (10000);
+
+  /* The bus name is released, the launch request dispatched after this does not return the id of the pipeline killed on exit. */
+  EXPECT_GE (ml_agent_idle_try_exit (0), 0);
+  EXPECT_TRUE (ml_agent_is_exiting ());
+
+  reply = _test_call_method (client, DBUS_PIPELINE_PATH, "launch_pipeline",
+      g_variant_new ("(s)", "test-exit"), &error);
+  ASSERT_TRUE (reply != nullptr) << (error ? error->message : "");
+  g_variant_get (reply, "(ix)", &result, &id);
+  g_variant_unref (reply);
+  EXPECT_EQ (result, -EAGAIN);
+  EXPECT_LT (id, 0);
+
+  /* The other requests are still handled. */
+  reply = _test_call_method (client, DBUS_PIPELINE_PATH, "delete_pipeline",
+      g_variant_new ("(s)", "test-exit"), &error);
+  ASSERT_TRUE (reply != nullptr) << (error ? error->message : "");
+  g_variant_get (reply, "(i)", &result);
+  g_variant_unref (reply);
+  EXPECT_EQ (result, 0);
+
+  g_object_unref (client);
+  exit_modules (NULL);
+  gdbus_put_system_connection ();
+  ml_agent_finalize ();
+
+  EXPECT_FALSE (ml_agent_is_exiting ());
+}
+
 /**
  * @brief Main gtest
  */
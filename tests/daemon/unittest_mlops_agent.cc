@@ -8,7 +8,11 @@
  */
 
 #include <gtest/gtest.h>
+#include <errno.h>
 #include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <gst/gst.h>
+#include <json-glib/json-glib.h>
 
 #include "log.h"
 #include "mlops-agent-interface.h"
@@ -167,6 +171,207 @@ TEST_F (MLAgentTest, pipeline_launch_01_n)
   EXPECT_NE (ret, 0);
 }
 
+/**
+ * @brief The interval (in microseconds) to poll the pipeline in the daemon.
+ */
+#define ML_AGENT_TEST_POLL_INTERVAL (50000)
+
+/**
+ * @brief The timeout (in milliseconds) to wait for the pipeline in the daemon.
+ */
+#define ML_AGENT_TEST_POLL_TIMEOUT_MS (5000)
+
+/**
+ * @brief Internal function to wait until the pipeline reaches the expected state, or the timeout expires.
+ * @param expected The state to wait for, GST_STATE_VOID_PENDING to wait for any state after launching the pipeline.
+ * @return The result of getting the state of the pipeline.
+ */
+static gint
+_wait_pipeline_state (gint64 id, gint expected, guint timeout_ms, gint *state)
+{
+  gint64 deadline = g_get_monotonic_time () + (gint64) timeout_ms * G_TIME_SPAN_MILLISECOND;
+  gint ret;
+
+  while (TRUE) {
+    ret = ml_agent_pipeline_get_state (id, state);
+    if (ret != 0)
+      break;
+
+    if (expected == GST_STATE_VOID_PENDING) {
+      if (*state != GST_STATE_VOID_PENDING)
+        break;
+    } else if (*state == expected) {
+      break;
+    }
+
+    if (g_get_monotonic_time () >= deadline)
+      break;
+    g_usleep (ML_AGENT_TEST_POLL_INTERVAL);
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Internal function to get the number of the buffers the element of the pipeline received.
+ * @return The number of the buffers, -1 if the element is not found.
+ */
+static gint64
+_get_element_buffers (gint64 id, const gchar *name)
+{
+  g_autofree gchar *stats = NULL;
+  JsonNode *node;
+  JsonArray *elements;
+  gint64 buffers = -1;
+  guint i;
+
+  if (ml_agent_pipeline_get_statistics (id, &stats) != 0)
+    return -1;
+
+  node = json_from_string (stats, NULL);
+  if (!node)
+    return -1;
+
+  elements = json_object_get_array_member (json_node_get_object (node), "elements");
+  for (i = 0; elements && i < json_array_get_length (elements); i++) {
+    JsonObject *element = json_array_get_object_element (elements, i);
+
+    if (g_str_equal (json_object_get_string_member (element, "name"), name))
+      buffers = json_object_get_int_member (element, "buffers_in");
+  }
+
+  json_node_free (node);
+  return buffers;
+}
+
+/**
+ * @brief Internal function to wait until the element of the pipeline receives the buffer, or the timeout expires.
+ * @return The number of the buffers the element received, -1 if the element is not found.
+ */
+static gint64
+_wait_element_buffers (gint64 id, const gchar *name, guint timeout_ms)
+{
+  gint64 deadline = g_get_monotonic_time () + (gint64) timeout_ms * G_TIME_SPAN_MILLISECOND;
+  gint64 buffers;
+
+  while (TRUE) {
+    buffers = _get_element_buffers (id, name);
+    if (buffers > 0 || g_get_monotonic_time () >= deadline)
+      break;
+    g_usleep (ML_AGENT_TEST_POLL_INTERVAL);
+  }
+
+  return buffers;
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - launch the pipeline asynchronously.
+ */
+TEST_F (MLAgentTest, pipeline_launch_async)
+{
+  gint ret;
+  gint state;
+  gint64 id;
+
+  ret = ml_agent_pipeline_set_description ("test-async", "fakesrc ! fakesink");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_launch_async ("test-async", &id);
+  EXPECT_EQ (ret, 0);
+
+  ret = _wait_pipeline_state (id, GST_STATE_VOID_PENDING, ML_AGENT_TEST_POLL_TIMEOUT_MS, &state);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (state, GST_STATE_PAUSED);
+
+  ret = ml_agent_pipeline_start (id);
+  EXPECT_EQ (ret, 0);
+  ret = _wait_pipeline_state (id, GST_STATE_PLAYING, ML_AGENT_TEST_POLL_TIMEOUT_MS, &state);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  ret = ml_agent_pipeline_destroy (id);
+  EXPECT_EQ (ret, 0);
+
+  /* Destroy the pipeline while launching. */
+  ret = ml_agent_pipeline_launch_async ("test-async", &id);
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_pipeline_destroy (id);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_delete ("test-async");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - launch the pipeline asynchronously with invalid parameter.
+ */
+TEST_F (MLAgentTest, pipeline_launch_async_01_n)
+{
+  gint ret;
+  gint state;
+  gint64 id;
+
+  ret = ml_agent_pipeline_launch_async (NULL, &id);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_launch_async ("", &id);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_launch_async ("test-async", NULL);
+  EXPECT_NE (ret, 0);
+
+  /* no registered pipeline */
+  ret = ml_agent_pipeline_launch_async ("test-async", &id);
+  EXPECT_NE (ret, 0);
+
+  /* The node is released when the pipeline is failed to launch. */
+  ret = ml_agent_pipeline_set_description ("test-async", "invalid_element ! fakesink");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_launch_async ("test-async", &id);
+  EXPECT_EQ (ret, 0);
+
+  ret = _wait_pipeline_state (id, GST_STATE_VOID_PENDING, ML_AGENT_TEST_POLL_TIMEOUT_MS, &state);
+  EXPECT_NE (ret, 0);
+
+  ret = ml_agent_pipeline_delete ("test-async");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - the state of the pipeline is updated by the bus messages.
+ */
+TEST_F (MLAgentTest, pipeline_get_state_cached)
+{
+  gint ret;
+  gint state = GST_STATE_VOID_PENDING;
+  gint64 id;
+
+  ret = ml_agent_pipeline_set_description ("test-state", "videotestsrc ! fakesink");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_launch ("test-state", &id);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_start (id);
+  EXPECT_EQ (ret, 0);
+
+  ret = _wait_pipeline_state (id, GST_STATE_PLAYING, ML_AGENT_TEST_POLL_TIMEOUT_MS, &state);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  ret = ml_agent_pipeline_stop (id);
+  EXPECT_EQ (ret, 0);
+
+  ret = _wait_pipeline_state (id, GST_STATE_PAUSED, ML_AGENT_TEST_POLL_TIMEOUT_MS, &state);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (state, GST_STATE_PAUSED);
+
+  ret = ml_agent_pipeline_destroy (id);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_delete ("test-state");
+  EXPECT_EQ (ret, 0);
+}
+
 /**
  * @brief Testcase for ML-Agent interface - pipeline.
  */
@@ -589,6 +794,972 @@ TEST_F (MLAgentTest, resource_get_01_n)
   EXPECT_NE (ret, 0);
 }
 
+/**
+ * @brief Testcase for ML-Agent interface - timeout and deadline.
+ */
+TEST_F (MLAgentTest, timeout)
+{
+  const gchar pipeline_desc[] = "fakesrc ! fakesink";
+  gint ret;
+  gint state;
+  gint64 id;
+  guint64 misses = 0;
+
+  ret = ml_agent_set_timeout (10000);
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_set_call_timeout (5000);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_set_description ("test-pipeline", pipeline_desc);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_launch ("test-pipeline", &id);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_start (id);
+  EXPECT_EQ (ret, 0);
+  ret = _wait_pipeline_state (id, GST_STATE_PLAYING, ML_AGENT_TEST_POLL_TIMEOUT_MS, &state);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  ret = ml_agent_pipeline_stop (id);
+  EXPECT_EQ (ret, 0);
+  ret = _wait_pipeline_state (id, GST_STATE_PAUSED, ML_AGENT_TEST_POLL_TIMEOUT_MS, &state);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (state, GST_STATE_PAUSED);
+
+  ret = ml_agent_pipeline_destroy (id);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_delete ("test-pipeline");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_get_deadline_misses (&misses);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (misses, 0U);
+
+  ret = ml_agent_set_call_timeout (-1);
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_set_timeout (-1);
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Internal function to call the method of the pipeline interface with raw dbus message and get the result.
+ */
+static gint
+_call_pipeline_method (const gchar *method, GVariant *params, gint64 *id)
+{
+  g_autoptr (GDBusConnection) conn = NULL;
+  g_autoptr (GVariant) reply = NULL;
+  gint result = -EIO;
+
+  conn = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, NULL);
+  if (!conn)
+    return -EIO;
+
+  reply = g_dbus_connection_call_sync (conn, "org.tizen.machinelearning.service",
+      "/Org/Tizen/MachineLearning/Service/Pipeline",
+      "org.tizen.machinelearning.service.pipeline", method, params, NULL,
+      G_DBUS_CALL_FLAGS_NONE, -1, NULL, NULL);
+  if (!reply)
+    return -EIO;
+
+  if (id)
+    g_variant_get (reply, "(ix)", &result, id);
+  else
+    g_variant_get (reply, "(i)", &result);
+
+  return result;
+}
+
+/**
+ * @brief Internal function to call the method to profile the pipeline with raw dbus message and get the result.
+ */
+static gint
+_call_profile_method (const gchar *method, GVariant *params)
+{
+  g_autoptr (GDBusConnection) conn = NULL;
+  g_autoptr (GVariant) reply = NULL;
+  g_autofree gchar *report = NULL;
+  gint result = -EIO;
+
+  conn = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, NULL);
+  if (!conn)
+    return -EIO;
+
+  reply = g_dbus_connection_call_sync (conn, "org.tizen.machinelearning.service",
+      "/Org/Tizen/MachineLearning/Service/Pipeline",
+      "org.tizen.machinelearning.service.pipeline", method, params, NULL,
+      G_DBUS_CALL_FLAGS_NONE, -1, NULL, NULL);
+  if (!reply)
+    return -EIO;
+
+  g_variant_get (reply, "(is)", &result, &report);
+  return result;
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - the request with expired deadline is dropped and counted as deadline miss.
+ */
+TEST_F (MLAgentTest, timeout_expired_deadline_n)
+{
+  const gchar pipeline_desc[] = "fakesrc ! fakesink";
+  gint ret;
+  gint64 id = -1;
+  gint64 dropped = -1;
+  guint64 before = 0;
+  guint64 after = 0;
+
+  ret = ml_agent_pipeline_set_description ("test-pipeline", pipeline_desc);
+  EXPECT_EQ (ret, 0);
+
+  /* The original methods without the deadline still work. */
+  ret = _call_pipeline_method ("launch_pipeline",
+      g_variant_new ("(s)", "test-pipeline"), &id);
+  EXPECT_EQ (ret, 0);
+  EXPECT_GT (id, 0);
+
+  ret = ml_agent_get_deadline_misses (&before);
+  EXPECT_EQ (ret, 0);
+
+  /* The monotonic time 1 is always in the past. */
+  ret = _call_pipeline_method ("start_pipeline_with_deadline",
+      g_variant_new ("(xx)", id, (gint64) 1), NULL);
+  EXPECT_EQ (ret, -ETIMEDOUT);
+
+  ret = _call_pipeline_method ("launch_pipeline_with_deadline",
+      g_variant_new ("(sx)", "test-pipeline", (gint64) 1), &dropped);
+  EXPECT_EQ (ret, -ETIMEDOUT);
+  EXPECT_LT (dropped, 0);
+
+  /* The benchmark is not started after the deadline. */
+  ret = _call_profile_method ("profile_pipeline_with_deadline",
+      g_variant_new ("(susx)", "test-pipeline", 10U, "", (gint64) 1));
+  EXPECT_EQ (ret, -ETIMEDOUT);
+
+  ret = ml_agent_get_deadline_misses (&after);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (after, before + 3U);
+
+  ret = _call_pipeline_method ("start_pipeline", g_variant_new ("(x)", id), NULL);
+  EXPECT_EQ (ret, 0);
+
+  ret = _call_pipeline_method ("stop_pipeline", g_variant_new ("(x)", id), NULL);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_destroy (id);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_delete ("test-pipeline");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - timeout and deadline.
+ */
+TEST_F (MLAgentTest, timeout_01_n)
+{
+  gint ret;
+
+  ret = ml_agent_set_timeout (0);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_set_timeout (-2);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_set_call_timeout (0);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_set_call_timeout (-2);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_get_deadline_misses (NULL);
+  EXPECT_NE (ret, 0);
+}
+
+/**
+ * @brief Internal function to get the member of the service in the statistics of the pipeline pools.
+ */
+static gint64
+_get_pool_stats_member (const gchar *name, const gchar *member)
+{
+  g_autofree gchar *stats = NULL;
+  JsonNode *node;
+  JsonObject *object;
+  gint64 value = -1;
+
+  if (ml_agent_pipeline_get_pool_stats (&stats) != 0)
+    return -1;
+
+  node = json_from_string (stats, NULL);
+  if (!node)
+    return -1;
+
+  object = json_node_get_object (node);
+  if (object && json_object_has_member (object, name)) {
+    object = json_object_get_object_member (object, name);
+    value = json_object_get_int_member (object, member);
+  }
+
+  json_node_free (node);
+  return value;
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - pipeline attributes and prerolled pipeline pool.
+ */
+TEST_F (MLAgentTest, pipeline_pool)
+{
+  const gchar pipeline_desc[] = "fakesrc ! fakesink";
+  g_autofree gchar *attributes = NULL;
+  gint ret, retry;
+  gint64 id;
+
+  ret = ml_agent_pipeline_set_description ("test-pool", pipeline_desc);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_set_attributes ("test-pool", "{\"pool_size\":1}");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_get_attributes ("test-pool", &attributes);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (attributes, "{\"pool_size\":1}");
+
+  /* Wait for the pool to be filled in the background. */
+  for (retry = 0; retry < 50; retry++) {
+    if (_get_pool_stats_member ("test-pool", "ready") == 1)
+      break;
+    g_usleep (100000);
+  }
+  EXPECT_EQ (_get_pool_stats_member ("test-pool", "ready"), 1);
+
+  ret = ml_agent_pipeline_launch ("test-pool", &id);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (_get_pool_stats_member ("test-pool", "hits"), 1);
+
+  ret = ml_agent_pipeline_start (id);
+  EXPECT_EQ (ret, 0);
+  g_usleep (200000);
+
+  ret = ml_agent_pipeline_destroy (id);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_delete ("test-pool");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - pipeline attributes with invalid parameter.
+ */
+TEST_F (MLAgentTest, pipeline_attributes_01_n)
+{
+  gchar *attributes = NULL;
+  gint ret;
+
+  ret = ml_agent_pipeline_set_description ("test-attr", "fakesrc ! fakesink");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_set_attributes ("test-attr", "invalid json");
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_set_attributes ("test-attr", NULL);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_set_attributes (NULL, "{\"pool_size\":1}");
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_set_attributes ("test-unknown", "{\"pool_size\":1}");
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_get_attributes ("test-attr", NULL);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_get_attributes ("test-unknown", &attributes);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_get_pool_stats (NULL);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_get_share_stats (NULL);
+  EXPECT_NE (ret, 0);
+
+  ret = ml_agent_pipeline_delete ("test-attr");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - runtime statistics of the pipeline.
+ */
+TEST_F (MLAgentTest, pipeline_statistics)
+{
+  g_autofree gchar *stats = NULL;
+  JsonNode *node;
+  JsonObject *object;
+  JsonArray *elements;
+  gint ret;
+  gint64 id;
+  guint i;
+  gint64 sink_buffers = -1;
+
+  ret = ml_agent_pipeline_set_description ("test-stats",
+      "videotestsrc ! queue name=q ! fakesink name=sink");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_launch ("test-stats", &id);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_start (id);
+  EXPECT_EQ (ret, 0);
+  g_usleep (500000);
+
+  ret = ml_agent_pipeline_get_statistics (id, &stats);
+  EXPECT_EQ (ret, 0);
+
+  node = json_from_string (stats, NULL);
+  ASSERT_TRUE (node != NULL);
+  object = json_node_get_object (node);
+  ASSERT_TRUE (object != NULL);
+
+  EXPECT_EQ (json_object_get_int_member (object, "id"), id);
+  EXPECT_STREQ (json_object_get_string_member (object, "state"), "PLAYING");
+  EXPECT_GT (json_object_get_double_member (object, "buffers_per_sec"), 0.0);
+  EXPECT_TRUE (json_object_has_member (object, "state_time_ms"));
+
+  elements = json_object_get_array_member (object, "elements");
+  ASSERT_TRUE (elements != NULL);
+  for (i = 0; i < json_array_get_length (elements); i++) {
+    JsonObject *element = json_array_get_object_element (elements, i);
+    const gchar *name = json_object_get_string_member (element, "name");
+
+    if (g_str_equal (name, "sink"))
+      sink_buffers = json_object_get_int_member (element, "buffers_in");
+    else if (g_str_equal (name, "q"))
+      EXPECT_TRUE (json_object_has_member (element, "level_buffers"));
+  }
+  EXPECT_GT (sink_buffers, 0);
+
+  json_node_free (node);
+
+  ret = ml_agent_pipeline_destroy (id);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_delete ("test-stats");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - runtime statistics with invalid parameter.
+ */
+TEST_F (MLAgentTest, pipeline_statistics_01_n)
+{
+  gchar *stats = NULL;
+  gint ret;
+
+  ret = ml_agent_pipeline_get_statistics (-1, &stats);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_get_statistics (-1, NULL);
+  EXPECT_NE (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - restart information with invalid parameter.
+ */
+TEST_F (MLAgentTest, pipeline_restart_info_01_n)
+{
+  gchar *info = NULL;
+  gint ret;
+
+  ret = ml_agent_pipeline_get_restart_info (-1, &info);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_get_restart_info (-1, NULL);
+  EXPECT_NE (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - run the pipeline in the benchmark mode.
+ */
+TEST_F (MLAgentTest, pipeline_profile)
+{
+  g_autofree gchar *report = NULL;
+  JsonNode *node;
+  JsonObject *object, *latency;
+  gint ret;
+
+  ret = ml_agent_pipeline_set_description ("test-profile",
+      "videotestsrc ! queue ! filesink location=/dev/null");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_profile ("test-profile", 30, "{\"timeout_ms\": 5000}", &report);
+  EXPECT_EQ (ret, 0);
+
+  node = json_from_string (report, NULL);
+  ASSERT_TRUE (node != NULL);
+  object = json_node_get_object (node);
+  ASSERT_TRUE (object != NULL);
+
+  EXPECT_STREQ (json_object_get_string_member (object, "service_name"), "test-profile");
+  EXPECT_EQ (json_object_get_int_member (object, "buffers"), 30);
+  EXPECT_TRUE (json_object_get_boolean_member (object, "completed"));
+  EXPECT_GT (json_object_get_double_member (object, "buffers_per_sec"), 0.0);
+  EXPECT_TRUE (json_object_has_member (object, "cpu_time_ms"));
+  EXPECT_TRUE (json_object_has_member (object, "peak_rss_delta_kb"));
+  EXPECT_TRUE (json_object_has_member (object, "pipeline"));
+
+  latency = json_object_get_object_member (object, "latency_us");
+  ASSERT_TRUE (latency != NULL);
+  EXPECT_GT (json_object_get_int_member (latency, "count"), 0);
+  EXPECT_LE (json_object_get_int_member (latency, "p50"),
+      json_object_get_int_member (latency, "p99"));
+
+  json_node_free (node);
+
+  ret = ml_agent_pipeline_delete ("test-profile");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - the benchmark measures the CPU time and the memory of the pipeline.
+ */
+TEST_F (MLAgentTest, pipeline_profile_usage)
+{
+  g_autofree gchar *report = NULL;
+  JsonNode *node;
+  JsonObject *object;
+  gint ret;
+
+  /* The large frames allocate the memory, and the test pattern is drawn in the streaming thread. */
+  ret = ml_agent_pipeline_set_description ("test-profile-usage",
+      "videotestsrc pattern=snow ! video/x-raw,format=RGBA,width=1920,height=1080 ! queue ! fakesink");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_profile ("test-profile-usage", 20, "{\"timeout_ms\": 10000}", &report);
+  EXPECT_EQ (ret, 0);
+
+  node = json_from_string (report, NULL);
+  ASSERT_TRUE (node != NULL);
+  object = json_node_get_object (node);
+  ASSERT_TRUE (object != NULL);
+
+  EXPECT_GT (json_object_get_int_member (object, "cpu_time_ms"), 0);
+  EXPECT_GT (json_object_get_int_member (object, "peak_rss_delta_kb"), 0);
+  json_node_free (node);
+
+  ret = ml_agent_pipeline_delete ("test-profile-usage");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - benchmark mode with invalid parameter.
+ */
+TEST_F (MLAgentTest, pipeline_profile_01_n)
+{
+  gchar *report = NULL;
+  gint ret;
+
+  ret = ml_agent_pipeline_profile (NULL, 10, NULL, &report);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_profile ("test-profile-invalid", 0, NULL, &report);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_profile ("test-profile-invalid", 10, NULL, NULL);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_profile ("test-profile-invalid", 10, NULL, &report);
+  EXPECT_NE (ret, 0);
+
+  ret = ml_agent_pipeline_set_description ("test-profile-invalid", "fakesrc ! fakesink");
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_pipeline_profile ("test-profile-invalid", 10, "invalid options", &report);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_profile ("test-profile-invalid", 10, "{\"timeout_ms\": 100000}", &report);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_delete ("test-profile-invalid");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - launch, start, stop and destroy the pipelines in the batch.
+ */
+TEST_F (MLAgentTest, pipeline_batch)
+{
+  const char *names[] = { "test-batch-1", "test-batch-2", "test-batch-1" };
+  int64_t ids[3];
+  int results[3];
+  gint ret, state, i;
+
+  ret = ml_agent_pipeline_set_description ("test-batch-1", "videotestsrc ! queue ! fakesink");
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_pipeline_set_description ("test-batch-2", "fakesrc ! queue ! fakesink");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_launch_batch (names, 3, ids, results);
+  ASSERT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_start_batch (ids, 3, results);
+  EXPECT_EQ (ret, 0);
+  g_usleep (200000);
+
+  for (i = 0; i < 3; i++) {
+    EXPECT_EQ (results[i], 0);
+    ret = ml_agent_pipeline_get_state (ids[i], &state);
+    EXPECT_EQ (ret, 0);
+    EXPECT_EQ (state, GST_STATE_PLAYING);
+  }
+
+  ret = ml_agent_pipeline_stop_batch (ids, 3, results);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_destroy_batch (ids, 3, results);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_get_state (ids[0], &state);
+  EXPECT_NE (ret, 0);
+
+  ret = ml_agent_pipeline_delete ("test-batch-1");
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_pipeline_delete ("test-batch-2");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - batch with invalid parameter and the result of each pipeline.
+ */
+TEST_F (MLAgentTest, pipeline_batch_01_n)
+{
+  const char *names[] = { "test-batch-valid", "test-batch-invalid" };
+  const char *invalid_names[] = { "test-batch-valid", NULL };
+  int64_t ids[2];
+  int results[2];
+  gint ret;
+
+  ret = ml_agent_pipeline_launch_batch (NULL, 2, ids, results);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_launch_batch (names, 0, ids, results);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_launch_batch (names, 2, NULL, results);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_launch_batch (invalid_names, 2, ids, results);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_start_batch (NULL, 2, results);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_stop_batch (ids, 0, results);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_destroy_batch (ids, 2, NULL);
+  EXPECT_NE (ret, 0);
+
+  /* The valid pipeline is launched, and the failed one has its own result. */
+  ret = ml_agent_pipeline_set_description ("test-batch-valid", "fakesrc ! fakesink");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_launch_batch (names, 2, ids, results);
+  EXPECT_NE (ret, 0);
+  EXPECT_EQ (results[0], 0);
+  EXPECT_NE (results[1], 0);
+  EXPECT_GT (ids[0], 0);
+  EXPECT_EQ (ids[1], -1);
+
+  ret = ml_agent_pipeline_destroy_batch (ids, 2, results);
+  EXPECT_NE (ret, 0);
+  EXPECT_EQ (results[0], 0);
+  EXPECT_NE (results[1], 0);
+
+  ret = ml_agent_pipeline_delete ("test-batch-valid");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - launch the pipeline template with the parameters.
+ */
+TEST_F (MLAgentTest, pipeline_template)
+{
+  const char *keys[] = { "pattern", "sink" };
+  const char *values[] = { "1", "out" };
+  int64_t id;
+  gint ret, state;
+
+  ret = ml_agent_pipeline_set_description ("test-template",
+      "videotestsrc pattern=${pattern:-0} ! queue ! fakesink name=${sink}");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_launch_with_params ("test-template", keys, values, 2, &id);
+  ASSERT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_start (id);
+  EXPECT_EQ (ret, 0);
+  g_usleep (200000);
+
+  ret = ml_agent_pipeline_get_state (id, &state);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  ret = ml_agent_pipeline_destroy (id);
+  EXPECT_EQ (ret, 0);
+
+  /* The parameter 'sink' does not have the default value. */
+  ret = ml_agent_pipeline_launch ("test-template", &id);
+  EXPECT_NE (ret, 0);
+
+  ret = ml_agent_pipeline_delete ("test-template");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - the template with invalid placeholder and parameters.
+ */
+TEST_F (MLAgentTest, pipeline_template_01_n)
+{
+  const char *keys[] = { "sink" };
+  const char *values[] = { "out ! filesink" };
+  int64_t id;
+  gint ret;
+
+  /* The text which is not a valid placeholder is kept as it is. */
+  ret = ml_agent_pipeline_set_description ("test-template-invalid", "videotestsrc ! fakesink name=${sink");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_launch_with_params (NULL, keys, values, 1, &id);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_launch_with_params ("test-template-invalid", NULL, values, 1, &id);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_launch_with_params ("test-template-invalid", keys, values, 1, NULL);
+  EXPECT_NE (ret, 0);
+
+  ret = ml_agent_pipeline_set_description ("test-template-invalid", "videotestsrc ! fakesink name=${sink}");
+  EXPECT_EQ (ret, 0);
+
+  /* The value changes the structure of the pipeline. */
+  ret = ml_agent_pipeline_launch_with_params ("test-template-invalid", keys, values, 1, &id);
+  EXPECT_NE (ret, 0);
+
+  ret = ml_agent_pipeline_delete ("test-template-invalid");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - the composite service chaining the stored pipelines.
+ */
+TEST_F (MLAgentTest, composite)
+{
+  const gchar *definition = "{\"pipelines\":[\"test-composite-src\",\"test-composite-sink\"],"
+                            "\"links\":[{\"from\":\"test-composite-src\",\"to\":\"test-composite-sink\"}]}";
+  g_autofree gchar *value = NULL;
+  g_autofree gchar *stats = NULL;
+  JsonNode *node;
+  gint ret;
+  int64_t id;
+
+  ret = ml_agent_pipeline_set_description ("test-composite-src", "videotestsrc ! fakesink");
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_pipeline_set_description ("test-composite-sink", "videotestsrc ! queue ! fakesink name=sink");
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_composite_set ("test-composite", definition);
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_composite_get ("test-composite", &value);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (value, definition);
+
+  ret = ml_agent_composite_launch ("test-composite", &id);
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_pipeline_start (id);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_pipeline_get_statistics (id, &stats);
+  EXPECT_EQ (ret, 0);
+
+  node = json_from_string (stats, NULL);
+  ASSERT_TRUE (node != NULL);
+  EXPECT_STREQ (json_object_get_string_member (json_node_get_object (node), "type"), "composite");
+  json_node_free (node);
+
+  /* The buffers from the upstream reach the sink of the downstream in one node. */
+  EXPECT_GT (_wait_element_buffers (id, "sink", ML_AGENT_TEST_POLL_TIMEOUT_MS), 0);
+
+  ret = ml_agent_pipeline_destroy (id);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_composite_delete ("test-composite");
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_pipeline_delete ("test-composite-src");
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_pipeline_delete ("test-composite-sink");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - the composite service with invalid definition.
+ */
+TEST_F (MLAgentTest, composite_01_n)
+{
+  g_autofree gchar *value = NULL;
+  int64_t id;
+  gint ret;
+
+  ret = ml_agent_composite_set (NULL, "{\"pipelines\":[\"a\"]}");
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_composite_set ("test-composite-invalid", NULL);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_composite_set ("test-composite-invalid",
+      "{\"pipelines\":[\"a\",\"b\"],\"links\":[{\"from\":\"a\",\"to\":\"b\"},{\"from\":\"b\",\"to\":\"a\"}]}");
+  EXPECT_NE (ret, 0);
+
+  ret = ml_agent_composite_get ("test-composite-invalid", &value);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_composite_get ("test-composite-invalid", NULL);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_composite_delete ("test-composite-invalid");
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_composite_launch ("test-composite-invalid", &id);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_composite_launch ("test-composite-invalid", NULL);
+  EXPECT_NE (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - histogram of the main loop dispatch lag.
+ */
+TEST_F (MLAgentTest, lag_histogram)
+{
+  JsonNode *node = NULL;
+  JsonObject *object = NULL;
+  gint64 count = 0;
+  guint retry = 0;
+  gint ret;
+
+  /* The lag is recorded by the periodic timer, which is started by the method call. */
+  do {
+    g_autofree gchar *histogram = NULL;
+
+    if (node) {
+      json_node_free (node);
+      g_usleep (100000);
+    }
+
+    ret = ml_agent_get_lag_histogram (&histogram);
+    EXPECT_EQ (ret, 0);
+    ASSERT_TRUE (histogram != NULL);
+
+    node = json_from_string (histogram, NULL);
+    ASSERT_TRUE (node != NULL);
+
+    object = json_node_get_object (node);
+    ASSERT_TRUE (object != NULL);
+    count = json_object_get_int_member (object, "count");
+  } while (count < 1 && ++retry < 30);
+
+  EXPECT_GE (count, 1);
+  EXPECT_TRUE (json_object_has_member (object, "stalls"));
+  EXPECT_TRUE (json_object_has_member (object, "max_ms"));
+  EXPECT_GT (json_array_get_length (json_object_get_array_member (object, "buckets")), 0U);
+
+  json_node_free (node);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - histogram of the main loop dispatch lag with invalid parameter.
+ */
+TEST_F (MLAgentTest, lag_histogram_01_n)
+{
+  gint ret;
+
+  ret = ml_agent_get_lag_histogram (NULL);
+  EXPECT_NE (ret, 0);
+}
+
+/**
+ * @brief The budget (in milliseconds) of the first request which activates the daemon.
+ */
+#define ML_AGENT_TEST_ACTIVATION_BUDGET_MS (3000)
+
+/**
+ * @brief The budget (in milliseconds) of the request to the running daemon.
+ */
+#define ML_AGENT_TEST_REQUEST_BUDGET_MS (500)
+
+/**
+ * @brief Internal function to measure the latency (in milliseconds) of the request to get the description.
+ */
+static gint64
+_measure_request_latency (void)
+{
+  g_autofree gchar *desc = NULL;
+  gint64 start;
+  gint ret;
+
+  start = g_get_monotonic_time ();
+
+  /* The first request after the activation waits for the database to be ready. */
+  ret = ml_agent_pipeline_get_description ("test-activation", &desc);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (desc, "fakesrc ! fakesink");
+
+  return (g_get_monotonic_time () - start) / 1000;
+}
+
+/**
+ * @brief Internal function to check the daemon owns the bus name.
+ */
+static gboolean
+_is_daemon_running (void)
+{
+  g_autoptr (GDBusConnection) conn = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, NULL);
+  GVariant *reply;
+  gboolean has_owner = FALSE;
+
+  if (!conn)
+    return FALSE;
+
+  reply = g_dbus_connection_call_sync (conn, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+      "org.freedesktop.DBus", "NameHasOwner", g_variant_new ("(s)", "org.tizen.machinelearning.service"),
+      G_VARIANT_TYPE ("(b)"), G_DBUS_CALL_FLAGS_NONE, -1, NULL, NULL);
+  if (reply) {
+    g_variant_get (reply, "(b)", &has_owner);
+    g_variant_unref (reply);
+  }
+
+  return has_owner;
+}
+
+/**
+ * @brief Internal function to get the unique name of the daemon owning the bus name.
+ */
+static gchar *
+_get_daemon_owner (void)
+{
+  g_autoptr (GDBusConnection) conn = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, NULL);
+  GVariant *reply;
+  gchar *owner = NULL;
+
+  if (!conn)
+    return NULL;
+
+  reply = g_dbus_connection_call_sync (conn, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+      "org.freedesktop.DBus", "GetNameOwner", g_variant_new ("(s)", "org.tizen.machinelearning.service"),
+      G_VARIANT_TYPE ("(s)"), G_DBUS_CALL_FLAGS_NONE, -1, NULL, NULL);
+  if (reply) {
+    g_variant_get (reply, "(s)", &owner);
+    g_variant_unref (reply);
+  }
+
+  return owner;
+}
+
+/**
+ * @brief Internal function to launch the pipeline in the daemon with given unique name, which may have released the bus name.
+ * @return The result of the call, -EIO if the daemon does not reply.
+ */
+static gint
+_launch_at_owner (const gchar *owner, const gchar *name, gint64 *id)
+{
+  g_autoptr (GDBusConnection) conn = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, NULL);
+  GVariant *reply;
+  gint result = -EIO;
+
+  *id = -1;
+  if (!conn)
+    return -EIO;
+
+  reply = g_dbus_connection_call_sync (conn, owner, "/Org/Tizen/MachineLearning/Service/Pipeline",
+      "org.tizen.machinelearning.service.pipeline", "launch_pipeline", g_variant_new ("(s)", name),
+      G_VARIANT_TYPE ("(ix)"), G_DBUS_CALL_FLAGS_NONE, -1, NULL, NULL);
+  if (reply) {
+    g_variant_get (reply, "(ix)", &result, id);
+    g_variant_unref (reply);
+  }
+
+  return result;
+}
+
+/**
+ * @brief Testcase for ML-Agent - latency of the request which activates the daemon, and the request to the running daemon.
+ */
+TEST_F (MLAgentTest, activation_latency)
+{
+  gint64 cold, warm;
+  gint ret;
+
+  /* Activate the daemon and register the pipeline. */
+  ret = ml_agent_pipeline_set_description ("test-activation", "fakesrc ! fakesink");
+  ASSERT_EQ (ret, 0);
+
+  /* Restart the bus, the daemon is terminated and the next request activates it again with the existing database. */
+  g_test_dbus_down (dbus);
+  g_test_dbus_up (dbus);
+  EXPECT_FALSE (_is_daemon_running ());
+  cold = _measure_request_latency ();
+
+  /* The daemon is running, the request is handled without the activation. */
+  EXPECT_TRUE (_is_daemon_running ());
+  warm = _measure_request_latency ();
+
+  ml_logi ("Request latency: activation %" G_GINT64_FORMAT " ms, running %" G_GINT64_FORMAT " ms",
+      cold, warm);
+  EXPECT_LT (cold, ML_AGENT_TEST_ACTIVATION_BUDGET_MS);
+  EXPECT_LT (warm, ML_AGENT_TEST_REQUEST_BUDGET_MS);
+
+  ret = ml_agent_pipeline_delete ("test-activation");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent - the idle daemon exits and the next request activates it again.
+ */
+TEST_F (MLAgentTest, idle_exit)
+{
+  g_autofree gchar *current_dir = g_get_current_dir ();
+  g_autofree gchar *services_dir = g_dir_make_tmp ("ml-agent-idle-XXXXXX", NULL);
+  g_autofree gchar *service_file = NULL;
+  g_autofree gchar *service = NULL;
+  g_autofree gchar *desc = NULL;
+  g_autofree gchar *owner = NULL;
+  gint64 id;
+  guint i;
+  gint ret;
+
+  ASSERT_TRUE (services_dir != NULL);
+
+  /* The daemon exits after 1 second of inactivity. */
+  service = g_strdup_printf ("[D-BUS Service]\nName=org.tizen.machinelearning.service\n"
+                             "Exec=%s/tests/mlops-agent-test --session --path=. --idle-timeout=1\n",
+      current_dir);
+  service_file = g_build_filename (services_dir, "org.tizen.machinelearning.service.service", NULL);
+  ASSERT_TRUE (g_file_set_contents (service_file, service, -1, NULL));
+
+  g_test_dbus_down (dbus);
+  g_object_unref (dbus);
+  dbus = g_test_dbus_new (G_TEST_DBUS_NONE);
+  ASSERT_TRUE (dbus != nullptr);
+  g_test_dbus_add_service_dir (dbus, services_dir);
+  g_test_dbus_up (dbus);
+
+  ret = ml_agent_pipeline_set_description ("test-idle", "fakesrc ! fakesink");
+  ASSERT_EQ (ret, 0);
+  EXPECT_TRUE (_is_daemon_running ());
+
+  /* The pipeline inhibits the idle exit. */
+  ret = ml_agent_pipeline_launch ("test-idle", &id);
+  ASSERT_EQ (ret, 0);
+
+  g_usleep (2500000);
+  EXPECT_TRUE (_is_daemon_running ());
+
+  owner = _get_daemon_owner ();
+  ASSERT_TRUE (owner != NULL);
+
+  ret = ml_agent_pipeline_destroy (id);
+  EXPECT_EQ (ret, 0);
+
+  /* Wait for the daemon to release the bus name and exit. */
+  for (i = 0; i < 100 && _is_daemon_running (); i++)
+    g_usleep (50000);
+  EXPECT_FALSE (_is_daemon_running ());
+
+  /* The daemon releasing the bus name does not launch the pipeline, which would be killed on exit. */
+  ret = _launch_at_owner (owner, "test-idle", &id);
+  EXPECT_TRUE (ret == -EAGAIN || ret == -EIO);
+  EXPECT_LT (id, 0);
+
+  /* The next request activates the daemon again with the existing database. */
+  ret = ml_agent_pipeline_get_description ("test-idle", &desc);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (desc, "fakesrc ! fakesink");
+  EXPECT_TRUE (_is_daemon_running ());
+
+  ret = ml_agent_pipeline_delete ("test-idle");
+  EXPECT_EQ (ret, 0);
+
+  g_remove (service_file);
+  g_rmdir (services_dir);
+}
+
 /**
  * @brief Main gtest
  */
@@ -0,0 +1,2514 @@
+/**
+ * @file        unittest_mlops_node.cc
+ * @date        18 Oct 2026
+ * @brief       Unit test for the node registry of ML Agent
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      Jaeyun Jung <jy1210.jung@samsung.com>
+ * @bug         No known bugs
+ */
+
+#include <gtest/gtest.h>
+#include <errno.h>
+#include <glib.h>
+#include <gst/gst.h>
+#include <json-glib/json-glib.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "log.h"
+#include "mlops-agent-node.h"
+#include "mlops-agent-node-admission.h"
+#include "mlops-agent-node-composite.h"
+#include "mlops-agent-node-config.h"
+#include "mlops-agent-node-sched.h"
+#include "mlops-agent-node-share.h"
+#include "mlops-agent-node-source.h"
+#include "mlops-agent-node-stats.h"
+#include "mlops-agent-node-taskpool.h"
+#include "mlops-agent-node-template.h"
+#include "service-db-util.h"
+
+#define TEST_DB_PATH "."
+
+/**
+ * @brief The number of the threads and nodes for the benchmark.
+ */
+#define TEST_NUM_THREADS (8)
+#define TEST_NUM_NODES (16)
+#define TEST_NUM_ITERATIONS (200)
+
+/**
+ * @brief The number of the lightweight pipelines and the rounds for the benchmark of the shared task pool.
+ */
+#define TEST_NUM_LIGHT_PIPELINES (24)
+#define TEST_NUM_ROUNDS (3)
+#define TEST_BENCHMARK_WINDOW_US (1000000)
+
+/**
+ * @brief The number of the pipelines launched over the bound of the shared task pool.
+ */
+#define TEST_NUM_BOUND_PIPELINES (6)
+
+/**
+ * @brief The number of the pipelines for the benchmark of the batch.
+ */
+#define TEST_NUM_BATCH (10)
+
+/**
+ * @brief The number of the buffers for the benchmark of the pad probes.
+ */
+#define TEST_NUM_PROBE_BUFFERS (100000)
+
+/**
+ * @brief Test base class for the node registry.
+ */
+class MLOpsNodeTest : public ::testing::Test
+{
+  public:
+  /**
+   * @brief Setup method for each test case.
+   */
+  void SetUp () override
+  {
+    ASSERT_TRUE (gst_init_check (NULL, NULL, NULL));
+    ASSERT_EQ (svcdb_initialize (TEST_DB_PATH), 0);
+    ASSERT_EQ (mlops_node_initialize (), 0);
+    ASSERT_EQ (svcdb_pipeline_set ("test-node", "fakesrc ! fakesink"), 0);
+  }
+
+  /**
+   * @brief Teardown method for each test case.
+   */
+  void TearDown () override
+  {
+    mlops_node_finalize ();
+    svcdb_pipeline_delete ("test-node");
+    svcdb_finalize ();
+  }
+};
+
+/**
+ * @brief Internal function to wait until the pipeline with given id is in the state.
+ * @return TRUE if the pipeline is in the state before the timeout.
+ */
+static gboolean
+_test_wait_state (gint64 id, GstState expected, guint timeout_ms)
+{
+  gint64 end = g_get_monotonic_time () + (gint64) timeout_ms * 1000;
+  GstState state = GST_STATE_VOID_PENDING;
+
+  while (mlops_node_get_state (id, &state) == 0 && state != expected) {
+    if (g_get_monotonic_time () >= end)
+      return FALSE;
+    g_usleep (1000);
+  }
+
+  return (state == expected);
+}
+
+/**
+ * @brief Data for the threads of the benchmark.
+ */
+typedef struct
+{
+  gint64 *ids;
+  guint index;
+  gint failures;
+} test_node_thread_s;
+
+/**
+ * @brief Thread to change and get the state of the nodes.
+ */
+static gpointer
+_test_node_thread (gpointer data)
+{
+  test_node_thread_s *t = (test_node_thread_s *) data;
+  GstState state;
+  guint i;
+
+  for (i = 0; i < TEST_NUM_ITERATIONS; i++) {
+    gint64 id = t->ids[(t->index + i) % TEST_NUM_NODES];
+
+    if (mlops_node_start (id) != 0)
+      t->failures++;
+    if (mlops_node_get_state (id, &state) != 0)
+      t->failures++;
+    if (mlops_node_stop (id) != 0)
+      t->failures++;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Thread to launch the nodes.
+ */
+static gpointer
+_test_node_create_thread (gpointer data)
+{
+  test_node_thread_s *t = (test_node_thread_s *) data;
+
+  if (mlops_node_create ("test-node", MLOPS_NODE_TYPE_PIPELINE, &t->ids[t->index]) != 0)
+    t->failures++;
+
+  return NULL;
+}
+
+/**
+ * @brief Testcase for the node registry - the ids of the nodes launched in parallel are unique.
+ */
+TEST_F (MLOpsNodeTest, create_parallel)
+{
+  gint64 ids[TEST_NUM_NODES] = { 0 };
+  test_node_thread_s data[TEST_NUM_NODES];
+  GThread *threads[TEST_NUM_NODES];
+  guint i, j;
+
+  for (i = 0; i < TEST_NUM_NODES; i++) {
+    data[i].ids = ids;
+    data[i].index = i;
+    data[i].failures = 0;
+    threads[i] = g_thread_new ("test-create", _test_node_create_thread, &data[i]);
+  }
+
+  for (i = 0; i < TEST_NUM_NODES; i++) {
+    g_thread_join (threads[i]);
+    EXPECT_EQ (data[i].failures, 0);
+  }
+
+  for (i = 0; i < TEST_NUM_NODES; i++) {
+    EXPECT_GT (ids[i], 0);
+    for (j = i + 1; j < TEST_NUM_NODES; j++)
+      EXPECT_NE (ids[i], ids[j]);
+
+    EXPECT_EQ (mlops_node_destroy (ids[i]), 0);
+  }
+}
+
+/**
+ * @brief Testcase for the node registry - benchmark of start/stop/get_state from multiple threads.
+ */
+TEST_F (MLOpsNodeTest, benchmark_parallel)
+{
+  gint64 ids[TEST_NUM_NODES];
+  test_node_thread_s data[TEST_NUM_THREADS];
+  GThread *threads[TEST_NUM_THREADS];
+  gint64 start, elapsed;
+  guint i;
+
+  for (i = 0; i < TEST_NUM_NODES; i++)
+    ASSERT_EQ (mlops_node_create ("test-node", MLOPS_NODE_TYPE_PIPELINE, &ids[i]), 0);
+
+  start = g_get_monotonic_time ();
+
+  for (i = 0; i < TEST_NUM_THREADS; i++) {
+    data[i].ids = ids;
+    data[i].index = i;
+    data[i].failures = 0;
+    threads[i] = g_thread_new ("test-bench", _test_node_thread, &data[i]);
+  }
+
+  for (i = 0; i < TEST_NUM_THREADS; i++) {
+    g_thread_join (threads[i]);
+    EXPECT_EQ (data[i].failures, 0);
+  }
+
+  elapsed = MAX (g_get_monotonic_time () - start, 1);
+  ml_logi ("%d threads, %d operations on %d nodes: %" G_GINT64_FORMAT " us, %.0f ops/sec",
+      TEST_NUM_THREADS, TEST_NUM_THREADS * TEST_NUM_ITERATIONS * 3, TEST_NUM_NODES, elapsed,
+      (gdouble) TEST_NUM_THREADS * TEST_NUM_ITERATIONS * 3 * G_USEC_PER_SEC / elapsed);
+
+  for (i = 0; i < TEST_NUM_NODES; i++)
+    EXPECT_EQ (mlops_node_destroy (ids[i]), 0);
+}
+
+/**
+ * @brief Testcase for the node registry - destroy the node while the other threads are using it.
+ */
+TEST_F (MLOpsNodeTest, destroy_while_running)
+{
+  gint64 ids[TEST_NUM_NODES];
+  test_node_thread_s data[TEST_NUM_THREADS];
+  GThread *threads[TEST_NUM_THREADS];
+  GstState state;
+  guint i;
+
+  for (i = 0; i < TEST_NUM_NODES; i++)
+    ASSERT_EQ (mlops_node_create ("test-node", MLOPS_NODE_TYPE_PIPELINE, &ids[i]), 0);
+
+  for (i = 0; i < TEST_NUM_THREADS; i++) {
+    data[i].ids = ids;
+    data[i].index = i;
+    data[i].failures = 0;
+    threads[i] = g_thread_new ("test-destroy", _test_node_thread, &data[i]);
+  }
+
+  /* The operations on the destroyed node fail, but the node is not released in the middle. */
+  for (i = 0; i < TEST_NUM_NODES; i++)
+    EXPECT_EQ (mlops_node_destroy (ids[i]), 0);
+
+  for (i = 0; i < TEST_NUM_THREADS; i++)
+    g_thread_join (threads[i]);
+
+  for (i = 0; i < TEST_NUM_NODES; i++) {
+    EXPECT_NE (mlops_node_destroy (ids[i]), 0);
+    EXPECT_NE (mlops_node_get_state (ids[i], &state), 0);
+  }
+}
+
+/**
+ * @brief Internal function to get the member of the statistics of the shared task pool.
+ */
+static gint64
+_test_get_task_pool_stat (const gchar *name)
+{
+  g_autofree gchar *stats = NULL;
+  JsonNode *node;
+  gint64 value;
+
+  if (mlops_node_task_pool_get_stats (&stats) != 0)
+    return -1;
+
+  node = json_from_string (stats, NULL);
+  if (!node)
+    return -1;
+
+  value = json_object_get_int_member (json_node_get_object (node), name);
+  json_node_free (node);
+  return value;
+}
+
+/**
+ * @brief Internal function to get the number of the context switches of the process.
+ */
+static gint64
+_test_get_context_switches (void)
+{
+  struct rusage usage;
+
+  if (getrusage (RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+  return (gint64) usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+/**
+ * @brief Testcase for the shared task pool - the streaming threads are reused by the pipelines launched again.
+ */
+TEST_F (MLOpsNodeTest, task_pool_reuse)
+{
+  gint64 id;
+  gint64 tasks, threads;
+  guint i;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-task-pool", "videotestsrc ! queue ! fakesink"), 0);
+
+  tasks = MAX (_test_get_task_pool_stat ("tasks"), 0);
+  threads = MAX (_test_get_task_pool_stat ("threads"), 0);
+
+  for (i = 0; i < TEST_NUM_ROUNDS; i++) {
+    ASSERT_EQ (mlops_node_create ("test-task-pool", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+    EXPECT_EQ (mlops_node_start (id), 0);
+    EXPECT_TRUE (_test_wait_state (id, GST_STATE_PLAYING, 3000));
+    EXPECT_EQ (mlops_node_destroy (id), 0);
+  }
+
+  tasks = _test_get_task_pool_stat ("tasks") - tasks;
+  threads = _test_get_task_pool_stat ("threads") - threads;
+
+  /* The source and the queue run 2 tasks in each round. */
+  EXPECT_GE (tasks, TEST_NUM_ROUNDS * 2);
+  EXPECT_LT (threads, tasks);
+  EXPECT_GT (_test_get_task_pool_stat ("bound"), 0);
+
+  svcdb_pipeline_delete ("test-task-pool");
+}
+
+/**
+ * @brief Internal function to count the buffers entered the sink.
+ */
+static void
+_test_handoff_cb (GstElement *sink, GstBuffer *buffer, GstPad *pad, gpointer user_data)
+{
+  g_atomic_int_inc ((gint *) user_data);
+}
+
+/**
+ * @brief Internal function to set the shared task pool to the streaming tasks of the pipeline.
+ */
+static GstBusSyncReply
+_test_task_pool_sync_handler (GstBus *bus, GstMessage *msg, gpointer user_data)
+{
+  mlops_node_task_pool_handle_message (msg);
+  return GST_BUS_PASS;
+}
+
+/**
+ * @brief Internal function to run many lightweight pipelines for a second, with or without the shared task pool.
+ * @return The number of the buffers entered the sinks.
+ */
+static gint
+_test_run_light_pipelines (gboolean pool, gint64 *switches)
+{
+  GstElement *pipelines[TEST_NUM_LIGHT_PIPELINES];
+  gint buffers = 0;
+  guint i;
+
+  for (i = 0; i < TEST_NUM_LIGHT_PIPELINES; i++) {
+    GstElement *sink;
+
+    pipelines[i] = gst_parse_launch ("videotestsrc ! video/x-raw,width=32,height=32 ! queue ! "
+                                     "fakesink name=sink signal-handoffs=true", NULL);
+    if (!pipelines[i])
+      return -1;
+
+    sink = gst_bin_get_by_name (GST_BIN (pipelines[i]), "sink");
+    g_signal_connect (sink, "handoff", G_CALLBACK (_test_handoff_cb), &buffers);
+    gst_object_unref (sink);
+
+    if (pool) {
+      GstBus *bus = gst_element_get_bus (pipelines[i]);
+
+      gst_bus_set_sync_handler (bus, _test_task_pool_sync_handler, NULL, NULL);
+      gst_object_unref (bus);
+    }
+  }
+
+  for (i = 0; i < TEST_NUM_LIGHT_PIPELINES; i++)
+    gst_element_set_state (pipelines[i], GST_STATE_PLAYING);
+
+  /* Measure after all pipelines are running, so the slow startup is not counted in the window. */
+  for (i = 0; i < TEST_NUM_LIGHT_PIPELINES; i++) {
+    if (gst_element_get_state (pipelines[i], NULL, NULL, 3 * GST_SECOND) != GST_STATE_CHANGE_SUCCESS)
+      ADD_FAILURE () << "Pipeline " << i << " is not running.";
+  }
+
+  *switches = _test_get_context_switches ();
+  g_atomic_int_set (&buffers, 0);
+
+  g_usleep (TEST_BENCHMARK_WINDOW_US);
+
+  for (i = 0; i < TEST_NUM_LIGHT_PIPELINES; i++) {
+    gst_element_set_state (pipelines[i], GST_STATE_NULL);
+    gst_object_unref (pipelines[i]);
+  }
+
+  *switches = _test_get_context_switches () - *switches;
+  return g_atomic_int_get (&buffers);
+}
+
+/**
+ * @brief Testcase for the shared task pool - benchmark of many concurrent lightweight pipelines, compared with the default task pool.
+ */
+TEST_F (MLOpsNodeTest, task_pool_benchmark)
+{
+  gint64 plain_switches = 0, pool_switches = 0;
+  gint64 queued;
+  gint plain, pooled;
+
+  plain = _test_run_light_pipelines (FALSE, &plain_switches);
+
+  /* The source and the queue run 2 tasks in each pipeline, all tasks run in the workers. */
+  mlops_node_task_pool_set_bound (TEST_NUM_LIGHT_PIPELINES * 2);
+
+  queued = _test_get_task_pool_stat ("queued");
+  pooled = _test_run_light_pipelines (TRUE, &pool_switches);
+  queued = _test_get_task_pool_stat ("queued") - queued;
+
+  ml_logi ("%d pipelines: default pool %d buffers, %" G_GINT64_FORMAT " context switches / shared pool %d buffers, %"
+           G_GINT64_FORMAT " context switches, peak %" G_GINT64_FORMAT " tasks on %" G_GINT64_FORMAT " workers",
+      TEST_NUM_LIGHT_PIPELINES, plain, plain_switches, pooled, pool_switches,
+      _test_get_task_pool_stat ("peak"), _test_get_task_pool_stat ("bound"));
+
+  EXPECT_GT (plain, 0);
+  EXPECT_GT (pooled, 0);
+  EXPECT_EQ (queued, 0);
+  EXPECT_GE (_test_get_task_pool_stat ("peak"), TEST_NUM_LIGHT_PIPELINES);
+  EXPECT_LE (_test_get_task_pool_stat ("peak"), TEST_NUM_LIGHT_PIPELINES * 2);
+
+  /* The shared pool does not slow down the pipelines. */
+  EXPECT_GT (pooled, plain / 2);
+
+  mlops_node_task_pool_set_bound (0U);
+}
+
+/**
+ * @brief Internal function to wait until the member of the statistics of the shared task pool has the value.
+ */
+static gboolean
+_test_wait_task_pool_stat (const gchar *name, gint64 expected, guint timeout_ms)
+{
+  gint64 end = g_get_monotonic_time () + (gint64) timeout_ms * 1000;
+
+  while (_test_get_task_pool_stat (name) != expected && g_get_monotonic_time () < end)
+    g_usleep (10000);
+
+  return (_test_get_task_pool_stat (name) == expected);
+}
+
+/**
+ * @brief Testcase for the shared task pool - the workers do not exceed the bound with many pipelines, and the waiting tasks are released.
+ */
+TEST_F (MLOpsNodeTest, task_pool_bound)
+{
+  const gint64 bound = 4;
+  gint64 ids[TEST_NUM_BOUND_PIPELINES];
+  gint64 queued, cancelled;
+  guint i;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-task-pool",
+                 "videotestsrc is-live=true ! queue ! fakesink async=false"), 0);
+  ASSERT_TRUE (_test_wait_task_pool_stat ("active", 0, 3000));
+
+  mlops_node_task_pool_set_bound ((guint) bound);
+  EXPECT_EQ (_test_get_task_pool_stat ("bound"), bound);
+
+  queued = _test_get_task_pool_stat ("queued");
+  cancelled = _test_get_task_pool_stat ("cancelled");
+
+  /* The live pipelines are playing, even if their tasks are waiting for the worker. */
+  for (i = 0; i < TEST_NUM_BOUND_PIPELINES; i++) {
+    ASSERT_EQ (mlops_node_create ("test-task-pool", MLOPS_NODE_TYPE_PIPELINE, &ids[i]), 0);
+    EXPECT_EQ (mlops_node_start (ids[i]), 0);
+    EXPECT_TRUE (_test_wait_state (ids[i], GST_STATE_PLAYING, 3000));
+  }
+
+  EXPECT_LE (_test_get_task_pool_stat ("active"), bound);
+  EXPECT_LE (_test_get_task_pool_stat ("peak"), bound);
+  EXPECT_GT (_test_get_task_pool_stat ("pending"), 0);
+  EXPECT_GE (_test_get_task_pool_stat ("queued") - queued, TEST_NUM_BOUND_PIPELINES * 2 - bound);
+
+  /* The tasks of the last pipelines are waiting, stopping the pipeline does not wait for the worker. */
+  for (i = TEST_NUM_BOUND_PIPELINES; i > 0; i--)
+    EXPECT_EQ (mlops_node_destroy (ids[i - 1]), 0);
+
+  EXPECT_TRUE (_test_wait_task_pool_stat ("pending", 0, 3000));
+  EXPECT_TRUE (_test_wait_task_pool_stat ("active", 0, 3000));
+  EXPECT_GT (_test_get_task_pool_stat ("cancelled") - cancelled, 0);
+  EXPECT_LE (_test_get_task_pool_stat ("peak"), bound);
+
+  mlops_node_task_pool_set_bound (0U);
+  svcdb_pipeline_delete ("test-task-pool");
+}
+
+/**
+ * @brief Internal function to post the stream-status message of the calling thread to the scheduling attributes.
+ */
+static void
+_test_sched_stream_status (const mlops_node_sched_s *sched, GstStreamStatusType type)
+{
+  GstElement *owner = gst_element_factory_make ("fakesrc", NULL);
+  GstMessage *msg;
+
+  msg = gst_message_new_stream_status (GST_OBJECT (owner), type, owner);
+  mlops_node_sched_handle_message (sched, msg);
+
+  gst_message_unref (msg);
+  gst_object_unref (owner);
+}
+
+/**
+ * @brief Structure for the result of the scheduling attributes applied in the thread.
+ */
+typedef struct {
+  const mlops_node_sched_s *sched;
+  cpu_set_t before;
+  cpu_set_t entered;
+  cpu_set_t left;
+  int nice_before;
+  int nice_entered;
+  int nice_left;
+} test_sched_result_s;
+
+/**
+ * @brief Internal function to enter and leave the task in the thread like the streaming thread.
+ */
+static gpointer
+_test_sched_thread (gpointer data)
+{
+  test_sched_result_s *result = (test_sched_result_s *) data;
+
+  sched_getaffinity (0, sizeof (cpu_set_t), &result->before);
+  result->nice_before = getpriority (PRIO_PROCESS, 0);
+
+  _test_sched_stream_status (result->sched, GST_STREAM_STATUS_TYPE_ENTER);
+  sched_getaffinity (0, sizeof (cpu_set_t), &result->entered);
+  result->nice_entered = getpriority (PRIO_PROCESS, 0);
+
+  _test_sched_stream_status (result->sched, GST_STREAM_STATUS_TYPE_LEAVE);
+  sched_getaffinity (0, sizeof (cpu_set_t), &result->left);
+  result->nice_left = getpriority (PRIO_PROCESS, 0);
+
+  return NULL;
+}
+
+/**
+ * @brief Testcase for the scheduling attributes - applied to the streaming thread and restored when leaving.
+ */
+TEST_F (MLOpsNodeTest, sched_apply)
+{
+  mlops_node_sched_s *sched;
+  test_sched_result_s result;
+  GThread *thread;
+
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-node", "{\"cpu_set\":\"0\",\"nice\":19}"), 0);
+
+  sched = mlops_node_sched_new ("test-node");
+  ASSERT_TRUE (sched != NULL);
+
+  /* Change the attributes of the other thread, not to leave them to the main thread of the test. */
+  memset (&result, 0, sizeof (result));
+  result.sched = sched;
+  thread = g_thread_new ("test-sched", _test_sched_thread, &result);
+  g_thread_join (thread);
+
+  EXPECT_EQ (CPU_COUNT (&result.entered), 1);
+  EXPECT_TRUE (CPU_ISSET (0, &result.entered));
+  EXPECT_TRUE (CPU_EQUAL (&result.before, &result.left));
+
+  /* The higher nice value is applied only if it can be lowered again, the thread never keeps it. */
+  EXPECT_TRUE (result.nice_entered == 19 || result.nice_entered == result.nice_before);
+  EXPECT_EQ (result.nice_left, result.nice_before);
+
+  mlops_node_sched_free (sched);
+  svcdb_pipeline_set_attributes ("test-node", "{\"cpu_set\":null,\"nice\":null}");
+}
+
+/**
+ * @brief Testcase for the scheduling attributes - the launched pipeline with the scheduling attributes.
+ */
+TEST_F (MLOpsNodeTest, sched_launch)
+{
+  GstState state;
+  gint64 id;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-sched", "videotestsrc ! queue ! fakesink"), 0);
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-sched", "{\"cpu_set\":\"0\"}"), 0);
+
+  ASSERT_EQ (mlops_node_create ("test-sched", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+  EXPECT_EQ (mlops_node_start (id), 0);
+  EXPECT_TRUE (_test_wait_state (id, GST_STATE_PLAYING, 3000));
+  EXPECT_EQ (mlops_node_get_state (id, &state), 0);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+
+  svcdb_pipeline_delete ("test-sched");
+}
+
+/**
+ * @brief Testcase for the scheduling attributes with invalid values.
+ */
+TEST_F (MLOpsNodeTest, sched_invalid_n)
+{
+  EXPECT_TRUE (mlops_node_sched_new ("test-node") == NULL);
+
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-node",
+                 "{\"cpu_set\":\"3-1\",\"nice\":100,\"sched_policy\":\"unknown\"}"),
+      0);
+  EXPECT_TRUE (mlops_node_sched_new ("test-node") == NULL);
+
+  svcdb_pipeline_set_attributes ("test-node",
+      "{\"cpu_set\":null,\"nice\":null,\"sched_policy\":null}");
+}
+
+/**
+ * @brief Data for the launch callback of the admission tests.
+ */
+typedef struct
+{
+  gint called;
+  gint result;
+} test_launch_result_s;
+
+/**
+ * @brief Callback to get the result of the launch.
+ */
+static void
+_test_launch_done (const int64_t id, const int result, void *user_data)
+{
+  test_launch_result_s *r = (test_launch_result_s *) user_data;
+
+  r->result = result;
+  r->called++;
+}
+
+/**
+ * @brief Internal function to set the budget of the admission control.
+ */
+static void
+_test_admission_configure (guint max_nodes, guint cpu_budget, guint app_max_nodes, guint timeout)
+{
+  mlops_node_admission_config_s config = { 0, 0, 0, 0, 0 };
+
+  config.max_nodes = max_nodes;
+  config.cpu_budget = cpu_budget;
+  config.app_max_nodes = app_max_nodes;
+  config.queue_timeout_ms = timeout;
+  mlops_node_admission_configure (&config);
+}
+
+/**
+ * @brief Internal function to iterate the main context until the callback is called.
+ */
+static void
+_test_wait_launch (test_launch_result_s *r, guint timeout_ms)
+{
+  gint64 end = g_get_monotonic_time () + (gint64) timeout_ms * 1000;
+
+  while (r->called == 0 && g_get_monotonic_time () < end) {
+    if (!g_main_context_iteration (NULL, FALSE))
+      g_usleep (1000);
+  }
+}
+
+/**
+ * @brief Testcase for the admission control - the launch over the maximum number of the nodes is rejected.
+ */
+TEST_F (MLOpsNodeTest, admission_max_nodes)
+{
+  gint64 id1, id2, id3;
+
+  _test_admission_configure (2, 0, 0, 0);
+
+  ASSERT_EQ (mlops_node_create ("test-node", MLOPS_NODE_TYPE_PIPELINE, &id1), 0);
+  ASSERT_EQ (mlops_node_create ("test-node", MLOPS_NODE_TYPE_PIPELINE, &id2), 0);
+  EXPECT_EQ (mlops_node_create ("test-node", MLOPS_NODE_TYPE_PIPELINE, &id3), -EBUSY);
+
+  /* The budget is released when the node is destroyed. */
+  EXPECT_EQ (mlops_node_destroy (id1), 0);
+  ASSERT_EQ (mlops_node_create ("test-node", MLOPS_NODE_TYPE_PIPELINE, &id3), 0);
+
+  EXPECT_EQ (mlops_node_destroy (id2), 0);
+  EXPECT_EQ (mlops_node_destroy (id3), 0);
+
+  _test_admission_configure (0, 0, 0, 0);
+}
+
+/**
+ * @brief Internal function to get the member of the pool statistics of the service.
+ */
+static gint64
+_test_get_pool_stat (const gchar *name, const gchar *member)
+{
+  gchar *stats = NULL;
+  JsonNode *root;
+  JsonObject *object;
+  gint64 value = -1;
+
+  if (mlops_node_pool_get_stats (&stats) != 0)
+    return -1;
+
+  root = json_from_string (stats, NULL);
+  object = root ? json_node_get_object (root) : NULL;
+  if (object && json_object_has_member (object, name)) {
+    object = json_object_get_object_member (object, name);
+    value = json_object_get_int_member (object, member);
+  }
+
+  if (root)
+    json_node_free (root);
+  g_free (stats);
+  return value;
+}
+
+/**
+ * @brief Testcase for the admission control - the prerolled pipeline is kept in the pool when the launch is rejected.
+ */
+TEST_F (MLOpsNodeTest, admission_pool_reject_n)
+{
+  gint64 id1, id2;
+  guint i;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-pool", "fakesrc ! fakesink"), 0);
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-pool", "{\"pool_size\":1}"), 0);
+  ASSERT_EQ (mlops_node_pool_update ("test-pool"), 0);
+
+  for (i = 0; i < 100 && _test_get_pool_stat ("test-pool", "ready") != 1; i++)
+    g_usleep (50000);
+  ASSERT_EQ (_test_get_pool_stat ("test-pool", "ready"), 1);
+
+  _test_admission_configure (1, 0, 0, 0);
+
+  /* The first launch takes the pipeline in the pool, wait for the refill. */
+  ASSERT_EQ (mlops_node_create ("test-pool", MLOPS_NODE_TYPE_PIPELINE, &id1), 0);
+  EXPECT_EQ (_test_get_pool_stat ("test-pool", "hits"), 1);
+  for (i = 0; i < 100 && _test_get_pool_stat ("test-pool", "ready") != 1; i++)
+    g_usleep (50000);
+  ASSERT_EQ (_test_get_pool_stat ("test-pool", "ready"), 1);
+
+  /* The rejected launch puts the pipeline back to the pool. */
+  EXPECT_EQ (mlops_node_create ("test-pool", MLOPS_NODE_TYPE_PIPELINE, &id2), -EBUSY);
+  EXPECT_EQ (_test_get_pool_stat ("test-pool", "ready"), 1);
+  EXPECT_EQ (_test_get_pool_stat ("test-pool", "hits"), 1);
+
+  EXPECT_EQ (mlops_node_destroy (id1), 0);
+  _test_admission_configure (0, 0, 0, 0);
+
+  svcdb_pipeline_delete ("test-pool");
+  mlops_node_pool_update ("test-pool");
+}
+
+/**
+ * @brief Testcase for the admission control - the queued request is admitted when the node is destroyed.
+ */
+TEST_F (MLOpsNodeTest, admission_queue)
+{
+  test_launch_result_s r1 = { 0, -1 };
+  test_launch_result_s r2 = { 0, -1 };
+  GstState state;
+  gint64 id1, id2;
+
+  _test_admission_configure (1, 0, 0, 10000);
+
+  ASSERT_EQ (mlops_node_create_async ("test-node", MLOPS_NODE_TYPE_PIPELINE,
+                "test-app", NULL, FALSE, _test_launch_done, &r1, &id1),
+      0);
+  _test_wait_launch (&r1, 5000);
+  ASSERT_EQ (r1.called, 1);
+  EXPECT_EQ (r1.result, 0);
+
+  /* The second request waits in the queue. */
+  ASSERT_EQ (mlops_node_create_async ("test-node", MLOPS_NODE_TYPE_PIPELINE,
+                "test-app", NULL, FALSE, _test_launch_done, &r2, &id2),
+      0);
+  _test_wait_launch (&r2, 200);
+  EXPECT_EQ (r2.called, 0);
+  EXPECT_EQ (mlops_node_get_state (id2, &state), 0);
+  EXPECT_EQ (state, GST_STATE_VOID_PENDING);
+
+  EXPECT_EQ (mlops_node_destroy (id1), 0);
+  _test_wait_launch (&r2, 5000);
+  ASSERT_EQ (r2.called, 1);
+  EXPECT_EQ (r2.result, 0);
+
+  EXPECT_EQ (mlops_node_start (id2), 0);
+  EXPECT_EQ (mlops_node_destroy (id2), 0);
+
+  _test_admission_configure (0, 0, 0, 0);
+}
+
+/**
+ * @brief Testcase for the admission control - the queued request is rejected after the timeout.
+ */
+TEST_F (MLOpsNodeTest, admission_queue_timeout_n)
+{
+  test_launch_result_s r1 = { 0, -1 };
+  test_launch_result_s r2 = { 0, -1 };
+  GstState state;
+  gint64 id1, id2;
+
+  _test_admission_configure (1, 0, 0, 100);
+
+  ASSERT_EQ (mlops_node_create_async ("test-node", MLOPS_NODE_TYPE_PIPELINE,
+                NULL, NULL, FALSE, _test_launch_done, &r1, &id1),
+      0);
+  _test_wait_launch (&r1, 5000);
+  ASSERT_EQ (r1.result, 0);
+
+  ASSERT_EQ (mlops_node_create_async ("test-node", MLOPS_NODE_TYPE_PIPELINE,
+                NULL, NULL, FALSE, _test_launch_done, &r2, &id2),
+      0);
+  _test_wait_launch (&r2, 5000);
+  ASSERT_EQ (r2.called, 1);
+  EXPECT_EQ (r2.result, -EBUSY);
+
+  /* The rejected node is released. */
+  EXPECT_NE (mlops_node_get_state (id2, &state), 0);
+
+  EXPECT_EQ (mlops_node_destroy (id1), 0);
+
+  _test_admission_configure (0, 0, 0, 0);
+}
+
+/**
+ * @brief Callback to get the result of the queued request, called in the worker of the admission control.
+ */
+static void
+_test_admission_done (const int result, void *user_data)
+{
+  test_launch_result_s *r = (test_launch_result_s *) user_data;
+
+  g_atomic_int_set (&r->result, result);
+  g_atomic_int_inc (&r->called);
+}
+
+/**
+ * @brief Internal function to wait for the queued request without iterating the main context.
+ */
+static void
+_test_wait_admission (test_launch_result_s *r, guint timeout_ms)
+{
+  gint64 end = g_get_monotonic_time () + (gint64) timeout_ms * 1000;
+
+  while (g_atomic_int_get (&r->called) == 0 && g_get_monotonic_time () < end)
+    g_usleep (1000);
+}
+
+/**
+ * @brief Testcase for the admission control - the queued request is admitted or expired without the main loop.
+ */
+TEST_F (MLOpsNodeTest, admission_queue_without_main_loop)
+{
+  test_launch_result_s r1 = { 0, -1 };
+  test_launch_result_s r2 = { 0, -1 };
+  mlops_node_cost_s cost = { 0, 0 };
+
+  _test_admission_configure (1, 0, 0, 100);
+  ASSERT_EQ (mlops_node_admission_acquire ("test-app", &cost, 0, NULL, NULL, NULL), 0);
+
+  /* The request expires in the worker, nothing iterates the main context. */
+  ASSERT_EQ (mlops_node_admission_acquire ("test-app", &cost, 0,
+                _test_admission_done, &r1, NULL),
+      -EINPROGRESS);
+  _test_wait_admission (&r1, 5000);
+  ASSERT_EQ (g_atomic_int_get (&r1.called), 1);
+  EXPECT_EQ (g_atomic_int_get (&r1.result), -EBUSY);
+
+  /* The request is admitted in the worker when the budget is released. */
+  _test_admission_configure (1, 0, 0, 10000);
+  ASSERT_EQ (mlops_node_admission_acquire ("test-app", &cost, 0,
+                _test_admission_done, &r2, NULL),
+      -EINPROGRESS);
+  mlops_node_admission_release ("test-app", &cost);
+  _test_wait_admission (&r2, 5000);
+  ASSERT_EQ (g_atomic_int_get (&r2.called), 1);
+  EXPECT_EQ (g_atomic_int_get (&r2.result), 0);
+
+  mlops_node_admission_release ("test-app", &cost);
+  _test_admission_configure (0, 0, 0, 0);
+}
+
+/**
+ * @brief Testcase for the admission control - the per-app quota and the estimated cost of the service.
+ */
+TEST_F (MLOpsNodeTest, admission_quota_n)
+{
+  test_launch_result_s r1 = { 0, -1 };
+  test_launch_result_s r2 = { 0, -1 };
+  test_launch_result_s r3 = { 0, -1 };
+  gint64 id1, id2, id3;
+
+  /* Each app launches one pipeline, the request over the quota is rejected immediately. */
+  _test_admission_configure (0, 0, 1, 0);
+
+  ASSERT_EQ (mlops_node_create_async ("test-node", MLOPS_NODE_TYPE_PIPELINE,
+                "test-app-1", NULL, FALSE, _test_launch_done, &r1, &id1),
+      0);
+  EXPECT_EQ (mlops_node_create_async ("test-node", MLOPS_NODE_TYPE_PIPELINE,
+                "test-app-1", NULL, FALSE, _test_launch_done, &r2, &id2),
+      -EBUSY);
+  ASSERT_EQ (mlops_node_create_async ("test-node", MLOPS_NODE_TYPE_PIPELINE,
+                "test-app-2", NULL, FALSE, _test_launch_done, &r3, &id3),
+      0);
+
+  _test_wait_launch (&r1, 5000);
+  _test_wait_launch (&r3, 5000);
+  EXPECT_EQ (mlops_node_destroy (id1), 0);
+  EXPECT_EQ (mlops_node_destroy (id3), 0);
+
+  /* The estimated cost of the service exceeds the CPU budget with the running pipeline. */
+  _test_admission_configure (0, 100, 0, 0);
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-node", "{\"cost_cpu\":60}"), 0);
+
+  ASSERT_EQ (mlops_node_create ("test-node", MLOPS_NODE_TYPE_PIPELINE, &id1), 0);
+  EXPECT_EQ (mlops_node_create ("test-node", MLOPS_NODE_TYPE_PIPELINE, &id2), -EBUSY);
+  EXPECT_EQ (mlops_node_destroy (id1), 0);
+
+  svcdb_pipeline_set_attributes ("test-node", "{\"cost_cpu\":null}");
+  _test_admission_configure (0, 0, 0, 0);
+}
+
+/**
+ * @brief Testcase for the idle reclamation - the stopped pipeline is released and built again when started.
+ */
+TEST_F (MLOpsNodeTest, reclaim_idle)
+{
+  g_autofree gchar *stats = NULL;
+  GstState state;
+  gint64 id, playing;
+  guint i, count = 0U;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-reclaim", "videotestsrc ! queue ! fakesink"), 0);
+  ASSERT_EQ (mlops_node_create ("test-reclaim", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+  ASSERT_EQ (mlops_node_create ("test-reclaim", MLOPS_NODE_TYPE_PIPELINE, &playing), 0);
+
+  mlops_node_set_reclaim_timeout (1U);
+  EXPECT_EQ (mlops_node_start (playing), 0);
+  EXPECT_TRUE (_test_wait_state (playing, GST_STATE_PLAYING, 3000));
+
+  EXPECT_EQ (mlops_node_start (id), 0);
+  EXPECT_TRUE (_test_wait_state (id, GST_STATE_PLAYING, 3000));
+  EXPECT_EQ (mlops_node_stop (id), 0);
+
+  /* Only the stopped pipeline is selected when the timeout is expired, the playing pipeline is not released. */
+  for (i = 0; i < 300 && count == 0U; i++) {
+    count = mlops_node_reclaim_idle ();
+    if (count == 0U)
+      g_usleep (10000);
+  }
+  EXPECT_EQ (count, 1U);
+  EXPECT_EQ (mlops_node_get_state (playing, &state), 0);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  /* The idle pipeline is released in the worker. */
+  EXPECT_TRUE (_test_wait_state (id, GST_STATE_NULL, 3000));
+
+  /* Stopping the released pipeline does not build it. */
+  EXPECT_EQ (mlops_node_stop (id), 0);
+  EXPECT_EQ (mlops_node_get_state (id, &state), 0);
+  EXPECT_EQ (state, GST_STATE_NULL);
+
+  EXPECT_EQ (mlops_node_start (id), 0);
+  EXPECT_TRUE (_test_wait_state (id, GST_STATE_PLAYING, 3000));
+
+  ASSERT_EQ (mlops_node_get_statistics (id, &stats), 0);
+  EXPECT_TRUE (g_strstr_len (stats, -1, "\"reclaim\"") != NULL);
+  EXPECT_TRUE (g_strstr_len (stats, -1, "\"rebuilds\":1") != NULL);
+
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+  EXPECT_EQ (mlops_node_destroy (playing), 0);
+  mlops_node_set_reclaim_timeout (0U);
+  EXPECT_EQ (mlops_node_reclaim_idle (), 0U);
+
+  svcdb_pipeline_delete ("test-reclaim");
+}
+
+/**
+ * @brief Testcase for releasing the idle pipeline - the node started while the pipeline is being released waits for the release.
+ */
+TEST_F (MLOpsNodeTest, reclaim_idle_restart)
+{
+  g_autofree gchar *stats = NULL;
+  gint64 id;
+  guint i, count = 0U;
+
+  /* The pipeline built again is rejected if the released one still holds the budget. */
+  _test_admission_configure (1, 0, 0, 0);
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-reclaim", "videotestsrc ! queue ! fakesink"), 0);
+  ASSERT_EQ (mlops_node_create ("test-reclaim", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+
+  mlops_node_set_reclaim_timeout (1U);
+  EXPECT_EQ (mlops_node_start (id), 0);
+  EXPECT_TRUE (_test_wait_state (id, GST_STATE_PLAYING, 3000));
+  EXPECT_EQ (mlops_node_stop (id), 0);
+
+  for (i = 0; i < 300 && count == 0U; i++) {
+    count = mlops_node_reclaim_idle ();
+    if (count == 0U)
+      g_usleep (10000);
+  }
+  EXPECT_EQ (count, 1U);
+
+  /* Start the node without waiting for the worker. */
+  EXPECT_EQ (mlops_node_start (id), 0);
+  EXPECT_TRUE (_test_wait_state (id, GST_STATE_PLAYING, 3000));
+
+  ASSERT_EQ (mlops_node_get_statistics (id, &stats), 0);
+  EXPECT_TRUE (g_strstr_len (stats, -1, "\"rebuilds\":1") != NULL);
+
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+  mlops_node_set_reclaim_timeout (0U);
+  _test_admission_configure (0, 0, 0, 0);
+
+  svcdb_pipeline_delete ("test-reclaim");
+}
+
+/**
+ * @brief Testcase for the batch - launch and start the pipelines in parallel, and compare with the sequential calls.
+ */
+TEST_F (MLOpsNodeTest, batch_benchmark)
+{
+  const gchar *names[TEST_NUM_BATCH];
+  gint64 ids[TEST_NUM_BATCH];
+  int results[TEST_NUM_BATCH];
+  gint64 start, sequential, batch;
+  guint i;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-batch", "videotestsrc ! queue ! fakesink"), 0);
+  for (i = 0; i < TEST_NUM_BATCH; i++)
+    names[i] = "test-batch";
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < TEST_NUM_BATCH; i++) {
+    ASSERT_EQ (mlops_node_create (names[i], MLOPS_NODE_TYPE_PIPELINE, &ids[i]), 0);
+    EXPECT_EQ (mlops_node_start (ids[i]), 0);
+  }
+  sequential = g_get_monotonic_time () - start;
+
+  for (i = 0; i < TEST_NUM_BATCH; i++)
+    EXPECT_EQ (mlops_node_destroy (ids[i]), 0);
+
+  start = g_get_monotonic_time ();
+  ASSERT_EQ (mlops_node_create_batch (names, TEST_NUM_BATCH, NULL, ids, results), 0);
+  EXPECT_EQ (mlops_node_batch (MLOPS_NODE_BATCH_START, ids, TEST_NUM_BATCH, results), 0);
+  batch = g_get_monotonic_time () - start;
+
+  for (i = 0; i < TEST_NUM_BATCH; i++)
+    EXPECT_EQ (results[i], 0);
+
+  ml_logi ("Launch and start %d pipelines: sequential %" G_GINT64_FORMAT " us, batch %" G_GINT64_FORMAT " us",
+      TEST_NUM_BATCH, sequential, batch);
+
+  /* The pipelines are built and prerolled in parallel. */
+  EXPECT_LT (batch, sequential);
+
+  EXPECT_EQ (mlops_node_batch (MLOPS_NODE_BATCH_STOP, ids, TEST_NUM_BATCH, results), 0);
+  EXPECT_EQ (mlops_node_batch (MLOPS_NODE_BATCH_DESTROY, ids, TEST_NUM_BATCH, results), 0);
+
+  /* The destroyed nodes have the error. */
+  EXPECT_NE (mlops_node_batch (MLOPS_NODE_BATCH_DESTROY, ids, TEST_NUM_BATCH, results), 0);
+  for (i = 0; i < TEST_NUM_BATCH; i++)
+    EXPECT_EQ (results[i], -EINVAL);
+
+  svcdb_pipeline_delete ("test-batch");
+}
+
+/**
+ * @brief Data for the callback of the asynchronous batch.
+ */
+typedef struct
+{
+  gint called;
+  gint result;
+  gint64 ids[TEST_NUM_BATCH];
+  int results[TEST_NUM_BATCH];
+} test_batch_result_s;
+
+/**
+ * @brief Callback to get the result of the asynchronous batch.
+ */
+static void
+_test_batch_cb (const int64_t *ids, const int *results, const guint count,
+    const int result, void *user_data)
+{
+  test_batch_result_s *r = (test_batch_result_s *) user_data;
+  guint i;
+
+  for (i = 0; i < count && i < TEST_NUM_BATCH; i++) {
+    r->ids[i] = ids[i];
+    r->results[i] = results[i];
+  }
+
+  r->result = result;
+  r->called++;
+}
+
+/**
+ * @brief Internal function to iterate the main context until the callback of the batch is called.
+ */
+static void
+_test_wait_batch (test_batch_result_s *r, guint timeout_ms)
+{
+  gint64 end = g_get_monotonic_time () + (gint64) timeout_ms * 1000;
+
+  while (r->called == 0 && g_get_monotonic_time () < end) {
+    if (!g_main_context_iteration (NULL, FALSE))
+      g_usleep (1000);
+  }
+}
+
+/**
+ * @brief Testcase for the asynchronous batch - the caller returns immediately and the callback has the results.
+ */
+TEST_F (MLOpsNodeTest, batch_async)
+{
+  const gchar *names[TEST_NUM_BATCH];
+  test_batch_result_s launch = {}, start = {}, destroy = {};
+  GstState state;
+  guint i;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-batch", "videotestsrc ! queue ! fakesink"), 0);
+  for (i = 0; i < TEST_NUM_BATCH; i++)
+    names[i] = "test-batch";
+  names[TEST_NUM_BATCH - 1] = "test-batch-unknown";
+
+  ASSERT_EQ (mlops_node_create_batch_async (names, TEST_NUM_BATCH, "test-app", _test_batch_cb, &launch), 0);
+  EXPECT_EQ (launch.called, 0);
+
+  _test_wait_batch (&launch, 10000);
+  ASSERT_EQ (launch.called, 1);
+  EXPECT_NE (launch.result, 0);
+  EXPECT_EQ (launch.ids[TEST_NUM_BATCH - 1], -1);
+  EXPECT_NE (launch.results[TEST_NUM_BATCH - 1], 0);
+
+  for (i = 0; i < TEST_NUM_BATCH - 1; i++)
+    ASSERT_EQ (launch.results[i], 0);
+
+  ASSERT_EQ (mlops_node_batch_async (MLOPS_NODE_BATCH_START, launch.ids, TEST_NUM_BATCH - 1, _test_batch_cb, &start), 0);
+  _test_wait_batch (&start, 10000);
+  ASSERT_EQ (start.called, 1);
+  EXPECT_EQ (start.result, 0);
+
+  state = GST_STATE_NULL;
+  for (i = 0; i < 100 && state != GST_STATE_PLAYING; i++) {
+    EXPECT_EQ (mlops_node_get_state (launch.ids[0], &state), 0);
+    g_usleep (10000);
+  }
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  ASSERT_EQ (mlops_node_batch_async (MLOPS_NODE_BATCH_DESTROY, launch.ids, TEST_NUM_BATCH - 1, _test_batch_cb, &destroy), 0);
+  _test_wait_batch (&destroy, 10000);
+  ASSERT_EQ (destroy.called, 1);
+  EXPECT_EQ (destroy.result, 0);
+  EXPECT_NE (mlops_node_get_state (launch.ids[0], &state), 0);
+
+  EXPECT_NE (mlops_node_batch_async (MLOPS_NODE_BATCH_START, launch.ids, 1, NULL, NULL), 0);
+  EXPECT_NE (mlops_node_create_batch_async (names, 0, NULL, _test_batch_cb, &launch), 0);
+
+  svcdb_pipeline_delete ("test-batch");
+}
+
+/**
+ * @brief Testcase for the template - replace the placeholders with the parameters, the default values and the activated model.
+ */
+TEST_F (MLOpsNodeTest, template_params)
+{
+  const gchar *desc = "videotestsrc num-buffers=${num:-10} ! tensor_converter ! "
+                      "tensor_filter model=${model:test-template-model} ! fakesink name=${sink}";
+  GHashTable *params;
+  gchar *expanded = NULL;
+  guint version = 0U;
+  gint64 id;
+
+  ASSERT_EQ (svcdb_model_add ("test-template-model", "/path/to/model.tflite", true,
+                 "description", "", &version), 0);
+  ASSERT_EQ (mlops_node_template_set ("test-template", desc), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-template", desc), 0);
+
+  params = g_hash_table_new (g_str_hash, g_str_equal);
+  g_hash_table_insert (params, (gpointer) "sink", (gpointer) "out");
+
+  ASSERT_EQ (mlops_node_template_expand ("test-template", desc, params, &expanded, NULL), 0);
+  EXPECT_STREQ (expanded, "videotestsrc num-buffers=10 ! tensor_converter ! "
+                          "tensor_filter model=/path/to/model.tflite ! fakesink name=out");
+  g_free (expanded);
+
+  g_hash_table_insert (params, (gpointer) "num", (gpointer) "5");
+  ASSERT_EQ (mlops_node_template_expand ("test-template", desc, params, &expanded, NULL), 0);
+  EXPECT_STREQ (expanded, "videotestsrc num-buffers=5 ! tensor_converter ! "
+                          "tensor_filter model=/path/to/model.tflite ! fakesink name=out");
+  g_free (expanded);
+
+  /* The description without the placeholder is not changed. */
+  ASSERT_EQ (mlops_node_template_expand ("test-node", "fakesrc ! fakesink", NULL, &expanded, NULL), 0);
+  EXPECT_STREQ (expanded, "fakesrc ! fakesink");
+  g_free (expanded);
+
+  /* Launch the pipeline with the parameters. */
+  ASSERT_EQ (svcdb_pipeline_set ("test-template", "videotestsrc num-buffers=${num:-10} ! fakesink name=${sink}"), 0);
+  EXPECT_EQ (mlops_node_create ("test-template", MLOPS_NODE_TYPE_PIPELINE, &id), -EINVAL);
+  ASSERT_EQ (mlops_node_create_with_params ("test-template", MLOPS_NODE_TYPE_PIPELINE, NULL, params, &id), 0);
+  EXPECT_EQ (mlops_node_start (id), 0);
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+
+  g_hash_table_destroy (params);
+  mlops_node_template_set ("test-template", NULL);
+  svcdb_pipeline_delete ("test-template");
+  svcdb_model_delete ("test-template-model", 0U, TRUE);
+}
+
+/**
+ * @brief Testcase for the template with the invalid placeholders and parameters.
+ */
+TEST_F (MLOpsNodeTest, template_params_n)
+{
+  GHashTable *params;
+  gchar *expanded = NULL;
+
+  params = g_hash_table_new (g_str_hash, g_str_equal);
+
+  /* The parameter is not given. */
+  EXPECT_EQ (mlops_node_template_expand ("test-template",
+                "videotestsrc pattern=${pattern} ! fakesink", params, &expanded, NULL), -EINVAL);
+
+  /* The value changes the structure of the pipeline. */
+  g_hash_table_insert (params, (gpointer) "pattern", (gpointer) "0 ! filesink location=/tmp/out");
+  EXPECT_EQ (mlops_node_template_expand ("test-template",
+                "videotestsrc pattern=${pattern} ! fakesink", params, &expanded, NULL), -EINVAL);
+
+  /* The model is not registered. */
+  EXPECT_NE (mlops_node_template_expand ("test-template",
+                "tensor_filter model=${model:test-unknown-model} ! fakesink", NULL, &expanded, NULL), 0);
+
+  g_hash_table_destroy (params);
+  mlops_node_template_set ("test-template", NULL);
+}
+
+/**
+ * @brief Testcase for the template - the text which is not a valid placeholder is kept, and '$${' is the escape of '${'.
+ */
+TEST_F (MLOpsNodeTest, template_literal)
+{
+  const gchar *kept[] = {
+    "videotestsrc pattern=${pattern ! fakesink",
+    "videotestsrc pattern=${} ! fakesink",
+    "videotestsrc pattern=${a-b} ! fakesink",
+    "tensor_filter model=${model:} ! fakesink",
+  };
+  gchar *expanded = NULL;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (kept); i++) {
+    EXPECT_EQ (mlops_node_template_set ("test-template", kept[i]), 0);
+    ASSERT_EQ (mlops_node_template_expand ("test-template", kept[i], NULL, &expanded, NULL), 0);
+    EXPECT_STREQ (expanded, kept[i]);
+    g_free (expanded);
+    expanded = NULL;
+  }
+
+  ASSERT_EQ (mlops_node_template_expand ("test-template",
+                "videotestsrc pattern=$${pattern} ! fakesink name=${sink:-out}", NULL, &expanded, NULL), 0);
+  EXPECT_STREQ (expanded, "videotestsrc pattern=${pattern} ! fakesink name=out");
+  g_free (expanded);
+
+  mlops_node_template_set ("test-template", NULL);
+}
+
+/**
+ * @brief Internal function to get the version of the model recorded on the node.
+ */
+static gint64
+_test_get_model_version (gint64 id, const gchar *model)
+{
+  gchar *stats = NULL;
+  JsonNode *root;
+  JsonObject *object;
+  gint64 version = -1;
+
+  if (mlops_node_get_statistics (id, &stats) != 0)
+    return -1;
+
+  root = json_from_string (stats, NULL);
+  object = root ? json_node_get_object (root) : NULL;
+  if (object && json_object_has_member (object, "models")) {
+    object = json_object_get_object_member (object, "models");
+    if (json_object_has_member (object, model))
+      version = json_object_get_int_member (object, model);
+  }
+
+  if (root)
+    json_node_free (root);
+  g_free (stats);
+  return version;
+}
+
+/**
+ * @brief Testcase for the model reference - resolve the activated model and record the version on the node.
+ */
+TEST_F (MLOpsNodeTest, model_reference)
+{
+  gchar *expanded = NULL;
+  GHashTable *models = NULL;
+  guint version1 = 0U, version2 = 0U;
+  gint64 id1, id2;
+
+  ASSERT_EQ (svcdb_model_add ("test-ref-model", "sink_v1", true, "description", "", &version1), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-ref", "fakesrc ! fakesink name=${model:test-ref-model}"), 0);
+
+  ASSERT_EQ (mlops_node_template_expand ("test-ref",
+                 "tensor_filter model=model:test-ref-model,model:test-ref-model ! fakesink",
+                 NULL, &expanded, &models), 0);
+  EXPECT_STREQ (expanded, "tensor_filter model=sink_v1,sink_v1 ! fakesink");
+  ASSERT_TRUE (models != NULL);
+  EXPECT_EQ (((mlops_node_model_s *) g_hash_table_lookup (models, "test-ref-model"))->version, version1);
+  g_hash_table_unref (models);
+  g_free (expanded);
+
+  /* The name with the prefix is not a reference. */
+  ASSERT_EQ (mlops_node_template_expand ("test-ref", "fakesrc ! fakesink name=my-model:x",
+                 NULL, &expanded, &models), 0);
+  EXPECT_STREQ (expanded, "fakesrc ! fakesink name=my-model:x");
+  EXPECT_TRUE (models == NULL);
+  g_free (expanded);
+
+  /* The reference without the braces is allowed only in the value of the model property. */
+  ASSERT_EQ (mlops_node_template_expand ("test-ref", "fakesrc ! fakesink name=model:x",
+                 NULL, &expanded, &models), 0);
+  EXPECT_STREQ (expanded, "fakesrc ! fakesink name=model:x");
+  EXPECT_TRUE (models == NULL);
+  g_free (expanded);
+
+  ASSERT_EQ (mlops_node_template_expand ("test-ref",
+                 "tensor_filter framework=tensorflow-lite model=\"model:test-ref-model\" custom=model:x ! fakesink",
+                 NULL, &expanded, &models), 0);
+  EXPECT_STREQ (expanded, "tensor_filter framework=tensorflow-lite model=\"sink_v1\" custom=model:x ! fakesink");
+  ASSERT_TRUE (models != NULL);
+  EXPECT_EQ (g_hash_table_size (models), 1U);
+  g_hash_table_unref (models);
+  g_free (expanded);
+
+  ASSERT_EQ (mlops_node_create ("test-ref", MLOPS_NODE_TYPE_PIPELINE, &id1), 0);
+  EXPECT_EQ (_test_get_model_version (id1, "test-ref-model"), (gint64) version1);
+
+  /* The cached model is used until the model is changed. */
+  ASSERT_EQ (svcdb_model_add ("test-ref-model", "sink_v2", true, "description", "", &version2), 0);
+  ASSERT_EQ (mlops_node_create ("test-ref", MLOPS_NODE_TYPE_PIPELINE, &id2), 0);
+  EXPECT_EQ (_test_get_model_version (id2, "test-ref-model"), (gint64) version1);
+  EXPECT_EQ (mlops_node_destroy (id2), 0);
+
+  mlops_node_template_model_changed ("test-ref-model");
+  ASSERT_EQ (mlops_node_create ("test-ref", MLOPS_NODE_TYPE_PIPELINE, &id2), 0);
+  EXPECT_EQ (_test_get_model_version (id2, "test-ref-model"), (gint64) version2);
+
+  /* The running pipeline keeps the version when it is launched. */
+  EXPECT_EQ (_test_get_model_version (id1, "test-ref-model"), (gint64) version1);
+
+  EXPECT_EQ (mlops_node_destroy (id1), 0);
+  EXPECT_EQ (mlops_node_destroy (id2), 0);
+
+  svcdb_pipeline_delete ("test-ref");
+  svcdb_model_delete ("test-ref-model", 0U, TRUE);
+  mlops_node_template_model_changed (NULL);
+}
+
+/**
+ * @brief Testcase for the model update - switch the running pipeline to the activated model.
+ */
+TEST_F (MLOpsNodeTest, model_update)
+{
+  guint version1 = 0U, version2 = 0U;
+  GstState state = GST_STATE_NULL;
+  gchar *stats = NULL;
+  gint64 id;
+  guint i;
+
+  ASSERT_EQ (svcdb_model_add ("test-swap-model", "sink_v1", true, "description", "", &version1), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-swap",
+                 "videotestsrc is-live=true ! fakesink name=${model:test-swap-model}"), 0);
+
+  ASSERT_EQ (mlops_node_create ("test-swap", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+  EXPECT_EQ (mlops_node_start (id), 0);
+  EXPECT_TRUE (_test_wait_state (id, GST_STATE_PLAYING, 3000));
+
+  /* The sink cannot reload the model, the pipeline is replaced with the new one. */
+  ASSERT_EQ (svcdb_model_add ("test-swap-model", "sink_v2", true, "description", "", &version2), 0);
+  EXPECT_EQ (mlops_node_model_update ("test-swap-model"), 0);
+
+  for (i = 0; i < 100 && _test_get_model_version (id, "test-swap-model") != (gint64) version2; i++)
+    g_usleep (50000);
+
+  EXPECT_EQ (_test_get_model_version (id, "test-swap-model"), (gint64) version2);
+
+  /* The node keeps its id and state. */
+  for (i = 0; i < 100 && state != GST_STATE_PLAYING; i++) {
+    EXPECT_EQ (mlops_node_get_state (id, &state), 0);
+    g_usleep (10000);
+  }
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  ASSERT_EQ (mlops_node_get_statistics (id, &stats), 0);
+  EXPECT_TRUE (g_strstr_len (stats, -1, "\"method\":\"shadow\"") != NULL);
+  g_free (stats);
+
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+
+  svcdb_pipeline_delete ("test-swap");
+  svcdb_model_delete ("test-swap-model", 0U, TRUE);
+  mlops_node_template_model_changed (NULL);
+}
+
+/**
+ * @brief Internal function to check the pipeline of the node has the element with given name.
+ */
+static gboolean
+_test_node_has_element (gint64 id, const gchar *name)
+{
+  g_autofree gchar *stats = NULL;
+  g_autofree gchar *member = g_strdup_printf ("\"name\":\"%s\"", name);
+
+  if (mlops_node_get_statistics (id, &stats) != 0)
+    return FALSE;
+
+  return (g_strstr_len (stats, -1, member) != NULL);
+}
+
+/**
+ * @brief Testcase for the model update - the path of the model which is a part of the other text in the description.
+ */
+TEST_F (MLOpsNodeTest, model_update_path_in_text)
+{
+  guint version1 = 0U, version2 = 0U;
+  gint64 id;
+  guint i;
+
+  /* The path 'sink' is also a part of the element 'fakesink'. */
+  ASSERT_EQ (svcdb_model_add ("test-swap-model", "sink", true, "description", "", &version1), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-swap",
+                 "videotestsrc is-live=true ! fakesink name=${model:test-swap-model}"), 0);
+
+  ASSERT_EQ (mlops_node_create ("test-swap", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+  EXPECT_EQ (mlops_node_start (id), 0);
+
+  ASSERT_EQ (svcdb_model_add ("test-swap-model", "out", true, "description", "", &version2), 0);
+  EXPECT_EQ (mlops_node_model_update ("test-swap-model"), 0);
+
+  for (i = 0; i < 100 && _test_get_model_version (id, "test-swap-model") != (gint64) version2; i++)
+    g_usleep (50000);
+
+  /* Only the model reference is replaced. */
+  EXPECT_EQ (_test_get_model_version (id, "test-swap-model"), (gint64) version2);
+  EXPECT_TRUE (_test_node_has_element (id, "out"));
+  EXPECT_FALSE (_test_node_has_element (id, "sink"));
+
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+
+  svcdb_pipeline_delete ("test-swap");
+  svcdb_model_delete ("test-swap-model", 0U, TRUE);
+  mlops_node_template_model_changed (NULL);
+}
+
+/**
+ * @brief Negative testcase for the model update - the model is not registered.
+ */
+TEST_F (MLOpsNodeTest, model_update_n)
+{
+  EXPECT_NE (mlops_node_model_update (NULL), 0);
+  EXPECT_NE (mlops_node_model_update ("test-unknown-model"), 0);
+}
+
+/**
+ * @brief Testcase for the description update - the running pipeline is switched to the changed description.
+ */
+TEST_F (MLOpsNodeTest, description_update)
+{
+  GstState state = GST_STATE_NULL;
+  gchar *stats = NULL;
+  gint64 id;
+  guint i;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-reload", "videotestsrc is-live=true ! fakesink name=sink_v1"), 0);
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-reload", "{\"reload\":\"seamless\"}"), 0);
+
+  ASSERT_EQ (mlops_node_create ("test-reload", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+  EXPECT_EQ (mlops_node_start (id), 0);
+  EXPECT_TRUE (_test_wait_state (id, GST_STATE_PLAYING, 3000));
+  EXPECT_TRUE (_test_node_has_element (id, "sink_v1"));
+
+  ASSERT_EQ (mlops_node_template_set ("test-reload", "videotestsrc is-live=true ! fakesink name=sink_v2"), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-reload", "videotestsrc is-live=true ! fakesink name=sink_v2"), 0);
+  EXPECT_EQ (mlops_node_description_update ("test-reload"), 0);
+
+  for (i = 0; i < 100 && !_test_node_has_element (id, "sink_v2"); i++)
+    g_usleep (50000);
+  EXPECT_TRUE (_test_node_has_element (id, "sink_v2"));
+  EXPECT_FALSE (_test_node_has_element (id, "sink_v1"));
+
+  /* The node keeps its id and state. */
+  for (i = 0; i < 100 && state != GST_STATE_PLAYING; i++) {
+    EXPECT_EQ (mlops_node_get_state (id, &state), 0);
+    g_usleep (10000);
+  }
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  ASSERT_EQ (mlops_node_get_statistics (id, &stats), 0);
+  EXPECT_TRUE (g_strstr_len (stats, -1, "\"method\":\"shadow\"") != NULL);
+  g_free (stats);
+
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+
+  svcdb_pipeline_delete ("test-reload");
+  mlops_node_template_set ("test-reload", NULL);
+}
+
+/**
+ * @brief Negative testcase for the description update - the running pipeline keeps the description without the reload policy.
+ */
+TEST_F (MLOpsNodeTest, description_update_n)
+{
+  gint64 id;
+
+  EXPECT_NE (mlops_node_description_update (NULL), 0);
+  EXPECT_EQ (mlops_node_description_update ("test-unknown-reload"), 0);
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-reload", "videotestsrc is-live=true ! fakesink name=sink_v1"), 0);
+  ASSERT_EQ (mlops_node_create ("test-reload", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+  EXPECT_EQ (mlops_node_start (id), 0);
+  EXPECT_TRUE (_test_wait_state (id, GST_STATE_PLAYING, 3000));
+
+  /* The service without the reload policy is not switched, the policy is checked before pushing the task. */
+  ASSERT_EQ (svcdb_pipeline_set ("test-reload", "videotestsrc is-live=true ! fakesink name=sink_v2"), 0);
+  EXPECT_EQ (mlops_node_description_update ("test-reload"), 0);
+
+  EXPECT_TRUE (_test_node_has_element (id, "sink_v1"));
+  EXPECT_FALSE (_test_node_has_element (id, "sink_v2"));
+
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+  svcdb_pipeline_delete ("test-reload");
+  mlops_node_template_set ("test-reload", NULL);
+}
+
+/**
+ * @brief Testcase for the description update - the composite service including the changed pipeline is switched, the others are not.
+ */
+TEST_F (MLOpsNodeTest, description_update_composite)
+{
+  gchar *stats = NULL;
+  gint64 id1, id2;
+  guint i;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-reload-src", "videotestsrc is-live=true ! fakesink"), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-reload", "videotestsrc ! fakesink name=sink_v1"), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-reload-other", "videotestsrc ! fakesink name=sink_other"), 0);
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-reload", "{\"reload\":\"seamless\"}"), 0);
+  ASSERT_EQ (svcdb_composite_set ("test-composite",
+                 "{\"pipelines\":[\"test-reload-src\",\"test-reload\"],"
+                 "\"links\":[{\"from\":\"test-reload-src\",\"to\":\"test-reload\"}]}"), 0);
+  ASSERT_EQ (svcdb_composite_set ("test-composite-other",
+                 "{\"pipelines\":[\"test-reload-src\",\"test-reload-other\"],"
+                 "\"links\":[{\"from\":\"test-reload-src\",\"to\":\"test-reload-other\"}]}"), 0);
+
+  ASSERT_EQ (mlops_node_create ("test-composite", MLOPS_NODE_TYPE_COMPOSITE, &id1), 0);
+  ASSERT_EQ (mlops_node_create ("test-composite-other", MLOPS_NODE_TYPE_COMPOSITE, &id2), 0);
+  EXPECT_EQ (mlops_node_start (id1), 0);
+  EXPECT_EQ (mlops_node_start (id2), 0);
+  EXPECT_TRUE (_test_node_has_element (id1, "sink_v1"));
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-reload", "videotestsrc ! fakesink name=sink_v2"), 0);
+  ASSERT_EQ (mlops_node_template_set ("test-reload", "videotestsrc ! fakesink name=sink_v2"), 0);
+  EXPECT_EQ (mlops_node_description_update ("test-reload"), 0);
+
+  for (i = 0; i < 100 && !_test_node_has_element (id1, "sink_v2"); i++)
+    g_usleep (50000);
+  EXPECT_TRUE (_test_node_has_element (id1, "sink_v2"));
+  EXPECT_FALSE (_test_node_has_element (id1, "sink_v1"));
+
+  /* The composite service without the changed pipeline is not switched. */
+  EXPECT_TRUE (_test_node_has_element (id2, "sink_other"));
+  ASSERT_EQ (mlops_node_get_statistics (id2, &stats), 0);
+  EXPECT_TRUE (g_strstr_len (stats, -1, "\"method\":\"none\"") != NULL);
+  g_free (stats);
+
+  EXPECT_EQ (mlops_node_destroy (id1), 0);
+  EXPECT_EQ (mlops_node_destroy (id2), 0);
+
+  svcdb_composite_delete ("test-composite");
+  svcdb_composite_delete ("test-composite-other");
+  svcdb_pipeline_delete ("test-reload-src");
+  svcdb_pipeline_delete ("test-reload");
+  svcdb_pipeline_delete ("test-reload-other");
+  mlops_node_template_set ("test-reload", NULL);
+}
+
+/**
+ * @brief Internal function to get the number of the filters using the shared model.
+ */
+static gint64
+_test_get_share_users (const gchar *model)
+{
+  gchar *stats = NULL;
+  JsonNode *root;
+  JsonArray *models;
+  gint64 users = -1;
+  guint i;
+
+  if (mlops_node_share_get_stats (&stats) != 0)
+    return -1;
+
+  root = json_from_string (stats, NULL);
+  models = root ? json_object_get_array_member (json_node_get_object (root), "models") : NULL;
+  for (i = 0; models && i < json_array_get_length (models); i++) {
+    JsonObject *object = json_array_get_object_element (models, i);
+
+    if (g_strcmp0 (json_object_get_string_member (object, "model"), model) == 0)
+      users = json_object_get_int_member (object, "users");
+  }
+
+  if (root)
+    json_node_free (root);
+  g_free (stats);
+  return users;
+}
+
+/**
+ * @brief Internal function to get the shared key of the filter in the pipeline.
+ */
+static gchar *
+_test_get_share_key (GstElement *pipeline)
+{
+  GstElement *filter;
+  gchar *key = NULL;
+
+  filter = gst_bin_get_by_name (GST_BIN (pipeline), "filter");
+  if (filter) {
+    g_object_get (filter, "shared-tensor-filter-key", &key, NULL);
+    gst_object_unref (filter);
+  }
+
+  return key;
+}
+
+/**
+ * @brief Testcase for the shared model - the filters with the same model share the loaded instance.
+ */
+TEST_F (MLOpsNodeTest, share_model)
+{
+  GstElementFactory *factory;
+  GstElement *p1, *p2, *p3, *p4;
+  gchar *k1, *k2, *k3, *k4;
+
+  /* The filter is available if nnstreamer is installed. */
+  factory = gst_element_factory_find ("tensor_filter");
+  if (!factory)
+    return;
+  gst_object_unref (factory);
+
+  p1 = gst_parse_launch ("tensor_filter name=filter framework=custom-easy model=test-share-model ! fakesink", NULL);
+  p2 = gst_parse_launch ("tensor_filter name=filter framework=custom-easy model=test-share-model ! fakesink", NULL);
+  p3 = gst_parse_launch ("tensor_filter name=filter framework=custom-easy model=test-share-other ! fakesink", NULL);
+  p4 = gst_parse_launch ("tensor_filter name=filter framework=custom-easy model=test-share-model "
+                         "shared-tensor-filter-key=user-key ! fakesink", NULL);
+  ASSERT_TRUE (p1 && p2 && p3 && p4);
+
+  mlops_node_share_attach (p1);
+  mlops_node_share_attach (p2);
+  mlops_node_share_attach (p3);
+  mlops_node_share_attach (p4);
+
+  k1 = _test_get_share_key (p1);
+  k2 = _test_get_share_key (p2);
+  k3 = _test_get_share_key (p3);
+  k4 = _test_get_share_key (p4);
+
+  EXPECT_TRUE (k1 != NULL && k1[0] != '\0');
+  EXPECT_STREQ (k1, k2);
+  EXPECT_STRNE (k1, k3);
+
+  /* The key given by the description is not changed. */
+  EXPECT_STREQ (k4, "user-key");
+
+  /* Both pipelines use one instance of the model. */
+  EXPECT_EQ (_test_get_share_users ("test-share-model"), 2);
+  EXPECT_EQ (_test_get_share_users ("test-share-other"), 1);
+
+  /* The instance is kept while the other pipeline uses it, and released with the last user. */
+  gst_object_unref (p1);
+  EXPECT_EQ (_test_get_share_users ("test-share-model"), 1);
+  g_free (k1);
+  k1 = _test_get_share_key (p2);
+  EXPECT_STREQ (k1, k2);
+
+  gst_object_unref (p2);
+  EXPECT_EQ (_test_get_share_users ("test-share-model"), -1);
+  EXPECT_EQ (_test_get_share_users ("test-share-other"), 1);
+  gst_object_unref (p3);
+  EXPECT_EQ (_test_get_share_users ("test-share-other"), -1);
+
+  gst_object_unref (p4);
+  g_free (k1);
+  g_free (k2);
+  g_free (k3);
+  g_free (k4);
+}
+
+/**
+ * @brief Testcase for the shared model - the model is shared only if the service allows it.
+ */
+TEST_F (MLOpsNodeTest, share_model_attribute)
+{
+  mlops_node_config_s config;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-share", "videotestsrc ! fakesink"), 0);
+
+  /* The model is not shared by default. */
+  mlops_node_config_load ("test-share", &config);
+  EXPECT_FALSE (config.share_model);
+
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-share", "{\"share_model\":\"true\"}"), 0);
+  mlops_node_config_load ("test-share", &config);
+  EXPECT_TRUE (config.share_model);
+
+  /* The configuration is not the scheduling attribute. */
+  EXPECT_TRUE (mlops_node_sched_new ("test-share") == NULL);
+
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-share", "{\"share_model\":\"false\"}"), 0);
+  mlops_node_config_load ("test-share", &config);
+  EXPECT_FALSE (config.share_model);
+
+  svcdb_pipeline_delete ("test-share");
+}
+
+/**
+ * @brief Internal function to get the member of the statistics of the element in the pipeline.
+ */
+static gint64
+_test_get_element_stat (gint64 id, const gchar *element, const gchar *member)
+{
+  gchar *stats = NULL;
+  JsonNode *root;
+  JsonObject *object;
+  JsonArray *elements = NULL;
+  gint64 value = -1;
+  guint i;
+
+  if (mlops_node_get_statistics (id, &stats) != 0)
+    return -1;
+
+  root = json_from_string (stats, NULL);
+  object = root ? json_node_get_object (root) : NULL;
+  if (object && json_object_has_member (object, "elements"))
+    elements = json_object_get_array_member (object, "elements");
+
+  for (i = 0; elements && i < json_array_get_length (elements); i++) {
+    object = json_array_get_object_element (elements, i);
+    if (g_strcmp0 (json_object_get_string_member (object, "name"), element) == 0) {
+      value = json_object_get_int_member (object, member);
+      break;
+    }
+  }
+
+  if (root)
+    json_node_free (root);
+  g_free (stats);
+  return value;
+}
+
+/**
+ * @brief Testcase for the statistics - the service disables the pad probes with the attribute.
+ */
+TEST_F (MLOpsNodeTest, stats_attribute)
+{
+  g_autofree gchar *stats = NULL;
+  mlops_node_config_s config;
+  gint64 id1, id2;
+  guint i;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-stats-on", "videotestsrc is-live=true ! fakesink name=sink"), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-stats-off", "videotestsrc is-live=true ! fakesink name=sink"), 0);
+
+  /* The probes are added by default. */
+  mlops_node_config_load ("test-stats-off", &config);
+  EXPECT_TRUE (config.stats);
+
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-stats-off", "{\"stats\":\"false\"}"), 0);
+  mlops_node_config_load ("test-stats-off", &config);
+  EXPECT_FALSE (config.stats);
+
+  ASSERT_EQ (mlops_node_create ("test-stats-on", MLOPS_NODE_TYPE_PIPELINE, &id1), 0);
+  ASSERT_EQ (mlops_node_create ("test-stats-off", MLOPS_NODE_TYPE_PIPELINE, &id2), 0);
+  EXPECT_EQ (mlops_node_start (id1), 0);
+  EXPECT_EQ (mlops_node_start (id2), 0);
+  EXPECT_TRUE (_test_wait_state (id1, GST_STATE_PLAYING, 3000));
+  EXPECT_TRUE (_test_wait_state (id2, GST_STATE_PLAYING, 3000));
+
+  /* Both pipelines are running when the sink of the other pipeline counts the buffers. */
+  for (i = 0; i < 100 && _test_get_element_stat (id1, "sink", "buffers_in") <= 0; i++)
+    g_usleep (50000);
+  EXPECT_GT (_test_get_element_stat (id1, "sink", "buffers_in"), 0);
+
+  /* The buffers are not counted without the probes. */
+  EXPECT_EQ (_test_get_element_stat (id2, "sink", "buffers_in"), 0);
+  ASSERT_EQ (mlops_node_get_statistics (id2, &stats), 0);
+  EXPECT_TRUE (g_strstr_len (stats, -1, "\"probe\":false") != NULL);
+
+  EXPECT_EQ (mlops_node_destroy (id1), 0);
+  EXPECT_EQ (mlops_node_destroy (id2), 0);
+
+  svcdb_pipeline_delete ("test-stats-on");
+  svcdb_pipeline_delete ("test-stats-off");
+}
+
+/**
+ * @brief Internal function to get the member of the statistics of the shared source.
+ */
+static gint64
+_test_get_source_stat (const gchar *name, const gchar *member)
+{
+  g_autofree gchar *stats = NULL;
+  JsonNode *node;
+  JsonObject *object;
+  gint64 value = -1;
+
+  if (mlops_node_source_get_stats (&stats) != 0)
+    return -1;
+
+  node = json_from_string (stats, NULL);
+  if (!node)
+    return -1;
+
+  object = json_node_get_object (node);
+  if (json_object_has_member (object, name)) {
+    object = json_object_get_object_member (object, name);
+    if (g_str_equal (member, "running"))
+      value = json_object_get_boolean_member (object, member) ? 1 : 0;
+    else
+      value = json_object_get_int_member (object, member);
+  }
+
+  json_node_free (node);
+  return value;
+}
+
+/**
+ * @brief Testcase for the shared source - the source is launched once and passes the data to the pipelines.
+ */
+TEST_F (MLOpsNodeTest, shared_source)
+{
+  GstState state = GST_STATE_NULL;
+  gint64 id1, id2, buffers;
+  guint i;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-source",
+                 "videotestsrc is-live=true ! video/x-raw,format=RGB,width=64,height=48,framerate=30/1"), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-source-receiver", "${source:test-source} ! queue ! fakesink"), 0);
+
+  ASSERT_EQ (mlops_node_create ("test-source-receiver", MLOPS_NODE_TYPE_PIPELINE, &id1), 0);
+  ASSERT_EQ (mlops_node_create ("test-source-receiver", MLOPS_NODE_TYPE_PIPELINE, &id2), 0);
+
+  /* The source is not launched until the receiver starts playing. */
+  EXPECT_EQ (_test_get_source_stat ("test-source", "running"), 0);
+  EXPECT_EQ (_test_get_source_stat ("test-source", "receivers"), 2);
+
+  EXPECT_EQ (mlops_node_start (id1), 0);
+  EXPECT_EQ (mlops_node_start (id2), 0);
+  for (i = 0; i < 100 && _test_get_source_stat ("test-source", "buffers") <= 0; i++)
+    g_usleep (10000);
+  EXPECT_EQ (_test_get_source_stat ("test-source", "running"), 1);
+
+  buffers = _test_get_source_stat ("test-source", "buffers");
+  EXPECT_GT (buffers, 0);
+
+  /* The other pipeline keeps receiving the data while one is stopped and destroyed. */
+  EXPECT_EQ (mlops_node_stop (id1), 0);
+  EXPECT_EQ (mlops_node_destroy (id1), 0);
+  for (i = 0; i < 100 && _test_get_source_stat ("test-source", "receivers") != 1; i++)
+    g_usleep (10000);
+  EXPECT_EQ (_test_get_source_stat ("test-source", "receivers"), 1);
+
+  for (i = 0; i < 100 && _test_get_source_stat ("test-source", "buffers") <= buffers; i++)
+    g_usleep (10000);
+  EXPECT_GT (_test_get_source_stat ("test-source", "buffers"), buffers);
+  EXPECT_EQ (mlops_node_get_state (id2, &state), 0);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  /* The source is stopped and removed when the last pipeline is released. */
+  EXPECT_EQ (mlops_node_destroy (id2), 0);
+
+  /* The new receiver reuses the source being stopped, and launches it again after it is stopped. */
+  ASSERT_EQ (mlops_node_create ("test-source-receiver", MLOPS_NODE_TYPE_PIPELINE, &id1), 0);
+  EXPECT_EQ (mlops_node_start (id1), 0);
+  for (i = 0; i < 100 && _test_get_source_stat ("test-source", "running") != 1; i++)
+    g_usleep (10000);
+  EXPECT_EQ (_test_get_source_stat ("test-source", "running"), 1);
+  EXPECT_EQ (_test_get_source_stat ("test-source", "receivers"), 1);
+
+  EXPECT_EQ (mlops_node_destroy (id1), 0);
+  for (i = 0; i < 100 && _test_get_source_stat ("test-source", "receivers") != -1; i++)
+    g_usleep (10000);
+  EXPECT_EQ (_test_get_source_stat ("test-source", "receivers"), -1);
+
+  svcdb_pipeline_delete ("test-source");
+  svcdb_pipeline_delete ("test-source-receiver");
+}
+
+/**
+ * @brief Negative testcase for the shared source - the source is not stored or the name is invalid.
+ */
+TEST_F (MLOpsNodeTest, shared_source_n)
+{
+  gchar *element = NULL;
+  gint64 id;
+
+  EXPECT_EQ (mlops_node_template_set ("test-source-receiver", "${source:} ! fakesink"), -EINVAL);
+  EXPECT_NE (mlops_node_source_prepare ("test unknown", &element), 0);
+  EXPECT_NE (mlops_node_source_prepare ("test-unknown-source", &element), 0);
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-source-receiver", "${source:test-unknown-source} ! fakesink"), 0);
+  EXPECT_NE (mlops_node_create ("test-source-receiver", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+
+  svcdb_pipeline_delete ("test-source-receiver");
+}
+
+/**
+ * @brief Testcase for the composite service - the stored pipelines are linked and launched as one node.
+ */
+TEST_F (MLOpsNodeTest, composite)
+{
+  GstState state = GST_STATE_NULL;
+  g_autofree gchar *desc = NULL;
+  g_autofree gchar *stats = NULL;
+  JsonNode *node;
+  gint64 id;
+  guint i;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-src",
+                 "videotestsrc is-live=true ! video/x-raw,width=64,height=48,framerate=30/1 ! fakesink"), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-convert", "videotestsrc ! videoconvert ! fakesink"), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-sink", "videotestsrc ! queue ! fakesink name=sink"), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-sink2", "videotestsrc ! queue ! fakesink name=sink2"), 0);
+
+  /* The complete pipelines are put in the bins, and linked when the pipeline is built. */
+  ASSERT_EQ (svcdb_composite_set ("test-composite",
+                 "{\"pipelines\":[\"test-composite-src\",\"test-composite-convert\",\"test-composite-sink\",\"test-composite-sink2\"],"
+                 "\"links\":[{\"from\":\"test-composite-src\",\"to\":\"test-composite-convert\"},"
+                 "{\"from\":\"test-composite-convert\",\"to\":\"test-composite-sink\"},"
+                 "{\"from\":\"test-composite-convert\",\"to\":\"test-composite-sink2\"}]}"), 0);
+
+  EXPECT_EQ (mlops_node_composite_expand ("test-composite", NULL, &desc, NULL), 0);
+  EXPECT_STREQ (desc, "bin.( name=mlops_composite_0 videotestsrc is-live=true ! video/x-raw,width=64,height=48,framerate=30/1 ! fakesink )"
+                      " bin.( name=mlops_composite_1_0 videotestsrc ! videoconvert ! fakesink )"
+                      " bin.( name=mlops_composite_2_1 videotestsrc ! queue ! fakesink name=sink )"
+                      " bin.( name=mlops_composite_3_1 videotestsrc ! queue ! fakesink name=sink2 )");
+
+  ASSERT_EQ (mlops_node_create ("test-composite", MLOPS_NODE_TYPE_COMPOSITE, &id), 0);
+  EXPECT_EQ (mlops_node_start (id), 0);
+  EXPECT_TRUE (_test_wait_state (id, GST_STATE_PLAYING, 3000));
+
+  EXPECT_EQ (mlops_node_get_state (id, &state), 0);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  /* The source elements of the downstreams are replaced, and the buffers of the upstream reach both sinks. */
+  EXPECT_TRUE (_test_node_has_element (id, "mlops_composite_src_1"));
+  for (i = 0; i < 100 && (_test_get_element_stat (id, "sink", "buffers_in") <= 0
+           || _test_get_element_stat (id, "sink2", "buffers_in") <= 0); i++)
+    g_usleep (20000);
+  EXPECT_GT (_test_get_element_stat (id, "sink", "buffers_in"), 0);
+  EXPECT_GT (_test_get_element_stat (id, "sink2", "buffers_in"), 0);
+
+  EXPECT_EQ (mlops_node_get_statistics (id, &stats), 0);
+  node = json_from_string (stats, NULL);
+  ASSERT_TRUE (node != NULL);
+  EXPECT_STREQ (json_object_get_string_member (json_node_get_object (node), "type"), "composite");
+  EXPECT_STREQ (json_object_get_string_member (json_node_get_object (node), "service_name"), "test-composite");
+  json_node_free (node);
+
+  EXPECT_EQ (mlops_node_stop (id), 0);
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+
+  svcdb_composite_delete ("test-composite");
+  svcdb_pipeline_delete ("test-composite-src");
+  svcdb_pipeline_delete ("test-composite-convert");
+  svcdb_pipeline_delete ("test-composite-sink");
+  svcdb_pipeline_delete ("test-composite-sink2");
+}
+
+/**
+ * @brief Negative testcase for the composite service - the definition is invalid or the pipeline is not stored.
+ */
+TEST_F (MLOpsNodeTest, composite_n)
+{
+  gint64 id;
+
+  EXPECT_EQ (mlops_node_composite_validate ("invalid"), -EINVAL);
+  EXPECT_EQ (mlops_node_composite_validate ("{\"pipelines\":[]}"), -EINVAL);
+  EXPECT_EQ (mlops_node_composite_validate ("{\"pipelines\":[\"a\",\"a\"]}"), -EINVAL);
+  EXPECT_EQ (mlops_node_composite_validate (
+                "{\"pipelines\":[\"a\"],\"links\":[{\"from\":\"a\",\"to\":\"b\"}]}"), -EINVAL);
+  EXPECT_EQ (mlops_node_composite_validate (
+                "{\"pipelines\":[\"a\",\"b\",\"c\"],\"links\":[{\"from\":\"a\",\"to\":\"c\"},{\"from\":\"b\",\"to\":\"c\"}]}"), -EINVAL);
+  EXPECT_EQ (mlops_node_composite_validate (
+                "{\"pipelines\":[\"a\",\"b\"],\"links\":[{\"from\":\"a\",\"to\":\"b\"},{\"from\":\"b\",\"to\":\"a\"}]}"), -EINVAL);
+  EXPECT_EQ (mlops_node_composite_validate ("{\"pipelines\":[\"a\",\"b\"]}"), 0);
+
+  EXPECT_NE (mlops_node_create ("test-composite-unknown", MLOPS_NODE_TYPE_COMPOSITE, &id), 0);
+
+  ASSERT_EQ (svcdb_composite_set ("test-composite", "{\"pipelines\":[\"test-node\",\"test-composite-unknown\"]}"), 0);
+  EXPECT_NE (mlops_node_create ("test-composite", MLOPS_NODE_TYPE_COMPOSITE, &id), 0);
+  svcdb_composite_delete ("test-composite");
+}
+
+/**
+ * @brief Negative testcase for the composite service - the pipeline cannot be linked with the others.
+ */
+TEST_F (MLOpsNodeTest, composite_link_n)
+{
+  const gchar *linked = "{\"pipelines\":[\"test-composite-src\",\"test-composite-sink\"],"
+                        "\"links\":[{\"from\":\"test-composite-src\",\"to\":\"test-composite-sink\"}]}";
+  gint64 id;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-src", "videotestsrc ! videoconvert name=conv ! fakesink"), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-sink", "videotestsrc ! queue ! fakesink"), 0);
+  EXPECT_EQ (mlops_node_composite_validate (linked), 0);
+
+  /* The upstream has no sink element or several sink elements. */
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-src", "videotestsrc ! videoconvert name=conv"), 0);
+  EXPECT_EQ (mlops_node_composite_validate (linked), -EINVAL);
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-src", "videotestsrc ! tee name=t t. ! queue ! fakesink t. ! queue ! fakesink"), 0);
+  EXPECT_EQ (mlops_node_composite_validate (linked), -EINVAL);
+
+  /* The downstream has no source element or several source elements. */
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-src", "videotestsrc ! videoconvert name=conv ! fakesink"), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-sink", "queue ! fakesink"), 0);
+  EXPECT_EQ (mlops_node_composite_validate (linked), -EINVAL);
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-sink", "videotestsrc ! compositor name=mix ! fakesink videotestsrc ! mix."), 0);
+  EXPECT_EQ (mlops_node_composite_validate (linked), -EINVAL);
+
+  /* The names of the elements collide. */
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-sink", "videotestsrc ! videoconvert name=conv ! fakesink"), 0);
+  EXPECT_EQ (mlops_node_composite_validate (linked), -EINVAL);
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-sink", "videotestsrc name=mlops_composite_src_1 ! fakesink"), 0);
+  EXPECT_EQ (mlops_node_composite_validate (linked), -EINVAL);
+
+  /* The pipeline changed after the composite service is set is rejected when it is launched. */
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-sink", "videotestsrc ! queue ! fakesink"), 0);
+  ASSERT_EQ (svcdb_composite_set ("test-composite", linked), 0);
+  ASSERT_EQ (svcdb_pipeline_set ("test-composite-sink", "queue ! fakesink"), 0);
+  EXPECT_NE (mlops_node_create ("test-composite", MLOPS_NODE_TYPE_COMPOSITE, &id), 0);
+
+  svcdb_composite_delete ("test-composite");
+  svcdb_pipeline_delete ("test-composite-src");
+  svcdb_pipeline_delete ("test-composite-sink");
+}
+
+/**
+ * @brief Internal function to iterate the main context until the restart information has the member.
+ */
+static gboolean
+_test_wait_restart (gint64 id, const gchar *member, guint timeout_ms)
+{
+  gint64 end = g_get_monotonic_time () + (gint64) timeout_ms * 1000;
+  gboolean found = FALSE;
+
+  while (!found && g_get_monotonic_time () < end) {
+    g_autofree gchar *info = NULL;
+
+    if (mlops_node_get_restart_info (id, &info) == 0)
+      found = (g_strstr_len (info, -1, member) != NULL);
+
+    if (!found && !g_main_context_iteration (NULL, FALSE))
+      g_usleep (1000);
+  }
+
+  return found;
+}
+
+/**
+ * @brief Testcase for the restart policy - the pipeline which posted an error is restarted and keeps its id.
+ */
+TEST_F (MLOpsNodeTest, restart_policy)
+{
+  GstState state = GST_STATE_NULL;
+  gchar *info = NULL;
+  gint64 id;
+  guint i;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-restart",
+                 "videotestsrc is-live=true ! identity name=fail error-after=10 ! fakesink"), 0);
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-restart",
+                 "{\"restart_max_retries\":3,\"restart_backoff_ms\":10}"), 0);
+
+  ASSERT_EQ (mlops_node_create ("test-restart", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+
+  ASSERT_EQ (mlops_node_get_restart_info (id, &info), 0);
+  EXPECT_TRUE (g_strstr_len (info, -1, "\"max_retries\":3") != NULL);
+  EXPECT_TRUE (g_strstr_len (info, -1, "\"strategy\":\"repreroll\"") != NULL);
+  EXPECT_TRUE (g_strstr_len (info, -1, "\"last_error\":null") != NULL);
+  g_free (info);
+
+  /* The identity posts an error after 10 buffers. */
+  EXPECT_EQ (mlops_node_start (id), 0);
+  EXPECT_TRUE (_test_wait_restart (id, "\"count\":1", 5000));
+
+  ASSERT_EQ (mlops_node_get_restart_info (id, &info), 0);
+  EXPECT_TRUE (g_strstr_len (info, -1, "\"source\":\"fail\"") != NULL);
+  g_free (info);
+
+  /* The restarted pipeline follows the state requested last. */
+  for (i = 0; i < 100 && state != GST_STATE_PLAYING; i++) {
+    EXPECT_EQ (mlops_node_get_state (id, &state), 0);
+    g_usleep (10000);
+  }
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  /* The scheduled restart is cancelled. */
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+  svcdb_pipeline_delete ("test-restart");
+}
+
+/**
+ * @brief Negative testcase for the restart policy - the pipeline is not restarted without the policy.
+ */
+TEST_F (MLOpsNodeTest, restart_policy_n)
+{
+  gchar *info = NULL;
+  gint64 id;
+
+  EXPECT_NE (mlops_node_get_restart_info (-1, &info), 0);
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-restart",
+                 "videotestsrc is-live=true ! identity name=fail error-after=10 ! fakesink"), 0);
+  ASSERT_EQ (mlops_node_create ("test-restart", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+  EXPECT_NE (mlops_node_get_restart_info (id, NULL), 0);
+
+  EXPECT_EQ (mlops_node_start (id), 0);
+  /* The restart is decided when the error is recorded. */
+  EXPECT_TRUE (_test_wait_restart (id, "\"source\":\"fail\"", 5000));
+
+  ASSERT_EQ (mlops_node_get_restart_info (id, &info), 0);
+  EXPECT_TRUE (g_strstr_len (info, -1, "\"max_retries\":0") != NULL);
+  EXPECT_TRUE (g_strstr_len (info, -1, "\"count\":0") != NULL);
+  EXPECT_TRUE (g_strstr_len (info, -1, "\"pending\":false") != NULL);
+  g_free (info);
+
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+  svcdb_pipeline_delete ("test-restart");
+}
+
+/**
+ * @brief Internal function to get the integer member of the restart information, the member of 'stall' if @a stall is true.
+ */
+static gint64
+_test_get_restart_member (gint64 id, gboolean stall, const gchar *member)
+{
+  g_autofree gchar *info = NULL;
+  JsonParser *parser;
+  JsonObject *object;
+  gint64 value = -1;
+
+  if (mlops_node_get_restart_info (id, &info) != 0)
+    return -1;
+
+  parser = json_parser_new ();
+  if (json_parser_load_from_data (parser, info, -1, NULL)) {
+    object = json_node_get_object (json_parser_get_root (parser));
+    if (stall)
+      object = json_object_get_object_member (object, "stall");
+
+    if (object && json_object_has_member (object, member))
+      value = json_object_get_int_member (object, member);
+  }
+
+  g_object_unref (parser);
+  return value;
+}
+
+/**
+ * @brief Internal function to wait until the restart information has the value, without iterating the main context.
+ * @return The monotonic time when the value is found, 0 if timed out.
+ */
+static gint64
+_test_wait_restart_member (gint64 id, const gchar *member, gint64 value, guint timeout_ms)
+{
+  gint64 end = g_get_monotonic_time () + (gint64) timeout_ms * 1000;
+
+  while (g_get_monotonic_time () < end) {
+    if (_test_get_restart_member (id, FALSE, member) >= value)
+      return g_get_monotonic_time ();
+    g_usleep (1000);
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to get the time (in milliseconds) of the last error recorded in the restart information.
+ * @return The timestamp of the last error, 0 if no error is recorded.
+ */
+static gint64
+_test_get_restart_error_time (gint64 id)
+{
+  g_autofree gchar *info = NULL;
+  JsonParser *parser;
+  JsonObject *object;
+  gint64 value = 0;
+
+  if (mlops_node_get_restart_info (id, &info) != 0)
+    return 0;
+
+  parser = json_parser_new ();
+  if (json_parser_load_from_data (parser, info, -1, NULL)) {
+    object = json_node_get_object (json_parser_get_root (parser));
+    if (object && json_object_has_member (object, "last_error") &&
+        !json_object_get_null_member (object, "last_error")) {
+      object = json_object_get_object_member (object, "last_error");
+      value = json_object_get_int_member (object, "timestamp_ms");
+    }
+  }
+
+  g_object_unref (parser);
+  return value;
+}
+
+/**
+ * @brief Testcase for the restart policy - the backoff is doubled for each restart, and the pipeline is not restarted after the maximum retries.
+ */
+TEST_F (MLOpsNodeTest, restart_backoff)
+{
+  gchar *info = NULL;
+  gint64 t1, t2, t3, error_time;
+  gboolean done = FALSE;
+  gint64 id;
+  guint i;
+
+  /* The pipeline built again posts an error after the first buffer. */
+  ASSERT_EQ (svcdb_pipeline_set ("test-restart",
+                 "videotestsrc is-live=true ! identity name=fail error-after=1 ! fakesink"), 0);
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-restart",
+                 "{\"restart_max_retries\":3,\"restart_backoff_ms\":100,\"restart_strategy\":\"rebuild\"}"), 0);
+
+  ASSERT_EQ (mlops_node_create ("test-restart", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+  EXPECT_EQ (mlops_node_start (id), 0);
+
+  /* The restart is scheduled in the timer of the agent, the main context is not iterated. */
+  t1 = _test_wait_restart_member (id, "attempts", 1, 5000);
+  t2 = _test_wait_restart_member (id, "attempts", 2, 5000);
+  t3 = _test_wait_restart_member (id, "attempts", 3, 5000);
+  error_time = _test_get_restart_error_time (id);
+  ASSERT_GT (t1, 0);
+  ASSERT_GT (t2, 0);
+  ASSERT_GT (t3, 0);
+
+  EXPECT_GE (t2 - t1, 100 * G_TIME_SPAN_MILLISECOND);
+  EXPECT_GE (t3 - t2, 200 * G_TIME_SPAN_MILLISECOND);
+
+  /**
+   * The attempt is counted when the restart is scheduled, so the last restart posts the error after this.
+   * The restart is decided when the error is recorded or the restart is done, so it is not restarted any more after both.
+   */
+  for (i = 0; i < 500 && !done; i++) {
+    ASSERT_EQ (mlops_node_get_restart_info (id, &info), 0);
+    done = (_test_get_restart_error_time (id) > error_time &&
+        g_strstr_len (info, -1, "\"pending\":false") != NULL);
+    g_free (info);
+    info = NULL;
+
+    if (!done)
+      g_usleep (10000);
+  }
+  EXPECT_TRUE (done);
+
+  EXPECT_EQ (_test_get_restart_member (id, FALSE, "attempts"), 3);
+  ASSERT_EQ (mlops_node_get_restart_info (id, &info), 0);
+  EXPECT_TRUE (g_strstr_len (info, -1, "\"pending\":false") != NULL);
+  g_free (info);
+
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+  svcdb_pipeline_delete ("test-restart");
+}
+
+/**
+ * @brief Callback to count the stalled pipelines.
+ */
+static void
+_test_stall_cb (const int64_t id, const int64_t idle_ms, void *user_data)
+{
+  gint *called = (gint *) user_data;
+
+  if (idle_ms > 0)
+    g_atomic_int_inc (called);
+}
+
+/**
+ * @brief Internal function to iterate the main context until the stall callback is called.
+ */
+static void
+_test_wait_stall (gint *called, gint count, guint timeout_ms)
+{
+  gint64 end = g_get_monotonic_time () + (gint64) timeout_ms * 1000;
+
+  while (g_atomic_int_get (called) < count && g_get_monotonic_time () < end) {
+    if (!g_main_context_iteration (NULL, FALSE))
+      g_usleep (1000);
+  }
+}
+
+/**
+ * @brief The pipeline description which keeps the playing state but no buffer enters the sink, without the end-of-stream.
+ */
+#define TEST_STALL_PIPELINE "videotestsrc is-live=true ! identity drop-probability=1.0 ! fakesink async=false"
+
+/**
+ * @brief Testcase for the stall detection - the playing pipeline whose buffers are dropped is notified.
+ */
+TEST_F (MLOpsNodeTest, stall_detection)
+{
+  GstState state = GST_STATE_NULL;
+  gint called = 0;
+  gint64 id;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-stall", TEST_STALL_PIPELINE), 0);
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-stall", "{\"stall_threshold_ms\":100}"), 0);
+  mlops_node_set_stall_cb (_test_stall_cb, &called);
+
+  ASSERT_EQ (mlops_node_create ("test-stall", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+  EXPECT_EQ (_test_get_restart_member (id, TRUE, "threshold_ms"), 100);
+  EXPECT_EQ (mlops_node_start (id), 0);
+
+  _test_wait_stall (&called, 1, 3000);
+  EXPECT_EQ (g_atomic_int_get (&called), 1);
+  EXPECT_EQ (_test_get_restart_member (id, TRUE, "count"), 1);
+
+  /* The stall is notified once, and the pipeline is not restarted without the policy. */
+  _test_wait_stall (&called, 2, 1500);
+  EXPECT_EQ (g_atomic_int_get (&called), 1);
+  EXPECT_EQ (_test_get_restart_member (id, FALSE, "count"), 0);
+
+  EXPECT_EQ (mlops_node_get_state (id, &state), 0);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+  mlops_node_set_stall_cb (NULL, NULL);
+  svcdb_pipeline_delete ("test-stall");
+}
+
+/**
+ * @brief Testcase for the stall detection - the stalled pipeline is restarted with the default retries.
+ */
+TEST_F (MLOpsNodeTest, stall_restart)
+{
+  g_autofree gchar *info = NULL;
+  gint called = 0;
+  gint64 id;
+
+  /* The stalled pipeline is restarted without 'restart_max_retries'. */
+  ASSERT_EQ (svcdb_pipeline_set ("test-stall", TEST_STALL_PIPELINE), 0);
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-stall",
+                 "{\"stall_threshold_ms\":100,\"stall_restart\":\"true\"}"), 0);
+  mlops_node_set_stall_cb (_test_stall_cb, &called);
+
+  ASSERT_EQ (mlops_node_create ("test-stall", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+  EXPECT_EQ (mlops_node_get_restart_info (id, &info), 0);
+  EXPECT_TRUE (g_strstr_len (info, -1, "\"max_retries\":3") != NULL);
+  EXPECT_EQ (mlops_node_start (id), 0);
+
+  /* The restarted pipeline is stalled again. */
+  _test_wait_stall (&called, 2, 5000);
+  EXPECT_GE (g_atomic_int_get (&called), 2);
+  EXPECT_GE (_test_get_restart_member (id, FALSE, "count"), 1);
+
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+  mlops_node_set_stall_cb (NULL, NULL);
+  svcdb_pipeline_delete ("test-stall");
+}
+
+/**
+ * @brief Negative testcase for the stall detection - the stall is not detected without the threshold.
+ */
+TEST_F (MLOpsNodeTest, stall_detection_n)
+{
+  gint called = 0;
+  gint64 id;
+
+  ASSERT_EQ (svcdb_pipeline_set ("test-stall", TEST_STALL_PIPELINE), 0);
+  mlops_node_set_stall_cb (_test_stall_cb, &called);
+
+  ASSERT_EQ (mlops_node_create ("test-stall", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+  EXPECT_EQ (_test_get_restart_member (id, TRUE, "threshold_ms"), 0);
+  EXPECT_EQ (mlops_node_start (id), 0);
+
+  _test_wait_stall (&called, 1, 1500);
+  EXPECT_EQ (g_atomic_int_get (&called), 0);
+  EXPECT_EQ (_test_get_restart_member (id, TRUE, "count"), 0);
+
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+  mlops_node_set_stall_cb (NULL, NULL);
+  svcdb_pipeline_delete ("test-stall");
+}
+
+/**
+ * @brief Negative testcase for the stall detection - the pipeline after the end-of-stream is not stalled nor restarted.
+ */
+TEST_F (MLOpsNodeTest, stall_detection_eos_n)
+{
+  gint called = 0;
+  gint64 id;
+
+  /* The source stops after 5 buffers and posts the end-of-stream. */
+  ASSERT_EQ (svcdb_pipeline_set ("test-stall", "videotestsrc is-live=true num-buffers=5 ! fakesink"), 0);
+  ASSERT_EQ (svcdb_pipeline_set_attributes ("test-stall",
+                 "{\"stall_threshold_ms\":100,\"stall_restart\":\"true\"}"), 0);
+  mlops_node_set_stall_cb (_test_stall_cb, &called);
+
+  ASSERT_EQ (mlops_node_create ("test-stall", MLOPS_NODE_TYPE_PIPELINE, &id), 0);
+  EXPECT_EQ (mlops_node_start (id), 0);
+
+  _test_wait_stall (&called, 1, 2500);
+  EXPECT_EQ (g_atomic_int_get (&called), 0);
+  EXPECT_EQ (_test_get_restart_member (id, TRUE, "count"), 0);
+  EXPECT_EQ (_test_get_restart_member (id, FALSE, "count"), 0);
+
+  EXPECT_EQ (mlops_node_destroy (id), 0);
+  mlops_node_set_stall_cb (NULL, NULL);
+  svcdb_pipeline_delete ("test-stall");
+}
+
+/**
+ * @brief Internal function to run the pipeline until EOS, with the pad probes of the statistics if @a probe is true.
+ */
+static gint64
+_test_run_probe_pipeline (gboolean probe)
+{
+  GstElement *pipeline;
+  GstBus *bus;
+  GstMessage *msg;
+  mlops_node_stats_s *stats = NULL;
+  gint64 start, elapsed = -1;
+
+  pipeline = gst_parse_launch ("fakesrc num-buffers=" G_STRINGIFY (TEST_NUM_PROBE_BUFFERS)
+                               " sizetype=fixed sizemax=64 ! identity ! fakesink", NULL);
+  if (!pipeline)
+    return -1;
+
+  if (probe)
+    stats = mlops_node_stats_new (pipeline, TRUE);
+
+  bus = gst_element_get_bus (pipeline);
+  start = g_get_monotonic_time ();
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  msg = gst_bus_timed_pop_filtered (bus, 20 * GST_SECOND,
+      (GstMessageType) (GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+  if (msg && GST_MESSAGE_TYPE (msg) == GST_MESSAGE_EOS)
+    elapsed = g_get_monotonic_time () - start;
+
+  if (msg)
+    gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+  mlops_node_stats_unref (stats);
+  return elapsed;
+}
+
+/**
+ * @brief Testcase for the stall detection - the overhead of the pad probes tracking the last buffer is negligible.
+ */
+TEST_F (MLOpsNodeTest, stall_probe_benchmark)
+{
+  gint64 plain = G_MAXINT64, probed = G_MAXINT64, elapsed;
+  gdouble overhead;
+  guint i;
+
+  /* Take the best of the rounds to reduce the noise. */
+  for (i = 0; i < TEST_NUM_ROUNDS; i++) {
+    elapsed = _test_run_probe_pipeline (FALSE);
+    ASSERT_GT (elapsed, 0);
+    plain = MIN (plain, elapsed);
+
+    elapsed = _test_run_probe_pipeline (TRUE);
+    ASSERT_GT (elapsed, 0);
+    probed = MIN (probed, elapsed);
+  }
+
+  overhead = (gdouble) (probed - plain) * 1000.0 / TEST_NUM_PROBE_BUFFERS;
+  ml_logi ("Run %d buffers: without probes %" G_GINT64_FORMAT " us, with probes %" G_GINT64_FORMAT
+      " us, %.1f ns per buffer", TEST_NUM_PROBE_BUFFERS, plain, probed, overhead);
+
+  /* The probes on 3 elements are small compared to the pipeline itself. */
+  EXPECT_LT (probed - plain, plain / 2);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
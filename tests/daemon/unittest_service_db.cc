@@ -88,6 +88,92 @@ TEST (serviceDB, delete_pipeline_n)
   db.disconnectDB ();
 }
 
+/**
+ * @brief Test for the attributes of pipeline.
+ */
+TEST (serviceDB, pipeline_attributes_scenario)
+{
+  MLServiceDB db (TEST_DB_PATH);
+  gchar *attributes = NULL;
+  gchar *value = NULL;
+
+  db.connectDB ();
+
+  db.set_pipeline ("test_attr", "videotestsrc ! fakesink");
+  db.get_pipeline_attributes ("test_attr", &attributes);
+  EXPECT_STREQ (attributes, "{}");
+  g_free (attributes);
+
+  /* The attributes are merged. */
+  db.set_pipeline_attributes ("test_attr", "{\"pool_size\":2}");
+  db.set_pipeline_attributes ("test_attr", "{\"test\":\"value\"}");
+
+  db.get_pipeline_attribute ("test_attr", "pool_size", &value);
+  EXPECT_STREQ (value, "2");
+  g_free (value);
+
+  db.get_pipeline_attribute ("test_attr", "test", &value);
+  EXPECT_STREQ (value, "value");
+  g_free (value);
+
+  /* The attributes are kept when the description is updated. */
+  db.set_pipeline ("test_attr", "videotestsrc ! fakesink sync=false");
+  db.get_pipeline_attribute ("test_attr", "pool_size", &value);
+  EXPECT_STREQ (value, "2");
+  g_free (value);
+
+  /* The member with null value is removed. */
+  db.set_pipeline_attributes ("test_attr", "{\"pool_size\":null}");
+  db.get_pipeline_attribute ("test_attr", "pool_size", &value);
+  EXPECT_TRUE (value == NULL);
+
+  db.delete_pipeline ("test_attr");
+  db.disconnectDB ();
+}
+
+/**
+ * @brief Negative test for the attributes of pipeline. Invalid param case.
+ */
+TEST (serviceDB, pipeline_attributes_n)
+{
+  MLServiceDB db (TEST_DB_PATH);
+  gchar *attributes = NULL;
+
+  db.connectDB ();
+  db.set_pipeline ("test_attr", "videotestsrc ! fakesink");
+
+  try {
+    db.set_pipeline_attributes ("test_attr", "invalid");
+    FAIL ();
+  } catch (const std::exception &e) {
+    /* expected */
+  }
+
+  try {
+    db.set_pipeline_attributes ("test_attr", "[1, 2]");
+    FAIL ();
+  } catch (const std::exception &e) {
+    /* expected */
+  }
+
+  try {
+    db.set_pipeline_attributes ("test_unknown", "{\"pool_size\":2}");
+    FAIL ();
+  } catch (const std::exception &e) {
+    /* expected */
+  }
+
+  try {
+    db.get_pipeline_attributes ("test_unknown", &attributes);
+    FAIL ();
+  } catch (const std::exception &e) {
+    /* expected */
+  }
+
+  db.delete_pipeline ("test_attr");
+  db.disconnectDB ();
+}
+
 /**
  * @brief Negative test for set_model. Invalid param case (empty name, model or version).
  */
@@ -344,6 +430,90 @@ TEST (serviceDB, delete_model_activated_n)
   db.disconnectDB ();
 }
 
+/**
+ * @brief Test for the definition of composite service.
+ */
+TEST (serviceDB, composite_scenario)
+{
+  MLServiceDB db (TEST_DB_PATH);
+  const gchar *definition = "{\"pipelines\":[\"src\",\"sink\"],\"links\":[{\"from\":\"src\",\"to\":\"sink\"}]}";
+  gchar *value = NULL;
+
+  db.connectDB ();
+
+  db.set_composite ("test_composite", definition);
+  db.get_composite ("test_composite", &value);
+  EXPECT_STREQ (value, definition);
+  g_free (value);
+  value = NULL;
+
+  db.delete_composite ("test_composite");
+
+  try {
+    db.get_composite ("test_composite", &value);
+    FAIL ();
+  } catch (const std::exception &e) {
+    /* expected */
+  }
+
+  try {
+    db.delete_composite ("test_composite");
+    FAIL ();
+  } catch (const std::exception &e) {
+    /* expected */
+  }
+
+  db.disconnectDB ();
+}
+
+/**
+ * @brief Negative test for composite service. Invalid param case.
+ */
+TEST (serviceDB, composite_n)
+{
+  MLServiceDB db (TEST_DB_PATH);
+
+  db.connectDB ();
+
+  try {
+    db.set_composite ("", "{\"pipelines\":[\"test\"]}");
+    FAIL ();
+  } catch (const std::exception &e) {
+    /* expected */
+  }
+
+  try {
+    db.set_composite ("test_composite", "");
+    FAIL ();
+  } catch (const std::exception &e) {
+    /* expected */
+  }
+
+  try {
+    gchar *definition;
+    db.get_composite ("", &definition);
+    FAIL ();
+  } catch (const std::exception &e) {
+    /* expected */
+  }
+
+  try {
+    db.get_composite ("test_composite", NULL);
+    FAIL ();
+  } catch (const std::exception &e) {
+    /* expected */
+  }
+
+  try {
+    db.delete_composite ("");
+    FAIL ();
+  } catch (const std::exception &e) {
+    /* expected */
+  }
+
+  db.disconnectDB ();
+}
+
 /**
  * @brief Negative test for set_pipeline. DB is not initialized.
  */
@@ -934,6 +1104,34 @@ TEST (serviceDBUtil, resource_delete_n)
   svcdb_finalize ();
 }
 
+/**
+ * @brief Negative test for service-db util. Invalid param case.
+ */
+TEST (serviceDBUtil, composite_n)
+{
+  gint ret;
+  gchar *definition;
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  ret = svcdb_composite_set ("", "{\"pipelines\":[\"test\"]}");
+  EXPECT_NE (ret, 0);
+  ret = svcdb_composite_set ("test", "");
+  EXPECT_NE (ret, 0);
+  ret = svcdb_composite_get ("", &definition);
+  EXPECT_NE (ret, 0);
+  ret = svcdb_composite_get ("test", NULL);
+  EXPECT_NE (ret, 0);
+  ret = svcdb_composite_get ("test_unregistered", &definition);
+  EXPECT_NE (ret, 0);
+  ret = svcdb_composite_delete ("");
+  EXPECT_NE (ret, 0);
+  ret = svcdb_composite_delete ("test_unregistered");
+  EXPECT_NE (ret, 0);
+
+  svcdb_finalize ();
+}
+
 /**
  * @brief Main gtest
  */